@@ -125,6 +125,34 @@ extern DECLSPEC Uint32 SDLCALL SDL_WasInit(Uint32 flags);
  */
 extern DECLSPEC void SDLCALL SDL_Quit(void);
 
+/**
+ *  How long one step of initialization took, see SDL_GetInitTimings().
+ */
+typedef struct SDL_InitTiming
+{
+    const char *name;       /**< The subsystem, like "video", or a step within it, like "video/x11" */
+    Uint32 subsystem;       /**< The SDL_INIT_* flag the step belongs to */
+    Uint64 start;           /**< Microseconds between the first recorded step starting and this one */
+    Uint64 duration;        /**< Microseconds the step took, 0 if it hasn't finished */
+    SDL_bool background;    /**< SDL_TRUE if the step ran on a background thread */
+} SDL_InitTiming;
+
+/**
+ *  Get the time spent initializing each subsystem, and the driver bootstrap
+ *  and device discovery steps within them.
+ *
+ *  Steps are recorded in the order they start, from the first
+ *  SDL_InitSubSystem() call until SDL_Quit(). Steps deferred by
+ *  ::SDL_HINT_LAZY_INIT are recorded when they actually run. The names
+ *  stay valid until SDL_Quit().
+ *
+ *  \param timings    An array to fill in, or NULL to just count the steps.
+ *  \param maxtimings The number of elements in \c timings.
+ *
+ *  \return The number of steps recorded, which may be more than \c maxtimings.
+ */
+extern DECLSPEC int SDLCALL SDL_GetInitTimings(SDL_InitTiming *timings, int maxtimings);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -826,6 +826,29 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
+/**
+ *  Get how much audio, in milliseconds, the device's callback has processed.
+ *
+ *  This is the number of sample frames that were handed to the callback (or
+ *  taken from the queue, when using SDL_QueueAudio()), converted to
+ *  milliseconds at the callback's frequency. It starts at 0 when the device
+ *  is opened and doesn't advance while the device is paused, so it can be
+ *  used like SDL_GetTicks() to keep an app in step with its audio.
+ *
+ *  With the "disk" audio driver and SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK set,
+ *  the callback runs as fast as the CPU allows, and this clock advances the
+ *  same way on every run no matter how long the rendering actually takes.
+ *
+ *  Drivers that run their own callback thread (such as Core Audio and
+ *  Emscripten) don't update this clock, and it always returns 0 for them.
+ *
+ *  \param dev The device ID of which to query the clock.
+ *  \return Milliseconds of audio processed, or 0 on an invalid device.
+ *
+ *  \sa SDL_PauseAudioDevice
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetAudioDeviceTicks(SDL_AudioDeviceID dev);
+
 
 /**
  *  \name Audio lock functions
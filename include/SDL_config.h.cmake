@@ -424,6 +424,9 @@
 #cmakedefine SDL_ARM_SIMD_BLITTERS @SDL_ARM_SIMD_BLITTERS@
 #cmakedefine SDL_ARM_NEON_BLITTERS @SDL_ARM_NEON_BLITTERS@
 
+/* Bind the public API straight to its implementation */
+#cmakedefine SDL_DYNAPI_DIRECT @SDL_DYNAPI_DIRECT@
+
 /* Enable dynamic libsamplerate support */
 #cmakedefine SDL_LIBSAMPLERATE_DYNAMIC @SDL_LIBSAMPLERATE_DYNAMIC@
 
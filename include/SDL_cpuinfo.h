@@ -126,6 +126,49 @@ extern DECLSPEC int SDLCALL SDL_GetCPUCount(void);
  */
 extern DECLSPEC int SDLCALL SDL_GetCPUCacheLineSize(void);
 
+/**
+ *  This function returns the size of one of the CPU's caches, in bytes.
+ *
+ *  Level 1 is the data cache of a single core; on most CPUs level 2 is
+ *  per core (or per cluster) and level 3 is shared by all cores. This is
+ *  useful for sizing blocks of work so they stay in the cache, or for
+ *  deciding when data is too large to be worth caching at all.
+ *
+ *  \param level The cache level to query: 1, 2 or 3.
+ *
+ *  \return The cache size in bytes, or 0 if the CPU doesn't have a cache at
+ *          that level or its size can't be determined.
+ */
+extern DECLSPEC int SDLCALL SDL_GetCPUCacheSize(int level);
+
+/**
+ *  This function returns the number of physical CPU cores.
+ *
+ *  With simultaneous multithreading (for example Hyper-Threading) each
+ *  physical core runs several of the logical CPUs counted by
+ *  SDL_GetCPUCount(). Compute-bound work rarely scales past this number.
+ *  If the topology can't be determined this returns SDL_GetCPUCount().
+ */
+extern DECLSPEC int SDLCALL SDL_GetCPUPhysicalCoreCount(void);
+
+/**
+ *  This function returns the number of logical CPUs that share each
+ *  physical core, which is 1 without simultaneous multithreading.
+ */
+extern DECLSPEC int SDLCALL SDL_GetCPUThreadsPerCore(void);
+
+/**
+ *  This function returns how many of the physical cores are efficiency
+ *  cores, on CPUs that mix core types such as ARM big.LITTLE, Intel hybrid
+ *  and Apple silicon.
+ *
+ *  Work that has to finish quickly shouldn't assume it runs on one of these.
+ *
+ *  \return The number of efficiency cores, or 0 if all cores are of the same
+ *          type or it can't be determined.
+ */
+extern DECLSPEC int SDLCALL SDL_GetCPUEfficiencyCoreCount(void);
+
 /**
  *  This function returns true if the CPU has the RDTSC instruction.
  */
@@ -196,6 +239,25 @@ extern DECLSPEC SDL_bool SDLCALL SDL_HasARMSIMD(void);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_HasNEON(void);
 
+/**
+ *  \brief Report which implementation SDL uses for one of its hot loops.
+ *
+ *  SDL picks the fastest variant of each of these for the CPU it's running
+ *  on, honoring SDL_HINT_CPU_FEATURE_MASK. The kernels are "fill"
+ *  (SDL_FillRect), "copy" (unscaled surface copies), "blend" (per-pixel
+ *  alpha blits), "convert" (audio sample format conversion), "resample"
+ *  (audio rate conversion), "mix" (SDL_MixAudioFormat) and "yuv" (YUV to
+ *  RGB conversion).
+ *
+ *  \param kernel The name of the kernel
+ *
+ *  \return The chosen variant, such as "scalar", "sse2", "avx2", "avx512f"
+ *          or "neon", or NULL if the kernel name isn't known.
+ *
+ *  \sa SDL_HINT_CPU_FEATURE_MASK
+ */
+extern DECLSPEC const char * SDLCALL SDL_GetSIMDKernelVariant(const char *kernel);
+
 /**
  *  This function returns the amount of RAM configured in the system, in MB.
  */
@@ -1115,6 +1115,25 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_RESAMPLING_MODE   "SDL_AUDIO_RESAMPLING_MODE"
 
+/**
+ *  \brief  A variable controlling how many threads SDL_ConvertAudio() may use.
+ *
+ *  Large buffers, such as a whole WAV file loaded with SDL_LoadWAV(), can be
+ *  split into chunks that are converted in parallel. The output is identical
+ *  to converting the buffer on one thread. Buffers smaller than a megabyte,
+ *  and buffers that aren't 16 byte aligned, are always converted on the
+ *  calling thread.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "1"       - Convert on the calling thread only (default)
+ *    "0"       - Use one thread per CPU core
+ *    "N"       - Use up to N threads
+ *
+ *  This hint is checked each time SDL_ConvertAudio() is called.
+ */
+#define SDL_HINT_AUDIO_CONVERT_THREADS   "SDL_AUDIO_CONVERT_THREADS"
+
 /**
  *  \brief  A variable controlling the audio category on iOS and Mac OS X
  *
@@ -1128,6 +1147,23 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_CATEGORY   "SDL_AUDIO_CATEGORY"
 
+/**
+ *  \brief  A variable controlling whether the "disk" audio driver runs on a virtual clock.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0"       - Write to the file at the rate the audio would play (default)
+ *    "1"       - Run the audio callback as fast as possible, for offline rendering
+ *
+ *  With a virtual clock, the driver doesn't wait between buffers and doesn't
+ *  write silence while the device is paused, so the output only depends on
+ *  what the callback produces. Use SDL_GetAudioDeviceTicks() instead of
+ *  SDL_GetTicks() to keep track of audio time.
+ *
+ *  This hint is checked when the audio device is opened.
+ */
+#define SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK   "SDL_AUDIO_DISK_VIRTUAL_CLOCK"
+
 /**
  *  \brief  A variable controlling whether the 2D render API is compatible or efficient.
  *
@@ -1174,6 +1210,52 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING   "SDL_EVENT_LOGGING"
 
+/**
+ *  \brief  A variable naming a file to record the event stream to.
+ *
+ *  Input, window and system events are written to the file as they enter
+ *  SDL's event queue, along with when they arrived and where the app pumped
+ *  events in between, so the session can be played back later with
+ *  SDL_HINT_EVENT_REPLAY. Events the app pushes itself, such as user
+ *  events, aren't recorded.
+ *
+ *  This hint can be changed at runtime: setting it starts a new recording,
+ *  and setting it to an empty string finishes the current one. The recording
+ *  is also finished when the events subsystem is shut down.
+ */
+#define SDL_HINT_EVENT_RECORD   "SDL_EVENT_RECORD"
+
+/**
+ *  \brief  A variable naming a file recorded with SDL_HINT_EVENT_RECORD to replay.
+ *
+ *  The recorded events are injected from SDL_PumpEvents() as if they came
+ *  from the video driver, which is most useful with the "dummy" or
+ *  "offscreen" video drivers to reproduce a session headless. Keyboard and
+ *  mouse events update SDL's keyboard and mouse state as usual.
+ *
+ *  The log has to be replayed by a build for the same platform as it was
+ *  recorded on. Setting this hint at runtime starts the replay from the
+ *  beginning, and setting it to an empty string stops the replay.
+ */
+#define SDL_HINT_EVENT_REPLAY   "SDL_EVENT_REPLAY"
+
+/**
+ *  \brief  A variable controlling how fast SDL_HINT_EVENT_REPLAY plays events back.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "1"       - Replay events at the times they were recorded (default)
+ *    "N"       - Replay events N times as fast, e.g. "2" or "0.5"
+ *    "0"       - Replay the events of one recorded SDL_PumpEvents() call on
+ *                each call, as fast as the app runs
+ *
+ *  The last mode doesn't depend on timing at all, so every run of the app
+ *  sees the same events on the same frames.
+ *
+ *  This hint is checked when a replay starts.
+ */
+#define SDL_HINT_EVENT_REPLAY_SPEED   "SDL_EVENT_REPLAY_SPEED"
+
 
 
 /**
@@ -1254,6 +1336,56 @@ extern "C" {
  */
 #define SDL_HINT_DISPLAY_USABLE_BOUNDS "SDL_DISPLAY_USABLE_BOUNDS"
 
+/**
+ *  \brief  A variable controlling the row alignment of new surfaces.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Rows are padded to a multiple of 4 bytes (default)
+ *    "1"       - Rows are padded to a multiple of SDL_SIMDGetAlignment() bytes
+ *
+ *  Surface pixels are always allocated with SDL_SIMDAlloc(). With this hint
+ *  set, every row of a surface created by SDL_CreateRGBSurface() and friends
+ *  starts on a SIMD boundary too, so blitters can use aligned loads and
+ *  stores. Only enable it if your code doesn't assume a particular pitch.
+ */
+#define SDL_HINT_SURFACE_SIMD_PITCH "SDL_SURFACE_SIMD_PITCH"
+
+/**
+ *  \brief  A variable hiding CPU features from SDL, mostly for testing.
+ *
+ *  The value is a comma separated list of feature names, each prefixed
+ *  with '-' to hide it or '+' to allow it again, applied left to right.
+ *  The names are "rdtsc", "altivec", "mmx", "3dnow", "sse", "sse2", "sse3",
+ *  "sse41", "sse42", "avx", "avx2", "avx512f", "armsimd", "neon" and "all".
+ *  For example "-avx512f" keeps SDL off AVX-512 and "-all" forces the plain
+ *  C code everywhere. Features the CPU doesn't have can't be turned on.
+ *
+ *  Hidden features are reported as missing by SDL_HasSSE2() and friends,
+ *  and the SIMD kernels SDL picked are chosen again when this changes.
+ *  SDL_GetSIMDKernelVariant() reports the result.
+ */
+#define SDL_HINT_CPU_FEATURE_MASK "SDL_CPU_FEATURE_MASK"
+
+/**
+ *  \brief  A variable controlling whether expensive parts of initialization are deferred.
+ *
+ *  Enumerating audio devices, discovering HIDAPI joysticks and parsing the
+ *  game controller mapping database can add noticeably to SDL_Init() time.
+ *  When deferred, audio devices are enumerated the first time the device
+ *  list or a named device is asked for, HIDAPI joysticks show up through
+ *  SDL_JOYDEVICEADDED events once the joysticks are first updated, and the
+ *  mappings are loaded the first time one is needed.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Do everything during SDL_InitSubSystem() (default)
+ *    "1"       - Defer the expensive steps until they're needed
+ *    "2"       - Defer them, and start the ones that can run on any thread
+ *                (currently the mapping database) on a background thread
+ *
+ *  This hint should be set before SDL_InitSubSystem() is called.
+ */
+#define SDL_HINT_LAZY_INIT "SDL_LAZY_INIT"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
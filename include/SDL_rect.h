@@ -163,6 +163,39 @@ extern DECLSPEC SDL_bool SDLCALL SDL_IntersectRectAndLine(const SDL_Rect *
                                                           int *Y1, int *X2,
                                                           int *Y2);
 
+/**
+ *  \brief Calculate the intersection of a clip rectangle with an array of
+ *         rectangles.
+ *
+ *  Only the non-empty intersections are written to \c result, in their
+ *  original order, which makes this useful for culling large sets of
+ *  rectangles against a view. \c result must have room for \c count
+ *  rectangles and may be the same array as \c rects.
+ *
+ *  \return The number of rectangles written to \c result, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_IntersectRects(const SDL_Rect * clip,
+                                               const SDL_Rect * rects,
+                                               int count,
+                                               SDL_Rect * result);
+
+/**
+ *  \brief Calculate the intersection of a rectangle and an array of line
+ *         segments.
+ *
+ *  \c points holds \c count line segments as pairs of end points. Each
+ *  segment that intersects the rectangle is clipped like
+ *  SDL_IntersectRectAndLine() would and written to \c result, in its
+ *  original order. \c result must have room for \c count * 2 points and
+ *  may be the same array as \c points.
+ *
+ *  \return The number of line segments written to \c result, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_IntersectRectAndLines(const SDL_Rect * rect,
+                                                      const SDL_Point * points,
+                                                      int count,
+                                                      SDL_Point * result);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -125,6 +125,16 @@ typedef enum
     SDL_FLIP_VERTICAL = 0x00000002     /**< flip vertically */
 } SDL_RendererFlip;
 
+/**
+ *  \brief Vertex structure used by SDL_RenderGeometry()
+ */
+typedef struct SDL_Vertex
+{
+    SDL_FPoint position;        /**< Vertex position, in SDL_Renderer coordinates  */
+    SDL_Color  color;           /**< Vertex color */
+    SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
+} SDL_Vertex;
+
 /**
  *  \brief A structure representing rendering state
  */
@@ -224,6 +234,24 @@ extern DECLSPEC SDL_Renderer * SDLCALL SDL_GetRenderer(SDL_Window * window);
 extern DECLSPEC int SDLCALL SDL_GetRendererInfo(SDL_Renderer * renderer,
                                                 SDL_RendererInfo * info);
 
+/**
+ *  \brief Get a number that identifies a rendering context.
+ *
+ *  Unlike its address, the number of a renderer is never given to another
+ *  renderer created later, so it tells whether data cached for a renderer
+ *  still belongs to it.
+ *
+ *  \return The ID of the renderer, or 0 if the renderer is invalid.
+ *
+ *  \sa SDL_GetRendererFromID()
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetRendererID(SDL_Renderer * renderer);
+
+/**
+ *  \brief Get a renderer from a stored ID, or NULL if it doesn't exist anymore.
+ */
+extern DECLSPEC SDL_Renderer * SDLCALL SDL_GetRendererFromID(Uint32 id);
+
 /**
  *  \brief Get the output size in pixels of a rendering context.
  */
@@ -1037,6 +1065,30 @@ extern DECLSPEC int SDLCALL SDL_RenderCopyExF(SDL_Renderer * renderer,
                                             const SDL_FPoint *center,
                                             const SDL_RendererFlip flip);
 
+/**
+ *  \brief Render a list of triangles, optionally using a texture and indices into the vertex array.
+ *
+ *  Color and alpha modulation is done per vertex, and the texture's own color
+ *  and alpha modulation (if any) is applied on top of it. The texture's blend
+ *  mode is used if a texture is given, otherwise the renderer's draw blend mode.
+ *
+ *  \param renderer     The renderer which should draw the triangles.
+ *  \param texture      (optional) The SDL texture to use.
+ *  \param vertices     Vertices.
+ *  \param num_vertices Number of vertices.
+ *  \param indices      (optional) An array of integer indices into the 'vertices' array,
+ *                      if NULL all vertices will be rendered in sequential order.
+ *  \param num_indices  Number of indices.
+ *
+ *  \return 0 on success, or -1 if the operation is not supported
+ *
+ *  \sa SDL_Vertex
+ */
+extern DECLSPEC int SDLCALL SDL_RenderGeometry(SDL_Renderer *renderer,
+                                               SDL_Texture *texture,
+                                               const SDL_Vertex *vertices, int num_vertices,
+                                               const int *indices, int num_indices);
+
 /**
  *  \brief Read pixels from the current rendering target.
  *
@@ -1103,6 +1155,82 @@ extern DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer * renderer);
  */
 extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
 
+/**
+ *  \brief Start writing the rendering commands of a renderer to a file.
+ *
+ *  Every command is written along with its vertex data, and textures are
+ *  written with their contents the first time a command uses them and again
+ *  after they changed, so the file can be replayed on any renderer with
+ *  SDL_RenderReplayCapture(). Reading back texture contents needs render
+ *  target support; without it textures are written without their pixels.
+ *
+ *  \param renderer The renderer to capture
+ *  \param file     The file to write the capture to
+ *  \param frames   The number of frames to capture, after which the capture
+ *                  stops by itself, or 0 to capture until
+ *                  SDL_RenderStopCapture() is called
+ *
+ *  \return 0 on success, or -1 on error
+ *
+ *  \sa SDL_RenderStopCapture()
+ *  \sa SDL_RenderReplayCapture()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderStartCapture(SDL_Renderer * renderer,
+                                                   const char *file,
+                                                   int frames);
+
+/**
+ *  \brief Stop a capture started with SDL_RenderStartCapture().
+ *
+ *  The capture is also stopped when the renderer is destroyed.
+ *
+ *  \return 0 on success, or -1 if the renderer wasn't being captured or the
+ *          capture couldn't be written completely
+ */
+extern DECLSPEC int SDLCALL SDL_RenderStopCapture(SDL_Renderer * renderer);
+
+/**
+ *  \brief Timing of one replayed command, see SDL_RenderReplayCapture().
+ */
+typedef struct SDL_RenderReplayTiming
+{
+    int frame;          /**< The frame of the command, starting with 0 */
+    int command;        /**< The index of the command in its frame */
+    const char *name;   /**< "texture", "target", "viewport", "cliprect",
+                             "clear", "points", "lines", "fill_rects", "copy",
+                             "copy_ex", "geometry" or "present" */
+    int count;          /**< The number of points, rectangles or vertices
+                             drawn, 1 for other commands */
+    Uint64 ticks;       /**< The time the command took, in
+                             SDL_GetPerformanceCounter() units */
+} SDL_RenderReplayTiming;
+
+typedef void (SDLCALL * SDL_RenderReplayCallback) (void *userdata, const SDL_RenderReplayTiming *timing);
+
+/**
+ *  \brief Replay a file written by SDL_RenderStartCapture().
+ *
+ *  The commands are drawn in output pixels, so the renderer shouldn't have
+ *  a logical size or scale set, and each captured frame ends with
+ *  SDL_RenderPresent(). The draw color, blend mode and render target are
+ *  reset afterwards.
+ *
+ *  \param renderer The renderer to replay the capture on
+ *  \param file     The capture to replay
+ *  \param callback A function called after each command, or NULL. When it
+ *                  is set, the renderer is flushed after every command so
+ *                  the timing includes the backend's work.
+ *  \param userdata A pointer that is passed to the callback
+ *
+ *  \return The number of frames replayed, or -1 on error
+ *
+ *  \sa SDL_RenderStartCapture()
+ */
+extern DECLSPEC int SDLCALL SDL_RenderReplayCapture(SDL_Renderer * renderer,
+                                                    const char *file,
+                                                    SDL_RenderReplayCallback callback,
+                                                    void *userdata);
+
 
 /**
  *  \brief Bind the texture to the current OpenGL/ES/ES2 context for use with
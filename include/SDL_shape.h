@@ -120,6 +120,23 @@ typedef struct SDL_WindowShapeMode {
  */
 extern DECLSPEC int SDLCALL SDL_SetWindowShape(SDL_Window *window,SDL_Surface *shape,SDL_WindowShapeMode *shape_mode);
 
+/**
+ * \brief Update the shape of a shaped window after part of its shape surface changed.
+ *
+ * Only the pixels of \c shape inside \c rect are examined, using the shape parameters last given to
+ * SDL_SetWindowShape(). If they leave the window's shape as it was, the window system is not updated at all.
+ *
+ * \param window The shaped window whose shape should be updated.
+ * \param shape The surface last passed to SDL_SetWindowShape(), with new contents inside \c rect.
+ * \param rect The area of \c shape that changed, or NULL to examine the entire surface.
+ *
+ * \return 0 on success, SDL_INVALID_SHAPE_ARGUMENT on an invalid shape argument, or SDL_NONSHAPEABLE_WINDOW
+ *           if the SDL_Window given does not reference a valid shaped window.
+ *
+ * \sa SDL_SetWindowShape
+ */
+extern DECLSPEC int SDLCALL SDL_UpdateWindowShapeRect(SDL_Window *window,SDL_Surface *shape,const SDL_Rect *rect);
+
 /**
  * \brief Get the shape parameters of a shaped window.
  *
@@ -32,12 +32,14 @@
 
 #include "SDL.h"
 #include "SDL_test_assert.h"
+#include "SDL_test_bench.h"
 #include "SDL_test_common.h"
 #include "SDL_test_compare.h"
 #include "SDL_test_crc32.h"
 #include "SDL_test_font.h"
 #include "SDL_test_fuzzer.h"
 #include "SDL_test_harness.h"
+#include "SDL_test_hash.h"
 #include "SDL_test_images.h"
 #include "SDL_test_log.h"
 #include "SDL_test_md5.h"
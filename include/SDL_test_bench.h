@@ -0,0 +1,192 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ *  \file SDL_test_bench.h
+ *
+ *  Include file for SDL test framework.
+ *
+ *  This code is a part of the SDL2_test library, not the main SDL library.
+ */
+
+/*
+
+  Microbenchmarks: each benchmark is calibrated to run long enough to time
+  reliably, warmed up, then timed over a number of samples. Results are
+  reported as the median time per iteration with the spread around it, and
+  can be saved to a JSON file and compared against a previous run.
+
+*/
+
+#ifndef SDL_test_bench_h_
+#define SDL_test_bench_h_
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --- Definitions */
+
+/* !< Function pointer to the code being measured; it performs the operation 'iterations' times */
+typedef void (*SDLTest_BenchmarkFp)(void *arg, int iterations);
+
+/**
+ * Statistics of one benchmark. Times are in nanoseconds per iteration.
+ */
+typedef struct SDLTest_BenchmarkResult {
+    /* !< Name of the benchmark */
+    char name[64];
+    /* !< Number of timed samples */
+    int samples;
+    /* !< Iterations per sample, as found by calibration */
+    int iterations;
+    /* !< Median of the samples */
+    double median;
+    /* !< Median absolute deviation of the samples from the median */
+    double mad;
+    /* !< 10th and 90th percentile of the samples */
+    double p10;
+    double p90;
+    /* !< Fastest and slowest sample */
+    double min;
+    double max;
+    /* !< Median of the same benchmark in the baseline, or 0 if it has none */
+    double baseline;
+} SDLTest_BenchmarkResult;
+
+/**
+ * Settings and results for a set of benchmarks.
+ */
+typedef struct SDLTest_BenchmarkContext {
+    /* !< Each sample runs for at least this many seconds */
+    double sampleTime;
+    /* !< Untimed samples run after calibration */
+    int warmupSamples;
+    /* !< Timed samples */
+    int samples;
+    /* !< Relative slowdown against the baseline that counts as a regression, e.g. 0.05 for 5% */
+    double threshold;
+    /* !< Only run benchmarks whose name contains this string, or NULL to run all */
+    const char *filter;
+    /* !< Results of the benchmarks run so far */
+    int numResults;
+    SDLTest_BenchmarkResult *results;
+    /* !< Results loaded from the baseline file */
+    int numBaselines;
+    SDLTest_BenchmarkResult *baselines;
+} SDLTest_BenchmarkContext;
+
+
+/* --- Function prototypes */
+
+/**
+ * \brief Initializes a benchmark context with default settings.
+ *
+ * \param context The context to initialize.
+ */
+void SDLTest_BenchmarkInit(SDLTest_BenchmarkContext *context);
+
+/**
+ * \brief Frees the results and baseline held by a benchmark context.
+ *
+ * \param context The context to clean up.
+ */
+void SDLTest_BenchmarkQuit(SDLTest_BenchmarkContext *context);
+
+/**
+ * \brief Pins the calling thread to one CPU, so samples don't pay for migrations.
+ *
+ * This is only supported on Linux.
+ *
+ * \param cpu The CPU to run on, starting at 0.
+ *
+ * \returns 0 on success, -1 on failure or if pinning isn't supported.
+ */
+int SDLTest_BenchmarkPinThread(int cpu);
+
+/**
+ * \brief Loads the results of an earlier run to compare new results against.
+ *
+ * \param context The benchmark context.
+ * \param filename A file written by SDLTest_BenchmarkSave().
+ *
+ * \returns The number of baseline results loaded, or -1 on failure.
+ */
+int SDLTest_BenchmarkLoadBaseline(SDLTest_BenchmarkContext *context, const char *filename);
+
+/**
+ * \brief Loads the results of a run from a file instead of running the benchmarks.
+ *
+ * Results that have a baseline loaded are compared against it, so
+ * SDLTest_BenchmarkRegressions() can check two saved runs against each other.
+ *
+ * \param context The benchmark context.
+ * \param filename A file written by SDLTest_BenchmarkSave().
+ *
+ * \returns The number of results loaded, or -1 on failure.
+ */
+int SDLTest_BenchmarkLoadResults(SDLTest_BenchmarkContext *context, const char *filename);
+
+/**
+ * \brief Calibrates, warms up and times a benchmark, then logs and records its result.
+ *
+ * \param context The benchmark context.
+ * \param name Name of the benchmark, used for filtering and baselines.
+ * \param benchmark Function that performs the operation being measured.
+ * \param arg Argument passed to the benchmark function.
+ *
+ * \returns The result, or NULL if the benchmark was filtered out or couldn't run.
+ */
+const SDLTest_BenchmarkResult *SDLTest_RunBenchmark(SDLTest_BenchmarkContext *context, const char *name, SDLTest_BenchmarkFp benchmark, void *arg);
+
+/**
+ * \brief Logs every result that is slower than its baseline.
+ *
+ * A result regresses when its median is slower than the baseline by more than
+ * the context's threshold and by more than three times its own deviation.
+ *
+ * \param context The benchmark context.
+ *
+ * \returns The number of regressions.
+ */
+int SDLTest_BenchmarkRegressions(SDLTest_BenchmarkContext *context);
+
+/**
+ * \brief Saves the results as JSON, to be used as a baseline later.
+ *
+ * \param context The benchmark context.
+ * \param filename The file to write.
+ *
+ * \returns 0 on success, -1 on failure.
+ */
+int SDLTest_BenchmarkSave(SDLTest_BenchmarkContext *context, const char *filename);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_test_bench_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -57,6 +57,34 @@ extern "C" {
  */
 int SDLTest_CompareSurfaces(SDL_Surface *surface, SDL_Surface *referenceSurface, int allowable_error);
 
+/**
+ * \brief Compares a surface and with reference image data, creating an image of the differences on failure
+ *
+ * Same as SDLTest_CompareSurfaces(). In addition, if the comparison failed, an
+ * ARGB8888 surface is created that shows the failing pixels in red over a dimmed
+ * grayscale copy of the reference; it is saved next to the other images.
+ *
+ * \param surface Surface used in comparison
+ * \param referenceSurface Test Surface used in comparison
+ * \param allowable_error Allowable difference (=sum of squared difference for each RGB component) in blending accuracy.
+ * \param diff Set to the difference image, to be freed with SDL_FreeSurface(), or NULL if the comparison succeeded. May be NULL.
+ *
+ * \returns 0 if comparison succeeded, >0 (=number of pixels for which the comparison failed) if comparison failed, -1 if any of the surfaces were NULL, -2 if the surface sizes differ.
+ */
+int SDLTest_CompareSurfacesWithDiff(SDL_Surface *surface, SDL_Surface *referenceSurface, int allowable_error, SDL_Surface **diff);
+
+/**
+ * \brief Enables or disables saving the surfaces of failed comparisons as images
+ *
+ * Saving is enabled by default. Tests that make comparisons fail on purpose can
+ * turn it off so they don't leave image files behind.
+ *
+ * \param enabled SDL_TRUE to save images on failure, SDL_FALSE to only log the failure.
+ *
+ * \returns the previous setting.
+ */
+SDL_bool SDLTest_SetCompareSurfacesSaveImages(SDL_bool enabled);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
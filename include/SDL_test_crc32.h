@@ -65,6 +65,7 @@ extern "C" {
  */
   typedef struct {
     CrcUint32    crc32_table[256]; /* CRC table */
+    CrcUint32    crc32_slice_table[7][256]; /* CRC tables for 2 to 8 bytes at a time */
   } SDLTest_Crc32Context;
 
 /* ---------- Function Prototypes ------------- */
@@ -64,9 +64,28 @@ int SDLTest_DrawCharacter(SDL_Renderer *renderer, int x, int y, char c);
  */
 int SDLTest_DrawString(SDL_Renderer *renderer, int x, int y, const char *s);
 
+/**
+ *  \brief Draw a string in the currently set font, scaled.
+ *
+ *  All characters are copied out of one texture, so a string doesn't make
+ *  the renderer switch textures. Scaling uses nearest sampling.
+ *
+ *  \param renderer The renderer to draw on.
+ *  \param x The X coordinate of the upper left corner of the string.
+ *  \param y The Y coordinate of the upper left corner of the string.
+ *  \param s The string to draw.
+ *  \param scale The size of a character, as a multiple of FONT_CHARACTER_SIZE.
+ *
+ *  \returns Returns 0 on success, -1 on failure.
+ */
+int SDLTest_DrawScaledString(SDL_Renderer *renderer, int x, int y, const char *s, float scale);
+
 
 /**
  *  \brief Cleanup textures used by font drawing functions.
+ *
+ *  Destroys the textures of renderers that still exist; those of destroyed
+ *  renderers were freed along with them, so this is safe to call any time.
  */
 void SDLTest_CleanupTextDrawing(void);
 
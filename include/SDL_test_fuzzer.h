@@ -368,6 +368,17 @@ char * SDLTest_RandomAsciiStringWithMaximumLength(int maxLength);
  */
 char * SDLTest_RandomAsciiStringOfSize(int size);
 
+/**
+ * Fills a buffer with random bytes, reproducible from the exec key.
+ *
+ * Use this instead of ...RandomUint8() in a loop for large buffers.
+ * Counts as a single fuzzer invocation.
+ *
+ * \param buffer Memory to fill
+ * \param size Number of bytes to fill
+ */
+void SDLTest_RandomBuffer(void *buffer, size_t size);
+
 /**
  * Returns the invocation count for the fuzzer since last ...FuzzerInit.
  */
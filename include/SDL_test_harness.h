@@ -69,6 +69,9 @@ typedef int (*SDLTest_TestCaseFp)(void *arg);
 /* !< Function pointer to a test case teardown function (run after every test) */
 typedef void  (*SDLTest_TestCaseTearDownFp)(void *arg);
 
+/* !< Function pointer to a worker process initialization function (returns 0 on success, -1 on failure) */
+typedef int (*SDLTest_WorkerInitFp)(void *arg);
+
 /**
  * Holds information about a single test case.
  */
@@ -109,6 +112,51 @@ typedef struct SDLTest_TestSuiteReference {
  */
 char *SDLTest_GenerateRunSeed(const int length);
 
+/**
+ * \brief Only run every shardCount-th selected test case, starting with shardIndex.
+ *
+ * This splits one run over several processes or machines. Pass every shard the
+ * same run seed so each test case gets the same execution key it would get in
+ * an unsharded run.
+ *
+ * \param shardIndex Which shard this process runs, 0..shardCount-1.
+ * \param shardCount Number of shards the test cases are split into.
+ *
+ * \returns 0 on success, -1 if the shard is invalid.
+ */
+int SDLTest_SetTestShard(int shardIndex, int shardCount);
+
+/**
+ * \brief Spread the test cases of SDLTest_RunSuites() over worker processes.
+ *
+ * Each worker is forked when the run starts and is handed test cases one at
+ * a time as it finishes the previous one. Execution keys don't depend on which
+ * worker runs a test case. A worker that crashes or times out fails the test
+ * case it was running and is replaced. The results are merged into the usual
+ * summary, and into the report if one was requested.
+ *
+ * Each worker runs in a scratch directory of its own below the current one,
+ * so test cases can use fixed file names without racing other workers. The
+ * directory and anything left in it are removed when the worker exits.
+ *
+ * Workers should initialize SDL in workerInit rather than inheriting an
+ * initialized SDL from the process that calls SDLTest_RunSuites().
+ *
+ * \param numWorkers Number of worker processes; 1 or less runs tests in this process.
+ * \param workerInit Function each worker calls before running tests, or NULL.
+ * \param arg Argument passed to workerInit.
+ *
+ * \returns 0 on success, -1 if worker processes aren't supported on this platform.
+ */
+int SDLTest_SetTestWorkers(int numWorkers, SDLTest_WorkerInitFp workerInit, void *arg);
+
+/**
+ * \brief Write a report of every following SDLTest_RunSuites() to a file.
+ *
+ * \param filename File to write; JSON if the name ends in ".json", JUnit XML otherwise. NULL disables the report.
+ */
+void SDLTest_SetTestReport(const char *filename);
+
 /**
  * \brief Execute a test suite using the given run seed and execution key.
  *
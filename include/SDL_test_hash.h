@@ -0,0 +1,82 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ *  \file SDL_test_hash.h
+ *
+ *  Include file for SDL test framework.
+ *
+ *  This code is a part of the SDL2_test library, not the main SDL library.
+ */
+
+/*
+
+ Fast 64-bit hashing, for fingerprinting large buffers such as framebuffers.
+ The hash is not cryptographic; use SDL_test_md5.h where that matters.
+
+*/
+
+#ifndef SDL_test_hash_h_
+#define SDL_test_hash_h_
+
+#include "SDL.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Hashes a block of memory.
+ *
+ * The algorithm is XXH64, so results match other implementations of it and
+ * are the same on every platform.
+ *
+ * \param data Pointer to the data; may be unaligned.
+ * \param len Number of bytes to hash.
+ * \param seed Seed value; hashing in pieces can chain each result into the next seed.
+ *
+ * \returns The 64-bit hash.
+ */
+Uint64 SDLTest_FastHash(const void *data, size_t len, Uint64 seed);
+
+/**
+ * \brief Hashes the size, format and pixels of a surface.
+ *
+ * Padding at the end of each row is not included, so surfaces with the same
+ * content but a different pitch hash the same.
+ *
+ * \param surface The surface to hash.
+ *
+ * \returns The 64-bit hash, or 0 if surface is NULL.
+ */
+Uint64 SDLTest_HashSurface(SDL_Surface *surface);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_test_hash_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -42,6 +42,9 @@
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "video/SDL_pixels_c.h"
+#include "cpuinfo/SDL_cpuinfo_c.h"
+#include "SDL_initprofile_c.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -171,11 +174,17 @@ SDL_InitSubSystem(Uint32 flags)
     SDL_TicksInit();
 #endif
 
+    /* Pick the SIMD implementations of the hot loops up front */
+    SDL_ChooseSIMDKernels();
+
     /* Initialize the event subsystem */
     if ((flags & SDL_INIT_EVENTS)) {
 #if !SDL_EVENTS_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_EVENTS)) {
-            if (SDL_EventsInit() < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_EVENTS, "events");
+            const int status = SDL_EventsInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -189,7 +198,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_TIMER)){
 #if !SDL_TIMERS_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_TIMER)) {
-            if (SDL_TimerInit() < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_TIMER, "timer");
+            const int status = SDL_TimerInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -203,7 +215,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_VIDEO)){
 #if !SDL_VIDEO_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_VIDEO)) {
-            if (SDL_VideoInit(NULL) < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_VIDEO, "video");
+            const int status = SDL_VideoInit(NULL);
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -217,7 +232,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_AUDIO)){
 #if !SDL_AUDIO_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_AUDIO)) {
-            if (SDL_AudioInit(NULL) < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_AUDIO, "audio");
+            const int status = SDL_AudioInit(NULL);
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -231,9 +249,12 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_JOYSTICK)){
 #if !SDL_JOYSTICK_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_JOYSTICK)) {
-           if (SDL_JoystickInit() < 0) {
-               return (-1);
-           }
+            const int step = SDL_BeginInitStep(SDL_INIT_JOYSTICK, "joystick");
+            const int status = SDL_JoystickInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
+                return (-1);
+            }
         }
         SDL_PrivateSubsystemRefCountIncr(SDL_INIT_JOYSTICK);
 #else
@@ -244,7 +265,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_GAMECONTROLLER)){
 #if !SDL_JOYSTICK_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_GAMECONTROLLER)) {
-            if (SDL_GameControllerInit() < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_GAMECONTROLLER, "gamecontroller");
+            const int status = SDL_GameControllerInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -258,7 +282,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_HAPTIC)){
 #if !SDL_HAPTIC_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_HAPTIC)) {
-            if (SDL_HapticInit() < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_HAPTIC, "haptic");
+            const int status = SDL_HapticInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -272,7 +299,10 @@ SDL_InitSubSystem(Uint32 flags)
     if ((flags & SDL_INIT_SENSOR)){
 #if !SDL_SENSOR_DISABLED
         if (SDL_PrivateShouldInitSubsystem(SDL_INIT_SENSOR)) {
-            if (SDL_SensorInit() < 0) {
+            const int step = SDL_BeginInitStep(SDL_INIT_SENSOR, "sensor");
+            const int status = SDL_SensorInit();
+            SDL_EndInitStep(step);
+            if (status < 0) {
                 return (-1);
             }
         }
@@ -421,9 +451,12 @@ SDL_Quit(void)
     SDL_TicksQuit();
 #endif
 
+    SDL_QuitSIMDKernels();
+    SDL_ClearSurfacePool();
     SDL_ClearHints();
     SDL_AssertionsQuit();
     SDL_LogResetPriorities();
+    SDL_ClearInitTimings();
 
     /* Now that every subsystem has been quit, we reset the subsystem refcount
      * and the list of initialized subsystems.
@@ -24,35 +24,90 @@
 #include "./SDL_dataqueue.h"
 #include "SDL_assert.h"
 
-typedef struct SDL_DataQueuePacket
-{
-    size_t datalen;  /* bytes currently in use in this packet. */
-    size_t startpos;  /* bytes currently consumed in this packet. */
-    struct SDL_DataQueuePacket *next;  /* next item in linked list. */
-    Uint8 data[SDL_VARIABLE_LENGTH_ARRAY];  /* packet data */
-} SDL_DataQueuePacket;
-
+/* The queue is a single ring buffer whose capacity is always a power of two,
+   so wrapping an offset is a mask. Queued data starts at (head) and runs for
+   (queued_bytes), possibly wrapping around the end of the buffer; everything
+   else is free space, which writers fill starting right after the data. */
 struct SDL_DataQueue
 {
-    SDL_DataQueuePacket *head; /* device fed from here. */
-    SDL_DataQueuePacket *tail; /* queue fills to here. */
-    SDL_DataQueuePacket *pool; /* these are unused packets. */
-    size_t packet_size;   /* size of new packets */
+    Uint8 *buffer;        /* ring storage, (capacity) bytes. */
+    size_t capacity;      /* zero or a power of two. */
+    size_t head;          /* offset of the first queued byte. */
     size_t queued_bytes;  /* number of bytes of data in the queue. */
+    size_t packet_size;   /* the buffer grows at least this much at a time. */
 };
 
-static void
-SDL_FreeDataQueueList(SDL_DataQueuePacket *packet)
+/* this all expects that you managed thread safety elsewhere. */
+
+static size_t
+RoundUpCapacity(const size_t len)
 {
-    while (packet) {
-        SDL_DataQueuePacket *next = packet->next;
-        SDL_free(packet);
-        packet = next;
+    size_t capacity = 64;
+    while (capacity < len) {
+        capacity <<= 1;
+        if (capacity == 0) {
+            return 0;  /* overflow. */
+        }
     }
+    return capacity;
 }
 
+/* Move the queued data to the start of a new buffer of (capacity) bytes. */
+static int
+ResizeDataQueue(SDL_DataQueue *queue, const size_t capacity)
+{
+    Uint8 *buffer;
+
+    SDL_assert(capacity >= queue->queued_bytes);
 
-/* this all expects that you managed thread safety elsewhere. */
+    if (capacity == 0) {
+        SDL_free(queue->buffer);
+        queue->buffer = NULL;
+        queue->capacity = 0;
+        queue->head = 0;
+        return 0;
+    }
+
+    buffer = (Uint8 *) SDL_malloc(capacity);
+    if (!buffer) {
+        return SDL_OutOfMemory();
+    }
+
+    if (queue->queued_bytes) {
+        SDL_DataQueueSpan spans[2];
+        SDL_PeekDataQueueSpans(queue, spans, queue->queued_bytes);
+        SDL_memcpy(buffer, spans[0].data, spans[0].len);
+        if (spans[1].len) {
+            SDL_memcpy(buffer + spans[0].len, spans[1].data, spans[1].len);
+        }
+    }
+
+    SDL_free(queue->buffer);
+    queue->buffer = buffer;
+    queue->capacity = capacity;
+    queue->head = 0;
+    return 0;
+}
+
+/* Make sure at least (len) bytes after the queued data are free. */
+static int
+EnsureDataQueueSpace(SDL_DataQueue *queue, const size_t len)
+{
+    const size_t needed = queue->queued_bytes + len;
+    size_t capacity;
+
+    if (needed < len) {
+        return SDL_OutOfMemory();  /* overflow. */
+    } else if (needed <= queue->capacity) {
+        return 0;
+    }
+
+    capacity = RoundUpCapacity(SDL_max(needed, queue->capacity + queue->packet_size));
+    if (capacity == 0) {
+        return SDL_OutOfMemory();
+    }
+    return ResizeDataQueue(queue, capacity);
+}
 
 SDL_DataQueue *
 SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
@@ -64,21 +119,14 @@ SDL_NewDataQueue(const size_t _packetlen, const size_t initialslack)
         return NULL;
     } else {
         const size_t packetlen = _packetlen ? _packetlen : 1024;
-        const size_t wantpackets = (initialslack + (packetlen - 1)) / packetlen;
-        size_t i;
+        const size_t capacity = RoundUpCapacity(SDL_max(initialslack, packetlen));
 
         SDL_zerop(queue);
         queue->packet_size = packetlen;
 
-        for (i = 0; i < wantpackets; i++) {
-            SDL_DataQueuePacket *packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + packetlen);
-            if (packet) { /* don't care if this fails, we'll deal later. */
-                packet->datalen = 0;
-                packet->startpos = 0;
-                packet->next = queue->pool;
-                queue->pool = packet;
-            }
-        }
+        /* don't care if this fails, we'll deal later. */
+        queue->buffer = capacity ? (Uint8 *) SDL_malloc(capacity) : NULL;
+        queue->capacity = queue->buffer ? capacity : 0;
     }
 
     return queue;
@@ -88,8 +136,7 @@ void
 SDL_FreeDataQueue(SDL_DataQueue *queue)
 {
     if (queue) {
-        SDL_FreeDataQueueList(queue->head);
-        SDL_FreeDataQueueList(queue->pool);
+        SDL_free(queue->buffer);
         SDL_free(queue);
     }
 }
@@ -97,209 +144,161 @@ SDL_FreeDataQueue(SDL_DataQueue *queue)
 void
 SDL_ClearDataQueue(SDL_DataQueue *queue, const size_t slack)
 {
-    const size_t packet_size = queue ? queue->packet_size : 1;
-    const size_t slackpackets = (slack + (packet_size-1)) / packet_size;
-    SDL_DataQueuePacket *packet;
-    SDL_DataQueuePacket *prev = NULL;
-    size_t i;
-
     if (!queue) {
         return;
     }
 
-    packet = queue->head;
+    queue->head = 0;
+    queue->queued_bytes = 0;
 
-    /* merge the available pool and the current queue into one list. */
-    if (packet) {
-        queue->tail->next = queue->pool;
+    /* Optionally keep some slack in the buffer to reduce malloc pressure. */
+    if (slack == 0) {
+        ResizeDataQueue(queue, 0);
     } else {
-        packet = queue->pool;
+        const size_t capacity = RoundUpCapacity(slack);
+        if (capacity && (queue->capacity > capacity)) {
+            ResizeDataQueue(queue, capacity);  /* if this fails we keep the bigger buffer. */
+        }
     }
+}
 
-    /* Remove the queued packets from the device. */
-    queue->tail = NULL;
-    queue->head = NULL;
-    queue->queued_bytes = 0;
-    queue->pool = packet;
+int
+SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *data, const size_t len)
+{
+    SDL_DataQueueSpan spans[2];
 
-    /* Optionally keep some slack in the pool to reduce malloc pressure. */
-    for (i = 0; packet && (i < slackpackets); i++) {
-        prev = packet;
-        packet = packet->next;
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (len == 0) {
+        return 0;
     }
 
-    if (prev) {
-        prev->next = NULL;
-    } else {
-        queue->pool = NULL;
+    if (SDL_ReserveDataQueueSpans(queue, spans, len) < 0) {
+        return -1;  /* nothing was queued. */
     }
 
-    SDL_FreeDataQueueList(packet);  /* free extra packets */
+    SDL_memcpy(spans[0].data, data, spans[0].len);
+    if (spans[1].len) {
+        SDL_memcpy(spans[1].data, (const Uint8 *) data + spans[0].len, spans[1].len);
+    }
+    SDL_CommitDataQueue(queue, len);
+    return 0;
 }
 
-static SDL_DataQueuePacket *
-AllocateDataQueuePacket(SDL_DataQueue *queue)
+size_t
+SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len)
 {
-    SDL_DataQueuePacket *packet;
+    SDL_DataQueueSpan spans[2];
+    const size_t total = SDL_PeekDataQueueSpans(queue, spans, len);
 
-    SDL_assert(queue != NULL);
-
-    packet = queue->pool;
-    if (packet != NULL) {
-        /* we have one available in the pool. */
-        queue->pool = packet->next;
-    } else {
-        /* Have to allocate a new one! */
-        packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + queue->packet_size);
-        if (packet == NULL) {
-            return NULL;
+    if (total) {
+        SDL_memcpy(buf, spans[0].data, spans[0].len);
+        if (spans[1].len) {
+            SDL_memcpy((Uint8 *) buf + spans[0].len, spans[1].data, spans[1].len);
         }
     }
 
-    packet->datalen = 0;
-    packet->startpos = 0;
-    packet->next = NULL;
-                
-    SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
-    if (queue->tail == NULL) {
-        queue->head = packet;
-    } else {
-        queue->tail->next = packet;
-    }
-    queue->tail = packet;
-    return packet;
+    return total;
+}
+
+size_t
+SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *buf, const size_t len)
+{
+    const size_t total = SDL_PeekIntoDataQueue(queue, buf, len);
+    SDL_ConsumeDataQueue(queue, total);
+    return total;
 }
 
+size_t
+SDL_CountDataQueue(SDL_DataQueue *queue)
+{
+    return queue ? queue->queued_bytes : 0;
+}
 
-int
-SDL_WriteToDataQueue(SDL_DataQueue *queue, const void *_data, const size_t _len)
+size_t
+SDL_PeekDataQueueSpans(SDL_DataQueue *queue, SDL_DataQueueSpan spans[2], const size_t len)
 {
-    size_t len = _len;
-    const Uint8 *data = (const Uint8 *) _data;
-    const size_t packet_size = queue ? queue->packet_size : 0;
-    SDL_DataQueuePacket *orighead;
-    SDL_DataQueuePacket *origtail;
-    size_t origlen;
-    size_t datalen;
+    size_t total, first;
+
+    spans[0].data = spans[1].data = NULL;
+    spans[0].len = spans[1].len = 0;
 
     if (!queue) {
-        return SDL_InvalidParamError("queue");
+        return 0;
     }
 
-    orighead = queue->head;
-    origtail = queue->tail;
-    origlen = origtail ? origtail->datalen : 0;
-
-    while (len > 0) {
-        SDL_DataQueuePacket *packet = queue->tail;
-        SDL_assert(!packet || (packet->datalen <= packet_size));
-        if (!packet || (packet->datalen >= packet_size)) {
-            /* tail packet missing or completely full; we need a new packet. */
-            packet = AllocateDataQueuePacket(queue);
-            if (!packet) {
-                /* uhoh, reset so we've queued nothing new, free what we can. */
-                if (!origtail) {
-                    packet = queue->head;  /* whole queue. */
-                } else {
-                    packet = origtail->next;  /* what we added to existing queue. */
-                    origtail->next = NULL;
-                    origtail->datalen = origlen;
-                }
-                queue->head = orighead;
-                queue->tail = origtail;
-                queue->pool = NULL;
-
-                SDL_FreeDataQueueList(packet);  /* give back what we can. */
-                return SDL_OutOfMemory();
-            }
-        }
-
-        datalen = SDL_min(len, packet_size - packet->datalen);
-        SDL_memcpy(packet->data + packet->datalen, data, datalen);
-        data += datalen;
-        len -= datalen;
-        packet->datalen += datalen;
-        queue->queued_bytes += datalen;
+    total = SDL_min(len, queue->queued_bytes);
+    if (total == 0) {
+        return 0;
     }
 
-    return 0;
+    first = SDL_min(total, queue->capacity - queue->head);
+    spans[0].data = queue->buffer + queue->head;
+    spans[0].len = first;
+    if (first < total) {
+        spans[1].data = queue->buffer;
+        spans[1].len = total - first;
+    }
+    return total;
 }
 
-size_t
-SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
+void
+SDL_ConsumeDataQueue(SDL_DataQueue *queue, const size_t len)
 {
-    size_t len = _len;
-    Uint8 *buf = (Uint8 *) _buf;
-    Uint8 *ptr = buf;
-    SDL_DataQueuePacket *packet;
-
     if (!queue) {
-        return 0;
+        return;
     }
 
-    for (packet = queue->head; len && packet; packet = packet->next) {
-        const size_t avail = packet->datalen - packet->startpos;
-        const size_t cpy = SDL_min(len, avail);
-        SDL_assert(queue->queued_bytes >= avail);
+    SDL_assert(len <= queue->queued_bytes);
 
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
-        ptr += cpy;
-        len -= cpy;
+    queue->queued_bytes -= len;
+    if (queue->queued_bytes == 0) {
+        queue->head = 0;  /* rewind, so later writes and reservations are contiguous. */
+    } else {
+        queue->head = (queue->head + len) & (queue->capacity - 1);
     }
-
-    return (size_t) (ptr - buf);
 }
 
-size_t
-SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *_buf, const size_t _len)
+int
+SDL_ReserveDataQueueSpans(SDL_DataQueue *queue, SDL_DataQueueSpan spans[2], const size_t len)
 {
-    size_t len = _len;
-    Uint8 *buf = (Uint8 *) _buf;
-    Uint8 *ptr = buf;
-    SDL_DataQueuePacket *packet;
+    size_t tail, first;
+
+    spans[0].data = spans[1].data = NULL;
+    spans[0].len = spans[1].len = 0;
 
     if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (len == 0) {
         return 0;
+    } else if (EnsureDataQueueSpace(queue, len) < 0) {
+        return -1;
     }
 
-    while ((len > 0) && ((packet = queue->head) != NULL)) {
-        const size_t avail = packet->datalen - packet->startpos;
-        const size_t cpy = SDL_min(len, avail);
-        SDL_assert(queue->queued_bytes >= avail);
-
-        SDL_memcpy(ptr, packet->data + packet->startpos, cpy);
-        packet->startpos += cpy;
-        ptr += cpy;
-        queue->queued_bytes -= cpy;
-        len -= cpy;
-
-        if (packet->startpos == packet->datalen) {  /* packet is done, put it in the pool. */
-            queue->head = packet->next;
-            SDL_assert((packet->next != NULL) || (packet == queue->tail));
-            packet->next = queue->pool;
-            queue->pool = packet;
-        }
-    }
-
-    SDL_assert((queue->head != NULL) == (queue->queued_bytes != 0));
-
-    if (queue->head == NULL) {
-        queue->tail = NULL;  /* in case we drained the queue entirely. */
+    tail = (queue->head + queue->queued_bytes) & (queue->capacity - 1);
+    first = SDL_min(len, queue->capacity - tail);
+    spans[0].data = queue->buffer + tail;
+    spans[0].len = first;
+    if (first < len) {
+        spans[1].data = queue->buffer;
+        spans[1].len = len - first;
     }
-
-    return (size_t) (ptr - buf);
+    return 0;
 }
 
-size_t
-SDL_CountDataQueue(SDL_DataQueue *queue)
+void
+SDL_CommitDataQueue(SDL_DataQueue *queue, const size_t len)
 {
-    return queue ? queue->queued_bytes : 0;
+    if (queue) {
+        SDL_assert(queue->queued_bytes + len <= queue->capacity);
+        queue->queued_bytes += len;
+    }
 }
 
 void *
 SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
 {
-    SDL_DataQueuePacket *packet;
+    SDL_DataQueueSpan spans[2];
 
     if (!queue) {
         SDL_InvalidParamError("queue");
@@ -307,33 +306,21 @@ SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
     } else if (len == 0) {
         SDL_InvalidParamError("len");
         return NULL;
-    } else if (len > queue->packet_size) {
-        SDL_SetError("len is larger than packet size");
+    } else if (SDL_ReserveDataQueueSpans(queue, spans, len) < 0) {
         return NULL;
     }
 
-    packet = queue->head;
-    if (packet) {
-        const size_t avail = queue->packet_size - packet->datalen;
-        if (len <= avail) {  /* we can use the space at end of this packet. */
-            void *retval = packet->data + packet->datalen;
-            packet->datalen += len;
-            queue->queued_bytes += len;
-            return retval;
+    if (spans[1].len) {
+        /* The free space wraps; straighten the data out so it doesn't. */
+        if (ResizeDataQueue(queue, queue->capacity) < 0) {
+            return NULL;
         }
+        SDL_ReserveDataQueueSpans(queue, spans, len);
+        SDL_assert(spans[1].len == 0);
     }
 
-    /* Need a fresh packet. */
-    packet = AllocateDataQueuePacket(queue);
-    if (!packet) {
-        SDL_OutOfMemory();
-        return NULL;
-    }
-
-    packet->datalen = len;
-    queue->queued_bytes += len;
-    return packet->data;
+    SDL_CommitDataQueue(queue, len);
+    return spans[0].data;
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
-
@@ -35,13 +35,13 @@ size_t SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 
 /* this sets a section of the data queue aside (possibly allocating memory for it)
-   as if it's been written to, but returns a pointer to that space. You may write
-   to this space until a read would consume it. Writes (and other calls to this
-   function) will safely append their data after this reserved space and can
-   be in flight at the same time. There is no thread safety.
-   If there isn't an existing block of memory that can contain the reserved
-   space, one will be allocated for it. You can not (currently) allocate
-   a space larger than the packetlen requested in SDL_NewDataQueue.
+   as if it's been written to, but returns a pointer to that space. Fill it in
+   before making any other call on this queue: later writes and reservations
+   may grow the buffer or move the queued data, which makes the pointer
+   invalid, so only one reservation can be outstanding at a time. There is no
+   thread safety.
+   If the free space after the queued data would wrap around the end of the
+   buffer, the queued data is moved so the reserved space is contiguous.
    Returned buffer is uninitialized.
    This lets you avoid an extra copy in some cases, but it's safer to use
    SDL_WriteToDataQueue() unless you know what you're doing.
@@ -49,6 +49,33 @@ size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 */
 void *SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len);
 
+/* The queue is a ring buffer, so any run of bytes in it is at most two
+   pieces of contiguous memory. These let callers work on that memory
+   directly instead of copying through a buffer of their own. */
+typedef struct SDL_DataQueueSpan
+{
+    Uint8 *data;
+    size_t len;
+} SDL_DataQueueSpan;
+
+/* Point (spans) at the first (len) queued bytes, or fewer if less is queued,
+   without consuming them. Unused spans get a zero length.
+   Returns the number of bytes the spans cover. */
+size_t SDL_PeekDataQueueSpans(SDL_DataQueue *queue, SDL_DataQueueSpan spans[2], const size_t len);
+
+/* Drop (len) bytes from the front of the queue, usually after reading them
+   through SDL_PeekDataQueueSpans(). (len) must not exceed the queued size. */
+void SDL_ConsumeDataQueue(SDL_DataQueue *queue, const size_t len);
+
+/* Point (spans) at (len) bytes of uninitialized space after the queued data,
+   growing the queue if needed. Nothing is queued until SDL_CommitDataQueue()
+   is called, and any other write to the queue invalidates the spans.
+   Returns 0 on success, -1 on error. */
+int SDL_ReserveDataQueueSpans(SDL_DataQueue *queue, SDL_DataQueueSpan spans[2], const size_t len);
+
+/* Append the first (len) bytes of the last reservation to the queue. */
+void SDL_CommitDataQueue(SDL_DataQueue *queue, const size_t len);
+
 #endif /* SDL_dataqueue_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
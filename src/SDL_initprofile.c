@@ -0,0 +1,278 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "./SDL_internal.h"
+
+/* Timing of initialization steps, and deferring the expensive ones */
+
+#include "SDL.h"
+#include "SDL_hints.h"
+#include "SDL_initprofile_c.h"
+#include "thread/SDL_systhread.h"
+
+#define SDL_MAX_INIT_STEPS  64
+
+typedef struct
+{
+    char name[48];
+    Uint32 subsystem;
+    Uint64 begin;
+    Uint64 end;             /* 0 until the step finishes */
+    SDL_bool background;
+} SDL_InitStep;
+
+static SDL_InitStep SDL_init_steps[SDL_MAX_INIT_STEPS];
+static int SDL_num_init_steps = 0;
+static SDL_SpinLock SDL_init_steps_lock;
+
+enum
+{
+    SDL_INIT_TASK_DONE,     /* zero, so a zeroed task has nothing to do */
+    SDL_INIT_TASK_PENDING,
+    SDL_INIT_TASK_RUNNING
+};
+
+static int
+SDL_AddInitStep(Uint32 subsystem, SDL_bool background, const char *name)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+    int step = -1;
+
+    SDL_AtomicLock(&SDL_init_steps_lock);
+    if (SDL_num_init_steps < SDL_MAX_INIT_STEPS) {
+        step = SDL_num_init_steps++;
+        SDL_strlcpy(SDL_init_steps[step].name, name, sizeof (SDL_init_steps[step].name));
+        SDL_init_steps[step].subsystem = subsystem;
+        SDL_init_steps[step].begin = now;
+        SDL_init_steps[step].end = 0;
+        SDL_init_steps[step].background = background;
+    }
+    SDL_AtomicUnlock(&SDL_init_steps_lock);
+
+    return step;
+}
+
+int
+SDL_BeginInitStep(Uint32 subsystem, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
+{
+    char name[SDL_arraysize(SDL_init_steps[0].name)];
+    va_list ap;
+
+    va_start(ap, fmt);
+    SDL_vsnprintf(name, sizeof (name), fmt, ap);
+    va_end(ap);
+
+    return SDL_AddInitStep(subsystem, SDL_FALSE, name);
+}
+
+void
+SDL_EndInitStep(int step)
+{
+    if (step >= 0) {
+        const Uint64 now = SDL_GetPerformanceCounter();
+        SDL_AtomicLock(&SDL_init_steps_lock);
+        SDL_init_steps[step].end = now;
+        SDL_AtomicUnlock(&SDL_init_steps_lock);
+    }
+}
+
+void
+SDL_ClearInitTimings(void)
+{
+    SDL_AtomicLock(&SDL_init_steps_lock);
+    SDL_num_init_steps = 0;
+    SDL_AtomicUnlock(&SDL_init_steps_lock);
+}
+
+static Uint64
+SDL_CountsToMicroseconds(Uint64 counts)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    /* Split up so that long intervals on fine counters don't overflow */
+    return ((counts / frequency) * 1000000) + (((counts % frequency) * 1000000) / frequency);
+}
+
+int
+SDL_GetInitTimings(SDL_InitTiming *timings, int maxtimings)
+{
+    int count;
+    int i;
+
+    SDL_AtomicLock(&SDL_init_steps_lock);
+    count = SDL_num_init_steps;
+    for (i = 0; timings && (i < count) && (i < maxtimings); ++i) {
+        const SDL_InitStep *step = &SDL_init_steps[i];
+        timings[i].name = step->name;
+        timings[i].subsystem = step->subsystem;
+        timings[i].start = SDL_CountsToMicroseconds(step->begin - SDL_init_steps[0].begin);
+        timings[i].duration = step->end ? SDL_CountsToMicroseconds(step->end - step->begin) : 0;
+        timings[i].background = step->background;
+    }
+    SDL_AtomicUnlock(&SDL_init_steps_lock);
+
+    return count;
+}
+
+static void
+SDL_RunInitTask(SDL_InitTask *task, SDL_bool background)
+{
+    const int step = SDL_AddInitStep(task->subsystem, background, task->name);
+
+    task->func();
+
+    SDL_EndInitStep(step);
+}
+
+/* Marks a deferred task as done and wakes up whoever waits for it, with task->lock held.
+   This is a full barrier, so callers that only check the state see what the task set up. */
+static void
+SDL_CompleteInitTask(SDL_InitTask *task)
+{
+    SDL_AtomicCAS(&task->state, SDL_INIT_TASK_RUNNING, SDL_INIT_TASK_DONE);
+    SDL_CondBroadcast(task->done);
+}
+
+/* Waits for the thread of a task that's done, with task->lock held */
+static void
+SDL_JoinInitTask(SDL_InitTask *task)
+{
+    if (task->thread && SDL_AtomicGet(&task->state) == SDL_INIT_TASK_DONE) {
+        SDL_WaitThread(task->thread, NULL);
+        task->thread = NULL;
+    }
+}
+
+static int SDLCALL
+SDL_InitTaskThread(void *data)
+{
+    SDL_InitTask *task = (SDL_InitTask *) data;
+
+    SDL_LockMutex(task->lock);
+    task->runner = SDL_ThreadID();
+    SDL_UnlockMutex(task->lock);
+
+    SDL_RunInitTask(task, SDL_TRUE);
+
+    SDL_LockMutex(task->lock);
+    SDL_CompleteInitTask(task);
+    SDL_UnlockMutex(task->lock);
+    return 0;
+}
+
+void
+SDL_StartInitTask(SDL_InitTask *task, Uint32 subsystem, const char *name,
+                  void (*func)(void), SDL_bool background)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_LAZY_INIT);
+    const int mode = hint ? SDL_atoi(hint) : 0;
+
+    task->name = name;
+    task->subsystem = subsystem;
+    task->func = func;
+    task->thread = NULL;
+    task->runner = 0;
+
+    if (mode > 0) {
+        task->lock = SDL_CreateMutex();
+        task->done = SDL_CreateCond();
+    }
+    if (!task->lock || !task->done) {
+        /* Not deferred, or there's nothing to wait for it with */
+        if (task->lock) {
+            SDL_DestroyMutex(task->lock);
+            task->lock = NULL;
+        }
+        if (task->done) {
+            SDL_DestroyCond(task->done);
+            task->done = NULL;
+        }
+        SDL_AtomicSet(&task->state, SDL_INIT_TASK_DONE);
+        SDL_RunInitTask(task, SDL_FALSE);
+        return;
+    }
+
+    SDL_AtomicSet(&task->state, SDL_INIT_TASK_PENDING);
+#if !SDL_THREADS_DISABLED
+    if (mode >= 2 && background) {
+        /* The thread waits for the lock, so it can't finish before it's recorded */
+        SDL_LockMutex(task->lock);
+        SDL_AtomicSet(&task->state, SDL_INIT_TASK_RUNNING);
+        task->thread = SDL_CreateThreadInternal(SDL_InitTaskThread, "SDLInitTask", 0, task);
+        if (!task->thread) {
+            SDL_AtomicSet(&task->state, SDL_INIT_TASK_PENDING);
+        }
+        SDL_UnlockMutex(task->lock);
+    }
+#endif
+}
+
+void
+SDL_FinishInitTask(SDL_InitTask *task)
+{
+    if (SDL_AtomicGet(&task->state) == SDL_INIT_TASK_DONE) {
+        return;
+    }
+
+    SDL_LockMutex(task->lock);
+    if (SDL_AtomicGet(&task->state) == SDL_INIT_TASK_PENDING) {
+        /* Run it here, without the lock so that the task can call back in */
+        SDL_AtomicSet(&task->state, SDL_INIT_TASK_RUNNING);
+        task->runner = SDL_ThreadID();
+        SDL_UnlockMutex(task->lock);
+
+        SDL_RunInitTask(task, SDL_FALSE);
+
+        SDL_LockMutex(task->lock);
+        SDL_CompleteInitTask(task);
+    } else if (task->runner != SDL_ThreadID()) {
+        while (SDL_AtomicGet(&task->state) == SDL_INIT_TASK_RUNNING) {
+            SDL_CondWait(task->done, task->lock);
+        }
+    }
+    /* else the task itself needs something it's still setting up */
+    SDL_JoinInitTask(task);
+    SDL_UnlockMutex(task->lock);
+}
+
+void
+SDL_CancelInitTask(SDL_InitTask *task)
+{
+    if (!task->lock) {
+        return;  /* it ran when it was started */
+    }
+
+    SDL_LockMutex(task->lock);
+    if (task->runner != SDL_ThreadID()) {
+        while (SDL_AtomicGet(&task->state) == SDL_INIT_TASK_RUNNING) {
+            SDL_CondWait(task->done, task->lock);
+        }
+    }
+    SDL_AtomicSet(&task->state, SDL_INIT_TASK_DONE);
+    SDL_JoinInitTask(task);
+    SDL_UnlockMutex(task->lock);
+
+    SDL_DestroyCond(task->done);
+    task->done = NULL;
+    SDL_DestroyMutex(task->lock);
+    task->lock = NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
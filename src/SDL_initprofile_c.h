@@ -0,0 +1,67 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "./SDL_internal.h"
+
+#ifndef SDL_initprofile_c_h_
+#define SDL_initprofile_c_h_
+
+#include "SDL.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+
+/* Records how long a step of initialization takes, for SDL_GetInitTimings().
+   SDL_BeginInitStep() returns a handle for SDL_EndInitStep(), or -1 if
+   there's no room left to record it (SDL_EndInitStep(-1) is harmless). */
+extern int SDL_BeginInitStep(Uint32 subsystem, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+extern void SDL_EndInitStep(int step);
+extern void SDL_ClearInitTimings(void);
+
+/* An expensive init step that SDL_HINT_LAZY_INIT can defer until it's
+   needed, or start on a background thread. Zero it before starting it. */
+typedef struct SDL_InitTask
+{
+    const char *name;
+    Uint32 subsystem;
+    void (*func)(void);
+    SDL_atomic_t state;     /* can be checked without the lock */
+    SDL_mutex *lock;        /* guards the rest while the task is deferred */
+    SDL_cond *done;         /* signaled when a deferred task has run */
+    SDL_Thread *thread;
+    SDL_threadID runner;    /* the thread running func, while it runs */
+} SDL_InitTask;
+
+/* Runs (func) now, or defers it, depending on SDL_HINT_LAZY_INIT.
+   If (background) is SDL_TRUE it may be run on another thread. */
+extern void SDL_StartInitTask(SDL_InitTask *task, Uint32 subsystem, const char *name,
+                              void (*func)(void), SDL_bool background);
+
+/* Makes sure the task has run, waiting for it or running it right here.
+   Does nothing when called from within the task itself. */
+extern void SDL_FinishInitTask(SDL_InitTask *task);
+
+/* Waits for the task if it's running and drops it if it hasn't started,
+   for use when the subsystem it belongs to shuts down. */
+extern void SDL_CancelInitTask(SDL_InitTask *task);
+
+#endif /* SDL_initprofile_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -27,11 +27,13 @@
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
 #include "../thread/SDL_systhread.h"
+#include "../SDL_initprofile_c.h"
 
 #define _THIS SDL_AudioDevice *_this
 
 static SDL_AudioDriver current_audio;
 static SDL_AudioDevice *open_devices[16];
+static SDL_InitTask device_detection;  /* the first DetectDevices(), see SDL_HINT_LAZY_INIT */
 
 /* Available audio drivers */
 static const AudioBootStrap *const bootstrap[] = {
@@ -658,6 +660,23 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     return retval;
 }
 
+Uint32
+SDL_GetAudioDeviceTicks(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    Uint64 frames;
+
+    if (!device) {
+        return 0;
+    }
+
+    current_audio.impl.LockDevice(device);
+    frames = device->callback_frames;
+    current_audio.impl.UnlockDevice(device);
+
+    return (Uint32) ((frames * 1000) / device->callbackspec.freq);
+}
+
 void
 SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 {
@@ -733,6 +752,7 @@ SDL_RunAudio(void *devicep)
             SDL_memset(data, device->spec.silence, data_len);
         } else {
             callback(udata, data, data_len);
+            device->callback_frames += device->callbackspec.samples;
         }
         SDL_UnlockMutex(device->mixer_lock);
 
@@ -874,6 +894,7 @@ SDL_CaptureAudio(void *devicep)
                 SDL_LockMutex(device->mixer_lock);
                 if (!SDL_AtomicGet(&device->paused)) {
                     callback(udata, device->work_buffer, device->callbackspec.size);
+                    device->callback_frames += device->callbackspec.samples;
                 }
                 SDL_UnlockMutex(device->mixer_lock);
             }
@@ -882,6 +903,7 @@ SDL_CaptureAudio(void *devicep)
             SDL_LockMutex(device->mixer_lock);
             if (!SDL_AtomicGet(&device->paused)) {
                 callback(udata, data, device->callbackspec.size);
+                device->callback_frames += device->callbackspec.samples;
             }
             SDL_UnlockMutex(device->mixer_lock);
         }
@@ -936,12 +958,19 @@ SDL_GetAudioDriver(int index)
     return NULL;
 }
 
+static void
+SDL_DetectAudioDevices(void)
+{
+    current_audio.impl.DetectDevices();
+}
+
 int
 SDL_AudioInit(const char *driver_name)
 {
     int i = 0;
     int initialized = 0;
     int tried_to_init = 0;
+    int step;
 
     if (SDL_WasInit(SDL_INIT_AUDIO)) {
         SDL_AudioQuit();        /* shutdown driver if already running. */
@@ -967,7 +996,9 @@ SDL_AudioInit(const char *driver_name)
         SDL_zero(current_audio);
         current_audio.name = backend->name;
         current_audio.desc = backend->desc;
+        step = SDL_BeginInitStep(SDL_INIT_AUDIO, "audio/%s", backend->name);
         initialized = backend->init(&current_audio.impl);
+        SDL_EndInitStep(step);
     }
 
     if (!initialized) {
@@ -988,8 +1019,9 @@ SDL_AudioInit(const char *driver_name)
 
     finish_audio_entry_points_init();
 
-    /* Make sure we have a list of devices available at startup. */
-    current_audio.impl.DetectDevices();
+    /* Make sure we have a list of devices available at startup, or by the
+       time it's first asked for if that's deferred. */
+    SDL_StartInitTask(&device_detection, SDL_INIT_AUDIO, "audio/detect devices", SDL_DetectAudioDevices, SDL_FALSE);
 
 #ifdef HAVE_LIBSAMPLERATE_H
     LoadLibSampleRate();
@@ -1050,6 +1082,8 @@ SDL_GetNumAudioDevices(int iscapture)
         return -1;
     }
 
+    SDL_FinishInitTask(&device_detection);
+
     SDL_LockMutex(current_audio.detectionLock);
     if (iscapture && current_audio.captureDevicesRemoved) {
         clean_out_device_list(&current_audio.inputDevices, &current_audio.inputDeviceCount, &current_audio.captureDevicesRemoved);
@@ -1085,6 +1119,8 @@ SDL_GetAudioDeviceName(int index, int iscapture)
         SDL_AudioDeviceItem *item;
         int i;
 
+        SDL_FinishInitTask(&device_detection);
+
         SDL_LockMutex(current_audio.detectionLock);
         item = iscapture ? current_audio.inputDevices : current_audio.outputDevices;
         i = iscapture ? current_audio.inputDeviceCount : current_audio.outputDeviceCount;
@@ -1304,6 +1340,7 @@ open_audio_device(const char *devname, int iscapture,
            It might still need to open a device based on the string for,
            say, a network audio server, but this optimizes some cases. */
         SDL_AudioDeviceItem *item;
+        SDL_FinishInitTask(&device_detection);
         SDL_LockMutex(current_audio.detectionLock);
         for (item = iscapture ? current_audio.inputDevices : current_audio.outputDevices; item; item = item->next) {
             if ((item->handle != NULL) && (SDL_strcmp(item->name, devname) == 0)) {
@@ -1595,6 +1632,8 @@ SDL_AudioQuit(void)
         return;
     }
 
+    SDL_CancelInitTask(&device_detection);
+
     for (i = 0; i < SDL_arraysize(open_devices); i++) {
         close_audio_device(open_devices[i]);
     }
@@ -33,9 +33,16 @@
 #include "SDL_assert.h"
 #include "../SDL_dataqueue.h"
 #include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+#include "../thread/SDL_systhread.h"
 
 #define DEBUG_AUDIOSTREAM 0
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
 #ifdef __SSE3__
 #define HAVE_SSE3_INTRINSICS 1
 #endif
@@ -480,26 +487,35 @@ ResamplerPadding(const int inrate, const int outrate)
     return RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
 }
 
+/* Works out output frames [firstframe, firstframe + outframes) of a
+   conversion of inframes frames. Doing it in pieces gives the same result
+   as doing it all at once. */
+typedef void (*SDL_ResampleFramesFunc)(const int chans, const int inrate, const int outrate,
+                                       const float *lpadding, const float *rpadding,
+                                       const float *inbuf, const int inframes,
+                                       float *outbuf, const int firstframe, const int outframes);
+
+static SDL_ResampleFramesFunc SDL_ResampleFrames = NULL;
+
 /* lpadding and rpadding are expected to be buffers of (ResamplePadding(inrate, outrate) * chans * sizeof (float)) bytes. */
-static int
-SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
-                        const float *lpadding, const float *rpadding,
-                        const float *inbuf, const int inbuflen,
-                        float *outbuf, const int outbuflen)
+static void
+SDL_ResampleFrames_Scalar(const int chans, const int inrate, const int outrate,
+                          const float *lpadding, const float *rpadding,
+                          const float *inbuf, const int inframes,
+                          float *outbuf, const int firstframe, const int outframes)
 {
     const double finrate = (double) inrate;
     const double outtimeincr = 1.0 / ((float) outrate);
-    const double  ratio = ((float) outrate) / ((float) inrate);
     const int paddinglen = ResamplerPadding(inrate, outrate);
-    const int framelen = chans * (int)sizeof (float);
-    const int inframes = inbuflen / framelen;
-    const int wantedoutframes = (int) ((inbuflen / framelen) * ratio);  /* outbuflen isn't total to write, it's total available. */
-    const int maxoutframes = outbuflen / framelen;
-    const int outframes = SDL_min(wantedoutframes, maxoutframes);
     float *dst = outbuf;
     double outtime = 0.0;
     int i, j, chan;
 
+    /* The time is accumulated rather than multiplied out, add it up the same way */
+    for (i = 0; i < firstframe; i++) {
+        outtime += outtimeincr;
+    }
+
     for (i = 0; i < outframes; i++) {
         const int srcindex = (int) (outtime * inrate);
         const double intime = ((double) srcindex) / finrate;
@@ -532,10 +548,137 @@ SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
 
         outtime += outtimeincr;
     }
+}
+
+#if HAVE_SSE2_INTRINSICS
+/* The same filter as SDL_ResampleFrames_Scalar(), with the coefficients
+   worked out once per frame and several channels filtered at once. The
+   products are still rounded from double to float one at a time and summed
+   in the same order, so the output is bit for bit identical. */
+static void
+SDL_ResampleFrames_SSE2(const int chans, const int inrate, const int outrate,
+                        const float *lpadding, const float *rpadding,
+                        const float *inbuf, const int inframes,
+                        float *outbuf, const int firstframe, const int outframes)
+{
+    const double finrate = (double) inrate;
+    const double outtimeincr = 1.0 / ((float) outrate);
+    const int paddinglen = ResamplerPadding(inrate, outrate);
+    const float *taps[2 * (RESAMPLER_ZERO_CROSSINGS + 1)];
+    double coefs[2 * (RESAMPLER_ZERO_CROSSINGS + 1)];
+    float *dst = outbuf;
+    double outtime = 0.0;
+    int i, j, chan, ntaps;
+
+    for (i = 0; i < firstframe; i++) {
+        outtime += outtimeincr;
+    }
+
+    for (i = 0; i < outframes; i++) {
+        const int srcindex = (int) (outtime * inrate);
+        const double intime = ((double) srcindex) / finrate;
+        const double innexttime = ((double) (srcindex + 1)) / finrate;
+        const double interpolation1 = 1.0 - ((innexttime - outtime) / (innexttime - intime));
+        const int filterindex1 = (int) (interpolation1 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+        const double interpolation2 = 1.0 - interpolation1;
+        const int filterindex2 = (int) (interpolation2 * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+
+        ntaps = 0;
+        for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+            const int srcframe = srcindex - j;
+            const int filterindex = filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+            taps[ntaps] = (srcframe < 0) ? &lpadding[(paddinglen + srcframe) * chans] : &inbuf[srcframe * chans];
+            coefs[ntaps++] = ResamplerFilter[filterindex] + (interpolation1 * ResamplerFilterDifference[filterindex]);
+        }
+        for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
+            const int srcframe = srcindex + 1 + j;
+            const int filterindex = filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING);
+            taps[ntaps] = (srcframe >= inframes) ? &rpadding[(srcframe - inframes) * chans] : &inbuf[srcframe * chans];
+            coefs[ntaps++] = ResamplerFilter[filterindex] + (interpolation2 * ResamplerFilterDifference[filterindex]);
+        }
+
+        for (chan = 0; chan + 4 <= chans; chan += 4) {
+            __m128 outsample = _mm_setzero_ps();
+            for (j = 0; j < ntaps; j++) {
+                const __m128 insample = _mm_loadu_ps(taps[j] + chan);
+                const __m128d coef = _mm_set1_pd(coefs[j]);
+                const __m128 lo = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(insample), coef));
+                const __m128 hi = _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(insample, insample)), coef));
+                outsample = _mm_add_ps(outsample, _mm_movelh_ps(lo, hi));
+            }
+            _mm_storeu_ps(dst, outsample);
+            dst += 4;
+        }
+
+        for (; chan + 2 <= chans; chan += 2) {
+            __m128 outsample = _mm_setzero_ps();
+            for (j = 0; j < ntaps; j++) {
+                const __m128 insample = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) (taps[j] + chan));
+                const __m128d coef = _mm_set1_pd(coefs[j]);
+                outsample = _mm_add_ps(outsample, _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(insample), coef)));
+            }
+            _mm_storel_pi((__m64 *) dst, outsample);
+            dst += 2;
+        }
+
+        for (; chan < chans; chan++) {
+            float outsample = 0.0f;
+            for (j = 0; j < ntaps; j++) {
+                outsample += (float)(taps[j][chan] * coefs[j]);
+            }
+            *(dst++) = outsample;
+        }
+
+        outtime += outtimeincr;
+    }
+}
+#endif
+
+void
+SDL_ChooseResampleKernels(void)
+{
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_ResampleFrames = SDL_ResampleFrames_SSE2;
+        SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_RESAMPLE, SDL_SIMD_SSE2);
+        return;
+    }
+#endif
+
+    SDL_ResampleFrames = SDL_ResampleFrames_Scalar;
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_RESAMPLE, SDL_SIMD_SCALAR);
+}
+
+/* The number of frames resampling inframes frames produces */
+static int
+ResamplerOutputFrames(const int inrate, const int outrate, const int inframes)
+{
+    const double ratio = ((float) outrate) / ((float) inrate);
+    return (int) (inframes * ratio);
+}
+
+static int
+SDL_ResampleAudio(const int chans, const int inrate, const int outrate,
+                  const float *lpadding, const float *rpadding,
+                  const float *inbuf, const int inbuflen,
+                  float *outbuf, const int outbuflen)
+{
+    const int framelen = chans * (int)sizeof (float);
+    const int inframes = inbuflen / framelen;
+    const int wantedoutframes = ResamplerOutputFrames(inrate, outrate, inframes);
+    const int maxoutframes = outbuflen / framelen;  /* outbuflen isn't total to write, it's total available. */
+    const int outframes = SDL_min(wantedoutframes, maxoutframes);
+
+    if (!SDL_ResampleFrames) {
+        SDL_ChooseResampleKernels();
+    }
+    SDL_ResampleFrames(chans, inrate, outrate, lpadding, rpadding, inbuf, inframes, outbuf, 0, outframes);
 
     return outframes * chans * sizeof (float);
 }
 
+static SDL_bool SDL_ConvertAudioParallel(SDL_AudioCVT *cvt);
+
 int
 SDL_ConvertAudio(SDL_AudioCVT * cvt)
 {
@@ -553,6 +696,11 @@ SDL_ConvertAudio(SDL_AudioCVT * cvt)
         return 0;
     }
 
+    /* Big buffers can be split up between several threads */
+    if (SDL_ConvertAudioParallel(cvt)) {
+        return 0;
+    }
+
     /* Set up the conversion and go! */
     cvt->filter_index = 0;
     cvt->filters[0] (cvt, cvt->src_format);
@@ -778,6 +926,283 @@ ChooseCVTResampler(const int dst_channels)
     return NULL;
 }
 
+/* Parallel SDL_ConvertAudio(), see SDL_HINT_AUDIO_CONVERT_THREADS.
+
+   The filter chain runs in two passes. The filters up to the resampler
+   (or all of them, if there isn't one) convert chunks of the input. Then
+   the resampler and the format conversion after it produce chunks of the
+   output; every worker reads the whole resampler input, which gives each
+   chunk the ResamplerPadding() frames of context it needs on either side.
+
+   Chunks start a multiple of 64 frames into a 16 byte aligned buffer, so
+   the SIMD converters switch between their vector and scalar loops at the
+   same samples they would in a single pass, and the stitched output is
+   bit for bit the same as the serial result. */
+#define PARALLEL_CONVERT_MIN_BYTES (1024 * 1024)
+#define PARALLEL_CONVERT_MAX_THREADS 64
+#define PARALLEL_CONVERT_ALIGNMENT 64
+/* 64 frames for every supported channel count */
+#define PARALLEL_CONVERT_INPUT_SAMPLES (64 * 24)
+#define PARALLEL_CONVERT_OUTPUT_FRAMES 64
+
+typedef struct
+{
+    int chans;
+    int inrate;
+    int outrate;
+    const float *inbuf;
+    int inframes;
+    const float *padding;
+} SDL_ParallelResample;
+
+typedef struct
+{
+    SDL_AudioCVT cvt;   /* the caller's filters, working on this chunk */
+    const Uint8 *src;   /* first pass: the input to convert */
+    int srclen;
+    const SDL_ParallelResample *resample;  /* second pass: the output frames to produce */
+    int firstframe;
+    int numframes;
+    SDL_Thread *thread;
+} SDL_AudioCVTChunk;
+
+static int SDLCALL
+SDL_ConvertAudioChunk(void *data)
+{
+    SDL_AudioCVTChunk *chunk = (SDL_AudioCVTChunk *) data;
+    SDL_AudioCVT *cvt = &chunk->cvt;
+    SDL_AudioFormat format;
+
+    if (chunk->resample) {
+        const SDL_ParallelResample *resample = chunk->resample;
+        SDL_ResampleFrames(resample->chans, resample->inrate, resample->outrate,
+                           resample->padding, resample->padding,
+                           resample->inbuf, resample->inframes,
+                           (float *) cvt->buf, chunk->firstframe, chunk->numframes);
+        cvt->len_cvt = chunk->numframes * resample->chans * sizeof (float);
+        format = AUDIO_F32SYS;
+    } else {
+        SDL_memcpy(cvt->buf, chunk->src, chunk->srclen);
+        cvt->len_cvt = chunk->srclen;
+        format = cvt->src_format;
+    }
+
+    if (cvt->filters[cvt->filter_index]) {
+        cvt->filters[cvt->filter_index](cvt, format);
+    }
+    return 0;
+}
+
+/* Runs the chunks, the first one on the calling thread, and gathers their
+   output in order at the start of (dst). Returns the number of bytes. */
+static int
+SDL_RunAudioCVTChunks(SDL_AudioCVTChunk *chunks, const int count, Uint8 *dst)
+{
+    int len = 0;
+    int i;
+
+    for (i = 1; i < count; i++) {
+        chunks[i].thread = SDL_CreateThreadInternal(SDL_ConvertAudioChunk, "SDLAudioConv", 0, &chunks[i]);
+        if (!chunks[i].thread) {
+            SDL_ConvertAudioChunk(&chunks[i]);
+        }
+    }
+    SDL_ConvertAudioChunk(&chunks[0]);
+
+    /* (dst) may be the input some chunk is still reading, wait for all of them */
+    for (i = 1; i < count; i++) {
+        if (chunks[i].thread) {
+            SDL_WaitThread(chunks[i].thread, NULL);
+            chunks[i].thread = NULL;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        SDL_memcpy(dst + len, chunks[i].cvt.buf, chunks[i].cvt.len_cvt);
+        len += chunks[i].cvt.len_cvt;
+    }
+    return len;
+}
+
+/* Channels a channel conversion filter expects, 0 if it's something else */
+static int
+SDL_AudioFilterInputChannels(const SDL_AudioFilter filter)
+{
+    if (filter == SDL_ConvertMonoToStereo) {
+        return 1;
+    } else if ((filter == SDL_ConvertStereoToMono) ||
+#if HAVE_SSE3_INTRINSICS
+               (filter == SDL_ConvertStereoToMono_SSE3) ||
+#endif
+               (filter == SDL_ConvertStereoTo51) || (filter == SDL_ConvertStereoToQuad)) {
+        return 2;
+    } else if ((filter == SDL_ConvertQuadToStereo) || (filter == SDL_ConvertQuadTo51)) {
+        return 4;
+    } else if ((filter == SDL_Convert51ToStereo) || (filter == SDL_Convert51ToQuad) || (filter == SDL_Convert51To71)) {
+        return 6;
+    } else if (filter == SDL_Convert71To51) {
+        return 8;
+    }
+    return 0;
+}
+
+static int
+SDL_GetAudioConvertThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_CONVERT_THREADS);
+    int threads = hint ? SDL_atoi(hint) : 1;
+
+    if (hint && !threads) {
+        threads = SDL_GetCPUCount();
+    }
+    return SDL_min(threads, PARALLEL_CONVERT_MAX_THREADS);
+}
+
+/* Returns SDL_TRUE if it converted (cvt), SDL_FALSE to have the caller do it. */
+static SDL_bool
+SDL_ConvertAudioParallel(SDL_AudioCVT *cvt)
+{
+#if SDL_THREADS_DISABLED
+    return SDL_FALSE;
+#else
+    const int samplesize = SDL_AUDIO_BITSIZE(cvt->src_format) / 8;
+    const int unit = PARALLEL_CONVERT_INPUT_SAMPLES * samplesize;
+    const int threads = SDL_GetAudioConvertThreads();
+    SDL_ParallelResample resample;
+    SDL_AudioCVTChunk *chunks;
+    float *padding = NULL;
+    Uint8 *scratch;
+    int resampler = -1;  /* index of the resampler in the filter chain */
+    int srcchans = 0;
+    int units, count, offset, i;
+
+    if ((threads <= 1) || (cvt->len < PARALLEL_CONVERT_MIN_BYTES) ||
+        (((size_t) cvt->buf) & 15) || (cvt->len_mult > ((SDL_MAX_SINT32 - (PARALLEL_CONVERT_MAX_THREADS * PARALLEL_CONVERT_ALIGNMENT)) / cvt->len))) {
+        return SDL_FALSE;
+    }
+
+    units = cvt->len / unit;
+    count = SDL_min(threads, units);
+    if (count <= 1) {
+        return SDL_FALSE;
+    }
+
+    for (i = 0; (i < SDL_AUDIOCVT_MAX_FILTERS - 1) && cvt->filters[i]; i++) {
+        const SDL_AudioFilter filter = cvt->filters[i];
+        if (!srcchans) {
+            srcchans = SDL_AudioFilterInputChannels(filter);
+        }
+        if (filter == SDL_ResampleCVT_c1) {
+            resample.chans = 1;
+        } else if (filter == SDL_ResampleCVT_c2) {
+            resample.chans = 2;
+        } else if (filter == SDL_ResampleCVT_c4) {
+            resample.chans = 4;
+        } else if (filter == SDL_ResampleCVT_c6) {
+            resample.chans = 6;
+        } else if (filter == SDL_ResampleCVT_c8) {
+            resample.chans = 8;
+        } else {
+            continue;
+        }
+        resampler = i;
+    }
+
+    /* The channel converters misread a buffer that ends partway through a
+       frame, in a way that can't be reproduced a chunk at a time */
+    if (!srcchans) {
+        srcchans = (resampler >= 0) ? resample.chans : 1;
+    }
+    if (cvt->len % (samplesize * srcchans)) {
+        return SDL_FALSE;
+    }
+
+    /* Nothing is touched until everything is allocated, so on failure the
+       caller can still convert the buffer itself. */
+    if (resampler >= 0) {
+        resample.inrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS-1];
+        resample.outrate = (int) (size_t) cvt->filters[SDL_AUDIOCVT_MAX_FILTERS];
+        if (ResamplerPadding(resample.inrate, resample.outrate) >= SDL_MAX_SINT32 / resample.chans) {
+            return SDL_FALSE;
+        }
+        padding = (float *) SDL_calloc(ResamplerPadding(resample.inrate, resample.outrate) * resample.chans + 1, sizeof (float));
+        if (!padding) {
+            return SDL_FALSE;
+        }
+        resample.padding = padding;
+        if (!SDL_ResampleFrames) {
+            SDL_ChooseResampleKernels();
+        }
+    }
+
+    /* Neither pass writes more than the caller's buffer holds */
+    chunks = (SDL_AudioCVTChunk *) SDL_malloc(threads * sizeof (SDL_AudioCVTChunk));
+    scratch = (Uint8 *) SDL_SIMDAlloc((cvt->len * cvt->len_mult) + (threads * PARALLEL_CONVERT_ALIGNMENT));
+    if (!chunks || !scratch) {
+        SDL_free(chunks);
+        SDL_SIMDFree(scratch);
+        SDL_free(padding);
+        return SDL_FALSE;
+    }
+
+    /* Convert the input up to the resampler */
+    offset = 0;
+    for (i = 0; i < count; i++) {
+        SDL_AudioCVTChunk *chunk = &chunks[i];
+        const int len = (i == count - 1) ? (cvt->len - offset) : ((units / count) + (i < (units % count))) * unit;
+
+        chunk->cvt = *cvt;
+        chunk->cvt.buf = scratch + (offset * cvt->len_mult) + (i * PARALLEL_CONVERT_ALIGNMENT);
+        chunk->cvt.len = len;
+        chunk->cvt.filter_index = 0;
+        if (resampler >= 0) {
+            chunk->cvt.filters[resampler] = NULL;
+        }
+        chunk->src = cvt->buf + offset;
+        chunk->srclen = len;
+        chunk->resample = NULL;
+        chunk->thread = NULL;
+        offset += len;
+    }
+    cvt->len_cvt = SDL_RunAudioCVTChunks(chunks, count, cvt->buf);
+
+    /* Resample into chunks of the output, like SDL_ResampleCVT() would */
+    if (resampler >= 0) {
+        const int framelen = resample.chans * (int) sizeof (float);
+        const int maxoutframes = ((cvt->len * cvt->len_mult) - cvt->len_cvt) / framelen;
+        int outframes;
+
+        resample.inbuf = (const float *) cvt->buf;
+        resample.inframes = cvt->len_cvt / framelen;
+        outframes = SDL_min(ResamplerOutputFrames(resample.inrate, resample.outrate, resample.inframes), maxoutframes);
+
+        units = outframes / PARALLEL_CONVERT_OUTPUT_FRAMES;
+        count = SDL_max(SDL_min(threads, units), 1);
+        offset = 0;
+        for (i = 0; i < count; i++) {
+            SDL_AudioCVTChunk *chunk = &chunks[i];
+            const int frames = (i == count - 1) ? (outframes - offset) : ((units / count) + (i < (units % count))) * PARALLEL_CONVERT_OUTPUT_FRAMES;
+
+            chunk->cvt = *cvt;
+            chunk->cvt.buf = scratch + (offset * framelen) + (i * PARALLEL_CONVERT_ALIGNMENT);
+            chunk->cvt.len = frames * framelen;
+            chunk->cvt.filter_index = resampler + 1;
+            chunk->resample = &resample;
+            chunk->firstframe = offset;
+            chunk->numframes = frames;
+            chunk->thread = NULL;
+            offset += frames;
+        }
+        cvt->len_cvt = SDL_RunAudioCVTChunks(chunks, count, cvt->buf);
+    }
+
+    SDL_free(chunks);
+    SDL_SIMDFree(scratch);
+    SDL_free(padding);
+    return SDL_TRUE;
+#endif
+}
+
 static int
 SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
                           const int src_rate, const int dst_rate)
@@ -921,7 +1346,9 @@ SDL_BuildAudioCVT(SDL_AudioCVT * cvt,
     cvt->rate_incr = ((double) dst_rate) / ((double) src_rate);
 
     /* Make sure we've chosen audio conversion functions (MMX, scalar, etc.) */
-    SDL_ChooseAudioConverters();
+    if (!SDL_Convert_S8_to_F32) {
+        SDL_ChooseAudioConverters();
+    }
 
     /* Type conversion goes like this now:
         - byteswap to CPU native format first if necessary.
@@ -1384,6 +1811,7 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     int resamplebuflen = 0;
     int neededpaddingbytes;
     int paddingbytes;
+    SDL_bool inqueue = SDL_FALSE;
 
     /* !!! FIXME: several converters can take advantage of SIMD, but only
        !!! FIXME:  if the data is aligned to 16 bytes. EnsureStreamBufferSize()
@@ -1463,6 +1891,17 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
         SDL_memcpy(stream->resampler_padding, workbuf + (buflen - neededpaddingbytes), neededpaddingbytes);
 
         resamplebuf = workbuf + buflen;  /* skip to second piece of workbuf. */
+
+        /* If resampling is the last step, resample straight into the queue
+           when it has that much contiguous space free after its data. */
+        if (!stream->cvt_after_resampling.needed && (resamplebuflen > 0)) {
+            SDL_DataQueueSpan spans[2];
+            if ((SDL_ReserveDataQueueSpans(stream->queue, spans, resamplebuflen) == 0) && (spans[1].len == 0)) {
+                resamplebuf = spans[0].data;
+                inqueue = SDL_TRUE;
+            }
+        }
+
         SDL_assert(buflen >= neededpaddingbytes);
         if (buflen > neededpaddingbytes) {
             buflen = stream->resampler_func(stream, workbuf, buflen - neededpaddingbytes, resamplebuf, resamplebuflen);
@@ -1499,6 +1938,11 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
         *maxputbytes -= buflen;
     }
 
+    if (inqueue) {
+        SDL_CommitDataQueue(stream->queue, buflen);
+        return 0;
+    }
+
     /* resamplebuf holds the final output, even if we didn't resample. */
     return buflen ? SDL_WriteToDataQueue(stream->queue, resamplebuf, buflen) : 0;
 }
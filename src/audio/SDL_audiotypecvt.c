@@ -24,6 +24,7 @@
 #include "SDL_audio_c.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_assert.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 #ifdef __ARM_NEON
 #define HAVE_NEON_INTRINSICS 1
@@ -33,21 +34,6 @@
 #define HAVE_SSE2_INTRINSICS 1
 #endif
 
-#if defined(__x86_64__) && HAVE_SSE2_INTRINSICS
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* x86_64 guarantees SSE2. */
-#elif __MACOSX__ && HAVE_SSE2_INTRINSICS
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* Mac OS X/Intel guarantees SSE2. */
-#elif defined(__ARM_ARCH) && (__ARM_ARCH >= 8) && HAVE_NEON_INTRINSICS
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* ARMv8+ promise NEON. */
-#elif defined(__APPLE__) && defined(__ARM_ARCH) && (__ARM_ARCH >= 7) && HAVE_NEON_INTRINSICS
-#define NEED_SCALAR_CONVERTER_FALLBACKS 0  /* All Apple ARMv7 chips promise NEON support. */
-#endif
-
-/* Set to zero if platform is guaranteed to use a SIMD codepath here. */
-#ifndef NEED_SCALAR_CONVERTER_FALLBACKS
-#define NEED_SCALAR_CONVERTER_FALLBACKS 1
-#endif
-
 /* Function pointers set to a CPU-specific implementation. */
 SDL_AudioFilter SDL_Convert_S8_to_F32 = NULL;
 SDL_AudioFilter SDL_Convert_U8_to_F32 = NULL;
@@ -66,7 +52,8 @@ SDL_AudioFilter SDL_Convert_F32_to_S32 = NULL;
 #define DIVBY8388607 0.00000011920930376163766f
 
 
-#if NEED_SCALAR_CONVERTER_FALLBACKS
+/* The plain C converters are always built, SDL_HINT_CPU_FEATURE_MASK can
+   hide the SIMD instruction sets even where the platform guarantees them. */
 static void SDLCALL
 SDL_Convert_S8_to_F32_Scalar(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 {
@@ -289,7 +276,6 @@ SDL_Convert_F32_to_S32_Scalar(SDL_AudioCVT *cvt, SDL_AudioFormat format)
         cvt->filters[cvt->filter_index](cvt, AUDIO_S32SYS);
     }
 }
-#endif
 
 
 #if HAVE_SSE2_INTRINSICS
@@ -1385,12 +1371,6 @@ SDL_Convert_F32_to_S32_NEON(SDL_AudioCVT *cvt, SDL_AudioFormat format)
 
 void SDL_ChooseAudioConverters(void)
 {
-    static SDL_bool converters_chosen = SDL_FALSE;
-
-    if (converters_chosen) {
-        return;
-    }
-
 #define SET_CONVERTER_FUNCS(fntype) \
         SDL_Convert_S8_to_F32 = SDL_Convert_S8_to_F32_##fntype; \
         SDL_Convert_U8_to_F32 = SDL_Convert_U8_to_F32_##fntype; \
@@ -1402,10 +1382,11 @@ void SDL_ChooseAudioConverters(void)
         SDL_Convert_F32_to_S16 = SDL_Convert_F32_to_S16_##fntype; \
         SDL_Convert_F32_to_U16 = SDL_Convert_F32_to_U16_##fntype; \
         SDL_Convert_F32_to_S32 = SDL_Convert_F32_to_S32_##fntype; \
-        converters_chosen = SDL_TRUE
+        SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_CONVERT, variant)
 
 #if HAVE_SSE2_INTRINSICS
     if (SDL_HasSSE2()) {
+        const SDL_SIMDVariant variant = SDL_SIMD_SSE2;
         SET_CONVERTER_FUNCS(SSE2);
         return;
     }
@@ -1413,18 +1394,18 @@ void SDL_ChooseAudioConverters(void)
 
 #if HAVE_NEON_INTRINSICS
     if (SDL_HasNEON()) {
+        const SDL_SIMDVariant variant = SDL_SIMD_NEON;
         SET_CONVERTER_FUNCS(NEON);
         return;
     }
 #endif
 
-#if NEED_SCALAR_CONVERTER_FALLBACKS
-    SET_CONVERTER_FUNCS(Scalar);
-#endif
+    {
+        const SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+        SET_CONVERTER_FUNCS(Scalar);
+    }
 
 #undef SET_CONVERTER_FUNCS
-
-    SDL_assert(converters_chosen == SDL_TRUE);
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
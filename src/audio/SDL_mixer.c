@@ -26,6 +26,11 @@
 #include "SDL_timer.h"
 #include "SDL_audio.h"
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -85,6 +90,78 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(s, v) (s = (s*v)/SDL_MIX_MAXVOLUME)
 #define ADJUST_VOLUME_U8(s, v)  (s = (((s-128)*v)/SDL_MIX_MAXVOLUME)+128)
 
+#if HAVE_SSE2_INTRINSICS
+/* Mixes as many whole 16 byte blocks as there are and returns the number of
+   bytes done, the caller does the rest. The volume must be 1 - 128 so the
+   scaled samples fit in 16 bits, which makes the results identical to the
+   plain C loop. */
+static Uint32
+SDL_MixAudio_S16LSB_SSE2(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16) volume);
+    const __m128i round = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    const Uint32 done = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < done; i += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i *) (src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *) (dst + i));
+        const __m128i prodlo = _mm_mullo_epi16(s, vol);
+        const __m128i prodhi = _mm_mulhi_epi16(s, vol);
+        __m128i lo = _mm_unpacklo_epi16(prodlo, prodhi);
+        __m128i hi = _mm_unpackhi_epi16(prodlo, prodhi);
+
+        /* Divide by 128, rounding towards zero like C does */
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_and_si128(_mm_srai_epi32(lo, 31), round)), 7);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_and_si128(_mm_srai_epi32(hi, 31), round)), 7);
+
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_adds_epi16(_mm_packs_epi32(lo, hi), d));
+    }
+    return done;
+}
+
+/* The sum is clamped in double precision as in the plain C loop, with the
+   operands ordered so NaNs pass through untouched the same way. */
+static Uint32
+SDL_MixAudio_F32LSB_SSE2(Uint8 * dst, const Uint8 * src, Uint32 len, int volume)
+{
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float) SDL_MIX_MAXVOLUME));
+    const __m128 fvolume = _mm_set1_ps((float) volume);
+    const __m128d max_audioval = _mm_set1_pd(3.402823466e+38F);
+    const __m128d min_audioval = _mm_set1_pd(-3.402823466e+38F);
+    const Uint32 done = len & ~15;
+    Uint32 i;
+
+    for (i = 0; i < done; i += 16) {
+        const __m128 s = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps((const float *) (src + i)), fvolume), fmaxvolume);
+        const __m128 d = _mm_loadu_ps((const float *) (dst + i));
+        __m128d lo = _mm_add_pd(_mm_cvtps_pd(s), _mm_cvtps_pd(d));
+        __m128d hi = _mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(s, s)), _mm_cvtps_pd(_mm_movehl_ps(d, d)));
+
+        lo = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, lo));
+        hi = _mm_max_pd(min_audioval, _mm_min_pd(max_audioval, hi));
+        _mm_storeu_ps((float *) (dst + i), _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+    }
+    return done;
+}
+#endif
+
+static SDL_SIMDVariant SDL_MixVariant = SDL_SIMD_UNRESOLVED;
+
+void
+SDL_ChooseMixKernels(void)
+{
+    SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        variant = SDL_SIMD_SSE2;
+    }
+#endif
+
+    SDL_MixVariant = variant;
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_MIX, variant);
+}
 
 void
 SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
@@ -94,6 +171,10 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         return;
     }
 
+    if (SDL_MixVariant == SDL_SIMD_UNRESOLVED) {
+        SDL_ChooseMixKernels();
+    }
+
     switch (format) {
 
     case AUDIO_U8:
@@ -144,6 +225,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         break;
 
     case AUDIO_S16LSB:
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_MixVariant == SDL_SIMD_SSE2 && volume > 0 && volume <= SDL_MIX_MAXVOLUME) {
+            const Uint32 done = SDL_MixAudio_S16LSB_SSE2(dst, src, len, volume);
+            dst += done;
+            src += done;
+            len -= done;
+        }
+#endif
         {
             Sint16 src1, src2;
             int dst_sample;
@@ -303,6 +392,14 @@ SDL_MixAudioFormat(Uint8 * dst, const Uint8 * src, SDL_AudioFormat format,
         break;
 
     case AUDIO_F32LSB:
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_MixVariant == SDL_SIMD_SSE2) {
+            const Uint32 done = SDL_MixAudio_F32LSB_SSE2(dst, src, len, volume);
+            dst += done;
+            src += done;
+            len -= done;
+        }
+#endif
         {
             const float fmaxvolume = 1.0f / ((float) SDL_MIX_MAXVOLUME);
             const float fvolume = (float) volume;
@@ -165,6 +165,9 @@ struct SDL_AudioDevice
     /* Queued buffers (if app not using callback). */
     SDL_DataQueue *buffer_queue;
 
+    /* Sample frames the callback has processed, protected by mixer_lock. */
+    Uint64 callback_frames;
+
     /* * * */
     /* Data private to this driver */
     struct SDL_PrivateAudioData *hidden;
@@ -34,6 +34,7 @@
 #include "../SDL_audio_c.h"
 #include "SDL_diskaudio.h"
 #include "SDL_log.h"
+#include "SDL_hints.h"
 
 /* !!! FIXME: these should be SDL hints, not environment variables. */
 /* environment variables and defaults. */
@@ -43,19 +44,43 @@
 #define DISKDEFAULT_INFILE      "sdlaudio-in.raw"
 #define DISKENVR_IODELAY      "SDL_DISKAUDIODELAY"
 
+static void
+DISKAUDIO_BeginLoopIteration(_THIS)
+{
+    /* On a virtual clock, time stands still while paused: don't write
+       silence, just wait without cooking the CPU until we're resumed. */
+    if (this->hidden->virtual_clock) {
+        const Uint32 delay = ((this->spec.samples * 1000) / this->spec.freq);
+        while (SDL_AtomicGet(&this->paused) && !SDL_AtomicGet(&this->shutdown)) {
+            SDL_Delay(delay);
+        }
+    }
+}
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 DISKAUDIO_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->io_delay);
+    if (!this->hidden->virtual_clock) {
+        SDL_Delay(this->hidden->io_delay);
+    }
 }
 
 static void
 DISKAUDIO_PlayDevice(_THIS)
 {
-    const size_t written = SDL_RWwrite(this->hidden->io,
-                                       this->hidden->mixbuf,
-                                       1, this->spec.size);
+    size_t written;
+
+    /* On a virtual clock, only write buffers the callback actually filled,
+       so pausing at an unlucky moment doesn't add silence to the file. */
+    if (this->hidden->virtual_clock && !this->stream) {
+        if (this->callback_frames == this->hidden->written_frames) {
+            return;
+        }
+        this->hidden->written_frames = this->callback_frames;
+    }
+
+    written = SDL_RWwrite(this->hidden->io, this->hidden->mixbuf, 1, this->spec.size);
 
     /* If we couldn't write, assume fatal error for now */
     if (written != this->spec.size) {
@@ -78,7 +103,9 @@ DISKAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
     struct SDL_PrivateAudioData *h = this->hidden;
     const int origbuflen = buflen;
 
-    SDL_Delay(h->io_delay);
+    if (!h->virtual_clock) {
+        SDL_Delay(h->io_delay);
+    }
 
     if (h->io) {
         const size_t br = SDL_RWread(h->io, buffer, 1, buflen);
@@ -145,6 +172,7 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     } else {
         this->hidden->io_delay = ((this->spec.samples * 1000) / this->spec.freq);
     }
+    this->hidden->virtual_clock = SDL_GetHintBoolean(SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK, SDL_FALSE);
 
     /* Open the audio device */
     this->hidden->io = SDL_RWFromFile(fname, iscapture ? "rb" : "wb");
@@ -166,6 +194,10 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO,
                 " %s file [%s].\n", iscapture ? "Reading from" : "Writing to",
                 fname);
+    if (this->hidden->virtual_clock) {
+        SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO,
+                    " Running on a virtual clock.\n");
+    }
 
     /* We're ready to rock and roll. :-) */
     return 0;
@@ -183,6 +215,7 @@ DISKAUDIO_Init(SDL_AudioDriverImpl * impl)
 {
     /* Set the function pointers */
     impl->OpenDevice = DISKAUDIO_OpenDevice;
+    impl->BeginLoopIteration = DISKAUDIO_BeginLoopIteration;
     impl->WaitDevice = DISKAUDIO_WaitDevice;
     impl->PlayDevice = DISKAUDIO_PlayDevice;
     impl->GetDeviceBuf = DISKAUDIO_GetDeviceBuf;
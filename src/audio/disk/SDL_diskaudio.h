@@ -35,6 +35,10 @@ struct SDL_PrivateAudioData
     SDL_RWops *io;
     Uint32 io_delay;
     Uint8 *mixbuf;
+    /* Run as fast as possible instead of at the rate the audio would play */
+    SDL_bool virtual_clock;
+    /* Value of callback_frames when the last buffer was written */
+    Uint64 written_frames;
 };
 
 #endif /* SDL_diskaudio_h_ */
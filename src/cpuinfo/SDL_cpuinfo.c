@@ -39,6 +39,10 @@
 
 #include "SDL_cpuinfo.h"
 #include "SDL_assert.h"
+#include "SDL_error.h"
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_cpuinfo_c.h"
 
 #ifdef HAVE_SYSCONF
 #include <unistd.h>
@@ -62,6 +66,11 @@
 #include <sys/syspage.h>
 #endif
 
+#if defined(__LINUX__) || defined(__ANDROID__)
+#include <fcntl.h>              /* For reading the CPU topology from sysfs */
+#include <unistd.h>
+#endif
+
 #if (defined(__LINUX__) || defined(__ANDROID__)) && defined(__ARM_ARCH)
 /*#include <asm/hwcap.h>*/
 #ifndef AT_HWCAP
@@ -264,6 +273,49 @@ done:
     do { a = b = c = d = 0; (void) a; (void) b; (void) c; (void) d; } while (0)
 #endif
 
+/* Like cpuid(), for the leaves that take a subleaf in ecx */
+#if defined(__GNUC__) && defined(i386)
+#define cpuid_count(func, sub, a, b, c, d) \
+    __asm__ __volatile__ ( \
+"        pushl %%ebx        \n" \
+"        cpuid              \n" \
+"        movl %%ebx, %%esi  \n" \
+"        popl %%ebx         \n" : \
+            "=a" (a), "=S" (b), "=c" (c), "=d" (d) : "a" (func), "c" (sub))
+#elif defined(__GNUC__) && defined(__x86_64__)
+#define cpuid_count(func, sub, a, b, c, d) \
+    __asm__ __volatile__ ( \
+"        pushq %%rbx        \n" \
+"        cpuid              \n" \
+"        movq %%rbx, %%rsi  \n" \
+"        popq %%rbx         \n" : \
+            "=a" (a), "=S" (b), "=c" (c), "=d" (d) : "a" (func), "c" (sub))
+#elif (defined(_MSC_VER) && defined(_M_IX86)) || defined(__WATCOMC__)
+#define cpuid_count(func, sub, a, b, c, d) \
+    __asm { \
+        __asm mov eax, func \
+        __asm mov ecx, sub \
+        __asm cpuid \
+        __asm mov a, eax \
+        __asm mov b, ebx \
+        __asm mov c, ecx \
+        __asm mov d, edx \
+}
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define cpuid_count(func, sub, a, b, c, d) \
+{ \
+    int CPUInfo[4]; \
+    __cpuidex(CPUInfo, func, sub); \
+    a = CPUInfo[0]; \
+    b = CPUInfo[1]; \
+    c = CPUInfo[2]; \
+    d = CPUInfo[3]; \
+}
+#else
+#define cpuid_count(func, sub, a, b, c, d) \
+    do { a = b = c = d = 0; (void) a; (void) b; (void) c; (void) d; } while (0)
+#endif
+
 static int CPU_CPUIDFeatures[4];
 static int CPU_CPUIDMaxFunction = 0;
 static SDL_bool CPU_OSSavesYMM = SDL_FALSE;
@@ -707,6 +759,396 @@ SDL_GetCPUCacheLineSize(void)
     }
 }
 
+/* Cache sizes and core counts, gathered the first time any of them is
+   asked for */
+static struct
+{
+    SDL_bool checked;
+    int cache_size[3];
+    int physical_cores;
+    int threads_per_core;
+    int efficiency_cores;
+} CPU_Topology;
+
+#if !defined(SDL_CPUINFO_DISABLED) && (defined(__LINUX__) || defined(__ANDROID__))
+static SDL_bool
+CPU_readSysfs(const char *path, char *buf, size_t buflen)
+{
+    const int fd = open(path, O_RDONLY);
+    ssize_t len = -1;
+
+    if (fd >= 0) {
+        len = read(fd, buf, buflen - 1);
+        close(fd);
+    }
+    if (len <= 0) {
+        buf[0] = '\0';
+        return SDL_FALSE;
+    }
+    buf[len] = '\0';
+    return SDL_TRUE;
+}
+
+static int
+CPU_readSysfsInt(const char *path, int fallback)
+{
+    char buf[32];
+    return CPU_readSysfs(path, buf, sizeof (buf)) ? SDL_atoi(buf) : fallback;
+}
+
+/* Checks whether a CPU is in a sysfs list like "0-3,8,10-11" */
+static SDL_bool
+CPU_inSysfsList(const char *list, int cpu)
+{
+    const char *p = list;
+
+    while (*p >= '0' && *p <= '9') {
+        char *end;
+        const long first = SDL_strtol(p, &end, 10);
+        long last = first;
+        if (*end == '-') {
+            last = SDL_strtol(end + 1, &end, 10);
+        }
+        if (cpu >= first && cpu <= last) {
+            return SDL_TRUE;
+        }
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return SDL_FALSE;
+}
+
+static int
+CPU_lastInSysfsList(const char *list)
+{
+    const char *p = list;
+    long last = -1;
+
+    while (*p >= '0' && *p <= '9') {
+        char *end;
+        last = SDL_strtol(p, &end, 10);
+        if (*end == '-') {
+            last = SDL_strtol(end + 1, &end, 10);
+        }
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return (int) last;
+}
+
+static void
+CPU_calcTopologySysfs(void)
+{
+    typedef struct
+    {
+        int package;
+        int core;
+        int capacity;
+        SDL_bool atom;
+    } CPU_Core;
+
+    char online[256];
+    char atoms[256];
+    char path[128];
+    char buf[32];
+    CPU_Core *cores;
+    int index, cpu, last, count = 0;
+    int min_capacity = SDL_MAX_SINT32, max_capacity = 0;
+    int physical = 0, efficiency = 0;
+    SDL_bool hybrid;
+
+    /* Caches of the first CPU, skipping instruction caches */
+    for (index = 0; index < 16; ++index) {
+        int level;
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        level = CPU_readSysfsInt(path, 0);
+        if (level == 0) {
+            break;
+        }
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        if (level > 3 || !CPU_readSysfs(path, buf, sizeof (buf)) || SDL_strncmp(buf, "Instruction", 11) == 0) {
+            continue;
+        }
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if (CPU_readSysfs(path, buf, sizeof (buf))) {
+            char *end;
+            long size = SDL_strtol(buf, &end, 10);
+            if (*end == 'K') {
+                size *= 1024;
+            } else if (*end == 'M') {
+                size *= 1024 * 1024;
+            }
+            CPU_Topology.cache_size[level - 1] = (int) size;
+        }
+    }
+
+    if (!CPU_readSysfs("/sys/devices/system/cpu/online", online, sizeof (online))) {
+        return;
+    }
+    last = CPU_lastInSysfsList(online);
+    if (last < 0 || last >= 4096) {
+        return;
+    }
+    cores = (CPU_Core *) SDL_malloc((last + 1) * sizeof (*cores));
+    if (!cores) {
+        return;
+    }
+
+    /* Intel hybrid CPUs list their efficiency cores as a separate PMU */
+    hybrid = CPU_readSysfs("/sys/devices/cpu_atom/cpus", atoms, sizeof (atoms));
+
+    for (cpu = 0; cpu <= last; ++cpu) {
+        CPU_Core *core = &cores[count];
+        if (!CPU_inSysfsList(online, cpu)) {
+            continue;
+        }
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        core->package = CPU_readSysfsInt(path, 0);
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        core->core = CPU_readSysfsInt(path, -1 - cpu);
+        /* ARM reports the relative performance of each core */
+        SDL_snprintf(path, sizeof (path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+        core->capacity = CPU_readSysfsInt(path, 0);
+        core->atom = hybrid ? CPU_inSysfsList(atoms, cpu) : SDL_FALSE;
+        min_capacity = SDL_min(min_capacity, core->capacity);
+        max_capacity = SDL_max(max_capacity, core->capacity);
+        ++count;
+    }
+
+    for (cpu = 0; cpu < count; ++cpu) {
+        int i;
+        for (i = 0; i < cpu; ++i) {
+            if (cores[i].package == cores[cpu].package && cores[i].core == cores[cpu].core) {
+                break;
+            }
+        }
+        if (i < cpu) {
+            continue;  /* an SMT sibling of a core we already counted */
+        }
+        ++physical;
+        if (hybrid) {
+            if (cores[cpu].atom) {
+                ++efficiency;
+            }
+        } else if (min_capacity < max_capacity && cores[cpu].capacity == min_capacity) {
+            /* With more than two clusters only the slowest are efficiency cores */
+            ++efficiency;
+        }
+    }
+    SDL_free(cores);
+
+    if (physical > 0) {
+        CPU_Topology.physical_cores = physical;
+        CPU_Topology.threads_per_core = SDL_max(count / physical, 1);
+        CPU_Topology.efficiency_cores = efficiency;
+    }
+}
+#endif /* __LINUX__ || __ANDROID__ */
+
+#if !defined(SDL_CPUINFO_DISABLED) && defined(__WIN32__)
+static void
+CPU_calcTopologyWindows(void)
+{
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION *info;
+    DWORD len = 0;
+
+    if (GetLogicalProcessorInformation(NULL, &len) || GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return;
+    }
+    info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION *) SDL_malloc(len);
+    if (info && GetLogicalProcessorInformation(info, &len)) {
+        const DWORD count = len / sizeof (*info);
+        int physical = 0, logical = 0;
+        DWORD i;
+
+        for (i = 0; i < count; ++i) {
+            if (info[i].Relationship == RelationProcessorCore) {
+                ULONG_PTR mask = info[i].ProcessorMask;
+                ++physical;
+                while (mask) {
+                    logical += (int) (mask & 1);
+                    mask >>= 1;
+                }
+            } else if (info[i].Relationship == RelationCache) {
+                const CACHE_DESCRIPTOR *cache = &info[i].Cache;
+                if (cache->Level >= 1 && cache->Level <= 3 && cache->Type != CacheInstruction &&
+                    !CPU_Topology.cache_size[cache->Level - 1]) {
+                    CPU_Topology.cache_size[cache->Level - 1] = (int) cache->Size;
+                }
+            }
+        }
+        if (physical > 0) {
+            CPU_Topology.physical_cores = physical;
+            CPU_Topology.threads_per_core = SDL_max(logical / physical, 1);
+        }
+    }
+    SDL_free(info);
+}
+#endif /* __WIN32__ */
+
+#if !defined(SDL_CPUINFO_DISABLED) && defined(__APPLE__) && defined(HAVE_SYSCTLBYNAME)
+static int
+CPU_sysctlInt(const char *name)
+{
+    Sint64 value = 0;
+    size_t size = sizeof (value);
+
+    /* Some of these are 32-bit and some 64-bit, the zeroed upper half covers both */
+    if (sysctlbyname(name, &value, &size, NULL, 0) != 0 || value <= 0 || value > SDL_MAX_SINT32) {
+        return 0;
+    }
+    return (int) value;
+}
+
+static void
+CPU_calcTopologySysctl(void)
+{
+    CPU_Topology.cache_size[0] = CPU_sysctlInt("hw.l1dcachesize");
+    CPU_Topology.cache_size[1] = CPU_sysctlInt("hw.l2cachesize");
+    CPU_Topology.cache_size[2] = CPU_sysctlInt("hw.l3cachesize");
+    CPU_Topology.physical_cores = CPU_sysctlInt("hw.physicalcpu");
+    if (CPU_Topology.physical_cores > 0) {
+        CPU_Topology.threads_per_core = SDL_max(CPU_sysctlInt("hw.logicalcpu") / CPU_Topology.physical_cores, 1);
+    }
+    /* Performance level 1 is the efficiency cores on Apple silicon */
+    if (CPU_sysctlInt("hw.nperflevels") > 1) {
+        CPU_Topology.efficiency_cores = CPU_sysctlInt("hw.perflevel1.physicalcpu");
+    }
+}
+#endif /* __APPLE__ */
+
+/* Fills in whatever the OS didn't tell us, on x86 */
+static void
+CPU_calcTopologyCPUID(void)
+{
+    const char *cpuType = SDL_GetCPUType();
+    int a, b, c, d;
+    int i;
+
+    CPU_calcCPUIDFeatures();
+    if (CPU_CPUIDMaxFunction <= 0) {
+        return;
+    }
+
+    if (SDL_strcmp(cpuType, "GenuineIntel") == 0) {
+        if (CPU_CPUIDMaxFunction >= 4) {
+            /* Deterministic cache parameters, one subleaf per cache */
+            for (i = 0; i < 16; ++i) {
+                int type, level;
+                cpuid_count(4, i, a, b, c, d);
+                type = a & 0x1F;
+                level = (a >> 5) & 0x7;
+                if (type == 0) {
+                    break;
+                }
+                if (type != 2 && level >= 1 && level <= 3 && !CPU_Topology.cache_size[level - 1]) {
+                    const int ways = ((b >> 22) & 0x3FF) + 1;
+                    const int partitions = ((b >> 12) & 0x3FF) + 1;
+                    const int linesize = (b & 0xFFF) + 1;
+                    const int sets = c + 1;
+                    CPU_Topology.cache_size[level - 1] = ways * partitions * linesize * sets;
+                }
+            }
+        }
+    } else if (SDL_strcmp(cpuType, "AuthenticAMD") == 0 || SDL_strcmp(cpuType, "HygonGenuine") == 0) {
+        int maxext;
+        cpuid(0x80000000, a, b, c, d);
+        maxext = a;
+        if (maxext >= (int) 0x80000005 && !CPU_Topology.cache_size[0]) {
+            cpuid(0x80000005, a, b, c, d);
+            CPU_Topology.cache_size[0] = ((c >> 24) & 0xFF) * 1024;
+        }
+        if (maxext >= (int) 0x80000006) {
+            cpuid(0x80000006, a, b, c, d);
+            if (!CPU_Topology.cache_size[1]) {
+                CPU_Topology.cache_size[1] = ((c >> 16) & 0xFFFF) * 1024;
+            }
+            if (!CPU_Topology.cache_size[2]) {
+                CPU_Topology.cache_size[2] = ((d >> 18) & 0x3FFF) * 512 * 1024;
+            }
+        }
+        if (maxext >= (int) 0x8000001E && !CPU_Topology.threads_per_core) {
+            cpuid(0x8000001E, a, b, c, d);
+            CPU_Topology.threads_per_core = ((b >> 8) & 0xFF) + 1;
+        }
+    }
+
+    /* Extended topology: subleaf 0 is the SMT level */
+    if (CPU_CPUIDMaxFunction >= 0xB && !CPU_Topology.threads_per_core) {
+        cpuid_count(0xB, 0, a, b, c, d);
+        if (((c >> 8) & 0xFF) == 1 && (b & 0xFFFF) > 0) {
+            CPU_Topology.threads_per_core = b & 0xFFFF;
+        }
+    }
+}
+
+static void
+CPU_calcTopology(void)
+{
+    if (CPU_Topology.checked) {
+        return;
+    }
+
+#ifndef SDL_CPUINFO_DISABLED
+#if defined(__LINUX__) || defined(__ANDROID__)
+    CPU_calcTopologySysfs();
+#endif
+#ifdef __WIN32__
+    CPU_calcTopologyWindows();
+#endif
+#if defined(__APPLE__) && defined(HAVE_SYSCTLBYNAME)
+    CPU_calcTopologySysctl();
+#endif
+    CPU_calcTopologyCPUID();
+#endif
+
+    if (CPU_Topology.threads_per_core <= 0) {
+        CPU_Topology.threads_per_core = 1;
+    }
+    if (CPU_Topology.physical_cores <= 0) {
+        CPU_Topology.physical_cores = SDL_max(SDL_GetCPUCount() / CPU_Topology.threads_per_core, 1);
+    }
+    CPU_Topology.checked = SDL_TRUE;
+}
+
+int
+SDL_GetCPUCacheSize(int level)
+{
+    if (level < 1 || level > 3) {
+        return 0;
+    }
+    CPU_calcTopology();
+    return CPU_Topology.cache_size[level - 1];
+}
+
+int
+SDL_GetCPUPhysicalCoreCount(void)
+{
+    CPU_calcTopology();
+    return CPU_Topology.physical_cores;
+}
+
+int
+SDL_GetCPUThreadsPerCore(void)
+{
+    CPU_calcTopology();
+    return CPU_Topology.threads_per_core;
+}
+
+int
+SDL_GetCPUEfficiencyCoreCount(void)
+{
+    CPU_calcTopology();
+    return CPU_Topology.efficiency_cores;
+}
+
+size_t
+SDL_GetCPUStreamingThreshold(void)
+{
+    /* Half of the last level cache leaves room for whatever else is in it */
+    const int l3 = SDL_GetCPUCacheSize(3);
+    const int l2 = SDL_GetCPUCacheSize(2);
+    return (size_t) (l3 ? l3 : l2) / 2;
+}
+
 static Uint32 SDL_CPUFeatures = 0xFFFFFFFF;
 static Uint32 SDL_SIMDAlignment = 0xFFFFFFFF;
 
@@ -776,7 +1218,86 @@ SDL_GetCPUFeatures(void)
     return SDL_CPUFeatures;
 }
 
-#define CPU_FEATURE_AVAILABLE(f) ((SDL_GetCPUFeatures() & f) ? SDL_TRUE : SDL_FALSE)
+static const struct
+{
+    const char *name;
+    Uint32 flag;
+} SDL_CPUFeatureNames[] = {
+    { "rdtsc", CPU_HAS_RDTSC },
+    { "altivec", CPU_HAS_ALTIVEC },
+    { "mmx", CPU_HAS_MMX },
+    { "3dnow", CPU_HAS_3DNOW },
+    { "sse", CPU_HAS_SSE },
+    { "sse2", CPU_HAS_SSE2 },
+    { "sse3", CPU_HAS_SSE3 },
+    { "sse41", CPU_HAS_SSE41 },
+    { "sse42", CPU_HAS_SSE42 },
+    { "avx", CPU_HAS_AVX },
+    { "avx2", CPU_HAS_AVX2 },
+    { "avx512f", CPU_HAS_AVX512F },
+    { "armsimd", CPU_HAS_ARM_SIMD },
+    { "neon", CPU_HAS_NEON },
+    { "all", 0xFFFFFFFF }
+};
+
+static Uint32 SDL_CPUFeatureMask = 0xFFFFFFFF;
+static SDL_bool SDL_CPUFeatureMaskParsed = SDL_FALSE;
+
+/* The hint is a comma separated list of feature names, each prefixed with
+   '-' to hide it or optionally '+' to allow it again, applied in order. */
+static Uint32
+SDL_ParseCPUFeatureMask(const char *hint)
+{
+    Uint32 mask = 0xFFFFFFFF;
+
+    while (hint && *hint) {
+        SDL_bool enable = SDL_TRUE;
+        size_t len = 0;
+        int i;
+
+        while (*hint == ',' || *hint == ' ') {
+            ++hint;
+        }
+        if (*hint == '-') {
+            enable = SDL_FALSE;
+            ++hint;
+        } else if (*hint == '+') {
+            ++hint;
+        }
+        while (hint[len] && hint[len] != ',' && hint[len] != ' ') {
+            ++len;
+        }
+        if (len == 0) {
+            continue;
+        }
+
+        for (i = 0; i < SDL_arraysize(SDL_CPUFeatureNames); ++i) {
+            const char *name = SDL_CPUFeatureNames[i].name;
+            if (SDL_strlen(name) == len && SDL_strncasecmp(hint, name, len) == 0) {
+                if (enable) {
+                    mask |= SDL_CPUFeatureNames[i].flag;
+                } else {
+                    mask &= ~SDL_CPUFeatureNames[i].flag;
+                }
+                break;
+            }
+        }
+        hint += len;
+    }
+    return mask;
+}
+
+static Uint32
+SDL_GetCPUFeatureMask(void)
+{
+    if (!SDL_CPUFeatureMaskParsed) {
+        SDL_CPUFeatureMask = SDL_ParseCPUFeatureMask(SDL_GetHint(SDL_HINT_CPU_FEATURE_MASK));
+        SDL_CPUFeatureMaskParsed = SDL_TRUE;
+    }
+    return SDL_CPUFeatureMask;
+}
+
+#define CPU_FEATURE_AVAILABLE(f) ((SDL_GetCPUFeatures() & SDL_GetCPUFeatureMask() & f) ? SDL_TRUE : SDL_FALSE)
 
 SDL_bool SDL_HasRDTSC(void)
 {
@@ -861,6 +1382,96 @@ SDL_HasNEON(void)
     return CPU_FEATURE_AVAILABLE(CPU_HAS_NEON);
 }
 
+static const char *SDL_SIMDKernelNames[SDL_SIMD_KERNEL_COUNT] = {
+    "fill", "copy", "blend", "convert", "resample", "mix", "yuv"
+};
+
+static const char *SDL_SIMDVariantNames[] = {
+    NULL, "scalar", "mmx", "3dnow", "sse", "sse2", "sse3", "avx", "avx2",
+    "avx512f", "altivec", "armsimd", "neon"
+};
+
+static SDL_SIMDVariant SDL_SIMDKernelVariants[SDL_SIMD_KERNEL_COUNT];
+static SDL_bool SDL_SIMDKernelsWatchingHint = SDL_FALSE;
+
+void
+SDL_SetSIMDKernelVariant(SDL_SIMDKernel kernel, SDL_SIMDVariant variant)
+{
+    SDL_SIMDKernelVariants[kernel] = variant;
+}
+
+static void
+SDL_ResolveSIMDKernels(void)
+{
+    SDL_ChooseFillKernels();
+    SDL_ChooseCopyKernels();
+    SDL_ChooseBlendKernels();
+    SDL_ChooseAudioConverters();
+    SDL_ChooseResampleKernels();
+    SDL_ChooseMixKernels();
+    SDL_ChooseYUVKernels();
+}
+
+static void SDLCALL
+SDL_CPUFeatureMaskChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    int i;
+
+    SDL_CPUFeatureMask = SDL_ParseCPUFeatureMask(hint);
+    SDL_CPUFeatureMaskParsed = SDL_TRUE;
+    SDL_ResolveSIMDKernels();
+
+    for (i = 0; i < SDL_SIMD_KERNEL_COUNT; ++i) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_SYSTEM, "SIMD kernel %s: %s",
+                     SDL_SIMDKernelNames[i], SDL_SIMDVariantNames[SDL_SIMDKernelVariants[i]]);
+    }
+}
+
+void
+SDL_ChooseSIMDKernels(void)
+{
+    if (!SDL_SIMDKernelsWatchingHint) {
+        /* This calls SDL_CPUFeatureMaskChanged() right away */
+        SDL_AddHintCallback(SDL_HINT_CPU_FEATURE_MASK, SDL_CPUFeatureMaskChanged, NULL);
+        SDL_SIMDKernelsWatchingHint = SDL_TRUE;
+    }
+}
+
+void
+SDL_QuitSIMDKernels(void)
+{
+    if (SDL_SIMDKernelsWatchingHint) {
+        SDL_DelHintCallback(SDL_HINT_CPU_FEATURE_MASK, SDL_CPUFeatureMaskChanged, NULL);
+        SDL_SIMDKernelsWatchingHint = SDL_FALSE;
+    }
+    /* The hints are about to be cleared, pick the mask up again on next use */
+    SDL_CPUFeatureMaskParsed = SDL_FALSE;
+}
+
+const char *
+SDL_GetSIMDKernelVariant(const char *kernel)
+{
+    int i;
+
+    if (!kernel) {
+        SDL_InvalidParamError("kernel");
+        return NULL;
+    }
+
+    for (i = 0; i < SDL_SIMD_KERNEL_COUNT; ++i) {
+        if (SDL_strcasecmp(kernel, SDL_SIMDKernelNames[i]) == 0) {
+            /* Follow the hint from here on even if SDL_Init() wasn't called */
+            SDL_ChooseSIMDKernels();
+            if (SDL_SIMDKernelVariants[i] == SDL_SIMD_UNRESOLVED) {
+                SDL_ResolveSIMDKernels();
+            }
+            return SDL_SIMDVariantNames[SDL_SIMDKernelVariants[i]];
+        }
+    }
+    SDL_SetError("Unknown SIMD kernel '%s'", kernel);
+    return NULL;
+}
+
 static int SDL_SystemRAM = 0;
 
 int
@@ -973,6 +1584,8 @@ main()
     printf("CPU type: %s\n", SDL_GetCPUType());
     printf("CPU name: %s\n", SDL_GetCPUName());
     printf("CacheLine size: %d\n", SDL_GetCPUCacheLineSize());
+    printf("L1/L2/L3 cache size: %d/%d/%d\n", SDL_GetCPUCacheSize(1), SDL_GetCPUCacheSize(2), SDL_GetCPUCacheSize(3));
+    printf("Physical cores: %d (%d threads each, %d efficiency)\n", SDL_GetCPUPhysicalCoreCount(), SDL_GetCPUThreadsPerCore(), SDL_GetCPUEfficiencyCoreCount());
     printf("RDTSC: %d\n", SDL_HasRDTSC());
     printf("Altivec: %d\n", SDL_HasAltiVec());
     printf("MMX: %d\n", SDL_HasMMX());
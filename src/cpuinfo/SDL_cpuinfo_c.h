@@ -0,0 +1,107 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_cpuinfo_c_h_
+#define SDL_cpuinfo_c_h_
+
+#include "../SDL_internal.h"
+
+/* Size in bytes above which bulk fills and copies should bypass the cache
+   with non-temporal stores. Output that large wouldn't stay in the cache
+   anyway, and writing it through the cache evicts data that's still in use.
+   0 if the cache sizes are unknown, in which case everything streams. */
+extern size_t SDL_GetCPUStreamingThreshold(void);
+
+/* Kernels for instruction sets newer than the compiler targets by default
+   are built with per-function target attributes, and must only be called
+   after the matching SDL_HasXXX() check. */
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) && \
+    (defined(__i386__) || defined(__x86_64__)) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+#define SDL_TARGETING(x) __attribute__((target(x)))
+#define HAVE_AVX_KERNELS 1
+#define HAVE_AVX2_KERNELS 1
+#define HAVE_AVX512F_KERNELS 1
+#elif defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SDL_TARGETING(x)
+#if _MSC_VER >= 1600
+#define HAVE_AVX_KERNELS 1
+#endif
+#if _MSC_VER >= 1700
+#define HAVE_AVX2_KERNELS 1
+#endif
+#if _MSC_VER >= 1911
+#define HAVE_AVX512F_KERNELS 1
+#endif
+#endif
+
+/* The hot loops that have more than one implementation. Each is resolved
+   to the best variant for the CPU once, when SDL is initialized or the
+   first time it's used, and again whenever SDL_HINT_CPU_FEATURE_MASK
+   changes. */
+typedef enum
+{
+    SDL_SIMD_KERNEL_FILL,
+    SDL_SIMD_KERNEL_COPY,
+    SDL_SIMD_KERNEL_BLEND,
+    SDL_SIMD_KERNEL_CONVERT,
+    SDL_SIMD_KERNEL_RESAMPLE,
+    SDL_SIMD_KERNEL_MIX,
+    SDL_SIMD_KERNEL_YUV,
+    SDL_SIMD_KERNEL_COUNT
+} SDL_SIMDKernel;
+
+typedef enum
+{
+    SDL_SIMD_UNRESOLVED,
+    SDL_SIMD_SCALAR,
+    SDL_SIMD_MMX,
+    SDL_SIMD_3DNOW,
+    SDL_SIMD_SSE,
+    SDL_SIMD_SSE2,
+    SDL_SIMD_SSE3,
+    SDL_SIMD_AVX,
+    SDL_SIMD_AVX2,
+    SDL_SIMD_AVX512F,
+    SDL_SIMD_ALTIVEC,
+    SDL_SIMD_ARMSIMD,
+    SDL_SIMD_NEON
+} SDL_SIMDVariant;
+
+/* Called by each module's chooser to record what it picked */
+extern void SDL_SetSIMDKernelVariant(SDL_SIMDKernel kernel, SDL_SIMDVariant variant);
+
+/* Resolve every kernel now and follow SDL_HINT_CPU_FEATURE_MASK from here on */
+extern void SDL_ChooseSIMDKernels(void);
+extern void SDL_QuitSIMDKernels(void);
+
+/* The per-module choosers, each safe to call again to re-resolve */
+extern void SDL_ChooseFillKernels(void);
+extern void SDL_ChooseCopyKernels(void);
+extern void SDL_ChooseBlendKernels(void);
+extern void SDL_ChooseAudioConverters(void);
+extern void SDL_ChooseResampleKernels(void);
+extern void SDL_ChooseMixKernels(void);
+extern void SDL_ChooseYUVKernels(void);
+
+#endif /* SDL_cpuinfo_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -137,6 +137,14 @@ static SDL_DYNAPI_jump_table jump_table = {
     #undef SDL_DYNAPI_PROC
 };
 
+/* What the jump table holds once it's initialized. Keeping a finished copy
+   around means filling in any table is a single memcpy. */
+static const SDL_DYNAPI_jump_table real_jump_table = {
+    #define SDL_DYNAPI_PROC(rc,fn,params,args,ret) fn##_REAL,
+    #include "SDL_dynapi_procs.h"
+    #undef SDL_DYNAPI_PROC
+};
+
 /* Default functions init the function table then call right thing. */
 #if DISABLE_JUMP_MAGIC
 #define SDL_DYNAPI_PROC(rc,fn,params,args,ret) \
@@ -155,7 +163,17 @@ SDL_DYNAPI_VARARGS(static, _DEFAULT, SDL_InitDynamicAPI())
 #endif
 
 /* Public API functions to jump into the jump table. */
-#if DISABLE_JUMP_MAGIC
+#if SDL_DYNAPI_DIRECT
+/* The dynamic linker binds each public function straight to its
+   implementation, so calls skip the jump table entirely. IFUNC resolvers
+   run before the environment is available, which is why a build like this
+   can't be overridden with SDL_DYNAMIC_API. */
+#define SDL_DYNAPI_PROC(rc,fn,params,args,ret) \
+    static SDL_DYNAPIFN_##fn fn##_RESOLVE(void) { return fn##_REAL; } \
+    rc SDLCALL fn params __attribute__((ifunc(#fn "_RESOLVE")));
+#include "SDL_dynapi_procs.h"
+#undef SDL_DYNAPI_PROC
+#elif DISABLE_JUMP_MAGIC
 #define SDL_DYNAPI_PROC(rc,fn,params,args,ret) \
     rc SDLCALL fn params { ret jump_table.fn args; }
 #define SDL_DYNAPI_PROC_NO_VARARGS 1
@@ -183,13 +201,11 @@ initialize_jumptable(Uint32 apiver, void *table, Uint32 tablesize)
     }
 
     /* Init our jump table first. */
-    #define SDL_DYNAPI_PROC(rc,fn,params,args,ret) jump_table.fn = fn##_REAL;
-    #include "SDL_dynapi_procs.h"
-    #undef SDL_DYNAPI_PROC
+    SDL_memcpy_REAL(&jump_table, &real_jump_table, sizeof (jump_table));
 
     /* Then the external table... */
     if (output_jump_table != &jump_table) {
-        jump_table.SDL_memcpy(output_jump_table, &jump_table, tablesize);
+        SDL_memcpy_REAL(output_jump_table, &real_jump_table, tablesize);
     }
 
     /* Safe to call SDL functions now; jump table is initialized! */
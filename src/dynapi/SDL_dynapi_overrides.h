@@ -746,3 +746,19 @@
 #define SDL_OnApplicationWillEnterForeground SDL_OnApplicationWillEnterForeground_REAL
 #define SDL_OnApplicationDidBecomeActive SDL_OnApplicationDidBecomeActive_REAL
 #define SDL_OnApplicationDidChangeStatusBarOrientation SDL_OnApplicationDidChangeStatusBarOrientation_REAL
+#define SDL_RenderGeometry SDL_RenderGeometry_REAL
+#define SDL_IntersectRects SDL_IntersectRects_REAL
+#define SDL_IntersectRectAndLines SDL_IntersectRectAndLines_REAL
+#define SDL_UpdateWindowShapeRect SDL_UpdateWindowShapeRect_REAL
+#define SDL_GetCPUCacheSize SDL_GetCPUCacheSize_REAL
+#define SDL_GetCPUPhysicalCoreCount SDL_GetCPUPhysicalCoreCount_REAL
+#define SDL_GetCPUThreadsPerCore SDL_GetCPUThreadsPerCore_REAL
+#define SDL_GetCPUEfficiencyCoreCount SDL_GetCPUEfficiencyCoreCount_REAL
+#define SDL_GetSIMDKernelVariant SDL_GetSIMDKernelVariant_REAL
+#define SDL_GetInitTimings SDL_GetInitTimings_REAL
+#define SDL_GetAudioDeviceTicks SDL_GetAudioDeviceTicks_REAL
+#define SDL_RenderStartCapture SDL_RenderStartCapture_REAL
+#define SDL_RenderStopCapture SDL_RenderStopCapture_REAL
+#define SDL_RenderReplayCapture SDL_RenderReplayCapture_REAL
+#define SDL_GetRendererID SDL_GetRendererID_REAL
+#define SDL_GetRendererFromID SDL_GetRendererFromID_REAL
@@ -804,3 +804,19 @@ SDL_DYNAPI_PROC(void,SDL_OnApplicationDidBecomeActive,(void),(),)
 #ifdef __IPHONEOS__
 SDL_DYNAPI_PROC(void,SDL_OnApplicationDidChangeStatusBarOrientation,(void),(),)
 #endif
+SDL_DYNAPI_PROC(int,SDL_RenderGeometry,(SDL_Renderer *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_IntersectRects,(const SDL_Rect *a, const SDL_Rect *b, int c, SDL_Rect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_IntersectRectAndLines,(const SDL_Rect *a, const SDL_Point *b, int c, SDL_Point *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_UpdateWindowShapeRect,(SDL_Window *a, SDL_Surface *b, const SDL_Rect *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetCPUCacheSize,(int a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetCPUPhysicalCoreCount,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetCPUThreadsPerCore,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetCPUEfficiencyCoreCount,(void),(),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetSIMDKernelVariant,(const char *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetInitTimings,(SDL_InitTiming *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetAudioDeviceTicks,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderStartCapture,(SDL_Renderer *a, const char *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RenderStopCapture,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_RenderReplayCapture,(SDL_Renderer *a, const char *b, SDL_RenderReplayCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetRendererID,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Renderer*,SDL_GetRendererFromID,(Uint32 a),(a),return)
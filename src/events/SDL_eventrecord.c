@@ -0,0 +1,689 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Recording the events that enter the queue, and replaying them later */
+
+#include "SDL_assert.h"
+#include "SDL_events.h"
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_timer.h"
+#include "SDL_events_c.h"
+#include "SDL_eventrecord_c.h"
+
+/* An event log starts with a header, followed by one record per event:
+
+     varint  milliseconds since the previous record
+     varint  event type, or 0 for a run of SDL_PumpEvents() calls
+     varint  payload length, or the number of calls for a run of pumps
+     bytes   the event after its type and timestamp, minus trailing zeros
+
+   Drop events store their window ID followed by the text instead, since the
+   event only holds a pointer to it. Events are stored in their in-memory
+   layout, so a log can only be replayed by a build for the same platform.
+
+   Events that SDL generates from other events (gestures, audio hotplug,
+   render resets) and events owned by the app (user and window manager
+   events) aren't recorded; they'll be generated again during the replay.
+ */
+#define EVENTLOG_MAGIC          "SDLEVLOG"
+#define EVENTLOG_VERSION        1
+#define EVENTLOG_HEADER_SIZE    12
+#define EVENTLOG_PUMP           0
+#define EVENTLOG_VARINT_SIZE    10
+/* The log is written out by SDL_PumpEvents() once this much is buffered */
+#define EVENTLOG_FLUSH_SIZE     4096
+
+/* Events are recorded with the event queue locked, so recording only
+   appends to a buffer in memory, under SDL_record_lock. The buffer is
+   written out with only SDL_record_write_lock held, which keeps the writes
+   in order and is never taken with the queue locked. */
+static SDL_mutex *SDL_record_lock;
+static SDL_mutex *SDL_record_write_lock;
+static SDL_RWops *SDL_record_io;
+static Uint8 *SDL_record_buffer;
+static size_t SDL_record_size;
+static size_t SDL_record_used;
+static Uint32 SDL_record_ticks;
+static Uint32 SDL_record_pumps;
+
+static struct
+{
+    Uint8 *data;
+    size_t size;
+    size_t pos;
+    float speed;
+    SDL_bool started;
+    Uint32 start_ticks;
+    Uint64 time;
+    Uint64 pumps;
+} SDL_replay;
+
+
+static void
+SDL_GetEventLogHeader(Uint8 header[EVENTLOG_HEADER_SIZE])
+{
+    SDL_memcpy(header, EVENTLOG_MAGIC, 8);
+    header[8] = EVENTLOG_VERSION;
+    header[9] = (Uint8) sizeof (SDL_Event);
+    header[10] = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? 1 : 0;
+    header[11] = 0;
+}
+
+/* Returns the size of the event structure stored for a type, or 0 if it isn't recorded */
+static size_t
+SDL_GetRecordedEventSize(Uint32 type)
+{
+    switch (type) {
+    case SDL_QUIT:
+        return sizeof (SDL_QuitEvent);
+    case SDL_APP_TERMINATING:
+    case SDL_APP_LOWMEMORY:
+    case SDL_APP_WILLENTERBACKGROUND:
+    case SDL_APP_DIDENTERBACKGROUND:
+    case SDL_APP_WILLENTERFOREGROUND:
+    case SDL_APP_DIDENTERFOREGROUND:
+    case SDL_KEYMAPCHANGED:
+    case SDL_CLIPBOARDUPDATE:
+        return sizeof (SDL_CommonEvent);
+    case SDL_DISPLAYEVENT:
+        return sizeof (SDL_DisplayEvent);
+    case SDL_WINDOWEVENT:
+        return sizeof (SDL_WindowEvent);
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        return sizeof (SDL_KeyboardEvent);
+    case SDL_TEXTEDITING:
+        return sizeof (SDL_TextEditingEvent);
+    case SDL_TEXTINPUT:
+        return sizeof (SDL_TextInputEvent);
+    case SDL_MOUSEMOTION:
+        return sizeof (SDL_MouseMotionEvent);
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        return sizeof (SDL_MouseButtonEvent);
+    case SDL_MOUSEWHEEL:
+        return sizeof (SDL_MouseWheelEvent);
+    case SDL_JOYAXISMOTION:
+        return sizeof (SDL_JoyAxisEvent);
+    case SDL_JOYBALLMOTION:
+        return sizeof (SDL_JoyBallEvent);
+    case SDL_JOYHATMOTION:
+        return sizeof (SDL_JoyHatEvent);
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        return sizeof (SDL_JoyButtonEvent);
+    case SDL_JOYDEVICEADDED:
+    case SDL_JOYDEVICEREMOVED:
+        return sizeof (SDL_JoyDeviceEvent);
+    case SDL_CONTROLLERAXISMOTION:
+        return sizeof (SDL_ControllerAxisEvent);
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        return sizeof (SDL_ControllerButtonEvent);
+    case SDL_CONTROLLERDEVICEADDED:
+    case SDL_CONTROLLERDEVICEREMOVED:
+    case SDL_CONTROLLERDEVICEREMAPPED:
+        return sizeof (SDL_ControllerDeviceEvent);
+    case SDL_FINGERDOWN:
+    case SDL_FINGERUP:
+    case SDL_FINGERMOTION:
+        return sizeof (SDL_TouchFingerEvent);
+    case SDL_SENSORUPDATE:
+        return sizeof (SDL_SensorEvent);
+    default:
+        return 0;
+    }
+}
+
+static SDL_bool
+SDL_IsDropEvent(Uint32 type)
+{
+    return (type >= SDL_DROPFILE && type <= SDL_DROPCOMPLETE) ? SDL_TRUE : SDL_FALSE;
+}
+
+
+/* Recording -- called with SDL_record_lock held */
+
+/* Makes room for len more bytes, so a record is never written in part */
+static SDL_bool
+SDL_ReserveRecording(size_t len)
+{
+    Uint8 *buffer;
+    size_t size;
+
+    if (SDL_record_used + len <= SDL_record_size) {
+        return SDL_TRUE;
+    }
+
+    size = SDL_record_size ? SDL_record_size : EVENTLOG_FLUSH_SIZE;
+    while (size < SDL_record_used + len) {
+        size *= 2;
+    }
+    buffer = (Uint8 *) SDL_realloc(SDL_record_buffer, size);
+    if (!buffer) {
+        return SDL_FALSE;
+    }
+    SDL_record_buffer = buffer;
+    SDL_record_size = size;
+    return SDL_TRUE;
+}
+
+static void
+SDL_RecordBytes(const void *data, size_t len)
+{
+    SDL_assert(SDL_record_used + len <= SDL_record_size);
+
+    SDL_memcpy(&SDL_record_buffer[SDL_record_used], data, len);
+    SDL_record_used += len;
+}
+
+static void
+SDL_RecordVarint(Uint64 value)
+{
+    Uint8 bytes[EVENTLOG_VARINT_SIZE];
+    size_t len = 0;
+
+    do {
+        bytes[len] = (Uint8) (value & 0x7F);
+        value >>= 7;
+        if (value) {
+            bytes[len] |= 0x80;
+        }
+        ++len;
+    } while (value);
+
+    SDL_RecordBytes(bytes, len);
+}
+
+static SDL_bool
+SDL_RecordPendingPumps(void)
+{
+    if (SDL_record_pumps > 0) {
+        if (!SDL_ReserveRecording(3 * EVENTLOG_VARINT_SIZE)) {
+            return SDL_FALSE;
+        }
+        /* Pumps don't need a time, only their position between events */
+        SDL_RecordVarint(0);
+        SDL_RecordVarint(EVENTLOG_PUMP);
+        SDL_RecordVarint(SDL_record_pumps);
+        SDL_record_pumps = 0;
+    }
+    return SDL_TRUE;
+}
+
+static void
+SDL_LockRecording(void)
+{
+    if (SDL_record_lock) {
+        SDL_LockMutex(SDL_record_lock);
+    }
+}
+
+static void
+SDL_UnlockRecording(void)
+{
+    if (SDL_record_lock) {
+        SDL_UnlockMutex(SDL_record_lock);
+    }
+}
+
+/* Writes out what was recorded so far, and closes the log if stop is set.
+   Must not be called with the event queue or SDL_record_lock locked. */
+static void
+SDL_FlushRecording(SDL_bool stop)
+{
+    SDL_RWops *io;
+    Uint8 *buffer;
+    size_t size, used;
+
+    if (SDL_record_write_lock) {
+        SDL_LockMutex(SDL_record_write_lock);
+    }
+
+    /* Take the buffer, so events can be recorded into a new one meanwhile */
+    SDL_LockRecording();
+    io = SDL_record_io;
+    if (io && stop) {
+        SDL_RecordPendingPumps();
+    }
+    buffer = SDL_record_buffer;
+    size = SDL_record_size;
+    used = SDL_record_used;
+    SDL_record_buffer = NULL;
+    SDL_record_size = 0;
+    SDL_record_used = 0;
+    if (stop) {
+        SDL_record_io = NULL;
+    }
+    SDL_UnlockRecording();
+
+    if (io && used > 0 && SDL_RWwrite(io, buffer, 1, used) != used) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't write event log: %s", SDL_GetError());
+    }
+    if (io && stop) {
+        SDL_RWclose(io);
+    }
+
+    /* Hand the buffer back for reuse, unless a new one was needed already */
+    SDL_LockRecording();
+    if (!SDL_record_buffer && SDL_record_io) {
+        SDL_record_buffer = buffer;
+        SDL_record_size = size;
+        buffer = NULL;
+    }
+    SDL_UnlockRecording();
+    SDL_free(buffer);
+
+    if (SDL_record_write_lock) {
+        SDL_UnlockMutex(SDL_record_write_lock);
+    }
+}
+
+void
+SDL_RecordEvent(const SDL_Event *event)
+{
+    const Uint8 *payload;
+    size_t size;
+    Uint32 windowID;
+    Uint32 now;
+
+    if (!SDL_record_io) {
+        return;
+    }
+
+    if (SDL_IsDropEvent(event->type)) {
+        payload = (const Uint8 *) event->drop.file;
+        size = payload ? SDL_strlen(event->drop.file) : 0;
+    } else {
+        size = SDL_GetRecordedEventSize(event->type);
+        if (size == 0) {
+            return;
+        }
+        payload = (const Uint8 *) event + sizeof (SDL_CommonEvent);
+        size -= sizeof (SDL_CommonEvent);
+        while (size > 0 && payload[size - 1] == 0) {
+            --size;
+        }
+    }
+
+    SDL_LockRecording();
+    if (SDL_record_io) {
+        if (!SDL_RecordPendingPumps() ||
+            !SDL_ReserveRecording(3 * EVENTLOG_VARINT_SIZE + sizeof (windowID) + size)) {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't record event: out of memory");
+            SDL_UnlockRecording();
+            return;
+        }
+
+        now = SDL_GetTicks();
+        SDL_RecordVarint(now - SDL_record_ticks);
+        SDL_record_ticks = now;
+        SDL_RecordVarint(event->type);
+        if (SDL_IsDropEvent(event->type)) {
+            windowID = event->drop.windowID;
+            SDL_RecordVarint(sizeof (windowID) + size);
+            SDL_RecordBytes(&windowID, sizeof (windowID));
+        } else {
+            SDL_RecordVarint(size);
+        }
+        SDL_RecordBytes(payload, size);
+    }
+    SDL_UnlockRecording();
+}
+
+void
+SDL_RecordPump(void)
+{
+    SDL_bool flush = SDL_FALSE;
+
+    if (!SDL_record_io) {
+        return;
+    }
+
+    SDL_LockRecording();
+    if (SDL_record_io) {
+        ++SDL_record_pumps;
+        flush = (SDL_record_used >= EVENTLOG_FLUSH_SIZE) ? SDL_TRUE : SDL_FALSE;
+    }
+    SDL_UnlockRecording();
+
+    /* The event queue isn't locked here, unlike when events are recorded */
+    if (flush) {
+        SDL_FlushRecording(SDL_FALSE);
+    }
+}
+
+static void SDLCALL
+SDL_EventRecordChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    Uint8 header[EVENTLOG_HEADER_SIZE];
+    SDL_RWops *io;
+
+    SDL_FlushRecording(SDL_TRUE);
+    if (!hint || !*hint) {
+        return;
+    }
+
+    io = SDL_RWFromFile(hint, "wb");
+    if (!io) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't record events to %s: %s", hint, SDL_GetError());
+        return;
+    }
+
+    SDL_LockRecording();
+    if (SDL_ReserveRecording(sizeof (header))) {
+        SDL_record_io = io;
+        SDL_record_used = 0;
+        SDL_record_ticks = SDL_GetTicks();
+        SDL_record_pumps = 0;
+        SDL_GetEventLogHeader(header);
+        SDL_RecordBytes(header, sizeof (header));
+        io = NULL;
+    }
+    SDL_UnlockRecording();
+
+    if (io) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't record events to %s: out of memory", hint);
+        SDL_RWclose(io);
+    }
+}
+
+
+/* Replaying -- called on the thread that pumps events */
+
+static void
+SDL_StopReplay(void)
+{
+    SDL_free(SDL_replay.data);
+    SDL_zero(SDL_replay);
+}
+
+static SDL_bool
+SDL_ReadVarint(size_t *pos, Uint64 *value)
+{
+    Uint64 result = 0;
+    int shift;
+
+    for (shift = 0; *pos < SDL_replay.size && shift < 64; shift += 7) {
+        const Uint8 byte = SDL_replay.data[(*pos)++];
+        result |= (Uint64) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+static SDL_Window *
+SDL_GetReplayWindow(Uint32 windowID)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    SDL_Window *window;
+
+    /* Not SDL_GetWindowFromID(), so replaying without video doesn't set errors */
+    if (_this) {
+        for (window = _this->windows; window; window = window->next) {
+            if (window->id == windowID) {
+                return window;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void
+SDL_ReplayDropEvent(Uint32 type, const Uint8 *payload, size_t length)
+{
+    SDL_Window *window;
+    Uint32 windowID;
+    char *text;
+
+    if (length < sizeof (windowID)) {
+        return;
+    }
+    SDL_memcpy(&windowID, payload, sizeof (windowID));
+    window = SDL_GetReplayWindow(windowID);
+    length -= sizeof (windowID);
+
+    text = (char *) SDL_malloc(length + 1);
+    if (!text) {
+        return;
+    }
+    SDL_memcpy(text, payload + sizeof (windowID), length);
+    text[length] = '\0';
+
+    /* SDL_DROPBEGIN is sent again along with the first drop */
+    switch (type) {
+    case SDL_DROPFILE:
+        SDL_SendDropFile(window, text);
+        break;
+    case SDL_DROPTEXT:
+        SDL_SendDropText(window, text);
+        break;
+    case SDL_DROPCOMPLETE:
+        SDL_SendDropComplete(window);
+        break;
+    default:
+        break;
+    }
+    SDL_free(text);
+}
+
+static void
+SDL_ReplayEvent(Uint32 type, const Uint8 *payload, size_t length)
+{
+    const size_t size = SDL_GetRecordedEventSize(type);
+    SDL_Window *window;
+    SDL_Event event;
+
+    if (SDL_IsDropEvent(type)) {
+        SDL_ReplayDropEvent(type, payload, length);
+        return;
+    }
+    if (size == 0 || length > size - sizeof (SDL_CommonEvent)) {
+        return;
+    }
+
+    SDL_zero(event);
+    event.type = type;
+    SDL_memcpy((Uint8 *) &event + sizeof (SDL_CommonEvent), payload, length);
+
+    /* Input goes through the same path as the video drivers' events, so
+       the keyboard and mouse state and the window flags follow along. */
+    switch (type) {
+    case SDL_QUIT:
+        SDL_SendQuit();
+        break;
+    case SDL_WINDOWEVENT:
+        window = SDL_GetReplayWindow(event.window.windowID);
+        if (window) {
+            SDL_SendWindowEvent(window, event.window.event, event.window.data1, event.window.data2);
+        }
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        SDL_SendKeyboardKey(event.key.state, event.key.keysym.scancode);
+        break;
+    case SDL_TEXTEDITING:
+        SDL_SendEditingText(event.edit.text, event.edit.start, event.edit.length);
+        break;
+    case SDL_TEXTINPUT:
+        SDL_SendKeyboardText(event.text.text);
+        break;
+    case SDL_MOUSEMOTION:
+        window = SDL_GetReplayWindow(event.motion.windowID);
+        if (SDL_GetRelativeMouseMode()) {
+            SDL_SendMouseMotion(window, event.motion.which, 1, event.motion.xrel, event.motion.yrel);
+        } else {
+            SDL_SendMouseMotion(window, event.motion.which, 0, event.motion.x, event.motion.y);
+        }
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        window = SDL_GetReplayWindow(event.button.windowID);
+        SDL_SendMouseButtonClicks(window, event.button.which, event.button.state, event.button.button, event.button.clicks);
+        break;
+    case SDL_MOUSEWHEEL:
+        window = SDL_GetReplayWindow(event.wheel.windowID);
+        SDL_SendMouseWheel(window, event.wheel.which, (float) event.wheel.x, (float) event.wheel.y, (SDL_MouseWheelDirection) event.wheel.direction);
+        break;
+    default:
+        SDL_PushEvent(&event);
+        break;
+    }
+}
+
+void
+SDL_ReplayEvents(void)
+{
+    const Uint32 now = SDL_GetTicks();
+    Uint64 elapsed = 0;
+    Uint64 delta, type, length;
+    size_t pos;
+
+    if (!SDL_replay.data) {
+        return;
+    }
+
+    /* The replay starts with the first pump after it was set up */
+    if (!SDL_replay.started) {
+        SDL_replay.started = SDL_TRUE;
+        SDL_replay.start_ticks = now;
+    }
+
+    if (SDL_replay.speed > 0.0f) {
+        elapsed = (Uint64) ((double) (now - SDL_replay.start_ticks) * SDL_replay.speed);
+    } else if (SDL_replay.pumps > 0) {
+        /* Nothing happened during this pump in the recording */
+        --SDL_replay.pumps;
+        return;
+    }
+
+    for (;;) {
+        pos = SDL_replay.pos;
+        if (pos == SDL_replay.size) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_INPUT, "Finished replaying events");
+            SDL_StopReplay();
+            return;
+        }
+        if (!SDL_ReadVarint(&pos, &delta) || !SDL_ReadVarint(&pos, &type) ||
+            !SDL_ReadVarint(&pos, &length) ||
+            (type != EVENTLOG_PUMP && length > SDL_replay.size - pos)) {
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Event log is truncated or corrupt");
+            SDL_StopReplay();
+            return;
+        }
+
+        if (type == EVENTLOG_PUMP) {
+            SDL_replay.pos = pos;
+            if (SDL_replay.speed <= 0.0f && length > 0) {
+                /* This pump ends here, skip the ones after it that had no events */
+                SDL_replay.pumps = length - 1;
+                return;
+            }
+            continue;
+        }
+
+        if (SDL_replay.speed > 0.0f && SDL_replay.time + delta > elapsed) {
+            return;  /* not time for this one yet */
+        }
+        SDL_replay.time += delta;
+        SDL_replay.pos = pos + (size_t) length;
+        SDL_ReplayEvent((Uint32) type, &SDL_replay.data[pos], (size_t) length);
+    }
+}
+
+static void SDLCALL
+SDL_EventReplayChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    Uint8 header[EVENTLOG_HEADER_SIZE];
+    const char *speed;
+    size_t size = 0;
+    Uint8 *data;
+
+    SDL_StopReplay();
+    if (!hint || !*hint) {
+        return;
+    }
+
+    data = (Uint8 *) SDL_LoadFile(hint, &size);
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't replay events from %s: %s", hint, SDL_GetError());
+        return;
+    }
+
+    SDL_GetEventLogHeader(header);
+    if (size < sizeof (header) || SDL_memcmp(data, header, sizeof (header)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Couldn't replay events from %s: not an event log for this platform", hint);
+        SDL_free(data);
+        return;
+    }
+
+    speed = SDL_GetHint(SDL_HINT_EVENT_REPLAY_SPEED);
+    SDL_replay.data = data;
+    SDL_replay.size = size;
+    SDL_replay.pos = sizeof (header);
+    SDL_replay.speed = (speed && *speed) ? (float) SDL_atof(speed) : 1.0f;
+}
+
+
+void
+SDL_EventRecordInit(void)
+{
+#if !SDL_THREADS_DISABLED
+    if (!SDL_record_lock) {
+        SDL_record_lock = SDL_CreateMutex();
+    }
+    if (!SDL_record_write_lock) {
+        SDL_record_write_lock = SDL_CreateMutex();
+    }
+#endif
+    SDL_AddHintCallback(SDL_HINT_EVENT_RECORD, SDL_EventRecordChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_REPLAY, SDL_EventReplayChanged, NULL);
+}
+
+void
+SDL_EventRecordQuit(void)
+{
+    SDL_DelHintCallback(SDL_HINT_EVENT_RECORD, SDL_EventRecordChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_REPLAY, SDL_EventReplayChanged, NULL);
+
+    SDL_StopReplay();
+
+    SDL_FlushRecording(SDL_TRUE);
+    SDL_free(SDL_record_buffer);
+    SDL_record_buffer = NULL;
+    SDL_record_size = 0;
+
+    if (SDL_record_lock) {
+        SDL_DestroyMutex(SDL_record_lock);
+        SDL_record_lock = NULL;
+    }
+    if (SDL_record_write_lock) {
+        SDL_DestroyMutex(SDL_record_write_lock);
+        SDL_record_write_lock = NULL;
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
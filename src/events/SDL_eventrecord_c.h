@@ -18,15 +18,22 @@
      misrepresented as being the original software.
   3. This notice may not be removed or altered from any source distribution.
 */
+#include "../SDL_internal.h"
 
-#ifndef SDL_rotate_h_
-#define SDL_rotate_h_
+#ifndef SDL_eventrecord_c_h_
+#define SDL_eventrecord_c_h_
 
-#ifndef MIN
-#define MIN(a,b)    (((a) < (b)) ? (a) : (b))
-#endif
+extern void SDL_EventRecordInit(void);
+extern void SDL_EventRecordQuit(void);
 
-extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery, int smooth, int flipx, int flipy, int dstwidth, int dstheight, double cangle, double sangle);
-extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, int *dstwidth, int *dstheight, double *cangle, double *sangle);
+/* Called with the event queue locked, for every event added to it.
+   This only buffers the event, the log is written by SDL_RecordPump(). */
+extern void SDL_RecordEvent(const SDL_Event *event);
 
-#endif /* SDL_rotate_h_ */
+/* Called at the end of SDL_PumpEvents(), with the event queue unlocked */
+extern void SDL_ReplayEvents(void);
+extern void SDL_RecordPump(void);
+
+#endif /* SDL_eventrecord_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -26,11 +26,13 @@
 #include "SDL_events.h"
 #include "SDL_thread.h"
 #include "SDL_events_c.h"
+#include "SDL_eventrecord_c.h"
 #include "../timer/SDL_timer_c.h"
 #if !SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
 #endif
 #include "../video/SDL_sysvideo.h"
+#include "../video/SDL_pixels_c.h"
 #include "SDL_syswm.h"
 
 /* An arbitrary limit so we don't have unbounded growth */
@@ -477,6 +479,7 @@ SDL_AddEvent(SDL_Event * event)
     if (SDL_DoEventLogging) {
         SDL_LogEvent(event);
     }
+    SDL_RecordEvent(event);
 
     entry->event = *event;
     if (event->type == SDL_SYSWMEVENT) {
@@ -690,6 +693,9 @@ SDL_PumpEvents(void)
 #endif
 
     SDL_SendPendingSignalEvents();  /* in case we had a signal handler fire, etc. */
+
+    SDL_ReplayEvents();
+    SDL_RecordPump();
 }
 
 /* Public functions */
@@ -966,6 +972,11 @@ SDL_SendAppEvent(SDL_EventType eventType)
 {
     int posted;
 
+    if (eventType == SDL_APP_LOWMEMORY) {
+        /* Give back the memory SDL holds on to just for speed */
+        SDL_TrimSurfacePool();
+    }
+
     posted = 0;
     if (SDL_GetEventState(eventType) == SDL_ENABLE) {
         SDL_Event event;
@@ -1008,6 +1019,7 @@ SDL_EventsInit(void)
     }
 
     SDL_QuitInit();
+    SDL_EventRecordInit();
 
     return 0;
 }
@@ -1015,6 +1027,7 @@ SDL_EventsInit(void)
 void
 SDL_EventsQuit(void)
 {
+    SDL_EventRecordQuit();
     SDL_QuitQuit();
     SDL_StopEventLoop();
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
@@ -29,6 +29,7 @@
 #include "SDL_sysjoystick.h"
 #include "SDL_joystick_c.h"
 #include "SDL_gamecontrollerdb.h"
+#include "../SDL_initprofile_c.h"
 
 #if !SDL_EVENTS_DISABLED
 #include "../events/SDL_events_c.h"
@@ -104,6 +105,7 @@ static ControllerMapping_t *s_pSupportedControllers = NULL;
 static ControllerMapping_t *s_pDefaultMapping = NULL;
 static ControllerMapping_t *s_pHIDAPIMapping = NULL;
 static ControllerMapping_t *s_pXInputMapping = NULL;
+static SDL_InitTask s_mappingsTask;  /* loads the database, see SDL_HINT_LAZY_INIT */
 
 /* The SDL game controller structure */
 struct _SDL_GameController
@@ -424,7 +426,11 @@ static int SDLCALL SDL_GameControllerEventWatcher(void *userdata, SDL_Event * ev
  */
 static ControllerMapping_t *SDL_PrivateGetControllerMappingForGUID(SDL_JoystickGUID *guid, SDL_bool exact_match)
 {
-    ControllerMapping_t *pSupportedController = s_pSupportedControllers;
+    ControllerMapping_t *pSupportedController;
+
+    SDL_FinishInitTask(&s_mappingsTask);
+
+    pSupportedController = s_pSupportedControllers;
     while (pSupportedController) {
         if (SDL_memcmp(guid, &pSupportedController->guid, sizeof(*guid)) == 0) {
             return pSupportedController;
@@ -1213,6 +1219,8 @@ SDL_GameControllerNumMappings(void)
     int num_mappings = 0;
     ControllerMapping_t *mapping;
 
+    SDL_FinishInitTask(&s_mappingsTask);
+
     for (mapping = s_pSupportedControllers; mapping; mapping = mapping->next) {
         if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
             continue;
@@ -1230,6 +1238,8 @@ SDL_GameControllerMappingForIndex(int mapping_index)
 {
     ControllerMapping_t *mapping;
 
+    SDL_FinishInitTask(&s_mappingsTask);
+
     for (mapping = s_pSupportedControllers; mapping; mapping = mapping->next) {
         if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
             continue;
@@ -1341,10 +1351,10 @@ static SDL_bool SDL_GetControllerMappingFilePath(char *path, size_t size)
 }
 
 /*
- * Initialize the game controller system, mostly load our DB of controller config mappings
+ * Load our DB of controller config mappings
  */
-int
-SDL_GameControllerInitMappings(void)
+static void
+SDL_GameControllerLoadMappings(void)
 {
     char szControllerMapPath[1024];
     int i = 0;
@@ -1363,6 +1373,16 @@ SDL_GameControllerInitMappings(void)
 
     /* load in any user supplied config */
     SDL_GameControllerLoadHints();
+}
+
+/*
+ * Initialize the game controller system, mostly load our DB of controller config mappings
+ */
+int
+SDL_GameControllerInitMappings(void)
+{
+    /* This only builds the mapping list, so it can be done on another thread */
+    SDL_StartInitTask(&s_mappingsTask, SDL_INIT_JOYSTICK, "joystick/mappings", SDL_GameControllerLoadMappings, SDL_TRUE);
 
     SDL_AddHintCallback(SDL_HINT_GAMECONTROLLER_IGNORE_DEVICES,
                         SDL_GameControllerIgnoreDevicesChanged, NULL);
@@ -1983,6 +2003,8 @@ SDL_GameControllerQuitMappings(void)
 {
     ControllerMapping_t *pControllerMap;
 
+    SDL_CancelInitTask(&s_mappingsTask);
+
     while (s_pSupportedControllers) {
         pControllerMap = s_pSupportedControllers;
         s_pSupportedControllers = s_pSupportedControllers->next;
@@ -34,6 +34,7 @@
 #include "SDL_hidapijoystick_c.h"
 #include "SDL_hidapi_rumble.h"
 #include "../../SDL_hints_c.h"
+#include "../../SDL_initprofile_c.h"
 
 #if defined(__WIN32__)
 #include "../../core/windows/SDL_windows.h"
@@ -574,8 +575,15 @@ HIDAPI_JoystickInit(void)
     SDL_AddHintCallback(SDL_HINT_JOYSTICK_HIDAPI,
                         SDL_HIDAPIDriverHintChanged, NULL);
     HIDAPI_InitializeDiscovery();
-    HIDAPI_JoystickDetect();
-    HIDAPI_UpdateDevices();
+
+    /* Enumerating HID devices is slow, when initialization is lazy the
+       first joystick update picks them up and sends added events instead */
+    if (!SDL_GetHintBoolean(SDL_HINT_LAZY_INIT, SDL_FALSE)) {
+        const int step = SDL_BeginInitStep(SDL_INIT_JOYSTICK, "joystick/hidapi devices");
+        HIDAPI_JoystickDetect();
+        HIDAPI_UpdateDevices();
+        SDL_EndInitStep(step);
+    }
 
     initialized = SDL_TRUE;
 
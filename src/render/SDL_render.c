@@ -27,7 +27,9 @@
 #include "SDL_log.h"
 #include "SDL_render.h"
 #include "SDL_sysrender.h"
+#include "SDL_rendercapture_c.h"
 #include "software/SDL_render_sw_c.h"
+#include "../video/SDL_rect_c.h"
 
 #if defined(__ANDROID__)
 #  include "../core/android/SDL_android.h"
@@ -113,6 +115,8 @@ static const SDL_RenderDriver *render_drivers[] = {
 
 static char renderer_magic;
 static char texture_magic;
+static SDL_Renderer *renderers;     /* every renderer that exists, for SDL_GetRendererFromID() */
+static Uint32 renderer_next_id = 1;
 
 static SDL_INLINE void
 DebugLogRenderCommands(const SDL_RenderCommand *cmd)
@@ -199,6 +203,15 @@ DebugLogRenderCommands(const SDL_RenderCommand *cmd)
                         (int) cmd->data.draw.b, (int) cmd->data.draw.a,
                         (int) cmd->data.draw.blend, cmd->data.draw.texture);
                 break;
+
+            case SDL_RENDERCMD_GEOMETRY:
+                SDL_Log(" %u. geometry (first=%u, count=%u, r=%d, g=%d, b=%d, a=%d, blend=%d, tex=%p)", i++,
+                        (unsigned int) cmd->data.draw.first,
+                        (unsigned int) cmd->data.draw.count,
+                        (int) cmd->data.draw.r, (int) cmd->data.draw.g,
+                        (int) cmd->data.draw.b, (int) cmd->data.draw.a,
+                        (int) cmd->data.draw.blend, cmd->data.draw.texture);
+                break;
         }
         cmd = cmd->next;
     }
@@ -339,6 +352,9 @@ QueueCmdSetViewport(SDL_Renderer *renderer)
             } else {
                 SDL_memcpy(&renderer->last_queued_viewport, &renderer->viewport, sizeof (SDL_Rect));
                 renderer->viewport_queued = SDL_TRUE;
+                if (renderer->capture) {
+                    SDL_RenderCaptureViewport(renderer);
+                }
             }
         }
     }
@@ -362,6 +378,9 @@ QueueCmdSetClipRect(SDL_Renderer *renderer)
             SDL_memcpy(&renderer->last_queued_cliprect, &renderer->clip_rect, sizeof (SDL_Rect));
             renderer->last_queued_cliprect_enabled = renderer->clipping_enabled;
             renderer->cliprect_queued = SDL_TRUE;
+            if (renderer->capture) {
+                SDL_RenderCaptureClipRect(renderer);
+            }
         }
     }
     return retval;
@@ -410,6 +429,9 @@ QueueCmdClear(SDL_Renderer *renderer)
     cmd->data.color.g = renderer->g;
     cmd->data.color.b = renderer->b;
     cmd->data.color.a = renderer->a;
+    if (renderer->capture) {
+        SDL_RenderCaptureClear(renderer);
+    }
     return 0;
 }
 
@@ -460,6 +482,8 @@ QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint * points, const int
         retval = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCapturePoints(renderer, SDL_RENDERCMD_DRAW_POINTS, points, count);
         }
     }
     return retval;
@@ -474,6 +498,8 @@ QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint * points, const int c
         retval = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCapturePoints(renderer, SDL_RENDERCMD_DRAW_LINES, points, count);
         }
     }
     return retval;
@@ -488,6 +514,8 @@ QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect * rects, const int cou
         retval = renderer->QueueFillRects(renderer, cmd, rects, count);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCaptureRects(renderer, rects, count);
         }
     }
     return retval;
@@ -524,6 +552,8 @@ QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture * texture, const SDL_Rect * src
         retval = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCaptureCopy(renderer, texture, srcrect, dstrect);
         }
     }
     return retval;
@@ -541,11 +571,39 @@ QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture * texture,
         retval = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCaptureCopyEx(renderer, texture, srcquad, dstrect, angle, center, flip);
         }
     }
     return retval;
 }
 
+static int
+QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                 const SDL_Vertex *vertices, int num_vertices,
+                 const int *indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    SDL_RenderCommand *cmd;
+    int retval = -1;
+    if (texture) {
+        cmd = PrepQueueCmdDrawTexture(renderer, texture, SDL_RENDERCMD_GEOMETRY);
+    } else {
+        cmd = PrepQueueCmdDrawSolid(renderer, SDL_RENDERCMD_GEOMETRY);
+    }
+    SDL_assert(renderer->QueueGeometry != NULL);  /* should have caught at higher level. */
+    if (cmd != NULL) {
+        retval = renderer->QueueGeometry(renderer, cmd, texture, vertices, num_vertices,
+                                         indices, num_indices, scale_x, scale_y);
+        if (retval < 0) {
+            cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->capture) {
+            SDL_RenderCaptureGeometry(renderer, texture, vertices, num_vertices,
+                                      indices, num_indices, scale_x, scale_y);
+        }
+    }
+    return retval;
+}
 
 static int UpdateLogicalSize(SDL_Renderer *renderer);
 
@@ -853,6 +911,9 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
 
     renderer->batching = batching;
     renderer->magic = &renderer_magic;
+    renderer->id = renderer_next_id++;
+    renderer->next = renderers;
+    renderers = renderer;
     renderer->window = window;
     renderer->target_mutex = SDL_CreateMutex();
     renderer->scale.x = 1.0f;
@@ -917,6 +978,9 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
     if (renderer) {
         VerifyDrawQueueFunctions(renderer);
         renderer->magic = &renderer_magic;
+        renderer->id = renderer_next_id++;
+        renderer->next = renderers;
+        renderers = renderer;
         renderer->target_mutex = SDL_CreateMutex();
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
@@ -948,6 +1012,27 @@ SDL_GetRendererInfo(SDL_Renderer * renderer, SDL_RendererInfo * info)
     return 0;
 }
 
+Uint32
+SDL_GetRendererID(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, 0);
+
+    return renderer->id;
+}
+
+SDL_Renderer *
+SDL_GetRendererFromID(Uint32 id)
+{
+    SDL_Renderer *renderer;
+
+    for (renderer = renderers; renderer; renderer = renderer->next) {
+        if (renderer->id == id) {
+            return renderer;
+        }
+    }
+    return NULL;
+}
+
 int
 SDL_GetRendererOutputSize(SDL_Renderer * renderer, int *w, int *h)
 {
@@ -1530,6 +1615,10 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_InvalidParamError("pitch");
     }
 
+    if (texture->renderer->capture) {
+        SDL_RenderCaptureTextureChanged(texture);
+    }
+
     if (!rect) {
         full_rect.x = 0;
         full_rect.y = 0;
@@ -1644,6 +1733,10 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_SetError("Texture format must by YV12 or IYUV");
     }
 
+    if (texture->renderer->capture) {
+        SDL_RenderCaptureTextureChanged(texture);
+    }
+
     if (!rect) {
         full_rect.x = 0;
         full_rect.y = 0;
@@ -1825,6 +1918,9 @@ SDL_UnlockTexture(SDL_Texture * texture)
     if (texture->access != SDL_TEXTUREACCESS_STREAMING) {
         return;
     }
+    if (texture->renderer->capture) {
+        SDL_RenderCaptureTextureChanged(texture);
+    }
 #if SDL_HAVE_YUV
     if (texture->yuv) {
         SDL_UnlockTextureYUV(texture);
@@ -1878,6 +1974,10 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         }
     }
 
+    if (renderer->capture) {
+        SDL_RenderCaptureTarget(renderer, texture);
+    }
+
     SDL_LockMutex(renderer->target_mutex);
 
     if (texture && !renderer->target) {
@@ -2312,7 +2412,6 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
                      const SDL_Point * points, int count)
 {
     SDL_FPoint *fpoints;
-    int i;
     int retval;
     SDL_bool isstack;
 
@@ -2338,10 +2437,7 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
     if (!fpoints) {
         return SDL_OutOfMemory();
     }
-    for (i = 0; i < count; ++i) {
-        fpoints[i].x = points[i].x * renderer->scale.x;
-        fpoints[i].y = points[i].y * renderer->scale.y;
-    }
+    SDL_ScalePointsToFPoints(points, count, renderer->scale.x, renderer->scale.y, fpoints);
 
     retval = QueueCmdDrawPoints(renderer, fpoints, count);
 
@@ -2557,7 +2653,6 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
                     const SDL_Point * points, int count)
 {
     SDL_FPoint *fpoints;
-    int i;
     int retval;
     SDL_bool isstack;
 
@@ -2583,10 +2678,7 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
     if (!fpoints) {
         return SDL_OutOfMemory();
     }
-    for (i = 0; i < count; ++i) {
-        fpoints[i].x = points[i].x * renderer->scale.x;
-        fpoints[i].y = points[i].y * renderer->scale.y;
-    }
+    SDL_ScalePointsToFPoints(points, count, renderer->scale.x, renderer->scale.y, fpoints);
 
     retval = QueueCmdDrawLines(renderer, fpoints, count);
 
@@ -2794,7 +2886,6 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
                     const SDL_Rect * rects, int count)
 {
     SDL_FRect *frects;
-    int i;
     int retval;
     SDL_bool isstack;
 
@@ -2816,12 +2907,7 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
     if (!frects) {
         return SDL_OutOfMemory();
     }
-    for (i = 0; i < count; ++i) {
-        frects[i].x = rects[i].x * renderer->scale.x;
-        frects[i].y = rects[i].y * renderer->scale.y;
-        frects[i].w = rects[i].w * renderer->scale.x;
-        frects[i].h = rects[i].h * renderer->scale.y;
-    }
+    SDL_ScaleRectsToFRects(rects, count, renderer->scale.x, renderer->scale.y, frects);
 
     retval = QueueCmdFillRects(renderer, frects, count);
 
@@ -3104,6 +3190,67 @@ SDL_RenderCopyExF(SDL_Renderer * renderer, SDL_Texture * texture,
     return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
 }
 
+int
+SDL_RenderGeometry(SDL_Renderer *renderer,
+                   SDL_Texture *texture,
+                   const SDL_Vertex *vertices, int num_vertices,
+                   const int *indices, int num_indices)
+{
+    int i;
+    int retval;
+    int count = indices ? num_indices : num_vertices;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!renderer->QueueGeometry) {
+        return SDL_Unsupported();
+    }
+
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, -1);
+
+        if (renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+
+    if (count % 3) {
+        return SDL_InvalidParamError(indices ? "num_indices" : "num_vertices");
+    }
+
+    if (indices) {
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Values of 'indices' out of bounds");
+            }
+        }
+    }
+
+    /* Don't draw while we're hidden */
+    if (renderer->hidden) {
+        return 0;
+    }
+
+    if (num_vertices < 3 || count < 3) {
+        return 0;
+    }
+
+    if (texture) {
+        if (texture->native) {
+            texture = texture->native;
+        }
+        texture->last_command_generation = renderer->render_command_generation;
+    }
+
+    retval = QueueCmdGeometry(renderer, texture, vertices, num_vertices, indices, num_indices,
+                              renderer->scale.x, renderer->scale.y);
+    return retval < 0 ? retval : FlushRenderCommandsIfNotBatching(renderer);
+}
+
 int
 SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                      Uint32 format, void * pixels, int pitch)
@@ -3150,6 +3297,10 @@ SDL_RenderPresent(SDL_Renderer * renderer)
 
     FlushRenderCommands(renderer);  /* time to send everything to the GPU! */
 
+    if (renderer->capture) {
+        SDL_RenderCapturePresent(renderer);
+    }
+
     /* Don't present while we're hidden */
     if (renderer->hidden) {
         return;
@@ -3171,6 +3322,10 @@ SDL_DestroyTexture(SDL_Texture * texture)
         FlushRenderCommandsIfTextureNeeded(texture);
     }
 
+    if (renderer->capture) {
+        SDL_RenderCaptureTextureDestroyed(texture);
+    }
+
     texture->magic = NULL;
 
     if (texture->next) {
@@ -3204,11 +3359,16 @@ void
 SDL_DestroyRenderer(SDL_Renderer * renderer)
 {
     SDL_RenderCommand *cmd;
+    SDL_Renderer **prev;
 
     CHECK_RENDERER_MAGIC(renderer, );
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    if (renderer->capture) {
+        SDL_RenderStopCapture(renderer);
+    }
+
     if (renderer->render_commands_tail != NULL) {
         renderer->render_commands_tail->next = renderer->render_commands_pool;
         cmd = renderer->render_commands;
@@ -3242,6 +3402,13 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
     /* It's no longer magical... */
     renderer->magic = NULL;
 
+    for (prev = &renderers; *prev; prev = &(*prev)->next) {
+        if (*prev == renderer) {
+            *prev = renderer->next;
+            break;
+        }
+    }
+
     /* Free the target mutex */
     SDL_DestroyMutex(renderer->target_mutex);
     renderer->target_mutex = NULL;
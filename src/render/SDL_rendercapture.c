@@ -0,0 +1,1067 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Capture of render commands to a file, and replay of such a file.
+
+   The capture holds the backend-neutral input of the command queue rather
+   than the vertex buffers the backend built from it, so that it can be
+   replayed on any renderer. A capture starts with the magic "SDLRCAPT" and
+   a 32-bit version, followed by operations that each start with a byte
+   from the CAPTURE_OP_* list. All values are little endian. Textures are
+   written as ARGB8888 the first time a command uses them and again after
+   they were updated, so the replay doesn't depend on anything that
+   happened before the capture started.
+ */
+
+#include "SDL_render.h"
+#include "SDL_rwops.h"
+#include "SDL_timer.h"
+#include "SDL_sysrender.h"
+#include "SDL_rendercapture_c.h"
+
+#define CAPTURE_MAGIC   "SDLRCAPT"
+#define CAPTURE_VERSION 1
+
+enum
+{
+    CAPTURE_OP_TEXTURE = 1,     /* id, target, scale mode, w, h, has pixels, pixels */
+    CAPTURE_OP_TARGET,          /* texture id, or 0 for the default target */
+    CAPTURE_OP_VIEWPORT,        /* x, y, w, h */
+    CAPTURE_OP_CLIPRECT,        /* enabled, x, y, w, h */
+    CAPTURE_OP_CLEAR,           /* r, g, b, a */
+    CAPTURE_OP_POINTS,          /* r, g, b, a, blend, count, points */
+    CAPTURE_OP_LINES,           /* r, g, b, a, blend, count, points */
+    CAPTURE_OP_FILL_RECTS,      /* r, g, b, a, blend, count, rects */
+    CAPTURE_OP_COPY,            /* id, r, g, b, a, blend, srcrect, dstrect */
+    CAPTURE_OP_COPY_EX,         /* as CAPTURE_OP_COPY, then angle, center, flip */
+    CAPTURE_OP_GEOMETRY,        /* id, r, g, b, a, blend, vertex count, vertices, index count, indices */
+    CAPTURE_OP_PRESENT,
+    CAPTURE_OP_COUNT
+};
+
+static const char *capture_op_names[CAPTURE_OP_COUNT] = {
+    NULL, "texture", "target", "viewport", "cliprect", "clear", "points",
+    "lines", "fill_rects", "copy", "copy_ex", "geometry", "present"
+};
+
+typedef struct
+{
+    SDL_Texture *texture;
+    Uint32 id;
+    SDL_bool dirty;
+} SDL_RenderCaptureTexture;
+
+typedef struct SDL_RenderCapture
+{
+    SDL_RWops *dst;
+    int frames;             /* frames left to capture, or 0 if there is no limit */
+    SDL_bool busy;          /* set while reading back texture contents */
+    SDL_bool failed;
+
+    /* Operations are collected here and written out once per frame */
+    Uint8 *data;
+    size_t size;
+    size_t allocated;
+
+    SDL_RenderCaptureTexture *textures;
+    int num_textures;
+    int max_textures;
+    Uint32 last_texture_id;
+} SDL_RenderCapture;
+
+
+static void
+PutData(SDL_RenderCapture *capture, const void *data, size_t size)
+{
+    if (capture->failed) {
+        return;
+    }
+    if (size > capture->allocated - capture->size) {
+        size_t allocated = capture->allocated ? capture->allocated : 4096;
+        Uint8 *buffer;
+
+        while (size > allocated - capture->size) {
+            allocated *= 2;
+        }
+        buffer = (Uint8 *) SDL_realloc(capture->data, allocated);
+        if (!buffer) {
+            capture->failed = SDL_TRUE;
+            return;
+        }
+        capture->data = buffer;
+        capture->allocated = allocated;
+    }
+    SDL_memcpy(capture->data + capture->size, data, size);
+    capture->size += size;
+}
+
+static void
+Put8(SDL_RenderCapture *capture, Uint8 value)
+{
+    PutData(capture, &value, sizeof (value));
+}
+
+static void
+Put32(SDL_RenderCapture *capture, Uint32 value)
+{
+    value = SDL_SwapLE32(value);
+    PutData(capture, &value, sizeof (value));
+}
+
+static void
+PutFloat(SDL_RenderCapture *capture, float value)
+{
+    union { float f; Uint32 u; } cvt;
+    cvt.f = value;
+    Put32(capture, cvt.u);
+}
+
+static void
+PutRect(SDL_RenderCapture *capture, const SDL_Rect *rect)
+{
+    Put32(capture, (Uint32) rect->x);
+    Put32(capture, (Uint32) rect->y);
+    Put32(capture, (Uint32) rect->w);
+    Put32(capture, (Uint32) rect->h);
+}
+
+static void
+PutColor(SDL_RenderCapture *capture, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    Put8(capture, r);
+    Put8(capture, g);
+    Put8(capture, b);
+    Put8(capture, a);
+}
+
+static void
+FlushCapture(SDL_RenderCapture *capture)
+{
+    if (capture->size > 0 && !capture->failed) {
+        if (SDL_RWwrite(capture->dst, capture->data, capture->size, 1) != 1) {
+            capture->failed = SDL_TRUE;
+        }
+    }
+    capture->size = 0;
+}
+
+/* Reads back the texture contents as ARGB8888, by making it the render
+   target or copying it to a temporary one. All renderer state the
+   application can see is restored afterwards. */
+static int
+ReadTexturePixels(SDL_Renderer *renderer, SDL_Texture *texture, void *pixels, int pitch)
+{
+    SDL_Texture *target = renderer->target;
+    SDL_Rect viewport = renderer->viewport;
+    SDL_Rect viewport_backup = renderer->viewport_backup;
+    SDL_Rect clip_rect = renderer->clip_rect;
+    SDL_Rect clip_rect_backup = renderer->clip_rect_backup;
+    SDL_bool clipping_enabled = renderer->clipping_enabled;
+    SDL_bool clipping_enabled_backup = renderer->clipping_enabled_backup;
+    SDL_FPoint scale = renderer->scale;
+    SDL_FPoint scale_backup = renderer->scale_backup;
+    int logical_w = renderer->logical_w;
+    int logical_h = renderer->logical_h;
+    int logical_w_backup = renderer->logical_w_backup;
+    int logical_h_backup = renderer->logical_h_backup;
+    SDL_Texture *copy = NULL;
+    int retval;
+
+    if (texture->access == SDL_TEXTUREACCESS_TARGET) {
+        retval = SDL_SetRenderTarget(renderer, texture);
+    } else if (renderer->hidden) {
+        /* Nothing can be drawn while we're hidden */
+        retval = -1;
+    } else {
+        copy = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, texture->w, texture->h);
+        retval = copy ? SDL_SetRenderTarget(renderer, copy) : -1;
+        if (retval == 0) {
+            Uint8 r = texture->r, g = texture->g, b = texture->b, a = texture->a;
+            SDL_BlendMode blendMode = texture->blendMode;
+
+            texture->r = texture->g = texture->b = texture->a = 255;
+            texture->blendMode = SDL_BLENDMODE_NONE;
+            retval = SDL_RenderCopy(renderer, texture, NULL, NULL);
+            if (retval == 0) {
+                retval = SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, pitch);
+            }
+            texture->r = r;
+            texture->g = g;
+            texture->b = b;
+            texture->a = a;
+            texture->blendMode = blendMode;
+        }
+    }
+    if (retval == 0 && !copy) {
+        retval = SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, pitch);
+    }
+
+    SDL_SetRenderTarget(renderer, target);
+    renderer->viewport = viewport;
+    renderer->viewport_backup = viewport_backup;
+    renderer->clip_rect = clip_rect;
+    renderer->clip_rect_backup = clip_rect_backup;
+    renderer->clipping_enabled = clipping_enabled;
+    renderer->clipping_enabled_backup = clipping_enabled_backup;
+    renderer->scale = scale;
+    renderer->scale_backup = scale_backup;
+    renderer->logical_w = logical_w;
+    renderer->logical_h = logical_h;
+    renderer->logical_w_backup = logical_w_backup;
+    renderer->logical_h_backup = logical_h_backup;
+    renderer->viewport_queued = SDL_FALSE;
+    renderer->cliprect_queued = SDL_FALSE;
+
+    if (copy) {
+        SDL_DestroyTexture(copy);
+    }
+    return retval;
+}
+
+static void
+WriteTexture(SDL_Renderer *renderer, Uint32 id, SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const int pitch = texture->w * 4;
+    void *pixels = NULL;
+
+    if (SDL_RenderTargetSupported(renderer) && renderer->RenderReadPixels) {
+        pixels = SDL_malloc((size_t) pitch * texture->h);
+        if (pixels) {
+            capture->busy = SDL_TRUE;
+            if (ReadTexturePixels(renderer, texture, pixels, pitch) < 0) {
+                SDL_free(pixels);
+                pixels = NULL;
+            }
+            capture->busy = SDL_FALSE;
+        }
+    }
+
+    Put8(capture, CAPTURE_OP_TEXTURE);
+    Put32(capture, id);
+    Put8(capture, (texture->access == SDL_TEXTUREACCESS_TARGET) ? 1 : 0);
+    Put8(capture, (Uint8) texture->scaleMode);
+    Put32(capture, (Uint32) texture->w);
+    Put32(capture, (Uint32) texture->h);
+    Put8(capture, pixels ? 1 : 0);
+    if (pixels) {
+        PutData(capture, pixels, (size_t) pitch * texture->h);
+        SDL_free(pixels);
+    }
+}
+
+static SDL_RenderCaptureTexture *
+FindTexture(SDL_RenderCapture *capture, SDL_Texture *texture)
+{
+    int i;
+
+    for (i = 0; i < capture->num_textures; ++i) {
+        if (capture->textures[i].texture == texture) {
+            return &capture->textures[i];
+        }
+    }
+    return NULL;
+}
+
+/* Returns the id of the texture in the capture, writing its contents if
+   they weren't written yet or changed since then. */
+static Uint32
+ReferenceTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    SDL_RenderCaptureTexture *entry = FindTexture(capture, texture);
+
+    if (!entry) {
+        if (capture->num_textures == capture->max_textures) {
+            int max_textures = capture->max_textures ? capture->max_textures * 2 : 16;
+            SDL_RenderCaptureTexture *textures = (SDL_RenderCaptureTexture *) SDL_realloc(capture->textures, max_textures * sizeof (*textures));
+            if (!textures) {
+                capture->failed = SDL_TRUE;
+                return 0;
+            }
+            capture->textures = textures;
+            capture->max_textures = max_textures;
+        }
+        entry = &capture->textures[capture->num_textures++];
+        entry->texture = texture;
+        entry->id = ++capture->last_texture_id;
+        entry->dirty = SDL_TRUE;
+    }
+    if (entry->dirty) {
+        entry->dirty = SDL_FALSE;
+        WriteTexture(renderer, entry->id, texture);
+    }
+    return entry->id;
+}
+
+void
+SDL_RenderCaptureTarget(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint32 id = 0;
+
+    if (capture->busy) {
+        return;
+    }
+    if (texture) {
+        id = ReferenceTexture(renderer, texture);
+    }
+    Put8(capture, CAPTURE_OP_TARGET);
+    Put32(capture, id);
+}
+
+void
+SDL_RenderCaptureViewport(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, CAPTURE_OP_VIEWPORT);
+    PutRect(capture, &renderer->viewport);
+}
+
+void
+SDL_RenderCaptureClipRect(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, CAPTURE_OP_CLIPRECT);
+    Put8(capture, renderer->clipping_enabled ? 1 : 0);
+    PutRect(capture, &renderer->clip_rect);
+}
+
+void
+SDL_RenderCaptureClear(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, CAPTURE_OP_CLEAR);
+    PutColor(capture, renderer->r, renderer->g, renderer->b, renderer->a);
+}
+
+void
+SDL_RenderCapturePoints(SDL_Renderer *renderer, SDL_RenderCommandType cmdtype, const SDL_FPoint *points, int count)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    int i;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, (cmdtype == SDL_RENDERCMD_DRAW_LINES) ? CAPTURE_OP_LINES : CAPTURE_OP_POINTS);
+    PutColor(capture, renderer->r, renderer->g, renderer->b, renderer->a);
+    Put32(capture, (Uint32) renderer->blendMode);
+    Put32(capture, (Uint32) count);
+    for (i = 0; i < count; ++i) {
+        PutFloat(capture, points[i].x);
+        PutFloat(capture, points[i].y);
+    }
+}
+
+void
+SDL_RenderCaptureRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    int i;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, CAPTURE_OP_FILL_RECTS);
+    PutColor(capture, renderer->r, renderer->g, renderer->b, renderer->a);
+    Put32(capture, (Uint32) renderer->blendMode);
+    Put32(capture, (Uint32) count);
+    for (i = 0; i < count; ++i) {
+        PutFloat(capture, rects[i].x);
+        PutFloat(capture, rects[i].y);
+        PutFloat(capture, rects[i].w);
+        PutFloat(capture, rects[i].h);
+    }
+}
+
+static void
+PutTextureCopy(SDL_Renderer *renderer, Uint8 op, SDL_Texture *texture, const SDL_Rect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    const Uint32 id = ReferenceTexture(renderer, texture);
+
+    Put8(capture, op);
+    Put32(capture, id);
+    PutColor(capture, texture->r, texture->g, texture->b, texture->a);
+    Put32(capture, (Uint32) texture->blendMode);
+    PutRect(capture, srcrect);
+    PutFloat(capture, dstrect->x);
+    PutFloat(capture, dstrect->y);
+    PutFloat(capture, dstrect->w);
+    PutFloat(capture, dstrect->h);
+}
+
+void
+SDL_RenderCaptureCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect, const SDL_FRect *dstrect)
+{
+    if (renderer->capture->busy) {
+        return;
+    }
+    PutTextureCopy(renderer, CAPTURE_OP_COPY, texture, srcrect, dstrect);
+}
+
+void
+SDL_RenderCaptureCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
+                        const SDL_Rect *srcrect, const SDL_FRect *dstrect,
+                        double angle, const SDL_FPoint *center, SDL_RendererFlip flip)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    union { double d; Uint64 u; } cvt;
+
+    if (capture->busy) {
+        return;
+    }
+    PutTextureCopy(renderer, CAPTURE_OP_COPY_EX, texture, srcrect, dstrect);
+    cvt.d = angle;
+    cvt.u = SDL_SwapLE64(cvt.u);
+    PutData(capture, &cvt.u, sizeof (cvt.u));
+    PutFloat(capture, center->x);
+    PutFloat(capture, center->y);
+    Put8(capture, (Uint8) flip);
+}
+
+void
+SDL_RenderCaptureGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                          const SDL_Vertex *vertices, int num_vertices,
+                          const int *indices, int num_indices,
+                          float scale_x, float scale_y)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+    Uint32 id;
+    int i;
+
+    if (capture->busy) {
+        return;
+    }
+    /* The texture contents may have to be written before the operation */
+    id = texture ? ReferenceTexture(renderer, texture) : 0;
+    Put8(capture, CAPTURE_OP_GEOMETRY);
+    Put32(capture, id);
+    if (texture) {
+        PutColor(capture, texture->r, texture->g, texture->b, texture->a);
+        Put32(capture, (Uint32) texture->blendMode);
+    } else {
+        PutColor(capture, renderer->r, renderer->g, renderer->b, renderer->a);
+        Put32(capture, (Uint32) renderer->blendMode);
+    }
+    Put32(capture, (Uint32) num_vertices);
+    for (i = 0; i < num_vertices; ++i) {
+        const SDL_Vertex *v = &vertices[i];
+        PutFloat(capture, v->position.x * scale_x);
+        PutFloat(capture, v->position.y * scale_y);
+        PutColor(capture, v->color.r, v->color.g, v->color.b, v->color.a);
+        PutFloat(capture, v->tex_coord.x);
+        PutFloat(capture, v->tex_coord.y);
+    }
+    Put32(capture, (Uint32) (indices ? num_indices : 0));
+    for (i = 0; indices && i < num_indices; ++i) {
+        Put32(capture, (Uint32) indices[i]);
+    }
+}
+
+void
+SDL_RenderCapturePresent(SDL_Renderer *renderer)
+{
+    SDL_RenderCapture *capture = renderer->capture;
+
+    if (capture->busy) {
+        return;
+    }
+    Put8(capture, CAPTURE_OP_PRESENT);
+    FlushCapture(capture);
+
+    if (capture->frames > 0 && --capture->frames == 0) {
+        SDL_RenderStopCapture(renderer);
+    }
+}
+
+void
+SDL_RenderCaptureTextureChanged(SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = texture->renderer->capture;
+    SDL_RenderCaptureTexture *entry;
+
+    entry = FindTexture(capture, texture);
+    if (entry) {
+        entry->dirty = SDL_TRUE;
+    }
+    if (texture->native) {
+        entry = FindTexture(capture, texture->native);
+        if (entry) {
+            entry->dirty = SDL_TRUE;
+        }
+    }
+}
+
+void
+SDL_RenderCaptureTextureDestroyed(SDL_Texture *texture)
+{
+    SDL_RenderCapture *capture = texture->renderer->capture;
+    SDL_RenderCaptureTexture *entry = FindTexture(capture, texture);
+
+    if (entry) {
+        *entry = capture->textures[--capture->num_textures];
+    }
+}
+
+int
+SDL_RenderStartCapture(SDL_Renderer *renderer, const char *file, int frames)
+{
+    SDL_RendererInfo info;
+    SDL_RenderCapture *capture;
+
+    if (SDL_GetRendererInfo(renderer, &info) < 0) {
+        return -1;
+    }
+    if (!file) {
+        return SDL_InvalidParamError("file");
+    }
+    if (renderer->capture) {
+        return SDL_SetError("Renderer is already being captured");
+    }
+
+    capture = (SDL_RenderCapture *) SDL_calloc(1, sizeof (*capture));
+    if (!capture) {
+        return SDL_OutOfMemory();
+    }
+    capture->dst = SDL_RWFromFile(file, "wb");
+    if (!capture->dst) {
+        SDL_free(capture);
+        return -1;
+    }
+    capture->frames = SDL_max(frames, 0);
+
+    /* Finish what was queued before, so it doesn't end up in the capture */
+    SDL_RenderFlush(renderer);
+
+    renderer->capture = capture;
+    PutData(capture, CAPTURE_MAGIC, 8);
+    Put32(capture, CAPTURE_VERSION);
+    SDL_RenderCaptureTarget(renderer, renderer->target);
+    SDL_RenderCaptureViewport(renderer);
+    SDL_RenderCaptureClipRect(renderer);
+    return 0;
+}
+
+int
+SDL_RenderStopCapture(SDL_Renderer *renderer)
+{
+    SDL_RendererInfo info;
+    SDL_RenderCapture *capture;
+    int retval = 0;
+
+    if (SDL_GetRendererInfo(renderer, &info) < 0) {
+        return -1;
+    }
+    capture = renderer->capture;
+    if (!capture) {
+        return SDL_SetError("Renderer is not being captured");
+    }
+
+    FlushCapture(capture);
+    if (SDL_RWclose(capture->dst) < 0 || capture->failed) {
+        retval = SDL_SetError("Couldn't write render capture");
+    }
+    renderer->capture = NULL;
+    SDL_free(capture->textures);
+    SDL_free(capture->data);
+    SDL_free(capture);
+    return retval;
+}
+
+
+typedef struct
+{
+    const Uint8 *data;
+    size_t size;
+    size_t pos;
+    SDL_bool truncated;
+} SDL_RenderReplayReader;
+
+static const Uint8 *
+GetData(SDL_RenderReplayReader *reader, size_t size)
+{
+    const Uint8 *data;
+
+    if (reader->truncated || size > reader->size - reader->pos) {
+        reader->truncated = SDL_TRUE;
+        return NULL;
+    }
+    data = reader->data + reader->pos;
+    reader->pos += size;
+    return data;
+}
+
+static Uint8
+Get8(SDL_RenderReplayReader *reader)
+{
+    const Uint8 *data = GetData(reader, 1);
+    return data ? data[0] : 0;
+}
+
+static Uint32
+Get32(SDL_RenderReplayReader *reader)
+{
+    const Uint8 *data = GetData(reader, 4);
+    if (!data) {
+        return 0;
+    }
+    return ((Uint32) data[0]) | ((Uint32) data[1] << 8) | ((Uint32) data[2] << 16) | ((Uint32) data[3] << 24);
+}
+
+static float
+GetFloat(SDL_RenderReplayReader *reader)
+{
+    union { float f; Uint32 u; } cvt;
+    cvt.u = Get32(reader);
+    return cvt.f;
+}
+
+static void
+GetRect(SDL_RenderReplayReader *reader, SDL_Rect *rect)
+{
+    rect->x = (int) Get32(reader);
+    rect->y = (int) Get32(reader);
+    rect->w = (int) Get32(reader);
+    rect->h = (int) Get32(reader);
+}
+
+static void
+GetFRect(SDL_RenderReplayReader *reader, SDL_FRect *rect)
+{
+    rect->x = GetFloat(reader);
+    rect->y = GetFloat(reader);
+    rect->w = GetFloat(reader);
+    rect->h = GetFloat(reader);
+}
+
+static void
+GetColor(SDL_RenderReplayReader *reader, SDL_Color *color)
+{
+    color->r = Get8(reader);
+    color->g = Get8(reader);
+    color->b = Get8(reader);
+    color->a = Get8(reader);
+}
+
+/* Returns the number of items if they fit in what's left of the capture */
+static int
+GetCount(SDL_RenderReplayReader *reader, size_t item_size)
+{
+    const Uint32 count = Get32(reader);
+
+    if (count > (reader->size - reader->pos) / item_size) {
+        reader->truncated = SDL_TRUE;
+        return 0;
+    }
+    return (int) count;
+}
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_Texture **textures;     /* indexed by capture id */
+    Uint32 num_textures;
+    void *scratch;
+    size_t scratch_size;
+} SDL_RenderReplay;
+
+static void *
+GetScratch(SDL_RenderReplay *replay, size_t size)
+{
+    if (size > replay->scratch_size) {
+        void *scratch = SDL_realloc(replay->scratch, size);
+        if (!scratch) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        replay->scratch = scratch;
+        replay->scratch_size = size;
+    }
+    return replay->scratch;
+}
+
+static SDL_Texture *
+GetReplayTexture(SDL_RenderReplay *replay, SDL_RenderReplayReader *reader, Uint32 id)
+{
+    if (id == 0 || id > replay->num_textures || !replay->textures[id - 1]) {
+        reader->truncated = SDL_TRUE;
+        return NULL;
+    }
+    return replay->textures[id - 1];
+}
+
+static int
+ReplayTexture(SDL_RenderReplay *replay, SDL_RenderReplayReader *reader)
+{
+    SDL_Renderer *renderer = replay->renderer;
+    const Uint32 id = Get32(reader);
+    const SDL_bool target = Get8(reader) ? SDL_TRUE : SDL_FALSE;
+    const SDL_ScaleMode scaleMode = (SDL_ScaleMode) Get8(reader);
+    const int w = (int) Get32(reader);
+    const int h = (int) Get32(reader);
+    const Uint8 *pixels = NULL;
+    SDL_Texture *texture;
+    int tw = 0, th = 0;
+
+    if (Get8(reader)) {
+        pixels = GetData(reader, (size_t) w * h * 4);
+    }
+    if (reader->truncated || w <= 0 || h <= 0 || w > 65535 || h > 65535 || id == 0 || id > replay->num_textures + 1) {
+        reader->truncated = SDL_TRUE;
+        return -1;
+    }
+
+    if (id > replay->num_textures) {
+        SDL_Texture **textures = (SDL_Texture **) SDL_realloc(replay->textures, id * sizeof (*textures));
+        if (!textures) {
+            return SDL_OutOfMemory();
+        }
+        textures[id - 1] = NULL;
+        replay->textures = textures;
+        replay->num_textures = id;
+    }
+
+    texture = replay->textures[id - 1];
+    if (texture) {
+        SDL_QueryTexture(texture, NULL, NULL, &tw, &th);
+    }
+    if (!texture || tw != w || th != h) {
+        int access = SDL_TEXTUREACCESS_STATIC;
+
+        if (target && SDL_RenderTargetSupported(renderer)) {
+            access = SDL_TEXTUREACCESS_TARGET;
+        }
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, access, w, h);
+        replay->textures[id - 1] = texture;
+        if (!texture) {
+            return -1;
+        }
+    }
+    SDL_SetTextureScaleMode(texture, scaleMode);
+    if (pixels) {
+        return SDL_UpdateTexture(texture, NULL, pixels, w * 4);
+    }
+    return 0;
+}
+
+static void
+SetTextureState(SDL_Texture *texture, const SDL_Color *color, SDL_BlendMode blendMode)
+{
+    SDL_SetTextureColorMod(texture, color->r, color->g, color->b);
+    SDL_SetTextureAlphaMod(texture, color->a);
+    SDL_SetTextureBlendMode(texture, blendMode);
+}
+
+static void
+SetDrawState(SDL_Renderer *renderer, const SDL_Color *color, SDL_BlendMode blendMode)
+{
+    SDL_SetRenderDrawColor(renderer, color->r, color->g, color->b, color->a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+}
+
+/* Replays one operation, returning the number of items it drew */
+static int
+ReplayOp(SDL_RenderReplay *replay, SDL_RenderReplayReader *reader, Uint8 op)
+{
+    SDL_Renderer *renderer = replay->renderer;
+    SDL_Texture *texture;
+    SDL_Color color;
+    SDL_BlendMode blendMode;
+    SDL_Rect rect;
+    SDL_FRect frect;
+    int i, count;
+
+    switch (op) {
+    case CAPTURE_OP_TEXTURE:
+        if (ReplayTexture(replay, reader) < 0) {
+            return -1;
+        }
+        return 1;
+
+    case CAPTURE_OP_TARGET:
+        i = (int) Get32(reader);
+        if (i == 0) {
+            SDL_SetRenderTarget(renderer, NULL);
+        } else {
+            texture = GetReplayTexture(replay, reader, (Uint32) i);
+            if (texture) {
+                SDL_SetRenderTarget(renderer, texture);
+            }
+        }
+        return 1;
+
+    case CAPTURE_OP_VIEWPORT:
+        GetRect(reader, &rect);
+        SDL_RenderSetViewport(renderer, &rect);
+        return 1;
+
+    case CAPTURE_OP_CLIPRECT:
+        i = Get8(reader);
+        GetRect(reader, &rect);
+        SDL_RenderSetClipRect(renderer, i ? &rect : NULL);
+        return 1;
+
+    case CAPTURE_OP_CLEAR:
+        GetColor(reader, &color);
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderClear(renderer);
+        return 1;
+
+    case CAPTURE_OP_POINTS:
+    case CAPTURE_OP_LINES:
+    {
+        SDL_FPoint *points;
+
+        GetColor(reader, &color);
+        blendMode = (SDL_BlendMode) Get32(reader);
+        count = GetCount(reader, 2 * sizeof (float));
+        points = (SDL_FPoint *) GetScratch(replay, count * sizeof (*points) + 1);
+        if (!points) {
+            return -1;
+        }
+        for (i = 0; i < count; ++i) {
+            points[i].x = GetFloat(reader);
+            points[i].y = GetFloat(reader);
+        }
+        SetDrawState(renderer, &color, blendMode);
+        if (op == CAPTURE_OP_POINTS) {
+            SDL_RenderDrawPointsF(renderer, points, count);
+        } else {
+            SDL_RenderDrawLinesF(renderer, points, count);
+        }
+        return count;
+    }
+
+    case CAPTURE_OP_FILL_RECTS:
+    {
+        SDL_FRect *rects;
+
+        GetColor(reader, &color);
+        blendMode = (SDL_BlendMode) Get32(reader);
+        count = GetCount(reader, 4 * sizeof (float));
+        rects = (SDL_FRect *) GetScratch(replay, count * sizeof (*rects) + 1);
+        if (!rects) {
+            return -1;
+        }
+        for (i = 0; i < count; ++i) {
+            GetFRect(reader, &rects[i]);
+        }
+        SetDrawState(renderer, &color, blendMode);
+        SDL_RenderFillRectsF(renderer, rects, count);
+        return count;
+    }
+
+    case CAPTURE_OP_COPY:
+    case CAPTURE_OP_COPY_EX:
+        texture = GetReplayTexture(replay, reader, Get32(reader));
+        GetColor(reader, &color);
+        blendMode = (SDL_BlendMode) Get32(reader);
+        GetRect(reader, &rect);
+        GetFRect(reader, &frect);
+        if (op == CAPTURE_OP_COPY) {
+            if (texture) {
+                SetTextureState(texture, &color, blendMode);
+                SDL_RenderCopyF(renderer, texture, &rect, &frect);
+            }
+        } else {
+            const Uint8 *data = GetData(reader, 8);
+            union { double d; Uint64 u; } angle;
+            SDL_FPoint center;
+            SDL_RendererFlip flip;
+
+            angle.u = 0;
+            if (data) {
+                SDL_memcpy(&angle.u, data, 8);
+                angle.u = SDL_SwapLE64(angle.u);
+            }
+            center.x = GetFloat(reader);
+            center.y = GetFloat(reader);
+            flip = (SDL_RendererFlip) Get8(reader);
+            if (texture) {
+                SetTextureState(texture, &color, blendMode);
+                SDL_RenderCopyExF(renderer, texture, &rect, &frect, angle.d, &center, flip);
+            }
+        }
+        return 1;
+
+    case CAPTURE_OP_GEOMETRY:
+    {
+        SDL_Vertex *vertices;
+        int *indices;
+        int num_indices;
+
+        i = (int) Get32(reader);
+        texture = i ? GetReplayTexture(replay, reader, (Uint32) i) : NULL;
+        GetColor(reader, &color);
+        blendMode = (SDL_BlendMode) Get32(reader);
+        count = GetCount(reader, 4 * sizeof (float) + 4);
+        vertices = (SDL_Vertex *) GetScratch(replay, count * sizeof (*vertices) + 1);
+        if (!vertices) {
+            return -1;
+        }
+        for (i = 0; i < count; ++i) {
+            vertices[i].position.x = GetFloat(reader);
+            vertices[i].position.y = GetFloat(reader);
+            GetColor(reader, &vertices[i].color);
+            vertices[i].tex_coord.x = GetFloat(reader);
+            vertices[i].tex_coord.y = GetFloat(reader);
+        }
+        num_indices = GetCount(reader, 4);
+        indices = NULL;
+        if (num_indices > 0) {
+            /* The indices go after the vertices in the same scratch buffer */
+            const size_t offset = count * sizeof (*vertices);
+            Uint8 *scratch = (Uint8 *) GetScratch(replay, offset + num_indices * sizeof (*indices));
+            if (!scratch) {
+                return -1;
+            }
+            vertices = (SDL_Vertex *) scratch;
+            indices = (int *) (scratch + offset);
+            for (i = 0; i < num_indices; ++i) {
+                indices[i] = (int) Get32(reader);
+            }
+        }
+        if (texture) {
+            SetTextureState(texture, &color, blendMode);
+        } else {
+            SetDrawState(renderer, &color, blendMode);
+        }
+        if (!reader->truncated) {
+            SDL_RenderGeometry(renderer, texture, vertices, count, indices, num_indices);
+        }
+        return count;
+    }
+
+    case CAPTURE_OP_PRESENT:
+        SDL_RenderPresent(renderer);
+        return 1;
+
+    default:
+        reader->truncated = SDL_TRUE;
+        return -1;
+    }
+}
+
+int
+SDL_RenderReplayCapture(SDL_Renderer *renderer, const char *file,
+                        SDL_RenderReplayCallback callback, void *userdata)
+{
+    SDL_RendererInfo info;
+    SDL_RenderReplayReader reader;
+    SDL_RenderReplay replay;
+    SDL_RenderReplayTiming timing;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    Uint8 r = 0, g = 0, b = 0, a = 0;
+    Uint32 i;
+    int retval = 0;
+
+    if (SDL_GetRendererInfo(renderer, &info) < 0) {
+        return -1;
+    }
+    if (!file) {
+        return SDL_InvalidParamError("file");
+    }
+
+    SDL_zero(reader);
+    reader.data = (const Uint8 *) SDL_LoadFile(file, &reader.size);
+    if (!reader.data) {
+        return -1;
+    }
+    if (reader.size < 12 || SDL_memcmp(reader.data, CAPTURE_MAGIC, 8) != 0) {
+        SDL_free((void *) reader.data);
+        return SDL_SetError("'%s' is not a render capture", file);
+    }
+    reader.pos = 8;
+    if (Get32(&reader) != CAPTURE_VERSION) {
+        SDL_free((void *) reader.data);
+        return SDL_SetError("Unsupported render capture version");
+    }
+
+    SDL_zero(replay);
+    replay.renderer = renderer;
+    SDL_zero(timing);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+    while (reader.pos < reader.size) {
+        const Uint8 op = Get8(&reader);
+        const Uint64 start = callback ? SDL_GetPerformanceCounter() : 0;
+        const int count = ReplayOp(&replay, &reader, op);
+
+        if (reader.truncated) {
+            retval = SDL_SetError("Render capture '%s' is truncated or corrupt", file);
+            break;
+        }
+        if (count < 0) {
+            retval = -1;
+            break;
+        }
+        if (callback) {
+            SDL_RenderFlush(renderer);
+            timing.name = capture_op_names[op];
+            timing.count = count;
+            timing.ticks = SDL_GetPerformanceCounter() - start;
+            callback(userdata, &timing);
+        }
+        if (op == CAPTURE_OP_PRESENT) {
+            ++timing.frame;
+            timing.command = 0;
+        } else {
+            ++timing.command;
+        }
+    }
+
+    if (SDL_RenderTargetSupported(renderer)) {
+        SDL_SetRenderTarget(renderer, NULL);
+    }
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    for (i = 0; i < replay.num_textures; ++i) {
+        if (replay.textures[i]) {
+            SDL_DestroyTexture(replay.textures[i]);
+        }
+    }
+    SDL_free(replay.textures);
+    SDL_free(replay.scratch);
+    SDL_free((void *) reader.data);
+
+    return (retval < 0) ? retval : timing.frame;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,52 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_rendercapture_c_h_
+#define SDL_rendercapture_c_h_
+
+#include "SDL_sysrender.h"
+
+/* These are only called while renderer->capture is set. Coordinates are in
+   output pixels, with the render scale already applied, except for geometry. */
+extern void SDL_RenderCaptureTarget(SDL_Renderer *renderer, SDL_Texture *texture);
+extern void SDL_RenderCaptureViewport(SDL_Renderer *renderer);
+extern void SDL_RenderCaptureClipRect(SDL_Renderer *renderer);
+extern void SDL_RenderCaptureClear(SDL_Renderer *renderer);
+extern void SDL_RenderCapturePoints(SDL_Renderer *renderer, SDL_RenderCommandType cmdtype, const SDL_FPoint *points, int count);
+extern void SDL_RenderCaptureRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count);
+extern void SDL_RenderCaptureCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect, const SDL_FRect *dstrect);
+extern void SDL_RenderCaptureCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
+                                    const SDL_Rect *srcrect, const SDL_FRect *dstrect,
+                                    double angle, const SDL_FPoint *center, SDL_RendererFlip flip);
+extern void SDL_RenderCaptureGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
+                                      const SDL_Vertex *vertices, int num_vertices,
+                                      const int *indices, int num_indices,
+                                      float scale_x, float scale_y);
+extern void SDL_RenderCapturePresent(SDL_Renderer *renderer);
+
+/* The texture contents changed outside of the command queue */
+extern void SDL_RenderCaptureTextureChanged(SDL_Texture *texture);
+extern void SDL_RenderCaptureTextureDestroyed(SDL_Texture *texture);
+
+#endif /* SDL_rendercapture_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -1431,6 +1431,8 @@ D3D_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *verti
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                /* not supported by this backend, SDL_RenderGeometry() rejects it up front. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
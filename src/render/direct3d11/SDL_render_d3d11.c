@@ -2310,6 +2310,8 @@ D3D11_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                /* not supported by this backend, SDL_RenderGeometry() rejects it up front. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
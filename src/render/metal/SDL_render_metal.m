@@ -1455,6 +1455,8 @@ METAL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *ver
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                /* not supported by this backend, SDL_RenderGeometry() rejects it up front. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -988,6 +988,50 @@ GL_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
     return 0;
 }
 
+static int
+GL_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                 const SDL_Vertex * vertices, int num_vertices,
+                 const int * indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    GL_TextureData *texturedata = NULL;
+    const int count = indices ? num_indices : num_vertices;
+    GLfloat *verts = (GLfloat *) SDL_AllocateRenderVertices(renderer, count * 8 * sizeof (GLfloat), 0, &cmd->data.draw.first);
+    GLfloat modr = 1.0f, modg = 1.0f, modb = 1.0f, moda = 1.0f;
+    int i;
+
+    if (!verts) {
+        return -1;
+    }
+
+    if (texture) {
+        texturedata = (GL_TextureData *) texture->driverdata;
+        modr = (GLfloat) cmd->data.draw.r * inv255f;
+        modg = (GLfloat) cmd->data.draw.g * inv255f;
+        modb = (GLfloat) cmd->data.draw.b * inv255f;
+        moda = (GLfloat) cmd->data.draw.a * inv255f;
+    }
+
+    cmd->data.draw.count = count;
+    for (i = 0; i < count; i++) {
+        const SDL_Vertex *v = &vertices[indices ? indices[i] : i];
+        *(verts++) = v->position.x * scale_x;
+        *(verts++) = v->position.y * scale_y;
+        *(verts++) = (GLfloat) v->color.r * inv255f * modr;
+        *(verts++) = (GLfloat) v->color.g * inv255f * modg;
+        *(verts++) = (GLfloat) v->color.b * inv255f * modb;
+        *(verts++) = (GLfloat) v->color.a * inv255f * moda;
+        if (texturedata) {
+            *(verts++) = v->tex_coord.x * texturedata->texw;
+            *(verts++) = v->tex_coord.y * texturedata->texh;
+        } else {
+            *(verts++) = 0.0f;
+            *(verts++) = 0.0f;
+        }
+    }
+    return 0;
+}
+
 static void
 SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const GL_Shader shader)
 {
@@ -1351,6 +1395,33 @@ GL_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY: {
+                const GLfloat *verts = (GLfloat *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                const size_t count = cmd->data.draw.count;
+                const Uint32 color = data->drawstate.color;
+                if (cmd->data.draw.texture) {
+                    SetCopyState(data, cmd);
+                } else {
+                    SetDrawState(data, cmd, SHADER_SOLID);
+                }
+                data->glBegin(GL_TRIANGLES);
+                for (i = 0; i < count; ++i, verts += 8) {
+                    data->glColor4f(verts[2], verts[3], verts[4], verts[5]);
+                    if (cmd->data.draw.texture) {
+                        data->glTexCoord2f(verts[6], verts[7]);
+                    }
+                    data->glVertex2f(verts[0], verts[1]);
+                }
+                data->glEnd();
+
+                /* Restore the current draw color, the vertex colors replaced it */
+                data->glColor4f((GLfloat) ((color >> 16) & 0xFF) * inv255f,
+                                (GLfloat) ((color >> 8) & 0xFF) * inv255f,
+                                (GLfloat) (color & 0xFF) * inv255f,
+                                (GLfloat) ((color >> 24) & 0xFF) * inv255f);
+                break;
+            }
+
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
@@ -1623,6 +1694,7 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->QueueFillRects = GL_QueueFillRects;
     renderer->QueueCopy = GL_QueueCopy;
     renderer->QueueCopyEx = GL_QueueCopyEx;
+    renderer->QueueGeometry = GL_QueueGeometry;
     renderer->RunCommandQueue = GL_RunCommandQueue;
     renderer->RenderReadPixels = GL_RenderReadPixels;
     renderer->RenderPresent = GL_RenderPresent;
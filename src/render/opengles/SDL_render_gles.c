@@ -952,6 +952,8 @@ GLES_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vert
                 break;
             }
 
+            case SDL_RENDERCMD_GEOMETRY:
+                /* not supported by this backend, SDL_RenderGeometry() rejects it up front. */
             case SDL_RENDERCMD_NO_OP:
                 break;
         }
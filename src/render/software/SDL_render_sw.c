@@ -33,7 +33,7 @@
 #include "SDL_blendpoint.h"
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
-#include "SDL_rotate.h"
+#include "SDL_triangle.h"
 
 /* SDL surface based renderer implementation */
 
@@ -236,14 +236,13 @@ static int
 SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRect * rects, int count)
 {
     SDL_Rect *verts = (SDL_Rect *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_Rect), 0, &cmd->data.draw.first);
+    SDL_Rect clip;
     int i;
 
     if (!verts) {
         return -1;
     }
 
-    cmd->data.draw.count = count;
-
     if (renderer->viewport.x || renderer->viewport.y) {
         const int x = renderer->viewport.x;
         const int y = renderer->viewport.y;
@@ -263,6 +262,18 @@ SW_QueueFillRects(SDL_Renderer * renderer, SDL_RenderCommand *cmd, const SDL_FRe
         }
     }
 
+    /* Clip to the viewport and clip rect now, so rects that can't be seen
+       are dropped before they ever reach the fill loops. */
+    clip = renderer->viewport;
+    if (renderer->clipping_enabled) {
+        SDL_Rect cliprect = renderer->clip_rect;
+        cliprect.x += renderer->viewport.x;
+        cliprect.y += renderer->viewport.y;
+        SDL_IntersectRect(&clip, &cliprect, &clip);
+    }
+    verts -= count;
+    cmd->data.draw.count = SDL_IntersectRects(&clip, verts, count, verts);
+
     return 0;
 }
 
@@ -297,18 +308,28 @@ SW_QueueCopy(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * text
 typedef struct CopyExData
 {
     SDL_Rect srcrect;
-    SDL_Rect dstrect;
-    double angle;
-    SDL_FPoint center;
-    SDL_RendererFlip flip;
+    SDL_Vertex verts[4];
 } CopyExData;
 
+/* Rotated copies are queued as a textured quad and mapped straight into the
+   target by the rasterizer in one pass, no intermediate surfaces are needed. */
 static int
 SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
                const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
 {
     CopyExData *verts = (CopyExData *) SDL_AllocateRenderVertices(renderer, sizeof (CopyExData), 0, &cmd->data.draw.first);
+    const double radians = angle * M_PI / 180.0;
+    const float c = (float) SDL_cos(radians);
+    const float s = (float) SDL_sin(radians);
+    const float cx = renderer->viewport.x + dstrect->x + center->x;
+    const float cy = renderer->viewport.y + dstrect->y + center->y;
+    float minu = (float) srcrect->x / texture->w;
+    float minv = (float) srcrect->y / texture->h;
+    float maxu = (float) (srcrect->x + srcrect->w) / texture->w;
+    float maxv = (float) (srcrect->y + srcrect->h) / texture->h;
+    SDL_Vertex corners[4];
+    int i;
 
     if (!verts) {
         return -1;
@@ -318,247 +339,78 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
 
     SDL_memcpy(&verts->srcrect, srcrect, sizeof (SDL_Rect));
 
-    if (renderer->viewport.x || renderer->viewport.y) {
-        verts->dstrect.x = (int)(renderer->viewport.x + dstrect->x);
-        verts->dstrect.y = (int)(renderer->viewport.y + dstrect->y);
-    } else {
-        verts->dstrect.x = (int)dstrect->x;
-        verts->dstrect.y = (int)dstrect->y;
-    }
-    verts->dstrect.w = (int)dstrect->w;
-    verts->dstrect.h = (int)dstrect->h;
-    verts->angle = angle;
-    SDL_memcpy(&verts->center, center, sizeof (SDL_FPoint));
-    verts->flip = flip;
-
-    return 0;
-}
-
-static int
-SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
-                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
-                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
-{
-    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect tmp_rect;
-    SDL_Surface *src_clone, *src_rotated, *src_scaled;
-    SDL_Surface *mask = NULL, *mask_rotated = NULL;
-    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
-    SDL_BlendMode blendmode;
-    Uint8 alphaMod, rMod, gMod, bMod;
-    int applyModulation = SDL_FALSE;
-    int blitRequired = SDL_FALSE;
-    int isOpaque = SDL_FALSE;
-
-    if (!surface) {
-        return -1;
-    }
-
-    tmp_rect.x = 0;
-    tmp_rect.y = 0;
-    tmp_rect.w = final_rect->w;
-    tmp_rect.h = final_rect->h;
-
-    /* It is possible to encounter an RLE encoded surface here and locking it is
-     * necessary because this code is going to access the pixel buffer directly.
-     */
-    if (SDL_MUSTLOCK(src)) {
-        SDL_LockSurface(src);
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        const float tmp = minu; minu = maxu; maxu = tmp;
     }
-
-    /* Clone the source surface but use its pixel buffer directly.
-     * The original source surface must be treated as read-only.
-     */
-    src_clone = SDL_CreateRGBSurfaceFrom(src->pixels, src->w, src->h, src->format->BitsPerPixel, src->pitch,
-                                         src->format->Rmask, src->format->Gmask,
-                                         src->format->Bmask, src->format->Amask);
-    if (src_clone == NULL) {
-        if (SDL_MUSTLOCK(src)) {
-            SDL_UnlockSurface(src);
-        }
-        return -1;
+    if (flip & SDL_FLIP_VERTICAL) {
+        const float tmp = minv; minv = maxv; maxv = tmp;
     }
 
-    SDL_GetSurfaceBlendMode(src, &blendmode);
-    SDL_GetSurfaceAlphaMod(src, &alphaMod);
-    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+    /* Corners relative to the center of rotation */
+    corners[0].position.x = corners[2].position.x = -center->x;
+    corners[1].position.x = corners[3].position.x = dstrect->w - center->x;
+    corners[0].position.y = corners[1].position.y = -center->y;
+    corners[2].position.y = corners[3].position.y = dstrect->h - center->y;
+    corners[0].tex_coord.x = corners[2].tex_coord.x = minu;
+    corners[1].tex_coord.x = corners[3].tex_coord.x = maxu;
+    corners[0].tex_coord.y = corners[1].tex_coord.y = minv;
+    corners[2].tex_coord.y = corners[3].tex_coord.y = maxv;
 
-    /* SDLgfx_rotateSurface only accepts 32-bit surfaces with a 8888 layout. Everything else has to be converted. */
-    if (src->format->BitsPerPixel != 32 || SDL_PIXELLAYOUT(src->format->format) != SDL_PACKEDLAYOUT_8888 || !src->format->Amask) {
-        blitRequired = SDL_TRUE;
+    for (i = 0; i < 4; ++i) {
+        const float x = corners[i].position.x;
+        const float y = corners[i].position.y;
+        corners[i].position.x = cx + x * c - y * s;
+        corners[i].position.y = cy + x * s + y * c;
+        corners[i].color.r = cmd->data.draw.r;
+        corners[i].color.g = cmd->data.draw.g;
+        corners[i].color.b = cmd->data.draw.b;
+        corners[i].color.a = cmd->data.draw.a;
     }
 
-    /* If scaling and cropping is necessary, it has to be taken care of before the rotation. */
-    if (!(srcrect->w == final_rect->w && srcrect->h == final_rect->h && srcrect->x == 0 && srcrect->y == 0)) {
-        blitRequired = SDL_TRUE;
-    }
+    /* In order around the quad */
+    verts->verts[0] = corners[0];
+    verts->verts[1] = corners[1];
+    verts->verts[2] = corners[3];
+    verts->verts[3] = corners[2];
 
-    /* srcrect is not selecting the whole src surface, so cropping is needed */
-    if (!(srcrect->w == src->w && srcrect->h == src->h && srcrect->x == 0 && srcrect->y == 0)) {
-        blitRequired = SDL_TRUE;
-    }
+    return 0;
+}
 
-    /* The color and alpha modulation has to be applied before the rotation when using the NONE, MOD or MUL blend modes. */
-    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD || blendmode == SDL_BLENDMODE_MUL) && (alphaMod & rMod & gMod & bMod) != 255) {
-        applyModulation = SDL_TRUE;
-        SDL_SetSurfaceAlphaMod(src_clone, alphaMod);
-        SDL_SetSurfaceColorMod(src_clone, rMod, gMod, bMod);
-    }
+static int
+SW_QueueGeometry(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * texture,
+                 const SDL_Vertex * vertices, int num_vertices,
+                 const int * indices, int num_indices,
+                 float scale_x, float scale_y)
+{
+    const int count = indices ? num_indices : num_vertices;
+    SDL_Vertex *verts = (SDL_Vertex *) SDL_AllocateRenderVertices(renderer, count * sizeof (SDL_Vertex), 0, &cmd->data.draw.first);
+    const float x = (float) renderer->viewport.x;
+    const float y = (float) renderer->viewport.y;
+    const SDL_bool modulate = (texture && (cmd->data.draw.r & cmd->data.draw.g & cmd->data.draw.b & cmd->data.draw.a) != 0xFF) ? SDL_TRUE : SDL_FALSE;
+    int i;
 
-    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
-    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
-        isOpaque = SDL_TRUE;
+    if (!verts) {
+        return -1;
     }
 
-    /* The NONE blend mode requires a mask for non-opaque surfaces. This mask will be used
-     * to clear the pixels in the destination surface. The other steps are explained below.
-     */
-    if (blendmode == SDL_BLENDMODE_NONE && !isOpaque) {
-        mask = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                    0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (mask == NULL) {
-            retval = -1;
-        } else {
-            SDL_SetSurfaceBlendMode(mask, SDL_BLENDMODE_MOD);
-        }
-    }
+    cmd->data.draw.count = count;
 
-    /* Create a new surface should there be a format mismatch or if scaling, cropping,
-     * or modulation is required. It's possible to use the source surface directly otherwise.
-     */
-    if (!retval && (blitRequired || applyModulation)) {
-        SDL_Rect scale_rect = tmp_rect;
-        src_scaled = SDL_CreateRGBSurface(0, final_rect->w, final_rect->h, 32,
-                                          0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000);
-        if (src_scaled == NULL) {
-            retval = -1;
+    for (i = 0; i < count; i++, verts++) {
+        const SDL_Vertex *v = &vertices[indices ? indices[i] : i];
+        verts->position.x = x + v->position.x * scale_x;
+        verts->position.y = y + v->position.y * scale_y;
+        verts->tex_coord = v->tex_coord;
+        if (modulate) {
+            verts->color.r = (Uint8) ((v->color.r * cmd->data.draw.r) / 255);
+            verts->color.g = (Uint8) ((v->color.g * cmd->data.draw.g) / 255);
+            verts->color.b = (Uint8) ((v->color.b * cmd->data.draw.b) / 255);
+            verts->color.a = (Uint8) ((v->color.a * cmd->data.draw.a) / 255);
         } else {
-            SDL_SetSurfaceBlendMode(src_clone, SDL_BLENDMODE_NONE);
-            retval = SDL_BlitScaled(src_clone, srcrect, src_scaled, &scale_rect);
-            SDL_FreeSurface(src_clone);
-            src_clone = src_scaled;
-            src_scaled = NULL;
+            verts->color = v->color;
         }
     }
 
-    /* SDLgfx_rotateSurface is going to make decisions depending on the blend mode. */
-    SDL_SetSurfaceBlendMode(src_clone, blendmode);
-
-    if (!retval) {
-        SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, angle, &dstwidth, &dstheight, &cangle, &sangle);
-        src_rotated = SDLgfx_rotateSurface(src_clone, angle, dstwidth/2, dstheight/2, (texture->scaleMode == SDL_ScaleModeNearest) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-        if (src_rotated == NULL) {
-            retval = -1;
-        }
-        if (!retval && mask != NULL) {
-            /* The mask needed for the NONE blend mode gets rotated with the same parameters. */
-            mask_rotated = SDLgfx_rotateSurface(mask, angle, dstwidth/2, dstheight/2, SDL_FALSE, 0, 0, dstwidth, dstheight, cangle, sangle);
-            if (mask_rotated == NULL) {
-                retval = -1;
-            }
-        }
-        if (!retval) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect->x + (int)center->x;
-            abscentery = final_rect->y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            /* The NONE blend mode needs some special care with non-opaque surfaces.
-             * Other blend modes or opaque surfaces can be blitted directly.
-             */
-            if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
-                if (applyModulation == SDL_FALSE) {
-                    /* If the modulation wasn't already applied, make it happen now. */
-                    SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
-                    SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
-                }
-                retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
-            } else {
-                /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
-                 * First, the area where the rotated pixels will be blitted to get set to zero.
-                 * This is accomplished by simply blitting a mask with the NONE blend mode.
-                 * The colorkey set by the rotate function will discard the correct pixels.
-                 */
-                SDL_Rect mask_rect = tmp_rect;
-                SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
-                retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
-                if (!retval) {
-                    /* The next step copies the alpha value. This is done with the BLEND blend mode and
-                     * by modulating the source colors with 0. Since the destination is all zeros, this
-                     * will effectively set the destination alpha to the source alpha.
-                     */
-                    SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
-                    mask_rect = tmp_rect;
-                    retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
-                    if (!retval) {
-                        /* The last step gets the color values in place. The ADD blend mode simply adds them to
-                         * the destination (where the color values are all zero). However, because the ADD blend
-                         * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
-                         * to be created. This makes all source pixels opaque and the colors get copied correctly.
-                         */
-                        SDL_Surface *src_rotated_rgb;
-                        src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
-                                                                   src_rotated->format->BitsPerPixel, src_rotated->pitch,
-                                                                   src_rotated->format->Rmask, src_rotated->format->Gmask,
-                                                                   src_rotated->format->Bmask, 0);
-                        if (src_rotated_rgb == NULL) {
-                            retval = -1;
-                        } else {
-                            SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
-                            retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
-                            SDL_FreeSurface(src_rotated_rgb);
-                        }
-                    }
-                }
-                SDL_FreeSurface(mask_rotated);
-            }
-            if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
-            }
-        }
-    }
-
-    if (SDL_MUSTLOCK(src)) {
-        SDL_UnlockSurface(src);
-    }
-    if (mask != NULL) {
-        SDL_FreeSurface(mask);
-    }
-    if (src_clone != NULL) {
-        SDL_FreeSurface(src_clone);
-    }
-    return retval;
+    return 0;
 }
 
 static void
@@ -728,10 +580,25 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
 
             case SDL_RENDERCMD_COPY_EX: {
                 const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                SDL_Texture *texture = cmd->data.draw.texture;
                 SetDrawState(surface, &drawstate);
-                PrepTextureForCopy(cmd);
-                SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
+                SDL_SW_RenderQuad(surface, (SDL_Surface *) texture->driverdata, &copydata->srcrect,
+                                  texture->scaleMode, copydata->verts, cmd->data.draw.blend);
+                break;
+            }
+
+            case SDL_RENDERCMD_GEOMETRY: {
+                const SDL_Vertex *verts = (SDL_Vertex *) (((Uint8 *) vertices) + cmd->data.draw.first);
+                const int count = (int) cmd->data.draw.count;
+                SDL_Texture *texture = cmd->data.draw.texture;
+                SetDrawState(surface, &drawstate);
+                if (texture) {
+                    SDL_SW_RenderTriangles(surface, (SDL_Surface *) texture->driverdata, NULL,
+                                           texture->scaleMode, verts, count, cmd->data.draw.blend);
+                } else {
+                    SDL_SW_RenderTriangles(surface, NULL, NULL, SDL_ScaleModeNearest,
+                                           verts, count, cmd->data.draw.blend);
+                }
                 break;
             }
 
@@ -844,6 +711,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     renderer->QueueFillRects = SW_QueueFillRects;
     renderer->QueueCopy = SW_QueueCopy;
     renderer->QueueCopyEx = SW_QueueCopyEx;
+    renderer->QueueGeometry = SW_QueueGeometry;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
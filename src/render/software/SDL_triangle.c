@@ -0,0 +1,995 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "../../SDL_internal.h"
+
+#if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
+
+#include "SDL_surface.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_triangle.h"
+
+#include "../../video/SDL_blit.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* This is a half-space rasterizer: every triangle is bounded by three edge
+ * functions evaluated at pixel centers in 28.4 fixed point, and pixel
+ * ownership follows the top-left fill rule so that triangles sharing an edge
+ * never touch the same pixel twice. Convex quads, as used for rotated copies,
+ * are rasterized the same way with four edges.
+ *
+ * Since these polygons are convex, the covered pixels of a row always form a
+ * single span. Its ends are solved from the edge functions once, and then
+ * walked from row to row with a quotient and remainder, without divisions.
+ * The inner loops therefore run without per-pixel coverage tests: a first
+ * pass writes the interpolated (and optionally textured) ARGB8888 colors of
+ * the span into a scratch buffer, and a second pass blends that buffer into
+ * the destination row. Both loops are straight-line code over contiguous
+ * memory, which keeps them friendly to the compiler's vectorizer.
+ *
+ * Textured triangles with a constant color, whose 32-bit texels store their
+ * 8-bit channels like the target pixels, take a direct path instead: the span
+ * is sampled without decoding any texels, the range of pixels whose samples
+ * need no clamping is solved once per span, and the span is blended four
+ * pixels at a time with SSE2 or NEON where available. This is what rotated
+ * copies of the usual ARGB8888 textures end up using.
+ */
+
+#define SUBPIXEL_BITS   4
+#define SUBPIXEL_ONE    (1 << SUBPIXEL_BITS)
+#define SUBPIXEL_HALF   (SUBPIXEL_ONE >> 1)
+
+/* Keep the edge functions well within 64 bits */
+#define COORD_LIMIT     16777216.0f
+
+typedef struct
+{
+    Sint64 step_x;      /* change of the edge function per pixel in x */
+    Sint64 step_y;      /* change of the edge function per pixel in y */
+    Sint64 origin;      /* value at the first pixel center of the bounding box */
+    Sint64 bound;       /* first (step_x > 0) or last (step_x < 0) covered pixel of the current row */
+    Sint64 bound_step;  /* whole pixels the bound moves per row */
+    Sint64 rem;         /* remainder of the bound division, in [0, divisor) */
+    Sint64 rem_step;    /* remainder of the per row move, in [0, divisor) */
+    Sint64 divisor;     /* |step_x| */
+} TriEdge;
+
+typedef struct
+{
+    double value;       /* value at the first pixel center of the bounding box */
+    double dx;          /* change per pixel in x */
+    double dy;          /* change per pixel in y */
+} TriGradient;
+
+typedef struct
+{
+    SDL_PixelFormat *fmt;
+    const Uint8 *pixels;
+    int pitch;
+    int bpp;
+    int width, height;
+    int minx, miny;     /* texels outside of this rectangle are never sampled */
+    int maxx, maxy;
+    SDL_bool linear;    /* bilinear filtering instead of nearest texel */
+    SDL_bool raw32;     /* 8-bit channels in 32 bits, filter before decoding */
+    SDL_bool direct;    /* raw32 and laid out like the target, no conversion at all */
+    SDL_bool simd;      /* SSE2 or NEON can be used on the direct path */
+    int ashift;         /* position of the alpha (or unused) byte on the direct path */
+    Uint32 alpha_fill;  /* alpha bits added to texels of textures without alpha */
+    Uint32 dst_mask;    /* bits kept in the target pixels */
+} TriTexture;
+
+enum
+{
+    GRAD_R,
+    GRAD_G,
+    GRAD_B,
+    GRAD_A,
+    GRAD_U,
+    GRAD_V,
+    NUM_GRADIENTS
+};
+
+static SDL_INLINE Sint64
+FloorDiv(Sint64 n, Sint64 d)
+{
+    Sint64 q = n / d;
+    if ((n % d) != 0 && n < 0) {
+        --q;
+    }
+    return q;
+}
+
+static SDL_INLINE Sint64
+CeilDiv(Sint64 n, Sint64 d)
+{
+    return -FloorDiv(-n, d);
+}
+
+static SDL_INLINE Sint64
+ToFixed(float v)
+{
+    if (v < -COORD_LIMIT) {
+        v = -COORD_LIMIT;
+    } else if (v > COORD_LIMIT) {
+        v = COORD_LIMIT;
+    }
+    return (Sint64) SDL_floorf(v * SUBPIXEL_ONE + 0.5f);
+}
+
+static SDL_INLINE Uint32
+ClampChannel(Sint32 v)
+{
+    v >>= 16;
+    if ((Uint32) v > 255) {
+        v = (v < 0) ? 0 : 255;
+    }
+    return (Uint32) v;
+}
+
+static SDL_INLINE SDL_bool
+SameColor(const SDL_Color *a, const SDL_Color *b)
+{
+    return (a->r == b->r && a->g == b->g && a->b == b->b && a->a == b->a) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Top-left rule for edges wound like ours: a top edge is horizontal and goes
+   right, a left edge goes up. Other edges don't own pixels lying exactly on them. */
+static SDL_INLINE Sint64
+EdgeBias(Sint64 ax, Sint64 ay, Sint64 bx, Sint64 by)
+{
+    const Sint64 dx = bx - ax;
+    const Sint64 dy = by - ay;
+    if ((dy == 0 && dx > 0) || dy < 0) {
+        return 0;
+    }
+    return -1;
+}
+
+static void
+SetupEdge(TriEdge *edge, Sint64 ax, Sint64 ay, Sint64 bx, Sint64 by, Sint64 px, Sint64 py)
+{
+    edge->step_x = -(by - ay) * SUBPIXEL_ONE;
+    edge->step_y = (bx - ax) * SUBPIXEL_ONE;
+    edge->origin = (bx - ax) * (py - ay) - (by - ay) * (px - ax) + EdgeBias(ax, ay, bx, by);
+
+    /* Walk the row bound with a quotient and remainder, so the rows don't need divisions:
+       with step_x > 0 the first covered pixel is ceil(-e / step_x), with step_x < 0 the
+       last one is floor(e / -step_x), e being the edge function at the row start. */
+    if (edge->step_x != 0) {
+        Sint64 n, dn;
+        if (edge->step_x > 0) {
+            edge->divisor = edge->step_x;
+            n = -edge->origin + edge->divisor - 1;
+            dn = -edge->step_y;
+        } else {
+            edge->divisor = -edge->step_x;
+            n = edge->origin;
+            dn = edge->step_y;
+        }
+        edge->bound = FloorDiv(n, edge->divisor);
+        edge->rem = n - edge->bound * edge->divisor;
+        edge->bound_step = FloorDiv(dn, edge->divisor);
+        edge->rem_step = dn - edge->bound_step * edge->divisor;
+    }
+}
+
+static SDL_INLINE void
+StepEdge(TriEdge *edge)
+{
+    edge->bound += edge->bound_step;
+    edge->rem += edge->rem_step;
+    if (edge->rem >= edge->divisor) {
+        edge->rem -= edge->divisor;
+        ++edge->bound;
+    }
+}
+
+static void
+SetupGradient(TriGradient *grad, double a0, double a1, double a2,
+              double d1x, double d1y, double d2x, double d2y, double inv_det,
+              double ox, double oy)
+{
+    const double da1 = a1 - a0;
+    const double da2 = a2 - a0;
+    grad->dx = (da1 * d2y - da2 * d1y) * inv_det;
+    grad->dy = (da2 * d1x - da1 * d2x) * inv_det;
+    grad->value = a0 + grad->dx * ox + grad->dy * oy;
+}
+
+static void
+ShadeSpanSolid(Uint32 *span, int n, const TriGradient *grads, double ox, double oy)
+{
+    Sint32 r = (Sint32) ((grads[GRAD_R].value + grads[GRAD_R].dx * ox + grads[GRAD_R].dy * oy) * 65536.0);
+    Sint32 g = (Sint32) ((grads[GRAD_G].value + grads[GRAD_G].dx * ox + grads[GRAD_G].dy * oy) * 65536.0);
+    Sint32 b = (Sint32) ((grads[GRAD_B].value + grads[GRAD_B].dx * ox + grads[GRAD_B].dy * oy) * 65536.0);
+    Sint32 a = (Sint32) ((grads[GRAD_A].value + grads[GRAD_A].dx * ox + grads[GRAD_A].dy * oy) * 65536.0);
+    const Sint32 dr = (Sint32) (grads[GRAD_R].dx * 65536.0);
+    const Sint32 dg = (Sint32) (grads[GRAD_G].dx * 65536.0);
+    const Sint32 db = (Sint32) (grads[GRAD_B].dx * 65536.0);
+    const Sint32 da = (Sint32) (grads[GRAD_A].dx * 65536.0);
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        span[i] = (ClampChannel(a) << 24) | (ClampChannel(r) << 16) | (ClampChannel(g) << 8) | ClampChannel(b);
+        r += dr;
+        g += dg;
+        b += db;
+        a += da;
+    }
+}
+
+/* Linear interpolation of the four 8-bit channels of two packed pixels,
+   two channels at a time, f is in [0, 256] */
+static SDL_INLINE Uint32
+Lerp8888(Uint32 a, Uint32 b, Uint32 f)
+{
+    const Uint32 rb = ((((a & 0x00FF00FF) * (256 - f)) + ((b & 0x00FF00FF) * f)) >> 8) & 0x00FF00FF;
+    const Uint32 ag = (((((a >> 8) & 0x00FF00FF) * (256 - f)) + (((b >> 8) & 0x00FF00FF) * f))) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static SDL_INLINE Uint32
+FetchTexel(const TriTexture *tex, int x, int y)
+{
+    const Uint8 *texel = tex->pixels + y * tex->pitch + x * tex->bpp;
+    Uint32 pixel;
+    unsigned r, g, b, a;
+
+    if (tex->raw32) {
+        return *(const Uint32 *) texel;
+    }
+    DISEMBLE_RGBA(texel, tex->bpp, tex->fmt, pixel, r, g, b, a);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+/* Samples the texture at u, v (16.16 fixed point), clamped to the source rectangle */
+static SDL_INLINE Uint32
+SampleTexel(const TriTexture *tex, Sint64 u, Sint64 v)
+{
+    if (tex->linear) {
+        /* Bilinear filtering, with texel centers at half coordinates */
+        const Sint64 su = u - 0x8000;
+        const Sint64 sv = v - 0x8000;
+        const Uint32 fx = (Uint32) (su >> 8) & 0xFF;
+        const Uint32 fy = (Uint32) (sv >> 8) & 0xFF;
+        const Sint64 xi = su >> 16;
+        const Sint64 yi = sv >> 16;
+        const int x0 = (int) SDL_max(SDL_min(xi, tex->maxx), tex->minx);
+        const int y0 = (int) SDL_max(SDL_min(yi, tex->maxy), tex->miny);
+        const int x1 = (int) SDL_max(SDL_min(xi + 1, tex->maxx), tex->minx);
+        const int y1 = (int) SDL_max(SDL_min(yi + 1, tex->maxy), tex->miny);
+        return Lerp8888(Lerp8888(FetchTexel(tex, x0, y0), FetchTexel(tex, x1, y0), fx),
+                        Lerp8888(FetchTexel(tex, x0, y1), FetchTexel(tex, x1, y1), fx), fy);
+    } else {
+        const int x0 = (int) SDL_max(SDL_min(u >> 16, tex->maxx), tex->minx);
+        const int y0 = (int) SDL_max(SDL_min(v >> 16, tex->maxy), tex->miny);
+        return FetchTexel(tex, x0, y0);
+    }
+}
+
+static void
+ShadeSpanTextured(Uint32 *span, int n, const TriGradient *grads, double ox, double oy, const TriTexture *tex)
+{
+    SDL_PixelFormat *fmt = tex->fmt;
+    Sint32 r = (Sint32) ((grads[GRAD_R].value + grads[GRAD_R].dx * ox + grads[GRAD_R].dy * oy) * 65536.0);
+    Sint32 g = (Sint32) ((grads[GRAD_G].value + grads[GRAD_G].dx * ox + grads[GRAD_G].dy * oy) * 65536.0);
+    Sint32 b = (Sint32) ((grads[GRAD_B].value + grads[GRAD_B].dx * ox + grads[GRAD_B].dy * oy) * 65536.0);
+    Sint32 a = (Sint32) ((grads[GRAD_A].value + grads[GRAD_A].dx * ox + grads[GRAD_A].dy * oy) * 65536.0);
+    Sint64 u = (Sint64) ((grads[GRAD_U].value + grads[GRAD_U].dx * ox + grads[GRAD_U].dy * oy) * 65536.0);
+    Sint64 v = (Sint64) ((grads[GRAD_V].value + grads[GRAD_V].dx * ox + grads[GRAD_V].dy * oy) * 65536.0);
+    const Sint32 dr = (Sint32) (grads[GRAD_R].dx * 65536.0);
+    const Sint32 dg = (Sint32) (grads[GRAD_G].dx * 65536.0);
+    const Sint32 db = (Sint32) (grads[GRAD_B].dx * 65536.0);
+    const Sint32 da = (Sint32) (grads[GRAD_A].dx * 65536.0);
+    const Sint64 du = (Sint64) (grads[GRAD_U].dx * 65536.0);
+    const Sint64 dv = (Sint64) (grads[GRAD_V].dx * 65536.0);
+    const SDL_bool modulate = (dr || dg || db || da || (r & g & b & a) != (255 << 16)) ? SDL_TRUE : SDL_FALSE;
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const Uint32 pixel = SampleTexel(tex, u, v);
+        unsigned srcR, srcG, srcB, srcA;
+
+        if (tex->raw32) {
+            RGBA_FROM_PIXEL(pixel, fmt, srcR, srcG, srcB, srcA);
+        } else {
+            srcA = pixel >> 24;
+            srcR = (pixel >> 16) & 0xFF;
+            srcG = (pixel >> 8) & 0xFF;
+            srcB = pixel & 0xFF;
+        }
+
+        if (modulate) {
+            srcR = (srcR * ClampChannel(r)) / 255;
+            srcG = (srcG * ClampChannel(g)) / 255;
+            srcB = (srcB * ClampChannel(b)) / 255;
+            srcA = (srcA * ClampChannel(a)) / 255;
+            r += dr;
+            g += dg;
+            b += db;
+            a += da;
+        }
+        span[i] = (srcA << 24) | (srcR << 16) | (srcG << 8) | srcB;
+
+        u += du;
+        v += dv;
+    }
+}
+
+#define BLEND_SPAN(op)                                              \
+    for (i = 0; i < n; ++i, dst += bpp) {                           \
+        const Uint32 s = span[i];                                   \
+        unsigned srcR = (s >> 16) & 0xFF;                           \
+        unsigned srcG = (s >> 8) & 0xFF;                            \
+        unsigned srcB = s & 0xFF;                                   \
+        unsigned srcA = s >> 24;                                    \
+        unsigned dstR, dstG, dstB, dstA;                            \
+        Uint32 dstpixel;                                            \
+        DISEMBLE_RGBA(dst, bpp, fmt, dstpixel, dstR, dstG, dstB, dstA); \
+        op                                                          \
+        ASSEMBLE_RGBA(dst, bpp, fmt, dstR, dstG, dstB, dstA);       \
+    }
+
+#define PREMULTIPLY                                                 \
+        if (srcA < 255) {                                           \
+            srcR = (srcR * srcA) / 255;                             \
+            srcG = (srcG * srcA) / 255;                             \
+            srcB = (srcB * srcA) / 255;                             \
+        }
+
+#define OP_BLEND                                                    \
+        PREMULTIPLY                                                 \
+        dstR = srcR + ((255 - srcA) * dstR) / 255;                  \
+        dstG = srcG + ((255 - srcA) * dstG) / 255;                  \
+        dstB = srcB + ((255 - srcA) * dstB) / 255;                  \
+        dstA = srcA + ((255 - srcA) * dstA) / 255;
+
+#define OP_ADD                                                      \
+        PREMULTIPLY                                                 \
+        dstR = SDL_min(srcR + dstR, 255);                           \
+        dstG = SDL_min(srcG + dstG, 255);                           \
+        dstB = SDL_min(srcB + dstB, 255);
+
+#define OP_MOD                                                      \
+        (void) srcA;                                                \
+        dstR = (srcR * dstR) / 255;                                 \
+        dstG = (srcG * dstG) / 255;                                 \
+        dstB = (srcB * dstB) / 255;
+
+#define OP_MUL                                                      \
+        dstR = SDL_min(((srcR * dstR) + (dstR * (255 - srcA))) / 255, 255); \
+        dstG = SDL_min(((srcG * dstG) + (dstG * (255 - srcA))) / 255, 255); \
+        dstB = SDL_min(((srcB * dstB) + (dstB * (255 - srcA))) / 255, 255); \
+        dstA = SDL_min(((srcA * dstA) + (dstA * (255 - srcA))) / 255, 255);
+
+static void
+BlendSpan(Uint8 *dst, SDL_PixelFormat *fmt, const Uint32 *span, int n, SDL_BlendMode blendMode)
+{
+    const int bpp = fmt->BytesPerPixel;
+    int i;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        BLEND_SPAN(OP_BLEND)
+        break;
+    case SDL_BLENDMODE_ADD:
+        BLEND_SPAN(OP_ADD)
+        break;
+    case SDL_BLENDMODE_MOD:
+        BLEND_SPAN(OP_MOD)
+        break;
+    case SDL_BLENDMODE_MUL:
+        BLEND_SPAN(OP_MUL)
+        break;
+    default:
+        if (bpp == 4 && fmt->format == SDL_PIXELFORMAT_ARGB8888) {
+            SDL_memcpy(dst, span, n * sizeof (Uint32));
+        } else {
+            for (i = 0; i < n; ++i, dst += bpp) {
+                const Uint32 s = span[i];
+                const unsigned srcR = (s >> 16) & 0xFF;
+                const unsigned srcG = (s >> 8) & 0xFF;
+                const unsigned srcB = s & 0xFF;
+                const unsigned srcA = s >> 24;
+                ASSEMBLE_RGBA(dst, bpp, fmt, srcR, srcG, srcB, srcA);
+            }
+        }
+        break;
+    }
+}
+
+/* The direct path: texels are used exactly as stored, and blended with
+   x / 255 computed as (x + 1 + (x >> 8)) >> 8, which is exact for the
+   products of two 8-bit values. It gives the same results as the generic
+   path, just without converting every pixel. */
+
+#define DIV255(x)   (((x) + 1 + ((x) >> 8)) >> 8)
+
+/* Multiplies the four 8-bit channels of p by those of m, divided by 255 */
+static SDL_INLINE Uint32
+Modulate8888(Uint32 p, Uint32 m)
+{
+    Uint32 result = 0;
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        const Uint32 x = ((p >> shift) & 0xFF) * ((m >> shift) & 0xFF);
+        result |= DIV255(x) << shift;
+    }
+    return result;
+}
+
+/* Narrows [first, last] to the pixels k of a span whose coordinate
+   (p + k * dp) >> 16 lies within [lo, hi] */
+static void
+ClipSpanRange(Sint64 p, Sint64 dp, int lo, int hi, Sint64 *first, Sint64 *last)
+{
+    const Sint64 plo = (Sint64) lo << 16;
+    const Sint64 phi = ((Sint64) hi << 16) + 0xFFFF;
+    const Sint64 pfirst = p + *first * dp;
+    const Sint64 plast = p + *last * dp;
+
+    if (*first > *last) {
+        return;
+    }
+    if (pfirst >= plo && pfirst <= phi && plast >= plo && plast <= phi) {
+        return;  /* the usual case, both ends are inside, so is everything between */
+    }
+    if (dp > 0) {
+        *first = SDL_max(*first, CeilDiv(plo - p, dp));
+        *last = SDL_min(*last, FloorDiv(phi - p, dp));
+    } else if (dp < 0) {
+        *first = SDL_max(*first, CeilDiv(p - phi, -dp));
+        *last = SDL_min(*last, FloorDiv(p - plo, -dp));
+    } else if (p < plo || p > phi) {
+        *last = *first - 1;
+    }
+}
+
+#if HAVE_SSE2_INTRINSICS
+static SDL_INLINE __m128i
+SSE2_Div255(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m128i
+SSE2_Modulate8888(__m128i p, __m128i m)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), _mm_unpacklo_epi8(m, zero));
+    const __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), _mm_unpackhi_epi8(m, zero));
+    return _mm_packus_epi16(SSE2_Div255(lo), SSE2_Div255(hi));
+}
+
+/* Lerp8888() of the 2x2 texels at row0 and row1 */
+static SDL_INLINE Uint32
+SSE2_Bilinear(const Uint8 *row0, const Uint8 *row1, Uint32 fx, Uint32 fy)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wx = _mm_unpacklo_epi64(_mm_set1_epi16((short) (256 - fx)), _mm_set1_epi16((short) fx));
+    __m128i t0 = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) row0), zero), wx);
+    __m128i t1 = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) row1), zero), wx);
+    t0 = _mm_srli_epi16(_mm_add_epi16(t0, _mm_srli_si128(t0, 8)), 8);
+    t1 = _mm_srli_epi16(_mm_add_epi16(t1, _mm_srli_si128(t1, 8)), 8);
+    t0 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(t0, _mm_set1_epi16((short) (256 - fy))),
+                                      _mm_mullo_epi16(t1, _mm_set1_epi16((short) fy))), 8);
+    return (Uint32) _mm_cvtsi128_si32(_mm_packus_epi16(t0, t0));
+}
+#elif HAVE_NEON_INTRINSICS
+static SDL_INLINE uint16x8_t
+NEON_Div255(uint16x8_t x)
+{
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+static SDL_INLINE uint32x4_t
+NEON_Modulate8888(uint32x4_t p, uint32x4_t m)
+{
+    const uint8x16_t p8 = vreinterpretq_u8_u32(p);
+    const uint8x16_t m8 = vreinterpretq_u8_u32(m);
+    const uint16x8_t lo = vmull_u8(vget_low_u8(p8), vget_low_u8(m8));
+    const uint16x8_t hi = vmull_u8(vget_high_u8(p8), vget_high_u8(m8));
+    return vreinterpretq_u32_u8(vcombine_u8(vmovn_u16(NEON_Div255(lo)), vmovn_u16(NEON_Div255(hi))));
+}
+
+/* Lerp8888() of the 2x2 texels at row0 and row1 */
+static SDL_INLINE Uint32
+NEON_Bilinear(const Uint8 *row0, const Uint8 *row1, Uint32 fx, Uint32 fy)
+{
+    const uint16x8_t wx = vcombine_u16(vdup_n_u16((Uint16) (256 - fx)), vdup_n_u16((Uint16) fx));
+    const uint16x8_t t0 = vmulq_u16(vmovl_u8(vld1_u8(row0)), wx);
+    const uint16x8_t t1 = vmulq_u16(vmovl_u8(vld1_u8(row1)), wx);
+    const uint16x4_t h0 = vshr_n_u16(vadd_u16(vget_low_u16(t0), vget_high_u16(t0)), 8);
+    const uint16x4_t h1 = vshr_n_u16(vadd_u16(vget_low_u16(t1), vget_high_u16(t1)), 8);
+    const uint16x4_t v = vshr_n_u16(vadd_u16(vmul_n_u16(h0, (Uint16) (256 - fy)), vmul_n_u16(h1, (Uint16) fy)), 8);
+    return vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(v, v))), 0);
+}
+#endif
+
+/* Samples n texels starting at u, v (16.16 fixed point) into span, as stored */
+static void
+SampleSpanDirect(Uint32 *span, int n, Sint64 u, Sint64 v, Sint64 du, Sint64 dv, const TriTexture *tex)
+{
+    const Uint8 *pixels = tex->pixels;
+    const int pitch = tex->pitch;
+    const Uint32 fill = tex->alpha_fill;
+    Sint64 first = 0;
+    Sint64 last = n - 1;
+    int i;
+
+    /* Only the pixels outside of [first, last] have to be clamped */
+    if (tex->linear) {
+        ClipSpanRange(u - 0x8000, du, tex->minx, tex->maxx - 1, &first, &last);
+        ClipSpanRange(v - 0x8000, dv, tex->miny, tex->maxy - 1, &first, &last);
+    } else {
+        ClipSpanRange(u, du, tex->minx, tex->maxx, &first, &last);
+        ClipSpanRange(v, dv, tex->miny, tex->maxy, &first, &last);
+    }
+    if (first > last) {
+        first = n;
+        last = n - 1;
+    }
+
+    for (i = 0; i < (int) first; ++i) {
+        span[i] = SampleTexel(tex, u, v) | fill;
+        u += du;
+        v += dv;
+    }
+
+    if (tex->linear) {
+#if HAVE_SSE2_INTRINSICS
+        if (tex->simd) {
+            for (; i <= (int) last; ++i) {
+                const Sint64 su = u - 0x8000;
+                const Sint64 sv = v - 0x8000;
+                const Uint8 *row = pixels + (int) (sv >> 16) * pitch + (int) (su >> 16) * 4;
+                span[i] = SSE2_Bilinear(row, row + pitch, (Uint32) (su >> 8) & 0xFF, (Uint32) (sv >> 8) & 0xFF) | fill;
+                u += du;
+                v += dv;
+            }
+        }
+#elif HAVE_NEON_INTRINSICS
+        if (tex->simd) {
+            for (; i <= (int) last; ++i) {
+                const Sint64 su = u - 0x8000;
+                const Sint64 sv = v - 0x8000;
+                const Uint8 *row = pixels + (int) (sv >> 16) * pitch + (int) (su >> 16) * 4;
+                span[i] = NEON_Bilinear(row, row + pitch, (Uint32) (su >> 8) & 0xFF, (Uint32) (sv >> 8) & 0xFF) | fill;
+                u += du;
+                v += dv;
+            }
+        }
+#endif
+        for (; i <= (int) last; ++i) {
+            const Sint64 su = u - 0x8000;
+            const Sint64 sv = v - 0x8000;
+            const Uint32 *row0 = (const Uint32 *) (pixels + (int) (sv >> 16) * pitch) + (int) (su >> 16);
+            const Uint32 *row1 = (const Uint32 *) ((const Uint8 *) row0 + pitch);
+            const Uint32 fx = (Uint32) (su >> 8) & 0xFF;
+            span[i] = Lerp8888(Lerp8888(row0[0], row0[1], fx), Lerp8888(row1[0], row1[1], fx), (Uint32) (sv >> 8) & 0xFF) | fill;
+            u += du;
+            v += dv;
+        }
+    } else {
+        for (; i <= (int) last; ++i) {
+            span[i] = *((const Uint32 *) (pixels + (int) (v >> 16) * pitch) + (int) (u >> 16)) | fill;
+            u += du;
+            v += dv;
+        }
+    }
+
+    for (; i < n; ++i) {
+        span[i] = SampleTexel(tex, u, v) | fill;
+        u += du;
+        v += dv;
+    }
+}
+
+/* Writes n texels of span to dst, modulated by color (in the same layout)
+   and blended with SDL_BLENDMODE_NONE or SDL_BLENDMODE_BLEND */
+static void
+BlendSpanDirect(Uint32 *dst, const Uint32 *span, int n, const TriTexture *tex,
+                Uint32 color, SDL_bool modulate, SDL_BlendMode blendMode)
+{
+    const SDL_bool blend = (blendMode == SDL_BLENDMODE_BLEND) ? SDL_TRUE : SDL_FALSE;
+    const int ashift = tex->ashift;
+    const Uint32 alpha = (Uint32) 0xFF << ashift;
+    const Uint32 mask = tex->dst_mask;
+    int i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    if (tex->simd) {
+        const __m128i vcolor = _mm_set1_epi32((int) color);
+        const __m128i valpha = _mm_set1_epi32((int) alpha);
+        const __m128i vmask = _mm_set1_epi32((int) mask);
+        const __m128i lowbyte = _mm_set1_epi32(0xFF);
+        const __m128i count = _mm_cvtsi32_si128(ashift);
+        for (; i + 4 <= n; i += 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *) &span[i]);
+            if (modulate) {
+                s = SSE2_Modulate8888(s, vcolor);
+            }
+            if (blend) {
+                const __m128i a = _mm_and_si128(_mm_srl_epi32(s, count), lowbyte);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, _mm_setzero_si128())) == 0xFFFF) {
+                    continue;
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, lowbyte)) != 0xFFFF) {
+                    /* Spread alpha over the bytes of each pixel */
+                    __m128i spread = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+                    spread = _mm_or_si128(spread, _mm_slli_epi32(spread, 16));
+                    s = _mm_add_epi8(SSE2_Modulate8888(s, _mm_or_si128(spread, valpha)),
+                                     SSE2_Modulate8888(_mm_loadu_si128((const __m128i *) &dst[i]),
+                                                       _mm_xor_si128(spread, _mm_set1_epi32(-1))));
+                }
+            }
+            _mm_storeu_si128((__m128i *) &dst[i], _mm_and_si128(s, vmask));
+        }
+    }
+#elif HAVE_NEON_INTRINSICS
+    if (tex->simd) {
+        const uint32x4_t vcolor = vdupq_n_u32(color);
+        const uint32x4_t valpha = vdupq_n_u32(alpha);
+        const uint32x4_t vmask = vdupq_n_u32(mask);
+        const uint32x4_t lowbyte = vdupq_n_u32(0xFF);
+        const int32x4_t count = vdupq_n_s32(-ashift);
+        for (; i + 4 <= n; i += 4) {
+            uint32x4_t s = vld1q_u32(&span[i]);
+            if (modulate) {
+                s = NEON_Modulate8888(s, vcolor);
+            }
+            if (blend) {
+                const uint32x4_t a = vandq_u32(vshlq_u32(s, count), lowbyte);
+                const uint32x2_t amax = vpmax_u32(vget_low_u32(a), vget_high_u32(a));
+                const uint32x2_t amin = vpmin_u32(vget_low_u32(a), vget_high_u32(a));
+                if (vget_lane_u32(vpmax_u32(amax, amax), 0) == 0) {
+                    continue;
+                }
+                if (vget_lane_u32(vpmin_u32(amin, amin), 0) != 0xFF) {
+                    /* Spread alpha over the bytes of each pixel */
+                    const uint32x4_t spread = vmulq_n_u32(a, 0x01010101);
+                    s = vreinterpretq_u32_u8(vaddq_u8(vreinterpretq_u8_u32(NEON_Modulate8888(s, vorrq_u32(spread, valpha))),
+                                                      vreinterpretq_u8_u32(NEON_Modulate8888(vld1q_u32(&dst[i]), vmvnq_u32(spread)))));
+                }
+            }
+            vst1q_u32(&dst[i], vandq_u32(s, vmask));
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        Uint32 s = span[i];
+        if (modulate) {
+            s = Modulate8888(s, color);
+        }
+        if (blend) {
+            const Uint32 a = (s >> ashift) & 0xFF;
+            if (a == 0) {
+                continue;
+            }
+            if (a != 0xFF) {
+                const Uint32 spread = a * 0x01010101;
+                s = Modulate8888(s, spread | alpha) + Modulate8888(dst[i], ~spread);
+            }
+        }
+        dst[i] = s & mask;
+    }
+}
+
+/* Renders a convex polygon of 3 or 4 vertices, given in order around it.
+ * Colors and texture coordinates are interpolated over the plane of the
+ * first three vertices, so with 4 vertices they must be affine over the
+ * polygon, as they are over a parallelogram.
+ */
+static void
+RenderPolygon(SDL_Surface *dst, const TriTexture *tex, const SDL_Vertex **verts, int count,
+              SDL_BlendMode blendMode, Uint32 *span)
+{
+    const SDL_Rect *clip = &dst->clip_rect;
+    const SDL_Vertex *vert[4];
+    const SDL_Vertex *v0, *v1, *v2;
+    Sint64 fx[4], fy[4];
+    Sint64 x0, y0, x1, y1, x2, y2, area;
+    Sint64 minfx, minfy, maxfx, maxfy;
+    int minx, miny, maxx, maxy, x, y;
+    Sint64 px, py;
+    TriEdge edges[4];
+    TriGradient grads[NUM_GRADIENTS];
+    SDL_bool constant, flat, direct, modulate = SDL_FALSE;
+    Uint32 modcolor = 0;
+    Sint64 du = 0, dv = 0;
+    double d1x, d1y, d2x, d2y, ox, oy, inv_det;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        vert[i] = verts[i];
+        fx[i] = ToFixed(vert[i]->position.x);
+        fy[i] = ToFixed(vert[i]->position.y);
+    }
+
+    area = (fx[1] - fx[0]) * (fy[2] - fy[0]) - (fy[1] - fy[0]) * (fx[2] - fx[0]);
+    if (area == 0) {
+        return;  /* degenerate, nothing to draw. */
+    }
+    if (area < 0) {
+        /* Reverse the winding, keeping the first vertex */
+        for (i = 1; i < count - i; ++i) {
+            const SDL_Vertex *tmpv = vert[i];
+            Sint64 tmp;
+            vert[i] = vert[count - i];
+            vert[count - i] = tmpv;
+            tmp = fx[i]; fx[i] = fx[count - i]; fx[count - i] = tmp;
+            tmp = fy[i]; fy[i] = fy[count - i]; fy[count - i] = tmp;
+        }
+        area = -area;
+    }
+    v0 = vert[0];
+    v1 = vert[1];
+    v2 = vert[2];
+    x0 = fx[0];
+    y0 = fy[0];
+    x1 = fx[1];
+    y1 = fy[1];
+    x2 = fx[2];
+    y2 = fy[2];
+
+    /* Pixel centers covered by the bounding box, clipped */
+    minfx = maxfx = fx[0];
+    minfy = maxfy = fy[0];
+    for (i = 1; i < count; ++i) {
+        minfx = SDL_min(minfx, fx[i]);
+        minfy = SDL_min(minfy, fy[i]);
+        maxfx = SDL_max(maxfx, fx[i]);
+        maxfy = SDL_max(maxfy, fy[i]);
+    }
+    minx = (int) SDL_max(CeilDiv(minfx - SUBPIXEL_HALF, SUBPIXEL_ONE), clip->x);
+    miny = (int) SDL_max(CeilDiv(minfy - SUBPIXEL_HALF, SUBPIXEL_ONE), clip->y);
+    maxx = (int) SDL_min(FloorDiv(maxfx - SUBPIXEL_HALF, SUBPIXEL_ONE), clip->x + clip->w - 1);
+    maxy = (int) SDL_min(FloorDiv(maxfy - SUBPIXEL_HALF, SUBPIXEL_ONE), clip->y + clip->h - 1);
+    if (minx > maxx || miny > maxy) {
+        return;
+    }
+
+    px = (Sint64) minx * SUBPIXEL_ONE + SUBPIXEL_HALF;
+    py = (Sint64) miny * SUBPIXEL_ONE + SUBPIXEL_HALF;
+    for (i = 0; i < count; ++i) {
+        const int next = (i + 1) % count;
+        SetupEdge(&edges[i], fx[i], fy[i], fx[next], fy[next], px, py);
+    }
+
+    /* Attribute planes, relative to the first pixel center of the bounding box */
+    d1x = (double) (x1 - x0) / SUBPIXEL_ONE;
+    d1y = (double) (y1 - y0) / SUBPIXEL_ONE;
+    d2x = (double) (x2 - x0) / SUBPIXEL_ONE;
+    d2y = (double) (y2 - y0) / SUBPIXEL_ONE;
+    inv_det = (double) (SUBPIXEL_ONE * SUBPIXEL_ONE) / (double) area;
+    ox = (double) (px - x0) / SUBPIXEL_ONE;
+    oy = (double) (py - y0) / SUBPIXEL_ONE;
+
+#define SETUP_GRADIENT(idx, field) \
+    SetupGradient(&grads[idx], v0->field, v1->field, v2->field, d1x, d1y, d2x, d2y, inv_det, ox, oy)
+
+    SETUP_GRADIENT(GRAD_R, color.r);
+    SETUP_GRADIENT(GRAD_G, color.g);
+    SETUP_GRADIENT(GRAD_B, color.b);
+    SETUP_GRADIENT(GRAD_A, color.a);
+    if (tex) {
+        const float w = (float) tex->width;
+        const float h = (float) tex->height;
+        SetupGradient(&grads[GRAD_U], v0->tex_coord.x * w, v1->tex_coord.x * w, v2->tex_coord.x * w,
+                      d1x, d1y, d2x, d2y, inv_det, ox, oy);
+        SetupGradient(&grads[GRAD_V], v0->tex_coord.y * h, v1->tex_coord.y * h, v2->tex_coord.y * h,
+                      d1x, d1y, d2x, d2y, inv_det, ox, oy);
+    }
+#undef SETUP_GRADIENT
+
+    constant = (SameColor(&v0->color, &v1->color) && SameColor(&v0->color, &v2->color) &&
+                (count < 4 || SameColor(&v0->color, &vert[3]->color))) ? SDL_TRUE : SDL_FALSE;
+    flat = (!tex && constant) ? SDL_TRUE : SDL_FALSE;
+    direct = (tex && tex->direct && constant &&
+              (blendMode == SDL_BLENDMODE_NONE || blendMode == SDL_BLENDMODE_BLEND)) ? SDL_TRUE : SDL_FALSE;
+    if (direct) {
+        const SDL_PixelFormat *fmt = tex->fmt;
+        modcolor = ((Uint32) v0->color.r << fmt->Rshift) | ((Uint32) v0->color.g << fmt->Gshift) |
+                   ((Uint32) v0->color.b << fmt->Bshift) | ((Uint32) v0->color.a << tex->ashift);
+        modulate = ((v0->color.r & v0->color.g & v0->color.b & v0->color.a) != 255) ? SDL_TRUE : SDL_FALSE;
+        du = (Sint64) (grads[GRAD_U].dx * 65536.0);
+        dv = (Sint64) (grads[GRAD_V].dx * 65536.0);
+    }
+    if (flat) {
+        const Uint32 color = ((Uint32) v0->color.a << 24) | ((Uint32) v0->color.r << 16) |
+                             ((Uint32) v0->color.g << 8) | v0->color.b;
+        for (i = 0; i <= maxx - minx; ++i) {
+            span[i] = color;
+        }
+    }
+
+    for (y = miny; y <= maxy; ++y) {
+        const Sint64 row = y - miny;
+        Sint64 kmin = 0;
+        Sint64 kmax = maxx - minx;
+        Uint8 *dstrow;
+
+        /* The pixels of this row covered by each edge function */
+        for (i = 0; i < count; ++i) {
+            TriEdge *edge = &edges[i];
+            if (edge->step_x > 0) {
+                kmin = SDL_max(kmin, edge->bound);
+                StepEdge(edge);
+            } else if (edge->step_x < 0) {
+                kmax = SDL_min(kmax, edge->bound);
+                StepEdge(edge);
+            } else if (edge->origin + edge->step_y * row < 0) {
+                kmax = -1;
+            }
+        }
+        if (kmin > kmax) {
+            continue;
+        }
+
+        x = minx + (int) kmin;
+        dstrow = (Uint8 *) dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel;
+        if (flat) {
+            BlendSpan(dstrow, dst->format, span, (int) (kmax - kmin + 1), blendMode);
+        } else if (direct) {
+            const double k = (double) kmin;
+            const Sint64 u = (Sint64) ((grads[GRAD_U].value + grads[GRAD_U].dx * k + grads[GRAD_U].dy * row) * 65536.0);
+            const Sint64 v = (Sint64) ((grads[GRAD_V].value + grads[GRAD_V].dx * k + grads[GRAD_V].dy * row) * 65536.0);
+            SampleSpanDirect(span, (int) (kmax - kmin + 1), u, v, du, dv, tex);
+            BlendSpanDirect((Uint32 *) dstrow, span, (int) (kmax - kmin + 1), tex, modcolor, modulate, blendMode);
+        } else {
+            if (tex) {
+                ShadeSpanTextured(span, (int) (kmax - kmin + 1), grads, (double) kmin, (double) row, tex);
+            } else {
+                ShadeSpanSolid(span, (int) (kmax - kmin + 1), grads, (double) kmin, (double) row);
+            }
+            BlendSpan(dstrow, dst->format, span, (int) (kmax - kmin + 1), blendMode);
+        }
+    }
+}
+
+/* Renders count / sides polygons of 'sides' vertices each */
+static int
+RenderPolygons(SDL_Surface * dst, SDL_Surface * src,
+               const SDL_Rect * srcrect, SDL_ScaleMode scaleMode,
+               const SDL_Vertex * vertices, int count, int sides,
+               SDL_BlendMode blendMode)
+{
+    const SDL_Vertex *polygon[4];
+    TriTexture tex;
+    Uint32 *span;
+    SDL_Rect area;
+    int i, j;
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+
+    if (dst->format->BytesPerPixel < 2) {
+        return SDL_SetError("Unsupported surface format for software rendering");
+    }
+
+    if (dst->clip_rect.w <= 0 || dst->clip_rect.h <= 0) {
+        return 0;
+    }
+
+    span = (Uint32 *) SDL_malloc(dst->clip_rect.w * sizeof (Uint32));
+    if (!span) {
+        return SDL_OutOfMemory();
+    }
+
+    if (src) {
+        SDL_PixelFormat *fmt = src->format;
+
+        area.x = area.y = 0;
+        area.w = src->w;
+        area.h = src->h;
+        if (srcrect && !SDL_IntersectRect(srcrect, &area, &area)) {
+            SDL_free(span);
+            return 0;
+        }
+        if (SDL_MUSTLOCK(src)) {
+            SDL_LockSurface(src);
+        }
+        tex.fmt = fmt;
+        tex.pixels = (const Uint8 *) src->pixels;
+        tex.pitch = src->pitch;
+        tex.bpp = fmt->BytesPerPixel;
+        tex.width = src->w;
+        tex.height = src->h;
+        tex.minx = area.x;
+        tex.miny = area.y;
+        tex.maxx = area.x + area.w - 1;
+        tex.maxy = area.y + area.h - 1;
+        tex.linear = (scaleMode != SDL_ScaleModeNearest) ? SDL_TRUE : SDL_FALSE;
+        tex.raw32 = (fmt->BytesPerPixel == 4 && !fmt->Rloss && !fmt->Gloss && !fmt->Bloss &&
+                     (!fmt->Amask || !fmt->Aloss)) ? SDL_TRUE : SDL_FALSE;
+
+        /* The direct path needs the color channels in the same bytes of
+           texels and target pixels, the remaining byte holds alpha if any */
+        tex.direct = SDL_FALSE;
+        if (tex.raw32 && dst->format->BytesPerPixel == 4 && dst->format->Rmask == fmt->Rmask &&
+            dst->format->Gmask == fmt->Gmask && dst->format->Bmask == fmt->Bmask) {
+            const Uint32 rest = ~(fmt->Rmask | fmt->Gmask | fmt->Bmask);
+            for (tex.ashift = 0; tex.ashift < 32; tex.ashift += 8) {
+                if (rest == ((Uint32) 0xFF << tex.ashift)) {
+                    break;
+                }
+            }
+            if (tex.ashift < 32 && (!dst->format->Amask || dst->format->Amask == rest)) {
+                tex.direct = SDL_TRUE;
+                tex.alpha_fill = fmt->Amask ? 0 : rest;
+                tex.dst_mask = dst->format->Amask ? 0xFFFFFFFF : ~rest;
+            }
+        }
+#if HAVE_SSE2_INTRINSICS
+        tex.simd = SDL_HasSSE2();
+#elif HAVE_NEON_INTRINSICS
+        tex.simd = SDL_HasNEON();
+#else
+        tex.simd = SDL_FALSE;
+#endif
+    }
+
+    for (i = 0; i + sides <= count; i += sides) {
+        for (j = 0; j < sides; ++j) {
+            polygon[j] = &vertices[i + j];
+        }
+        RenderPolygon(dst, src ? &tex : NULL, polygon, sides, blendMode, span);
+    }
+
+    if (src && SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+
+    SDL_free(span);
+    return 0;
+}
+
+int
+SDL_SW_RenderTriangles(SDL_Surface * dst, SDL_Surface * src,
+                       const SDL_Rect * srcrect, SDL_ScaleMode scaleMode,
+                       const SDL_Vertex * vertices, int count,
+                       SDL_BlendMode blendMode)
+{
+    return RenderPolygons(dst, src, srcrect, scaleMode, vertices, count, 3, blendMode);
+}
+
+int
+SDL_SW_RenderQuad(SDL_Surface * dst, SDL_Surface * src,
+                  const SDL_Rect * srcrect, SDL_ScaleMode scaleMode,
+                  const SDL_Vertex * vertices, SDL_BlendMode blendMode)
+{
+    return RenderPolygons(dst, src, srcrect, scaleMode, vertices, 4, 4, blendMode);
+}
+
+#endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,52 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef SDL_triangle_h_
+#define SDL_triangle_h_
+
+#include "../../SDL_internal.h"
+
+#include "SDL_render.h"
+
+/* Rasterize 'count' / 3 triangles into dst, clipped to dst->clip_rect.
+ * Vertex positions are in dst pixel coordinates, colors are applied per vertex
+ * and texture coordinates are normalized to the size of src (may be NULL).
+ * Texels outside of srcrect (NULL for the whole surface) are never sampled,
+ * scaleMode selects nearest or bilinear sampling.
+ */
+extern int SDL_SW_RenderTriangles(SDL_Surface * dst, SDL_Surface * src,
+                                  const SDL_Rect * srcrect, SDL_ScaleMode scaleMode,
+                                  const SDL_Vertex * vertices, int count,
+                                  SDL_BlendMode blendMode);
+
+/* Rasterize the convex quad of the 4 vertices, given in order around it, in
+ * one pass. Colors and texture coordinates are interpolated over the plane of
+ * the first three vertices, so they must be affine over the quad, as they are
+ * for a rotated or scaled rectangle.
+ */
+extern int SDL_SW_RenderQuad(SDL_Surface * dst, SDL_Surface * src,
+                             const SDL_Rect * srcrect, SDL_ScaleMode scaleMode,
+                             const SDL_Vertex * vertices, SDL_BlendMode blendMode);
+
+#endif /* SDL_triangle_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -29,6 +29,7 @@
 
 #include "SDL_stdinc.h"
 #include "SDL_endian.h"
+#include "SDL_cpuinfo.h"
 
 #if defined(HAVE_ICONV) && defined(HAVE_ICONV_H)
 #include <iconv.h>
@@ -97,6 +98,14 @@ SDL_iconv(SDL_iconv_t cd,
 #define UNKNOWN_ASCII    '?'
 #define UNKNOWN_UNICODE    0xFFFD
 
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
 enum
 {
     ENCODING_UNKNOWN,
@@ -244,6 +253,735 @@ SDL_iconv_open(const char *tocode, const char *fromcode)
     return (SDL_iconv_t) - 1;
 }
 
+/* Bulk converters for the common Unicode pairs.  Each one converts as many
+   characters as it can with exactly the result the character at a time loop
+   in SDL_iconv() would give, and stops at anything that loop has to handle
+   itself: malformed or truncated input, characters that get replaced, and
+   output that doesn't fit.  Runs of ASCII, which is most of what goes through
+   here, are converted 16 characters at a time.
+ */
+enum
+{
+    FASTPATH_NONE,
+    FASTPATH_ASCII,             /* 8-bit to 8-bit, copies bytes below 0x80 */
+    FASTPATH_UTF8_UTF16,
+    FASTPATH_UTF8_UTF32,
+    FASTPATH_UTF16_UTF8,
+    FASTPATH_UTF32_UTF8
+};
+
+/* Length of a well-formed UTF-8 sequence by its first byte, or 0 if the
+   byte can't start one: continuation bytes, the overlong C0 and C1, and
+   F5 and up, which would be above U+10FFFF.
+ */
+static const Uint8 utf8_sequence_length[256] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* Decodes one well-formed UTF-8 sequence, returning its length, or 0 if the
+   slow path has to look at it */
+static SDL_INLINE size_t
+UTF8_Decode(const Uint8 *p, size_t len, Uint32 *ch)
+{
+    const size_t n = utf8_sequence_length[p[0]];
+    Uint8 lo = 0x80, hi = 0xBF;
+
+    if (n == 0 || n > len) {
+        return 0;
+    }
+
+    /* Second byte ranges that rule out overlong forms, surrogates and
+       values above U+10FFFF, from RFC 3629 section 4 */
+    switch (p[0]) {
+    case 0xE0:
+        lo = 0xA0;
+        break;
+    case 0xED:
+        hi = 0x9F;
+        break;
+    case 0xF0:
+        lo = 0x90;
+        break;
+    case 0xF4:
+        hi = 0x8F;
+        break;
+    }
+
+    switch (n) {
+    case 1:
+        *ch = p[0];
+        return 1;
+    case 2:
+        if ((p[1] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *ch = ((Uint32) (p[0] & 0x1F) << 6) | (Uint32) (p[1] & 0x3F);
+        return 2;
+    case 3:
+        if (p[1] < lo || p[1] > hi || (p[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *ch = ((Uint32) (p[0] & 0x0F) << 12) |
+              ((Uint32) (p[1] & 0x3F) << 6) | (Uint32) (p[2] & 0x3F);
+        if (*ch >= 0xFFFE) {
+            /* U+FFFE and U+FFFF are replaced by the slow path */
+            return 0;
+        }
+        return 3;
+    default:
+        if (p[1] < lo || p[1] > hi ||
+            (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *ch = ((Uint32) (p[0] & 0x07) << 18) | ((Uint32) (p[1] & 0x3F) << 12) |
+              ((Uint32) (p[2] & 0x3F) << 6) | (Uint32) (p[3] & 0x3F);
+        return 4;
+    }
+}
+
+/* Encodes a character up to U+10FFFF, returning the bytes written, or 0 if
+   there isn't room */
+static SDL_INLINE size_t
+UTF8_Encode(Uint32 ch, Uint8 *p, size_t len)
+{
+    if (ch <= 0x7F) {
+        if (len < 1) {
+            return 0;
+        }
+        p[0] = (Uint8) ch;
+        return 1;
+    } else if (ch <= 0x7FF) {
+        if (len < 2) {
+            return 0;
+        }
+        p[0] = 0xC0 | (Uint8) (ch >> 6);
+        p[1] = 0x80 | (Uint8) (ch & 0x3F);
+        return 2;
+    } else if (ch <= 0xFFFF) {
+        if (len < 3) {
+            return 0;
+        }
+        p[0] = 0xE0 | (Uint8) (ch >> 12);
+        p[1] = 0x80 | (Uint8) ((ch >> 6) & 0x3F);
+        p[2] = 0x80 | (Uint8) (ch & 0x3F);
+        return 3;
+    } else {
+        if (len < 4) {
+            return 0;
+        }
+        p[0] = 0xF0 | (Uint8) (ch >> 18);
+        p[1] = 0x80 | (Uint8) ((ch >> 12) & 0x3F);
+        p[2] = 0x80 | (Uint8) ((ch >> 6) & 0x3F);
+        p[3] = 0x80 | (Uint8) (ch & 0x3F);
+        return 4;
+    }
+}
+
+static SDL_INLINE Uint32
+Read16(const Uint8 *p, SDL_bool bigendian)
+{
+    return bigendian ? (((Uint32) p[0] << 8) | p[1]) : (((Uint32) p[1] << 8) | p[0]);
+}
+
+static SDL_INLINE Uint32
+Read32(const Uint8 *p, SDL_bool bigendian)
+{
+    if (bigendian) {
+        return ((Uint32) p[0] << 24) | ((Uint32) p[1] << 16) | ((Uint32) p[2] << 8) | p[3];
+    }
+    return ((Uint32) p[3] << 24) | ((Uint32) p[2] << 16) | ((Uint32) p[1] << 8) | p[0];
+}
+
+static SDL_INLINE void
+Write16(Uint8 *p, Uint32 w, SDL_bool bigendian)
+{
+    p[bigendian ? 0 : 1] = (Uint8) (w >> 8);
+    p[bigendian ? 1 : 0] = (Uint8) w;
+}
+
+static SDL_INLINE void
+Write32(Uint8 *p, Uint32 ch, SDL_bool bigendian)
+{
+    if (bigendian) {
+        p[0] = (Uint8) (ch >> 24);
+        p[1] = (Uint8) (ch >> 16);
+        p[2] = (Uint8) (ch >> 8);
+        p[3] = (Uint8) ch;
+    } else {
+        p[3] = (Uint8) (ch >> 24);
+        p[2] = (Uint8) (ch >> 16);
+        p[1] = (Uint8) (ch >> 8);
+        p[0] = (Uint8) ch;
+    }
+}
+
+#if HAVE_NEON_INTRINSICS
+static SDL_INLINE SDL_bool
+NEON_IsASCII(uint8x16_t v)
+{
+    const uint8x8_t any = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+    return (vget_lane_u64(vreinterpret_u64_u8(any), 0) & 0x8080808080808080ULL) == 0;
+}
+#endif
+
+/* Counts the bytes below 0x80 at the start of src */
+static size_t
+ASCIIPrefix(const Uint8 *src, size_t len)
+{
+    size_t i = 0;
+
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        while (i + 16 <= len &&
+               _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (src + i))) == 0) {
+            i += 16;
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        while (i + 16 <= len && NEON_IsASCII(vld1q_u8(src + i))) {
+            i += 16;
+        }
+    }
+#endif
+    while (i < len && src[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+static size_t
+Convert_ASCII(const Uint8 **psrc, size_t *psrclen, Uint8 **pdst, size_t *pdstlen)
+{
+    const size_t n = ASCIIPrefix(*psrc, SDL_min(*psrclen, *pdstlen));
+
+    SDL_memcpy(*pdst, *psrc, n);
+    *psrc += n;
+    *psrclen -= n;
+    *pdst += n;
+    *pdstlen -= n;
+    return n;
+}
+
+static size_t
+Convert_UTF8_UTF16(const Uint8 **psrc, size_t *psrclen, Uint8 **pdst, size_t *pdstlen,
+                   SDL_bool bigendian, SDL_bool ucs2)
+{
+    const Uint8 *src = *psrc;
+    size_t srclen = *psrclen;
+    Uint8 *dst = *pdst;
+    size_t dstlen = *pdstlen;
+    size_t total = 0;
+#if HAVE_SSE2_INTRINSICS
+    const SDL_bool sse2 = SDL_HasSSE2();
+#endif
+#if HAVE_NEON_INTRINSICS
+    const SDL_bool neon = SDL_HasNEON();
+#endif
+
+    while (srclen > 0) {
+        Uint32 ch;
+        size_t n;
+
+#if HAVE_SSE2_INTRINSICS
+        if (sse2) {
+            const __m128i zero = _mm_setzero_si128();
+            while (srclen >= 16 && dstlen >= 32) {
+                const __m128i v = _mm_loadu_si128((const __m128i *) src);
+                if (_mm_movemask_epi8(v) != 0) {
+                    break;
+                }
+                if (bigendian) {
+                    _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi8(zero, v));
+                    _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi8(zero, v));
+                } else {
+                    _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi8(v, zero));
+                    _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi8(v, zero));
+                }
+                src += 16;
+                srclen -= 16;
+                dst += 32;
+                dstlen -= 32;
+                total += 16;
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (neon) {
+            while (srclen >= 16 && dstlen >= 32) {
+                const uint8x16_t v = vld1q_u8(src);
+                uint8x16_t lo, hi;
+                if (!NEON_IsASCII(v)) {
+                    break;
+                }
+                lo = vreinterpretq_u8_u16(vmovl_u8(vget_low_u8(v)));
+                hi = vreinterpretq_u8_u16(vmovl_u8(vget_high_u8(v)));
+                if (bigendian) {
+                    lo = vrev16q_u8(lo);
+                    hi = vrev16q_u8(hi);
+                }
+                vst1q_u8(dst, lo);
+                vst1q_u8(dst + 16, hi);
+                src += 16;
+                srclen -= 16;
+                dst += 32;
+                dstlen -= 32;
+                total += 16;
+            }
+        }
+#endif
+        if (srclen == 0) {
+            break;
+        }
+
+        n = UTF8_Decode(src, srclen, &ch);
+        if (n == 0) {
+            break;
+        }
+        if (ch < 0x10000) {
+            if (dstlen < 2) {
+                break;
+            }
+            Write16(dst, ch, bigendian);
+            dst += 2;
+            dstlen -= 2;
+        } else {
+            if (ucs2 || dstlen < 4) {
+                break;
+            }
+            ch -= 0x10000;
+            Write16(dst, 0xD800 | (ch >> 10), bigendian);
+            Write16(dst + 2, 0xDC00 | (ch & 0x3FF), bigendian);
+            dst += 4;
+            dstlen -= 4;
+        }
+        src += n;
+        srclen -= n;
+        ++total;
+    }
+
+    *psrc = src;
+    *psrclen = srclen;
+    *pdst = dst;
+    *pdstlen = dstlen;
+    return total;
+}
+
+static size_t
+Convert_UTF8_UTF32(const Uint8 **psrc, size_t *psrclen, Uint8 **pdst, size_t *pdstlen,
+                   SDL_bool bigendian)
+{
+    const Uint8 *src = *psrc;
+    size_t srclen = *psrclen;
+    Uint8 *dst = *pdst;
+    size_t dstlen = *pdstlen;
+    size_t total = 0;
+#if HAVE_SSE2_INTRINSICS
+    const SDL_bool sse2 = SDL_HasSSE2();
+#endif
+#if HAVE_NEON_INTRINSICS
+    const SDL_bool neon = SDL_HasNEON();
+#endif
+
+    while (srclen > 0) {
+        Uint32 ch;
+        size_t n;
+
+#if HAVE_SSE2_INTRINSICS
+        if (sse2) {
+            const __m128i zero = _mm_setzero_si128();
+            while (srclen >= 16 && dstlen >= 64) {
+                const __m128i v = _mm_loadu_si128((const __m128i *) src);
+                __m128i lo, hi;
+                if (_mm_movemask_epi8(v) != 0) {
+                    break;
+                }
+                if (bigendian) {
+                    lo = _mm_unpacklo_epi8(zero, v);
+                    hi = _mm_unpackhi_epi8(zero, v);
+                    _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi16(zero, lo));
+                    _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi16(zero, lo));
+                    _mm_storeu_si128((__m128i *) (dst + 32), _mm_unpacklo_epi16(zero, hi));
+                    _mm_storeu_si128((__m128i *) (dst + 48), _mm_unpackhi_epi16(zero, hi));
+                } else {
+                    lo = _mm_unpacklo_epi8(v, zero);
+                    hi = _mm_unpackhi_epi8(v, zero);
+                    _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi16(lo, zero));
+                    _mm_storeu_si128((__m128i *) (dst + 16), _mm_unpackhi_epi16(lo, zero));
+                    _mm_storeu_si128((__m128i *) (dst + 32), _mm_unpacklo_epi16(hi, zero));
+                    _mm_storeu_si128((__m128i *) (dst + 48), _mm_unpackhi_epi16(hi, zero));
+                }
+                src += 16;
+                srclen -= 16;
+                dst += 64;
+                dstlen -= 64;
+                total += 16;
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (neon) {
+            while (srclen >= 16 && dstlen >= 64) {
+                const uint8x16_t v = vld1q_u8(src);
+                uint16x8_t lo, hi;
+                uint8x16_t out[4];
+                int i;
+                if (!NEON_IsASCII(v)) {
+                    break;
+                }
+                lo = vmovl_u8(vget_low_u8(v));
+                hi = vmovl_u8(vget_high_u8(v));
+                out[0] = vreinterpretq_u8_u32(vmovl_u16(vget_low_u16(lo)));
+                out[1] = vreinterpretq_u8_u32(vmovl_u16(vget_high_u16(lo)));
+                out[2] = vreinterpretq_u8_u32(vmovl_u16(vget_low_u16(hi)));
+                out[3] = vreinterpretq_u8_u32(vmovl_u16(vget_high_u16(hi)));
+                for (i = 0; i < 4; ++i) {
+                    vst1q_u8(dst + i * 16, bigendian ? vrev32q_u8(out[i]) : out[i]);
+                }
+                src += 16;
+                srclen -= 16;
+                dst += 64;
+                dstlen -= 64;
+                total += 16;
+            }
+        }
+#endif
+        if (srclen == 0) {
+            break;
+        }
+
+        n = UTF8_Decode(src, srclen, &ch);
+        if (n == 0 || dstlen < 4) {
+            break;
+        }
+        Write32(dst, ch, bigendian);
+        src += n;
+        srclen -= n;
+        dst += 4;
+        dstlen -= 4;
+        ++total;
+    }
+
+    *psrc = src;
+    *psrclen = srclen;
+    *pdst = dst;
+    *pdstlen = dstlen;
+    return total;
+}
+
+static size_t
+Convert_UTF16_UTF8(const Uint8 **psrc, size_t *psrclen, Uint8 **pdst, size_t *pdstlen,
+                   SDL_bool bigendian, SDL_bool ucs2)
+{
+    const Uint8 *src = *psrc;
+    size_t srclen = *psrclen;
+    Uint8 *dst = *pdst;
+    size_t dstlen = *pdstlen;
+    size_t total = 0;
+#if HAVE_SSE2_INTRINSICS
+    const SDL_bool sse2 = SDL_HasSSE2();
+#endif
+#if HAVE_NEON_INTRINSICS
+    const SDL_bool neon = SDL_HasNEON();
+#endif
+
+    while (srclen >= 2) {
+        Uint32 ch;
+        size_t n = 2, written;
+
+#if HAVE_SSE2_INTRINSICS
+        if (sse2) {
+            /* A unit is ASCII if none of its bits above the low 7 are set */
+            const __m128i nonascii = _mm_set1_epi16(bigendian ? 0x80FF : 0xFF80);
+            const __m128i zero = _mm_setzero_si128();
+            while (srclen >= 32 && dstlen >= 16) {
+                __m128i a = _mm_loadu_si128((const __m128i *) src);
+                __m128i b = _mm_loadu_si128((const __m128i *) (src + 16));
+                const __m128i test = _mm_and_si128(_mm_or_si128(a, b), nonascii);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(test, zero)) != 0xFFFF) {
+                    break;
+                }
+                if (bigendian) {
+                    a = _mm_srli_epi16(a, 8);
+                    b = _mm_srli_epi16(b, 8);
+                }
+                _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(a, b));
+                src += 32;
+                srclen -= 32;
+                dst += 16;
+                dstlen -= 16;
+                total += 16;
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (neon) {
+            const uint16x8_t nonascii = vdupq_n_u16(0xFF80);
+            while (srclen >= 32 && dstlen >= 16) {
+                uint8x16_t a = vld1q_u8(src);
+                uint8x16_t b = vld1q_u8(src + 16);
+                uint16x8_t wa, wb, test;
+                uint8x8_t any;
+                if (bigendian) {
+                    a = vrev16q_u8(a);
+                    b = vrev16q_u8(b);
+                }
+                wa = vreinterpretq_u16_u8(a);
+                wb = vreinterpretq_u16_u8(b);
+                test = vandq_u16(vorrq_u16(wa, wb), nonascii);
+                any = vmovn_u16(vorrq_u16(test, vshrq_n_u16(test, 8)));
+                if (vget_lane_u64(vreinterpret_u64_u8(any), 0) != 0) {
+                    break;
+                }
+                vst1q_u8(dst, vcombine_u8(vmovn_u16(wa), vmovn_u16(wb)));
+                src += 32;
+                srclen -= 32;
+                dst += 16;
+                dstlen -= 16;
+                total += 16;
+            }
+        }
+#endif
+        if (srclen < 2) {
+            break;
+        }
+
+        ch = Read16(src, bigendian);
+        if (!ucs2 && ch >= 0xD800 && ch <= 0xDFFF) {
+            Uint32 W2;
+            if (ch > 0xDBFF || srclen < 4) {
+                break;
+            }
+            W2 = Read16(src + 2, bigendian);
+            if (W2 < 0xDC00 || W2 > 0xDFFF) {
+                break;
+            }
+            ch = (((ch & 0x3FF) << 10) | (W2 & 0x3FF)) + 0x10000;
+            n = 4;
+        }
+        written = UTF8_Encode(ch, dst, dstlen);
+        if (written == 0) {
+            break;
+        }
+        src += n;
+        srclen -= n;
+        dst += written;
+        dstlen -= written;
+        ++total;
+    }
+
+    *psrc = src;
+    *psrclen = srclen;
+    *pdst = dst;
+    *pdstlen = dstlen;
+    return total;
+}
+
+static size_t
+Convert_UTF32_UTF8(const Uint8 **psrc, size_t *psrclen, Uint8 **pdst, size_t *pdstlen,
+                   SDL_bool bigendian)
+{
+    const Uint8 *src = *psrc;
+    size_t srclen = *psrclen;
+    Uint8 *dst = *pdst;
+    size_t dstlen = *pdstlen;
+    size_t total = 0;
+#if HAVE_SSE2_INTRINSICS
+    const SDL_bool sse2 = SDL_HasSSE2();
+#endif
+#if HAVE_NEON_INTRINSICS
+    const SDL_bool neon = SDL_HasNEON();
+#endif
+
+    while (srclen >= 4) {
+        Uint32 ch;
+        size_t written;
+
+#if HAVE_SSE2_INTRINSICS
+        if (sse2) {
+            const __m128i nonascii = _mm_set1_epi32(bigendian ? 0x80FFFFFF : 0xFFFFFF80);
+            const __m128i zero = _mm_setzero_si128();
+            while (srclen >= 64 && dstlen >= 16) {
+                __m128i a = _mm_loadu_si128((const __m128i *) src);
+                __m128i b = _mm_loadu_si128((const __m128i *) (src + 16));
+                __m128i c = _mm_loadu_si128((const __m128i *) (src + 32));
+                __m128i d = _mm_loadu_si128((const __m128i *) (src + 48));
+                const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+                const __m128i test = _mm_and_si128(any, nonascii);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(test, zero)) != 0xFFFF) {
+                    break;
+                }
+                if (bigendian) {
+                    a = _mm_srli_epi32(a, 24);
+                    b = _mm_srli_epi32(b, 24);
+                    c = _mm_srli_epi32(c, 24);
+                    d = _mm_srli_epi32(d, 24);
+                }
+                _mm_storeu_si128((__m128i *) dst,
+                                 _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+                src += 64;
+                srclen -= 64;
+                dst += 16;
+                dstlen -= 16;
+                total += 16;
+            }
+        }
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (neon) {
+            const uint32x4_t nonascii = vdupq_n_u32(0xFFFFFF80);
+            while (srclen >= 64 && dstlen >= 16) {
+                uint32x4_t w[4];
+                uint32x4_t test;
+                int i;
+                for (i = 0; i < 4; ++i) {
+                    const uint8x16_t v = vld1q_u8(src + i * 16);
+                    w[i] = vreinterpretq_u32_u8(bigendian ? vrev32q_u8(v) : v);
+                }
+                test = vandq_u32(vorrq_u32(vorrq_u32(w[0], w[1]), vorrq_u32(w[2], w[3])), nonascii);
+                if ((vgetq_lane_u32(test, 0) | vgetq_lane_u32(test, 1) |
+                     vgetq_lane_u32(test, 2) | vgetq_lane_u32(test, 3)) != 0) {
+                    break;
+                }
+                vst1q_u8(dst, vcombine_u8(
+                    vmovn_u16(vcombine_u16(vmovn_u32(w[0]), vmovn_u32(w[1]))),
+                    vmovn_u16(vcombine_u16(vmovn_u32(w[2]), vmovn_u32(w[3])))));
+                src += 64;
+                srclen -= 64;
+                dst += 16;
+                dstlen -= 16;
+                total += 16;
+            }
+        }
+#endif
+        if (srclen < 4) {
+            break;
+        }
+
+        ch = Read32(src, bigendian);
+        if (ch > 0x10FFFF) {
+            break;
+        }
+        written = UTF8_Encode(ch, dst, dstlen);
+        if (written == 0) {
+            break;
+        }
+        src += 4;
+        srclen -= 4;
+        dst += written;
+        dstlen -= written;
+        ++total;
+    }
+
+    *psrc = src;
+    *psrclen = srclen;
+    *pdst = dst;
+    *pdstlen = dstlen;
+    return total;
+}
+
+static int
+GetFastPath(int src_fmt, int dst_fmt)
+{
+    switch (src_fmt) {
+    case ENCODING_ASCII:
+    case ENCODING_LATIN1:
+    case ENCODING_UTF8:
+        switch (dst_fmt) {
+        case ENCODING_ASCII:
+        case ENCODING_LATIN1:
+        case ENCODING_UTF8:
+            return FASTPATH_ASCII;
+        case ENCODING_UTF16BE:
+        case ENCODING_UTF16LE:
+        case ENCODING_UCS2BE:
+        case ENCODING_UCS2LE:
+            return (src_fmt == ENCODING_UTF8) ? FASTPATH_UTF8_UTF16 : FASTPATH_NONE;
+        case ENCODING_UTF32BE:
+        case ENCODING_UTF32LE:
+        case ENCODING_UCS4BE:
+        case ENCODING_UCS4LE:
+            return (src_fmt == ENCODING_UTF8) ? FASTPATH_UTF8_UTF32 : FASTPATH_NONE;
+        }
+        break;
+    case ENCODING_UTF16BE:
+    case ENCODING_UTF16LE:
+    case ENCODING_UCS2BE:
+    case ENCODING_UCS2LE:
+        if (dst_fmt == ENCODING_UTF8) {
+            return FASTPATH_UTF16_UTF8;
+        }
+        break;
+    case ENCODING_UTF32BE:
+    case ENCODING_UTF32LE:
+    case ENCODING_UCS4BE:
+    case ENCODING_UCS4LE:
+        if (dst_fmt == ENCODING_UTF8) {
+            return FASTPATH_UTF32_UTF8;
+        }
+        break;
+    }
+    return FASTPATH_NONE;
+}
+
+static SDL_bool
+IsBigEndian(int fmt)
+{
+    return (fmt == ENCODING_UTF16BE || fmt == ENCODING_UCS2BE ||
+            fmt == ENCODING_UTF32BE || fmt == ENCODING_UCS4BE) ? SDL_TRUE : SDL_FALSE;
+}
+
+static SDL_bool
+IsUCS2(int fmt)
+{
+    return (fmt == ENCODING_UCS2BE || fmt == ENCODING_UCS2LE) ? SDL_TRUE : SDL_FALSE;
+}
+
+static size_t
+ConvertFast(SDL_iconv_t cd, int fastpath, const char **src, size_t *srclen, char **dst, size_t *dstlen)
+{
+    const Uint8 *in = (const Uint8 *) *src;
+    Uint8 *out = (Uint8 *) *dst;
+    size_t total = 0;
+
+    switch (fastpath) {
+    case FASTPATH_ASCII:
+        total = Convert_ASCII(&in, srclen, &out, dstlen);
+        break;
+    case FASTPATH_UTF8_UTF16:
+        total = Convert_UTF8_UTF16(&in, srclen, &out, dstlen, IsBigEndian(cd->dst_fmt), IsUCS2(cd->dst_fmt));
+        break;
+    case FASTPATH_UTF8_UTF32:
+        total = Convert_UTF8_UTF32(&in, srclen, &out, dstlen, IsBigEndian(cd->dst_fmt));
+        break;
+    case FASTPATH_UTF16_UTF8:
+        total = Convert_UTF16_UTF8(&in, srclen, &out, dstlen, IsBigEndian(cd->src_fmt), IsUCS2(cd->src_fmt));
+        break;
+    case FASTPATH_UTF32_UTF8:
+        total = Convert_UTF32_UTF8(&in, srclen, &out, dstlen, IsBigEndian(cd->src_fmt));
+        break;
+    }
+    *src = (const char *) in;
+    *dst = (char *) out;
+    return total;
+}
+
 size_t
 SDL_iconv(SDL_iconv_t cd,
           const char **inbuf, size_t * inbytesleft,
@@ -255,6 +993,7 @@ SDL_iconv(SDL_iconv_t cd,
     size_t srclen, dstlen;
     Uint32 ch = 0;
     size_t total;
+    int fastpath;
 
     if (!inbuf || !*inbuf) {
         /* Reset the context */
@@ -340,8 +1079,22 @@ SDL_iconv(SDL_iconv_t cd,
         break;
     }
 
+    fastpath = GetFastPath(cd->src_fmt, cd->dst_fmt);
+
     total = 0;
     while (srclen > 0) {
+        if (fastpath != FASTPATH_NONE) {
+            const size_t converted = ConvertFast(cd, fastpath, &src, &srclen, &dst, &dstlen);
+            if (converted > 0) {
+                *inbuf = src;
+                *inbytesleft = srclen;
+                *outbuf = dst;
+                *outbytesleft = dstlen;
+                total += converted;
+                continue;
+            }
+        }
+
         /* Decode a character */
         switch (cd->src_fmt) {
         case ENCODING_ASCII:
@@ -0,0 +1,459 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+
+ Used by benchmark programs to time code and compare against earlier runs.
+
+*/
+
+/* sched_setaffinity() needs this */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "SDL_config.h"
+
+#include "SDL_test.h"
+
+#if defined(__LINUX__)
+#include <sched.h>
+#endif
+
+/* Calibration stops growing the iteration count here */
+#define SDLTEST_BENCHMARK_MAX_ITERATIONS (1 << 30)
+
+void
+SDLTest_BenchmarkInit(SDLTest_BenchmarkContext *context)
+{
+    SDL_zerop(context);
+    context->sampleTime = 0.01;
+    context->warmupSamples = 3;
+    context->samples = 31;
+    context->threshold = 0.05;
+}
+
+void
+SDLTest_BenchmarkQuit(SDLTest_BenchmarkContext *context)
+{
+    SDL_free(context->results);
+    SDL_free(context->baselines);
+    context->results = NULL;
+    context->baselines = NULL;
+    context->numResults = 0;
+    context->numBaselines = 0;
+}
+
+int
+SDLTest_BenchmarkPinThread(int cpu)
+{
+#if defined(__LINUX__)
+    cpu_set_t set;
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        SDLTest_LogError("Invalid CPU %d", cpu);
+        return -1;
+    }
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof (set), &set) < 0) {
+        SDLTest_LogError("Failed to pin thread to CPU %d", cpu);
+        return -1;
+    }
+    return 0;
+#else
+    SDLTest_LogError("Pinning threads to a CPU is not supported on this platform");
+    return -1;
+#endif
+}
+
+/* Times one sample, in seconds */
+static double
+SDLTest_TimeSample(SDLTest_BenchmarkFp benchmark, void *arg, int iterations)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    benchmark(arg, iterations);
+    return (double) (SDL_GetPerformanceCounter() - start) / (double) SDL_GetPerformanceFrequency();
+}
+
+static int SDLCALL
+SDLTest_CompareDoubles(const void *a, const void *b)
+{
+    const double x = *(const double *) a;
+    const double y = *(const double *) b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/* Percentile of sorted values, interpolating between the two closest */
+static double
+SDLTest_Percentile(const double *sorted, int count, double percentile)
+{
+    const double position = percentile * (count - 1);
+    const int index = (int) position;
+
+    if (index + 1 >= count) {
+        return sorted[count - 1];
+    }
+    return sorted[index] + (sorted[index + 1] - sorted[index]) * (position - index);
+}
+
+static const SDLTest_BenchmarkResult *
+SDLTest_FindResult(const SDLTest_BenchmarkResult *results, int count, const char *name)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (SDL_strcmp(results[i].name, name) == 0) {
+            return &results[i];
+        }
+    }
+    return NULL;
+}
+
+const SDLTest_BenchmarkResult *
+SDLTest_RunBenchmark(SDLTest_BenchmarkContext *context, const char *name, SDLTest_BenchmarkFp benchmark, void *arg)
+{
+    SDLTest_BenchmarkResult result;
+    SDLTest_BenchmarkResult *results;
+    const SDLTest_BenchmarkResult *baseline;
+    double *samples;
+    double elapsed;
+    int iterations;
+    int i;
+
+    if (context == NULL || name == NULL || benchmark == NULL) {
+        SDLTest_LogError("Invalid benchmark parameters");
+        return NULL;
+    }
+
+    if (context->filter != NULL && SDL_strstr(name, context->filter) == NULL) {
+        return NULL;
+    }
+
+    SDL_zero(result);
+    SDL_strlcpy(result.name, name, sizeof (result.name));
+    result.samples = SDL_max(context->samples, 1);
+
+    samples = (double *) SDL_malloc(result.samples * sizeof (double));
+    results = (SDLTest_BenchmarkResult *) SDL_realloc(context->results, (context->numResults + 1) * sizeof (*results));
+    if (samples == NULL || results == NULL) {
+        SDLTest_LogError("Failed to allocate benchmark samples");
+        SDL_Error(SDL_ENOMEM);
+        SDL_free(samples);
+        if (results != NULL) {
+            context->results = results;
+        }
+        return NULL;
+    }
+    context->results = results;
+
+    /* Find an iteration count that makes a sample long enough to time reliably.
+       This also warms up caches and branch predictors. */
+    iterations = 1;
+    for ( ; ; ) {
+        double scale;
+
+        elapsed = SDLTest_TimeSample(benchmark, arg, iterations);
+        if (elapsed >= context->sampleTime || iterations >= SDLTEST_BENCHMARK_MAX_ITERATIONS) {
+            break;
+        }
+
+        /* Aim a little past the target, growing at least 2x and at most 10x per step */
+        scale = (elapsed > 0.0) ? (context->sampleTime * 1.2) / elapsed : 10.0;
+        scale = SDL_max(scale, 2.0);
+        scale = SDL_min(scale, 10.0);
+        if (iterations * scale >= SDLTEST_BENCHMARK_MAX_ITERATIONS) {
+            iterations = SDLTEST_BENCHMARK_MAX_ITERATIONS;
+        } else {
+            iterations = (int) (iterations * scale);
+        }
+    }
+    result.iterations = iterations;
+
+    for (i = 0; i < context->warmupSamples; i++) {
+        SDLTest_TimeSample(benchmark, arg, iterations);
+    }
+
+    for (i = 0; i < result.samples; i++) {
+        samples[i] = SDLTest_TimeSample(benchmark, arg, iterations) * 1000000000.0 / iterations;
+    }
+
+    SDL_qsort(samples, result.samples, sizeof (double), SDLTest_CompareDoubles);
+    result.min = samples[0];
+    result.max = samples[result.samples - 1];
+    result.median = SDLTest_Percentile(samples, result.samples, 0.5);
+    result.p10 = SDLTest_Percentile(samples, result.samples, 0.1);
+    result.p90 = SDLTest_Percentile(samples, result.samples, 0.9);
+
+    /* Reuse the samples for their deviations from the median */
+    for (i = 0; i < result.samples; i++) {
+        samples[i] = SDL_fabs(samples[i] - result.median);
+    }
+    SDL_qsort(samples, result.samples, sizeof (double), SDLTest_CompareDoubles);
+    result.mad = SDLTest_Percentile(samples, result.samples, 0.5);
+    SDL_free(samples);
+
+    baseline = SDLTest_FindResult(context->baselines, context->numBaselines, name);
+    if (baseline) {
+        result.baseline = baseline->median;
+        SDLTest_Log("%-36s %12.2f ns/iter  MAD %8.2f  p10 %10.2f  p90 %10.2f  %+7.1f%% vs baseline",
+            result.name, result.median, result.mad, result.p10, result.p90,
+            (result.baseline > 0.0) ? (result.median / result.baseline - 1.0) * 100.0 : 0.0);
+    } else {
+        SDLTest_Log("%-36s %12.2f ns/iter  MAD %8.2f  p10 %10.2f  p90 %10.2f",
+            result.name, result.median, result.mad, result.p10, result.p90);
+    }
+
+    context->results[context->numResults] = result;
+    return &context->results[context->numResults++];
+}
+
+int
+SDLTest_BenchmarkRegressions(SDLTest_BenchmarkContext *context)
+{
+    int regressions = 0;
+    int i;
+
+    for (i = 0; i < context->numResults; i++) {
+        const SDLTest_BenchmarkResult *result = &context->results[i];
+        const double slowdown = result->median - result->baseline;
+
+        /* Slower by more than the threshold, and by more than the noise */
+        if (result->baseline > 0.0 &&
+            slowdown > result->baseline * context->threshold &&
+            slowdown > result->mad * 3.0) {
+            SDLTest_LogError("Regression: %s takes %.2f ns/iter, baseline %.2f ns/iter (%+.1f%%)",
+                result->name, result->median, result->baseline, (slowdown / result->baseline) * 100.0);
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+/* Reads the string value after a "key": in a JSON object, returns a pointer past it or NULL */
+static const char *
+SDLTest_ParseString(const char *json, const char *key, char *value, size_t maxlen)
+{
+    const char *found = SDL_strstr(json, key);
+    size_t length = 0;
+
+    if (found == NULL) {
+        return NULL;
+    }
+    found = SDL_strchr(found + SDL_strlen(key), '"');
+    if (found == NULL) {
+        return NULL;
+    }
+
+    for (++found; *found && *found != '"'; ++found) {
+        if (*found == '\\' && found[1]) {
+            ++found;
+        }
+        if (length + 1 < maxlen) {
+            value[length++] = *found;
+        }
+    }
+    value[length] = '\0';
+    return *found ? found + 1 : NULL;
+}
+
+/* Reads the number after a "key": that comes before the end of the object */
+static double
+SDLTest_ParseNumber(const char *json, const char *key)
+{
+    const char *found = SDL_strstr(json, key);
+    const char *end = SDL_strchr(json, '}');
+
+    if (found == NULL || (end != NULL && found > end)) {
+        return 0.0;
+    }
+    found = SDL_strchr(found + SDL_strlen(key), ':');
+    return found ? SDL_strtod(found + 1, NULL) : 0.0;
+}
+
+/* Reads the results in a file written by SDLTest_BenchmarkSave(), appending them to an array */
+static int
+SDLTest_LoadResults(const char *filename, SDLTest_BenchmarkResult **results, int *numResults)
+{
+    SDL_RWops *rw;
+    Sint64 size;
+    char *json;
+    const char *next;
+    SDLTest_BenchmarkResult result;
+    SDLTest_BenchmarkResult *grown;
+    int loaded = 0;
+
+    rw = SDL_RWFromFile(filename, "rb");
+    if (rw == NULL) {
+        SDLTest_LogError("Failed to open benchmark results '%s': %s", filename, SDL_GetError());
+        return -1;
+    }
+
+    size = SDL_RWsize(rw);
+    json = (size >= 0) ? (char *) SDL_malloc((size_t) size + 1) : NULL;
+    if (json == NULL || SDL_RWread(rw, json, 1, (size_t) size) != (size_t) size) {
+        SDLTest_LogError("Failed to read benchmark results '%s'", filename);
+        SDL_free(json);
+        SDL_RWclose(rw);
+        return -1;
+    }
+    json[size] = '\0';
+    SDL_RWclose(rw);
+
+    /* Each benchmark is an object with a name, as written by SDLTest_BenchmarkSave() */
+    next = json;
+    for ( ; ; ) {
+        SDL_zero(result);
+        next = SDLTest_ParseString(next, "\"name\"", result.name, sizeof (result.name));
+        if (next == NULL) {
+            break;
+        }
+
+        result.median = SDLTest_ParseNumber(next, "\"median\"");
+        result.mad = SDLTest_ParseNumber(next, "\"mad\"");
+        result.p10 = SDLTest_ParseNumber(next, "\"p10\"");
+        result.p90 = SDLTest_ParseNumber(next, "\"p90\"");
+        result.min = SDLTest_ParseNumber(next, "\"min\"");
+        result.max = SDLTest_ParseNumber(next, "\"max\"");
+        result.samples = (int) SDLTest_ParseNumber(next, "\"samples\"");
+        result.iterations = (int) SDLTest_ParseNumber(next, "\"iterations\"");
+
+        grown = (SDLTest_BenchmarkResult *) SDL_realloc(*results, (*numResults + 1) * sizeof (*grown));
+        if (grown == NULL) {
+            SDL_Error(SDL_ENOMEM);
+            break;
+        }
+        *results = grown;
+        (*results)[(*numResults)++] = result;
+        loaded++;
+    }
+    SDL_free(json);
+    return loaded;
+}
+
+int
+SDLTest_BenchmarkLoadBaseline(SDLTest_BenchmarkContext *context, const char *filename)
+{
+    if (SDLTest_LoadResults(filename, &context->baselines, &context->numBaselines) < 0) {
+        return -1;
+    }
+
+    SDLTest_Log("Loaded %d benchmark baselines from '%s'", context->numBaselines, filename);
+    return context->numBaselines;
+}
+
+int
+SDLTest_BenchmarkLoadResults(SDLTest_BenchmarkContext *context, const char *filename)
+{
+    const SDLTest_BenchmarkResult *baseline;
+    int first = context->numResults;
+    int i;
+
+    if (SDLTest_LoadResults(filename, &context->results, &context->numResults) < 0) {
+        return -1;
+    }
+
+    for (i = first; i < context->numResults; i++) {
+        SDLTest_BenchmarkResult *result = &context->results[i];
+
+        baseline = SDLTest_FindResult(context->baselines, context->numBaselines, result->name);
+        if (baseline) {
+            result->baseline = baseline->median;
+            SDLTest_Log("%-36s %12.2f ns/iter  MAD %8.2f  p10 %10.2f  p90 %10.2f  %+7.1f%% vs baseline",
+                result->name, result->median, result->mad, result->p10, result->p90,
+                (result->baseline > 0.0) ? (result->median / result->baseline - 1.0) * 100.0 : 0.0);
+        }
+    }
+
+    SDLTest_Log("Loaded %d benchmark results from '%s'", context->numResults - first, filename);
+    return context->numResults - first;
+}
+
+static SDL_bool
+SDLTest_WriteJSON(SDL_RWops *rw, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(2);
+
+static SDL_bool
+SDLTest_WriteJSON(SDL_RWops *rw, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
+{
+    char buffer[256];
+    va_list ap;
+    int length;
+
+    va_start(ap, fmt);
+    length = SDL_vsnprintf(buffer, sizeof (buffer), fmt, ap);
+    va_end(ap);
+
+    if (length < 0 || length >= (int) sizeof (buffer)) {
+        return SDL_FALSE;
+    }
+    return (SDL_RWwrite(rw, buffer, 1, length) == (size_t) length) ? SDL_TRUE : SDL_FALSE;
+}
+
+int
+SDLTest_BenchmarkSave(SDLTest_BenchmarkContext *context, const char *filename)
+{
+    SDL_bool ok;
+    SDL_RWops *rw;
+    int i;
+
+    rw = SDL_RWFromFile(filename, "wb");
+    if (rw == NULL) {
+        SDLTest_LogError("Failed to create benchmark results '%s': %s", filename, SDL_GetError());
+        return -1;
+    }
+
+    ok = SDLTest_WriteJSON(rw, "{\n  \"benchmarks\": [");
+    for (i = 0; ok && i < context->numResults; i++) {
+        const SDLTest_BenchmarkResult *result = &context->results[i];
+        char name[2 * sizeof (result->name)];
+        const char *src;
+        char *dst = name;
+
+        /* Names are plain text, but keep the file valid JSON whatever they are */
+        for (src = result->name; *src; ++src) {
+            if (*src == '"' || *src == '\\') {
+                *dst++ = '\\';
+            }
+            *dst++ = ((unsigned char) *src < 0x20) ? ' ' : *src;
+        }
+        *dst = '\0';
+
+        ok = SDLTest_WriteJSON(rw, "%s\n    { \"name\": \"%s\", \"median\": %.4f, \"mad\": %.4f, \"p10\": %.4f, \"p90\": %.4f, ",
+                               (i > 0) ? "," : "", name, result->median, result->mad, result->p10, result->p90) &&
+             SDLTest_WriteJSON(rw, "\"min\": %.4f, \"max\": %.4f, \"samples\": %d, \"iterations\": %d }",
+                               result->min, result->max, result->samples, result->iterations);
+    }
+    ok = ok && SDLTest_WriteJSON(rw, "\n  ]\n}\n");
+
+    if (SDL_RWclose(rw) < 0) {
+        ok = SDL_FALSE;
+    }
+    if (!ok) {
+        SDLTest_LogError("Failed to write benchmark results '%s'", filename);
+        return -1;
+    }
+
+    SDLTest_Log("Saved %d benchmark results to '%s'", context->numResults, filename);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -35,19 +35,177 @@
 /* Counter for _CompareSurface calls; used for filename creation when comparisons fail */
 static int _CompareSurfaceCount = 0;
 
+/* Whether surfaces from failed comparisons are saved as images */
+static SDL_bool _CompareSurfaceSave = SDL_TRUE;
+
+/* Squared RGB-difference of two pixels; alpha is not compared */
+static int _PixelDistance(const Uint8 *p, const SDL_PixelFormat *format, const Uint8 *p_reference, const SDL_PixelFormat *referenceFormat)
+{
+   Uint8 R, G, B, A;
+   Uint8 Rd, Gd, Bd, Ad;
+   int dist;
+
+   SDL_GetRGBA(*(Uint32*)p, format, &R, &G, &B, &A);
+   SDL_GetRGBA(*(Uint32*)p_reference, referenceFormat, &Rd, &Gd, &Bd, &Ad);
+
+   dist = 0;
+   dist += (R-Rd)*(R-Rd);
+   dist += (G-Gd)*(G-Gd);
+   dist += (B-Bd)*(B-Bd);
+   return dist;
+}
+
+/* Equal bytes mean equal pixels only if both surfaces store them the same way */
+static SDL_bool _SameLayout(const SDL_PixelFormat *a, const SDL_PixelFormat *b)
+{
+   return (a->format == b->format && a->BytesPerPixel == b->BytesPerPixel &&
+           a->Rmask == b->Rmask && a->Gmask == b->Gmask && a->Bmask == b->Bmask && a->Amask == b->Amask &&
+           a->palette == NULL && b->palette == NULL) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Whether R, G and B are whole bytes at the same place in both 32-bit formats */
+static SDL_bool _SameBytes8888(const SDL_PixelFormat *a, const SDL_PixelFormat *b)
+{
+   return (a->BytesPerPixel == 4 && b->BytesPerPixel == 4 &&
+           a->palette == NULL && b->palette == NULL &&
+           a->Rmask == b->Rmask && a->Gmask == b->Gmask && a->Bmask == b->Bmask &&
+           a->Rloss == 0 && a->Gloss == 0 && a->Bloss == 0 &&
+           (a->Rshift % 8) == 0 && (a->Gshift % 8) == 0 && (a->Bshift % 8) == 0) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Same as _PixelDistance() for pixels checked with _SameBytes8888() */
+static int _PixelDistance8888(Uint32 pixel, Uint32 reference, Uint32 rgbMask)
+{
+   int dist = 0;
+   int shift;
+
+   for (shift = 0; shift < 32; shift += 8) {
+      if ((rgbMask >> shift) & 0xFF) {
+         const int d = (int)((pixel >> shift) & 0xFF) - (int)((reference >> shift) & 0xFF);
+         dist += d*d;
+      }
+   }
+   return dist;
+}
+
+/* Compares a row of pixels checked with _SameBytes8888(); returns the number of
+   pixels over the allowable error and the position and distance of the first */
+static int _CompareRow8888(const Uint32 *row, const Uint32 *row_reference, int w, Uint32 rgbMask, int allowable_error, int *firstX, int *firstDist)
+{
+   int count = 0;
+   int dist;
+   int i = 0;
+
+#if defined(__SSE2__)
+   const __m128i mask = _mm_set1_epi32((int)rgbMask);
+   const __m128i limit = _mm_set1_epi32(allowable_error);
+   const __m128i zero = _mm_setzero_si128();
+   int failed, k;
+
+   for (; i + 4 <= w; i += 4) {
+      const __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)(row + i)), mask);
+      const __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(row_reference + i)), mask);
+      const __m128i absdiff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+      const __m128i lo = _mm_unpacklo_epi8(absdiff, zero);
+      const __m128i hi = _mm_unpackhi_epi8(absdiff, zero);
+      /* Squares summed over pairs of channels, two pairs per pixel */
+      const __m128 squares_lo = _mm_castsi128_ps(_mm_madd_epi16(lo, lo));
+      const __m128 squares_hi = _mm_castsi128_ps(_mm_madd_epi16(hi, hi));
+      const __m128i distances = _mm_add_epi32(
+         _mm_castps_si128(_mm_shuffle_ps(squares_lo, squares_hi, _MM_SHUFFLE(2, 0, 2, 0))),
+         _mm_castps_si128(_mm_shuffle_ps(squares_lo, squares_hi, _MM_SHUFFLE(3, 1, 3, 1))));
+
+      failed = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(distances, limit)));
+      if (failed) {
+         for (k = 0; k < 4; k++) {
+            if (failed & (1 << k)) {
+               if (count == 0) {
+                  *firstX = i + k;
+                  *firstDist = _PixelDistance8888(row[i + k], row_reference[i + k], rgbMask);
+               }
+               count++;
+            }
+         }
+      }
+   }
+#endif
+
+   for (; i < w; i++) {
+      dist = _PixelDistance8888(row[i], row_reference[i], rgbMask);
+      if (dist > allowable_error) {
+         if (count == 0) {
+            *firstX = i;
+            *firstDist = dist;
+         }
+         count++;
+      }
+   }
+   return count;
+}
+
+/* Creates an image showing failing pixels in red over a dimmed grayscale reference */
+static SDL_Surface *_CreateDiffSurface(SDL_Surface *surface, SDL_Surface *referenceSurface, int allowable_error)
+{
+   SDL_Surface *diff;
+   int i,j;
+   int bpp, bpp_reference;
+   Uint8 *p, *p_reference;
+   Uint32 *p_diff;
+   Uint8 Rd, Gd, Bd, Ad;
+   Uint8 gray;
+
+   diff = SDL_CreateRGBSurfaceWithFormat(0, surface->w, surface->h, 32, SDL_PIXELFORMAT_ARGB8888);
+   if (diff == NULL) {
+      return NULL;
+   }
+
+   bpp = surface->format->BytesPerPixel;
+   bpp_reference = referenceSurface->format->BytesPerPixel;
+   for (j=0; j<surface->h; j++) {
+      p_diff = (Uint32 *)((Uint8 *)diff->pixels + j * diff->pitch);
+      for (i=0; i<surface->w; i++) {
+         p  = (Uint8 *)surface->pixels + j * surface->pitch + i * bpp;
+         p_reference = (Uint8 *)referenceSurface->pixels + j * referenceSurface->pitch + i * bpp_reference;
+
+         if (_PixelDistance(p, surface->format, p_reference, referenceSurface->format) > allowable_error) {
+            p_diff[i] = 0xFFFF0000;
+         } else {
+            SDL_GetRGBA(*(Uint32*)p_reference, referenceSurface->format, &Rd, &Gd, &Bd, &Ad);
+            gray = (Uint8)((Rd * 77 + Gd * 150 + Bd * 29) >> 10);
+            p_diff[i] = 0xFF000000 | (gray << 16) | (gray << 8) | gray;
+         }
+      }
+   }
+   return diff;
+}
+
 /* Compare surfaces */
 int SDLTest_CompareSurfaces(SDL_Surface *surface, SDL_Surface *referenceSurface, int allowable_error)
+{
+   return SDLTest_CompareSurfacesWithDiff(surface, referenceSurface, allowable_error, NULL);
+}
+
+/* Compare surfaces, optionally creating a difference image */
+int SDLTest_CompareSurfacesWithDiff(SDL_Surface *surface, SDL_Surface *referenceSurface, int allowable_error, SDL_Surface **diff)
 {
    int ret;
    int i,j;
    int bpp, bpp_reference;
    Uint8 *p, *p_reference;
    int dist;
+   int count, firstX, firstDist;
    int sampleErrorX = 0, sampleErrorY = 0, sampleDist = 0;
-   Uint8 R, G, B, A;
-   Uint8 Rd, Gd, Bd, Ad;
+   SDL_bool sameLayout, sameBytes8888;
+   Uint32 rgbMask;
+   size_t rowSize;
+   SDL_Surface *diffSurface = NULL;
    char imageFilename[128];
    char referenceFilename[128];
+   char diffFilename[128];
+
+   if (diff) {
+      *diff = NULL;
+   }
 
    /* Validate input surfaces */
    if (surface == NULL || referenceSurface == NULL) {
@@ -70,19 +228,35 @@ int SDLTest_CompareSurfaces(SDL_Surface *surface, SDL_Surface *referenceSurface,
    ret = 0;
    bpp = surface->format->BytesPerPixel;
    bpp_reference = referenceSurface->format->BytesPerPixel;
+   sameLayout = _SameLayout(surface->format, referenceSurface->format);
+   sameBytes8888 = _SameBytes8888(surface->format, referenceSurface->format);
+   rgbMask = surface->format->Rmask | surface->format->Gmask | surface->format->Bmask;
+   rowSize = (size_t)surface->w * bpp;
    /* Compare image - should be same format. */
    for (j=0; j<surface->h; j++) {
-      for (i=0; i<surface->w; i++) {
-         p  = (Uint8 *)surface->pixels + j * surface->pitch + i * bpp;
-         p_reference = (Uint8 *)referenceSurface->pixels + j * referenceSurface->pitch + i * bpp_reference;
+      p  = (Uint8 *)surface->pixels + j * surface->pitch;
+      p_reference = (Uint8 *)referenceSurface->pixels + j * referenceSurface->pitch;
 
-         SDL_GetRGBA(*(Uint32*)p, surface->format, &R, &G, &B, &A);
-         SDL_GetRGBA(*(Uint32*)p_reference, referenceSurface->format, &Rd, &Gd, &Bd, &Ad);
+      /* Identical rows can't have any errors */
+      if (sameLayout && SDL_memcmp(p, p_reference, rowSize) == 0) {
+         continue;
+      }
+
+      if (sameBytes8888) {
+         count = _CompareRow8888((const Uint32 *)p, (const Uint32 *)p_reference, surface->w, rgbMask, allowable_error, &firstX, &firstDist);
+         if (count > 0) {
+            if (ret == 0) {
+               sampleErrorX = firstX;
+               sampleErrorY = j;
+               sampleDist = firstDist;
+            }
+            ret += count;
+         }
+         continue;
+      }
 
-         dist = 0;
-         dist += (R-Rd)*(R-Rd);
-         dist += (G-Gd)*(G-Gd);
-         dist += (B-Bd)*(B-Bd);
+      for (i=0; i<surface->w; i++) {
+         dist = _PixelDistance(p + i * bpp, surface->format, p_reference + i * bpp_reference, referenceSurface->format);
 
          /* Allow some difference in blending accuracy */
          if (dist > allowable_error) {
@@ -96,6 +270,10 @@ int SDLTest_CompareSurfaces(SDL_Surface *surface, SDL_Surface *referenceSurface,
       }
    }
 
+   if (ret != 0 && diff) {
+      diffSurface = _CreateDiffSurface(surface, referenceSurface, allowable_error);
+   }
+
    SDL_UnlockSurface( surface );
    SDL_UnlockSurface( referenceSurface );
 
@@ -104,14 +282,32 @@ int SDLTest_CompareSurfaces(SDL_Surface *surface, SDL_Surface *referenceSurface,
    if (ret != 0) {
       SDLTest_LogError("Comparison of pixels with allowable error of %i failed %i times.", allowable_error, ret);
       SDLTest_LogError("First detected occurrence at position %i,%i with a squared RGB-difference of %i.", sampleErrorX, sampleErrorY, sampleDist); 
-      SDL_snprintf(imageFilename, 127, "CompareSurfaces%04d_TestOutput.bmp", _CompareSurfaceCount);
-      SDL_SaveBMP(surface, imageFilename);
-      SDL_snprintf(referenceFilename, 127, "CompareSurfaces%04d_Reference.bmp", _CompareSurfaceCount);
-      SDL_SaveBMP(referenceSurface, referenceFilename);
-      SDLTest_LogError("Surfaces from failed comparison saved as '%s' and '%s'", imageFilename, referenceFilename);
+      if (_CompareSurfaceSave) {
+         SDL_snprintf(imageFilename, 127, "CompareSurfaces%04d_TestOutput.bmp", _CompareSurfaceCount);
+         SDL_SaveBMP(surface, imageFilename);
+         SDL_snprintf(referenceFilename, 127, "CompareSurfaces%04d_Reference.bmp", _CompareSurfaceCount);
+         SDL_SaveBMP(referenceSurface, referenceFilename);
+         SDLTest_LogError("Surfaces from failed comparison saved as '%s' and '%s'", imageFilename, referenceFilename);
+      }
+      if (diffSurface) {
+         if (_CompareSurfaceSave) {
+            SDL_snprintf(diffFilename, 127, "CompareSurfaces%04d_Diff.bmp", _CompareSurfaceCount);
+            SDL_SaveBMP(diffSurface, diffFilename);
+            SDLTest_LogError("Differences saved as '%s'", diffFilename);
+         }
+         *diff = diffSurface;
+      }
    }
 
    return ret;
 }
 
+/* Enables or disables saving surfaces from failed comparisons */
+SDL_bool SDLTest_SetCompareSurfacesSaveImages(SDL_bool enabled)
+{
+   SDL_bool previous = _CompareSurfaceSave;
+   _CompareSurfaceSave = enabled;
+   return previous;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -30,6 +30,131 @@
 
 #include "SDL_test.h"
 
+#ifndef ORIGINAL_METHOD
+/* Carry-less multiplication folds 64 bytes per step; kernels are built with
+   per-function target attributes and only called after a CPUID check. */
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) && \
+    (defined(__i386__) || defined(__x86_64__)) && defined(HAVE_IMMINTRIN_H) && \
+    !defined(SDL_DISABLE_IMMINTRIN_H)
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define SDLTEST_CRC32_PCLMUL 1
+#define SDLTEST_CRC32_TARGETING __attribute__((target("sse2,pclmul")))
+#elif defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64)) && _MSC_VER >= 1600
+#define SDLTEST_CRC32_PCLMUL 1
+#define SDLTEST_CRC32_TARGETING
+#endif
+
+/* ARMv8 has instructions for this polynomial, use them when the compiler targets them */
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define SDLTEST_CRC32_ARM 1
+#endif
+#endif /* !ORIGINAL_METHOD */
+
+/* Shorter buffers aren't worth setting up the carry-less multiplication for */
+#define SDLTEST_CRC32_PCLMUL_MINIMUM 64
+
+#ifdef SDLTEST_CRC32_PCLMUL
+static int SDLTest_Crc32HavePclmul(void)
+{
+  static int havePclmul = -1;
+
+  if (havePclmul < 0) {
+#ifdef _MSC_VER
+   int regs[4];
+   __cpuid(regs, 1);
+   havePclmul = ((regs[2] & 0x00000002) && (regs[3] & 0x04000000)) ? 1 : 0;
+#else
+   unsigned int a, b, c, d;
+   havePclmul = (__get_cpuid(1, &a, &b, &c, &d) && (c & 0x00000002) && (d & 0x04000000)) ? 1 : 0;
+#endif
+  }
+  return havePclmul;
+}
+
+/*
+ * Folds a multiple of 16 bytes, at least 64, into the CRC using carry-less
+ * multiplication, as described in Intel's "Fast CRC Computation for Generic
+ * Polynomials Using PCLMULQDQ Instruction". The constants are for the
+ * bit-reflected 0xEDB88320 polynomial.
+ */
+SDLTEST_CRC32_TARGETING static CrcUint32 SDLTest_Crc32Pclmul(const CrcUint8 *p, CrcUint32 len, CrcUint32 crc)
+{
+  const __m128i k1k2 = _mm_set_epi32(0x00000001, 0xc6e41596, 0x00000001, 0x54442bd4);
+  const __m128i k3k4 = _mm_set_epi32(0x00000000, 0xccaa009e, 0x00000001, 0x751997d0);
+  const __m128i k5k0 = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+  const __m128i poly = _mm_set_epi32(0x00000001, 0xf7011641, 0x00000001, 0xdb710641);
+  const __m128i mask32 = _mm_set_epi32(0, ~0, 0, ~0);
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i *)(p + 0x00));
+  x2 = _mm_loadu_si128((const __m128i *)(p + 0x10));
+  x3 = _mm_loadu_si128((const __m128i *)(p + 0x20));
+  x4 = _mm_loadu_si128((const __m128i *)(p + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+  p += 64;
+  len -= 64;
+
+  /* Fold 64 bytes at a time */
+  x0 = k1k2;
+  while (len >= 64) {
+   x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+   x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+   x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+   x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+   x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+   x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+   x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(p + 0x00)));
+   x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(p + 0x10)));
+   x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(p + 0x20)));
+   x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(p + 0x30)));
+   p += 64;
+   len -= 64;
+  }
+
+  /* Fold the four lanes into one */
+  x0 = k3k4;
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  /* Fold the remaining 16 byte blocks */
+  while (len >= 16) {
+   x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+   x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+   x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)p)), x5);
+   p += 16;
+   len -= 16;
+  }
+
+  /* Fold 128 bits to 64 bits */
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  /* Barrett reduction to 32 bits */
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (CrcUint32)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+#endif /* SDLTEST_CRC32_PCLMUL */
+
 
 int SDLTest_Crc32Init(SDLTest_Crc32Context *crcContext)
 {
@@ -63,6 +188,17 @@ int SDLTest_Crc32Init(SDLTest_Crc32Context *crcContext)
    }
    crcContext->crc32_table[i] = c;
   }
+
+  /*
+   * Build the tables for slice-by-8, each advancing one more byte
+   */
+  for (i=0; i<256; i++) {
+   c = crcContext->crc32_table[i];
+   for (j=0; j<7; j++) {
+    c = (c >> 8) ^ crcContext->crc32_table[c & 0xFF];
+    crcContext->crc32_slice_table[j][i] = c;
+   }
+  }
 #endif
 
   return 0;
@@ -142,7 +278,36 @@ int SDLTest_Crc32CalcBuffer(SDLTest_Crc32Context * crcContext, CrcUint8 *inBuf,
    * Calculate CRC from data
    */
   crc = *crc32;
-  for (p = inBuf; inLen > 0; ++p, --inLen) {
+  p = inBuf;
+#ifndef ORIGINAL_METHOD
+#ifdef SDLTEST_CRC32_PCLMUL
+  if (inLen >= SDLTEST_CRC32_PCLMUL_MINIMUM && SDLTest_Crc32HavePclmul()) {
+    CrcUint32 len = inLen & ~15u;
+    crc = SDLTest_Crc32Pclmul(p, len, crc);
+    p += len;
+    inLen -= len;
+  }
+#endif
+#ifdef SDLTEST_CRC32_ARM
+  for ( ; inLen >= 8; p += 8, inLen -= 8) {
+    const Uint64 data = (Uint64)p[0] | ((Uint64)p[1] << 8) | ((Uint64)p[2] << 16) | ((Uint64)p[3] << 24) |
+                        ((Uint64)p[4] << 32) | ((Uint64)p[5] << 40) | ((Uint64)p[6] << 48) | ((Uint64)p[7] << 56);
+    crc = __crc32d(crc, data);
+  }
+#endif
+  /*
+   * Slice-by-8: eight table lookups per eight bytes, independent of each other
+   */
+  for ( ; inLen >= 8; p += 8, inLen -= 8) {
+    const CrcUint32 *t = crcContext->crc32_table;
+    CrcUint32 (*s)[256] = crcContext->crc32_slice_table;
+    CrcUint32 one = crc ^ ((CrcUint32)p[0] | ((CrcUint32)p[1] << 8) | ((CrcUint32)p[2] << 16) | ((CrcUint32)p[3] << 24));
+    CrcUint32 two = (CrcUint32)p[4] | ((CrcUint32)p[5] << 8) | ((CrcUint32)p[6] << 16) | ((CrcUint32)p[7] << 24);
+    crc = s[6][one & 0xFF] ^ s[5][(one >> 8) & 0xFF] ^ s[4][(one >> 16) & 0xFF] ^ s[3][one >> 24] ^
+          s[2][two & 0xFF] ^ s[1][(two >> 8) & 0xFF] ^ s[0][(two >> 16) & 0xFF] ^ t[two >> 24];
+  }
+#endif
+  for ( ; inLen > 0; ++p, --inLen) {
 #ifdef ORIGINAL_METHOD
     crc = (crc << 8) ^ crcContext->crc32_table[(crc >> 24) ^ *p];
 #else
@@ -3109,69 +3109,91 @@ static unsigned char SDLTest_FontData[SDL_TESTFONTDATAMAX] = {
 
 /* ---- Character */
 
+/* The atlas holds the 256 characters in 16 rows of 16 */
+#define FONT_ATLAS_COLUMNS  16
+
+/* Number of renderers that can have an atlas at the same time */
+#define FONT_ATLAS_CACHE_SIZE  8
+
+typedef struct {
+    Uint32 rendererID;  /* unlike the renderer's address, never reused */
+    SDL_Texture *atlas;
+} SDLTest_CharTextureAtlas;
+
 /*!
-\brief Global cache for 8x8 pixel font textures created at runtime.
+\brief Global cache of all 8x8 pixel font characters in one texture per renderer, created at runtime.
 */
-static SDL_Texture *SDLTest_CharTextureCache[256];
+static SDLTest_CharTextureAtlas SDLTest_CharTextureCache[FONT_ATLAS_CACHE_SIZE];
 
-int SDLTest_DrawCharacter(SDL_Renderer *renderer, int x, int y, char c)
+/*!
+\brief Entry of the cache to reuse next when all are taken.
+*/
+static int SDLTest_CharTextureCacheNext = 0;
+
+static SDL_Texture *SDLTest_GetCharTextureAtlas(SDL_Renderer *renderer)
 {
     const Uint32 charWidth = FONT_CHARACTER_SIZE;
-    const Uint32 charHeight = FONT_CHARACTER_SIZE;
     const Uint32 charSize = FONT_CHARACTER_SIZE;
-    SDL_Rect srect;
-    SDL_Rect drect;
-    int result;
+    const int atlasSize = FONT_ATLAS_COLUMNS * FONT_CHARACTER_SIZE;
     Uint32 ix, iy;
     const unsigned char *charpos;
     Uint8 *curpos;
     Uint8 patt, mask;
     Uint8 *linepos;
     Uint32 pitch;
-    SDL_Surface *character;
+    SDL_Surface *atlas;
+    SDLTest_CharTextureAtlas *entry = NULL;
+    Uint32 rendererID;
     Uint32 ci;
-    Uint8 r, g, b, a;
+    int i;
 
-    /*
-     * Setup source rectangle
-     */
-    srect.x = 0;
-    srect.y = 0;
-    srect.w = charWidth;
-    srect.h = charHeight;
+    rendererID = SDL_GetRendererID(renderer);
+    if (rendererID == 0) {
+        return NULL;
+    }
 
-    /*
-     * Setup destination rectangle
-     */
-    drect.x = x;
-    drect.y = y;
-    drect.w = charWidth;
-    drect.h = charHeight;
+    /* A texture only works with the renderer that created it */
+    for (i = 0; i < FONT_ATLAS_CACHE_SIZE; i++) {
+        SDLTest_CharTextureAtlas *cached = &SDLTest_CharTextureCache[i];
+        if (cached->rendererID == rendererID) {
+            return cached->atlas;
+        }
+        if (cached->rendererID != 0 && SDL_GetRendererFromID(cached->rendererID) == NULL) {
+            /* The atlas was destroyed along with its renderer */
+            cached->rendererID = 0;
+            cached->atlas = NULL;
+        }
+        if (entry == NULL && cached->rendererID == 0) {
+            entry = cached;
+        }
+    }
+
+    /* With all entries taken by live renderers, evict one */
+    if (entry == NULL) {
+        entry = &SDLTest_CharTextureCache[SDLTest_CharTextureCacheNext];
+        SDLTest_CharTextureCacheNext = (SDLTest_CharTextureCacheNext + 1) % FONT_ATLAS_CACHE_SIZE;
+        SDL_DestroyTexture(entry->atlas);
+        entry->rendererID = 0;
+        entry->atlas = NULL;
+    }
 
-    /* Character index in cache */
-    ci = (unsigned char)c;
+    atlas = SDL_CreateRGBSurface(SDL_SWSURFACE,
+        atlasSize, atlasSize, 32,
+        0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF);
+    if (atlas == NULL) {
+        return NULL;
+    }
+    pitch = atlas->pitch;
 
     /*
-     * Create new charWidth x charHeight bitmap surface if not already present.
+     * Drawing loop, one character after the other
      */
-    if (SDLTest_CharTextureCache[ci] == NULL) {
-        /*
-         * Redraw character into surface
-         */
-        character = SDL_CreateRGBSurface(SDL_SWSURFACE,
-            charWidth, charHeight, 32,
-            0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF);
-        if (character == NULL) {
-            return (-1);
-        }
-
+    for (ci = 0; ci < 256; ci++) {
         charpos = SDLTest_FontData + ci * charSize;
-        linepos = (Uint8 *)character->pixels;
-        pitch = character->pitch;
+        linepos = (Uint8 *)atlas->pixels +
+            (ci / FONT_ATLAS_COLUMNS) * charSize * pitch +
+            (ci % FONT_ATLAS_COLUMNS) * charWidth * 4;
 
-        /*
-         * Drawing loop
-         */
         patt = 0;
         for (iy = 0; iy < charWidth; iy++) {
             mask = 0x00;
@@ -3190,45 +3212,120 @@ int SDLTest_DrawCharacter(SDL_Renderer *renderer, int x, int y, char c)
             }
             linepos += pitch;
         }
+    }
 
-        /* Convert temp surface into texture */
-        SDLTest_CharTextureCache[ci] = SDL_CreateTextureFromSurface(renderer, character);
-        SDL_FreeSurface(character);
+    /* Convert temp surface into texture */
+    entry->atlas = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
 
-        /*
-         * Check pointer
-         */
-        if (SDLTest_CharTextureCache[ci] == NULL) {
-            return (-1);
-        }
+    /*
+     * Check pointer
+     */
+    if (entry->atlas == NULL) {
+        return NULL;
     }
 
+    /* Scaled characters stay crisp and don't pick up their neighbours */
+    SDL_SetTextureScaleMode(entry->atlas, SDL_ScaleModeNearest);
+
+    entry->rendererID = rendererID;
+    return entry->atlas;
+}
+
+/* Modulates the atlas with the current draw color */
+static int SDLTest_SetCharTextureColor(SDL_Renderer *renderer, SDL_Texture *atlas)
+{
+    int result = 0;
+    Uint8 r, g, b, a;
+
+    result |= SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    result |= SDL_SetTextureColorMod(atlas, r, g, b);
+    result |= SDL_SetTextureAlphaMod(atlas, a);
+
+    return (result);
+}
+
+/* Copies one character out of the atlas */
+static int SDLTest_CopyCharacter(SDL_Renderer *renderer, SDL_Texture *atlas, float x, float y, char c, float scale)
+{
+    const int charSize = FONT_CHARACTER_SIZE;
+    const Uint32 ci = (unsigned char)c;
+    SDL_Rect srect;
+    SDL_FRect drect;
+
     /*
-     * Set color
+     * Setup source rectangle
      */
-    result = 0;
-    result |= SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
-    result |= SDL_SetTextureColorMod(SDLTest_CharTextureCache[ci], r, g, b);
-    result |= SDL_SetTextureAlphaMod(SDLTest_CharTextureCache[ci], a);
+    srect.x = (ci % FONT_ATLAS_COLUMNS) * charSize;
+    srect.y = (ci / FONT_ATLAS_COLUMNS) * charSize;
+    srect.w = charSize;
+    srect.h = charSize;
+
+    /*
+     * Setup destination rectangle
+     */
+    drect.x = x;
+    drect.y = y;
+    drect.w = charSize * scale;
+    drect.h = charSize * scale;
 
     /*
      * Draw texture onto destination
      */
-    result |= SDL_RenderCopy(renderer, SDLTest_CharTextureCache[ci], &srect, &drect);
+    return SDL_RenderCopyF(renderer, atlas, &srect, &drect);
+}
+
+int SDLTest_DrawCharacter(SDL_Renderer *renderer, int x, int y, char c)
+{
+    SDL_Texture *atlas;
+    int result;
+
+    atlas = SDLTest_GetCharTextureAtlas(renderer);
+    if (atlas == NULL) {
+        return (-1);
+    }
+
+    /*
+     * Set color
+     */
+    result = SDLTest_SetCharTextureColor(renderer, atlas);
+
+    result |= SDLTest_CopyCharacter(renderer, atlas, (float)x, (float)y, c, 1.0f);
 
     return (result);
 }
 
 int SDLTest_DrawString(SDL_Renderer * renderer, int x, int y, const char *s)
 {
-    const Uint32 charWidth = FONT_CHARACTER_SIZE;
+    return SDLTest_DrawScaledString(renderer, x, y, s, 1.0f);
+}
+
+int SDLTest_DrawScaledString(SDL_Renderer *renderer, int x, int y, const char *s, float scale)
+{
+    const float charWidth = FONT_CHARACTER_SIZE * scale;
+    SDL_Texture *atlas;
     int result = 0;
-    int curx = x;
-    int cury = y;
+    float curx = (float)x;
+    float cury = (float)y;
     const char *curchar = s;
 
+    if (scale <= 0.0f) {
+        return SDL_InvalidParamError("scale");
+    }
+
+    atlas = SDLTest_GetCharTextureAtlas(renderer);
+    if (atlas == NULL) {
+        return (-1);
+    }
+
+    /*
+     * Every character is copied from the same texture with the same color,
+     * so the renderer doesn't switch textures between them.
+     */
+    result |= SDLTest_SetCharTextureColor(renderer, atlas);
+
     while (*curchar && !result) {
-        result |= SDLTest_DrawCharacter(renderer, curx, cury, *curchar);
+        result |= SDLTest_CopyCharacter(renderer, atlas, curx, cury, *curchar, scale);
         curx += charWidth;
         curchar++;
     }
@@ -3240,11 +3337,15 @@ void SDLTest_CleanupTextDrawing(void)
 {
     unsigned int i;
     for (i = 0; i < SDL_arraysize(SDLTest_CharTextureCache); ++i) {
-        if (SDLTest_CharTextureCache[i]) {
-            SDL_DestroyTexture(SDLTest_CharTextureCache[i]);
-            SDLTest_CharTextureCache[i] = NULL;
+        /* Atlases of destroyed renderers went with them */
+        if (SDLTest_CharTextureCache[i].atlas &&
+            SDL_GetRendererFromID(SDLTest_CharTextureCache[i].rendererID)) {
+            SDL_DestroyTexture(SDLTest_CharTextureCache[i].atlas);
         }
+        SDLTest_CharTextureCache[i].rendererID = 0;
+        SDLTest_CharTextureCache[i].atlas = NULL;
     }
+    SDLTest_CharTextureCacheNext = 0;
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -531,4 +531,12 @@ SDLTest_RandomAsciiStringOfSize(int size)
     return string;
 }
 
+void
+SDLTest_RandomBuffer(void *buffer, size_t size)
+{
+    fuzzerInvocationCounter++;
+
+    SDLTest_RandomFill(&rndContext, buffer, size);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
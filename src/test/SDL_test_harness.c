@@ -28,6 +28,19 @@
 #include <string.h>
 #include <time.h>
 
+/* Test cases can be spread over forked worker processes */
+#if defined(__LINUX__) || defined(__MACOSX__) || defined(__FREEBSD__) || defined(__NETBSD__) || defined(__OPENBSD__)
+#define SDLTEST_HAVE_WORKERS 1
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 /* Invalid test name/description message format */
 #define SDLTEST_INVALID_NAME_FORMAT "(Invalid)"
 
@@ -40,6 +53,35 @@
 /* ! \brief Timeout for single test case execution */
 static Uint32 SDLTest_TestCaseTimeout = 3600;
 
+/* ! \brief Which of the selected test cases this process runs, see SDLTest_SetTestShard() */
+static int SDLTest_ShardIndex = 0;
+static int SDLTest_ShardCount = 1;
+
+/* ! \brief Worker processes to spread test cases over, see SDLTest_SetTestWorkers() */
+static int SDLTest_NumWorkers = 1;
+static SDLTest_WorkerInitFp SDLTest_WorkerInit = NULL;
+static void *SDLTest_WorkerInitArg = NULL;
+
+/* ! \brief File to write the report of a run to, see SDLTest_SetTestReport() */
+static char *SDLTest_ReportFile = NULL;
+
+/* ! \brief A test case selected for a run, and its outcome */
+typedef struct SDLTest_TestRecord {
+    SDLTest_TestSuiteReference *testSuite;
+    const SDLTest_TestCaseReference *testCase;
+    int suiteNumber;
+    int testNumber;
+    SDL_bool forceTestRun;
+    /* TEST_RESULT_* of the last iteration, -1 if the test didn't run */
+    int result;
+    /* Iterations that passed, failed or were skipped */
+    int passed;
+    int failed;
+    int skipped;
+    /* Wall clock time of all iterations, in seconds */
+    double runtime;
+} SDLTest_TestRecord;
+
 /**
 * Generates a random run seed string for the harness. The generated seed
 * will contain alphanumeric characters (0-9A-Z).
@@ -353,6 +395,701 @@ static float GetClock()
     return currentClock;
 }
 
+/* Gets the wall clock time in seconds; unlike GetClock() this includes time spent waiting */
+static double GetWallClock(void)
+{
+    return (double) SDL_GetPerformanceCounter() / (double) SDL_GetPerformanceFrequency();
+}
+
+/**
+* \brief Run every shardCount-th selected test case, starting with shardIndex.
+*
+* \param shardIndex Which shard this process runs, 0..shardCount-1.
+* \param shardCount Number of shards the test cases are split into.
+*
+* \returns 0 on success, -1 if the shard is invalid.
+*/
+int
+SDLTest_SetTestShard(int shardIndex, int shardCount)
+{
+    if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+        SDLTest_LogError("Invalid shard %d/%d; the index must be between 0 and count-1.", shardIndex, shardCount);
+        return -1;
+    }
+
+    SDLTest_ShardIndex = shardIndex;
+    SDLTest_ShardCount = shardCount;
+    return 0;
+}
+
+/**
+* \brief Spread the test cases of a run over worker processes.
+*
+* \param numWorkers Number of worker processes; 1 or less runs tests in this process.
+* \param workerInit Function each worker calls before running tests, or NULL.
+* \param arg Argument passed to workerInit.
+*
+* \returns 0 on success, -1 if workers aren't supported on this platform.
+*/
+int
+SDLTest_SetTestWorkers(int numWorkers, SDLTest_WorkerInitFp workerInit, void *arg)
+{
+#if SDLTEST_HAVE_WORKERS
+    SDLTest_NumWorkers = (numWorkers > 1) ? numWorkers : 1;
+    SDLTest_WorkerInit = workerInit;
+    SDLTest_WorkerInitArg = arg;
+    return 0;
+#else
+    if (numWorkers > 1) {
+        SDLTest_LogError("Worker processes are not supported on this platform.");
+        return -1;
+    }
+    return 0;
+#endif
+}
+
+/**
+* \brief Write a report of each run to a file.
+*
+* \param filename File to write, JSON if it ends in ".json" and JUnit XML otherwise. NULL disables.
+*/
+void
+SDLTest_SetTestReport(const char *filename)
+{
+    SDL_free(SDLTest_ReportFile);
+    SDLTest_ReportFile = NULL;
+    if (filename != NULL && filename[0] != '\0') {
+        SDLTest_ReportFile = SDL_strdup(filename);
+    }
+}
+
+/**
+* \brief Execute every iteration of a test case and log the outcome.
+*
+* \param record Selected test case; receives the results.
+* \param runSeed The run seed the execution keys are generated from.
+* \param userExecKey Custom execution key provided by user, or 0 to generate them.
+* \param testIterations Number of iterations to run the test case.
+*/
+static void
+SDLTest_RunTestIterations(SDLTest_TestRecord *record, const char *runSeed, Uint64 userExecKey, int testIterations)
+{
+    SDLTest_TestSuiteReference *testSuite = record->testSuite;
+    const SDLTest_TestCaseReference *testCase = record->testCase;
+    char *currentTestName = (testCase->name ? testCase->name : SDLTEST_INVALID_NAME_FORMAT);
+    int iterationCounter;
+    Uint64 execKey;
+    float testStartSeconds;
+    float testEndSeconds;
+    float runtime;
+    double wallStartSeconds;
+    int testResult = 0;
+
+    /* Override 'disabled' flag if we specified a test filter (i.e. force run for debugging) */
+    if (record->forceTestRun) {
+        SDLTest_Log("Force run of disabled test since test filter was set");
+    }
+
+    /* Take time - test start */
+    testStartSeconds = GetClock();
+    wallStartSeconds = GetWallClock();
+
+    /* Log test started */
+    SDLTest_Log("----- Test Case %i.%i: '%s' started",
+        record->suiteNumber,
+        record->testNumber,
+        currentTestName);
+    if (testCase->description != NULL && testCase->description[0] != '\0') {
+        SDLTest_Log("Test Description: '%s'",
+            (testCase->description) ? testCase->description : SDLTEST_INVALID_NAME_FORMAT);
+    }
+
+    /* Loop over all iterations */
+    iterationCounter = 0;
+    while(iterationCounter < testIterations)
+    {
+        iterationCounter++;
+
+        if (userExecKey != 0) {
+            execKey = userExecKey;
+        } else {
+            execKey = SDLTest_GenerateExecKey(runSeed, testSuite->name, testCase->name, iterationCounter);
+        }
+
+        SDLTest_Log("Test Iteration %i: execKey %" SDL_PRIu64, iterationCounter, execKey);
+        testResult = SDLTest_RunTest(testSuite, testCase, execKey, record->forceTestRun);
+
+        if (testResult == TEST_RESULT_PASSED) {
+            record->passed++;
+        } else if (testResult == TEST_RESULT_SKIPPED) {
+            record->skipped++;
+        } else {
+            record->failed++;
+        }
+    }
+
+    /* Take time - test end */
+    testEndSeconds = GetClock();
+    runtime = testEndSeconds - testStartSeconds;
+    if (runtime < 0.0f) runtime = 0.0f;
+
+    if (testIterations > 1) {
+        /* Log test runtime */
+        SDLTest_Log("Runtime of %i iterations: %.1f sec", testIterations, runtime);
+        SDLTest_Log("Average Test runtime: %.5f sec", runtime / (float)testIterations);
+    } else {
+        /* Log test runtime */
+        SDLTest_Log("Total Test runtime: %.1f sec", runtime);
+    }
+
+    /* Log final test result */
+    switch (testResult) {
+    case TEST_RESULT_PASSED:
+        SDLTest_Log(SDLTEST_FINAL_RESULT_FORMAT, "Test", currentTestName, "Passed");
+        break;
+    case TEST_RESULT_FAILED:
+        SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT, "Test", currentTestName, "Failed");
+        break;
+    case TEST_RESULT_NO_ASSERT:
+        SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT,"Test", currentTestName, "No Asserts");
+        break;
+    }
+
+    record->result = testResult;
+    record->runtime = GetWallClock() - wallStartSeconds;
+}
+
+#if SDLTEST_HAVE_WORKERS
+
+/* ! \brief A forked process that runs test cases it's handed over a pipe */
+typedef struct SDLTest_Worker {
+    pid_t pid;
+    /* Record numbers go to the worker here, closing it tells the worker to quit */
+    int assignFd;
+    /* SDLTest_WorkerResult comes back here */
+    int resultFd;
+    /* Record the worker is running, or -1 */
+    int record;
+} SDLTest_Worker;
+
+/* ! \brief What a worker sends back after running a test case */
+typedef struct SDLTest_WorkerResult {
+    int record;
+    int result;
+    int passed;
+    int failed;
+    int skipped;
+    double runtime;
+} SDLTest_WorkerResult;
+
+static SDL_bool
+SDLTest_ReadFully(int fd, void *buffer, size_t length)
+{
+    Uint8 *ptr = (Uint8 *) buffer;
+
+    while (length > 0) {
+        const ssize_t amount = read(fd, ptr, length);
+        if (amount < 0 && errno == EINTR) {
+            continue;
+        }
+        if (amount <= 0) {
+            return SDL_FALSE;
+        }
+        ptr += amount;
+        length -= amount;
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+SDLTest_WriteFully(int fd, const void *buffer, size_t length)
+{
+    const Uint8 *ptr = (const Uint8 *) buffer;
+
+    while (length > 0) {
+        const ssize_t amount = write(fd, ptr, length);
+        if (amount < 0 && errno == EINTR) {
+            continue;
+        }
+        if (amount <= 0) {
+            return SDL_FALSE;
+        }
+        ptr += amount;
+        length -= amount;
+    }
+    return SDL_TRUE;
+}
+
+/* Test cases may use fixed names for scratch files, so every worker runs in a directory of its own */
+static void
+SDLTest_GetWorkerDirectory(pid_t pid, char *path, size_t length)
+{
+    SDL_snprintf(path, length, "sdltest-worker-%d", (int) pid);
+}
+
+/* Removes the directory of a worker that exited, with whatever its test cases left behind */
+static void
+SDLTest_RemoveWorkerDirectory(pid_t pid)
+{
+    char path[64];
+    char file[320];
+    DIR *dir;
+    struct dirent *entry;
+
+    SDLTest_GetWorkerDirectory(pid, path, sizeof (path));
+    dir = opendir(path);
+    if (dir == NULL) {
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (SDL_strcmp(entry->d_name, ".") != 0 && SDL_strcmp(entry->d_name, "..") != 0) {
+            SDL_snprintf(file, sizeof (file), "%s/%s", path, entry->d_name);
+            remove(file);
+        }
+    }
+    closedir(dir);
+    if (rmdir(path) < 0) {
+        SDLTest_LogError("Failed to remove worker directory %s: %s", path, strerror(errno));
+    }
+}
+
+/**
+* \brief Main loop of a worker process: run test cases until the parent closes the pipe.
+*/
+static SDL_NORETURN void
+SDLTest_RunWorker(int assignFd, int resultFd, SDLTest_TestRecord *records, const char *runSeed, Uint64 userExecKey, int testIterations)
+{
+    SDLTest_WorkerResult result;
+    char directory[64];
+    int recordNumber;
+
+    SDLTest_GetWorkerDirectory(getpid(), directory, sizeof (directory));
+    if ((mkdir(directory, 0700) < 0 && errno != EEXIST) || chdir(directory) < 0) {
+        SDLTest_LogError("Worker %d failed to enter %s: %s", (int) getpid(), directory, strerror(errno));
+        exit(2);
+    }
+
+    if (SDLTest_WorkerInit && SDLTest_WorkerInit(SDLTest_WorkerInitArg) < 0) {
+        SDLTest_LogError("Worker %d failed to initialize", (int) getpid());
+        exit(2);
+    }
+
+    while (SDLTest_ReadFully(assignFd, &recordNumber, sizeof (recordNumber))) {
+        SDLTest_TestRecord *record = &records[recordNumber];
+
+        SDLTest_RunTestIterations(record, runSeed, userExecKey, testIterations);
+
+        SDL_zero(result);
+        result.record = recordNumber;
+        result.result = record->result;
+        result.passed = record->passed;
+        result.failed = record->failed;
+        result.skipped = record->skipped;
+        result.runtime = record->runtime;
+        if (!SDLTest_WriteFully(resultFd, &result, sizeof (result))) {
+            break;
+        }
+    }
+
+    SDL_Quit();
+    exit(0);
+}
+
+static SDL_bool
+SDLTest_StartWorker(SDLTest_Worker *workers, int numWorkers, int index, SDLTest_TestRecord *records, const char *runSeed, Uint64 userExecKey, int testIterations)
+{
+    SDLTest_Worker *worker = &workers[index];
+    int assignPipe[2];
+    int resultPipe[2];
+    pid_t pid;
+    int i;
+
+    if (pipe(assignPipe) < 0) {
+        SDLTest_LogError("Failed to create a pipe for a worker: %s", strerror(errno));
+        return SDL_FALSE;
+    }
+    if (pipe(resultPipe) < 0) {
+        SDLTest_LogError("Failed to create a pipe for a worker: %s", strerror(errno));
+        close(assignPipe[0]);
+        close(assignPipe[1]);
+        return SDL_FALSE;
+    }
+
+    /* Don't let the worker repeat whatever we still have buffered */
+    fflush(stdout);
+    fflush(stderr);
+
+    pid = fork();
+    if (pid < 0) {
+        SDLTest_LogError("Failed to start a worker: %s", strerror(errno));
+        close(assignPipe[0]);
+        close(assignPipe[1]);
+        close(resultPipe[0]);
+        close(resultPipe[1]);
+        return SDL_FALSE;
+    }
+
+    if (pid == 0) {
+        /* Only keep our own end of our own pipes, so other workers see EOF when the parent closes theirs */
+        for (i = 0; i < numWorkers; i++) {
+            if (i != index && workers[i].pid > 0) {
+                if (workers[i].assignFd >= 0) {
+                    close(workers[i].assignFd);
+                }
+                close(workers[i].resultFd);
+            }
+        }
+        close(assignPipe[1]);
+        close(resultPipe[0]);
+        SDLTest_RunWorker(assignPipe[0], resultPipe[1], records, runSeed, userExecKey, testIterations);
+    }
+
+    close(assignPipe[0]);
+    close(resultPipe[1]);
+    worker->pid = pid;
+    worker->assignFd = assignPipe[1];
+    worker->resultFd = resultPipe[0];
+    worker->record = -1;
+    return SDL_TRUE;
+}
+
+/* Hands the next record to an idle worker, or tells it to quit once they're all handed out */
+static void
+SDLTest_AssignTest(SDLTest_Worker *worker, int *nextRecord, int numRecords)
+{
+    if (worker->assignFd < 0) {
+        return;
+    }
+
+    if (*nextRecord < numRecords && SDLTest_WriteFully(worker->assignFd, nextRecord, sizeof (*nextRecord))) {
+        worker->record = *nextRecord;
+        ++*nextRecord;
+    } else {
+        /* Nothing left, or the worker died; either way it sees EOF and we'll see it go */
+        close(worker->assignFd);
+        worker->assignFd = -1;
+    }
+}
+
+/* Waits for a worker to exit and returns its wait status */
+static int
+SDLTest_StopWorker(SDLTest_Worker *worker)
+{
+    int status = 0;
+
+    if (worker->assignFd >= 0) {
+        close(worker->assignFd);
+        worker->assignFd = -1;
+    }
+    close(worker->resultFd);
+    worker->resultFd = -1;
+    while (waitpid(worker->pid, &status, 0) < 0 && errno == EINTR) {
+        /* try again */
+    }
+    SDLTest_RemoveWorkerDirectory(worker->pid);
+    worker->pid = 0;
+    return status;
+}
+
+/**
+* \brief Run the selected test cases in worker processes, handing each one to whichever worker is free.
+*
+* A worker that dies fails the test case it was running and is replaced.
+*
+* \returns SDL_FALSE if the workers couldn't be set up, and the tests should run in this process.
+*/
+static SDL_bool
+SDLTest_RunTestsInWorkers(SDLTest_TestRecord *records, int numRecords, const char *runSeed, Uint64 userExecKey, int testIterations)
+{
+    const int numWorkers = SDL_min(SDLTest_NumWorkers, numRecords);
+    SDLTest_Worker *workers;
+    struct pollfd *fds;
+    int *fdWorkers;
+    void (*oldPipeHandler)(int);
+    SDLTest_WorkerResult result;
+    int nextRecord = 0;
+    int finished = 0;
+    int i;
+
+    workers = (SDLTest_Worker *) SDL_calloc(numWorkers, sizeof (*workers));
+    fds = (struct pollfd *) SDL_calloc(numWorkers, sizeof (*fds));
+    fdWorkers = (int *) SDL_calloc(numWorkers, sizeof (*fdWorkers));
+    if (workers == NULL || fds == NULL || fdWorkers == NULL) {
+        SDLTest_LogError("Failed to allocate worker state");
+        SDL_Error(SDL_ENOMEM);
+        SDL_free(workers);
+        SDL_free(fds);
+        SDL_free(fdWorkers);
+        return SDL_FALSE;
+    }
+
+    /* Writing to the pipe of a worker that died should fail, not kill us */
+    oldPipeHandler = signal(SIGPIPE, SIG_IGN);
+
+    SDLTest_Log("Running %d test cases in %d worker processes", numRecords, numWorkers);
+    for (i = 0; i < numWorkers; i++) {
+        if (SDLTest_StartWorker(workers, numWorkers, i, records, runSeed, userExecKey, testIterations)) {
+            SDLTest_AssignTest(&workers[i], &nextRecord, numRecords);
+        }
+    }
+
+    while (finished < numRecords) {
+        int numFds = 0;
+
+        for (i = 0; i < numWorkers; i++) {
+            if (workers[i].pid > 0) {
+                fds[numFds].fd = workers[i].resultFd;
+                fds[numFds].events = POLLIN;
+                fds[numFds].revents = 0;
+                fdWorkers[numFds] = i;
+                numFds++;
+            }
+        }
+        if (numFds == 0) {
+            SDLTest_LogError("No workers left to run the remaining %d test cases", numRecords - finished);
+            break;
+        }
+
+        if (poll(fds, numFds, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDLTest_LogError("Failed to wait for workers: %s", strerror(errno));
+            break;
+        }
+
+        for (i = 0; i < numFds; i++) {
+            SDLTest_Worker *worker = &workers[fdWorkers[i]];
+
+            if (fds[i].revents == 0) {
+                continue;
+            }
+
+            if (SDLTest_ReadFully(worker->resultFd, &result, sizeof (result)) &&
+                result.record >= 0 && result.record < numRecords) {
+                SDLTest_TestRecord *record = &records[result.record];
+                record->result = result.result;
+                record->passed = result.passed;
+                record->failed = result.failed;
+                record->skipped = result.skipped;
+                record->runtime = result.runtime;
+                worker->record = -1;
+                finished++;
+                SDLTest_AssignTest(worker, &nextRecord, numRecords);
+            } else {
+                const int running = worker->record;
+                const int status = SDLTest_StopWorker(worker);
+
+                if (running >= 0) {
+                    /* The worker exited in the middle of a test case, which fails it */
+                    SDLTest_TestRecord *record = &records[running];
+                    char reason[64];
+
+                    if (WIFSIGNALED(status)) {
+                        SDL_snprintf(reason, sizeof (reason), "Failed (worker killed by signal %d)", WTERMSIG(status));
+                    } else {
+                        SDL_snprintf(reason, sizeof (reason), "Failed (worker exited with code %d)", WEXITSTATUS(status));
+                    }
+                    SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT, "Test",
+                        record->testCase->name ? record->testCase->name : SDLTEST_INVALID_NAME_FORMAT, reason);
+                    record->result = TEST_RESULT_FAILED;
+                    record->failed = testIterations - record->passed - record->skipped;
+                    finished++;
+
+                    if (nextRecord < numRecords &&
+                        SDLTest_StartWorker(workers, numWorkers, fdWorkers[i], records, runSeed, userExecKey, testIterations)) {
+                        SDLTest_AssignTest(worker, &nextRecord, numRecords);
+                    }
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < numWorkers; i++) {
+        if (workers[i].pid > 0) {
+            SDLTest_StopWorker(&workers[i]);
+        }
+    }
+
+    /* Anything that never ran counts as failed */
+    for (i = 0; i < numRecords; i++) {
+        if (records[i].result < 0) {
+            records[i].result = TEST_RESULT_FAILED;
+            records[i].failed = testIterations;
+        }
+    }
+
+    signal(SIGPIPE, oldPipeHandler);
+    SDL_free(workers);
+    SDL_free(fds);
+    SDL_free(fdWorkers);
+    return SDL_TRUE;
+}
+
+#endif /* SDLTEST_HAVE_WORKERS */
+
+static const char *
+SDLTest_ResultName(int result)
+{
+    switch (result) {
+    case TEST_RESULT_PASSED:
+        return "passed";
+    case TEST_RESULT_SKIPPED:
+        return "skipped";
+    case TEST_RESULT_NO_ASSERT:
+        return "no asserts";
+    case TEST_RESULT_SETUP_FAILURE:
+        return "setup failure";
+    default:
+        return "failed";
+    }
+}
+
+static void
+SDLTest_WriteEscaped(FILE *file, const char *string, SDL_bool json)
+{
+    for (; *string; string++) {
+        const unsigned char ch = (unsigned char) *string;
+        if (json) {
+            if (ch == '"' || ch == '\\') {
+                fprintf(file, "\\%c", ch);
+            } else if (ch < 0x20) {
+                fprintf(file, "\\u%04x", ch);
+            } else {
+                fputc(ch, file);
+            }
+        } else {
+            if (ch == '&') {
+                fputs("&amp;", file);
+            } else if (ch == '<') {
+                fputs("&lt;", file);
+            } else if (ch == '>') {
+                fputs("&gt;", file);
+            } else if (ch == '"') {
+                fputs("&quot;", file);
+            } else {
+                fputc(ch, file);
+            }
+        }
+    }
+}
+
+/**
+* \brief Write the results of a run as JUnit XML, or JSON if the file name ends in ".json".
+*/
+static void
+SDLTest_WriteReport(const char *filename, const char *runSeed, const SDLTest_TestRecord *records, int numRecords, double runtime)
+{
+    const size_t length = SDL_strlen(filename);
+    const SDL_bool json = (length >= 5 && SDL_strcasecmp(filename + length - 5, ".json") == 0) ? SDL_TRUE : SDL_FALSE;
+    int passed = 0, failed = 0, skipped = 0;
+    FILE *file;
+    int i, j;
+
+    file = fopen(filename, "w");
+    if (file == NULL) {
+        SDLTest_LogError("Failed to open report file '%s'", filename);
+        return;
+    }
+
+    for (i = 0; i < numRecords; i++) {
+        if (records[i].result == TEST_RESULT_PASSED) {
+            passed++;
+        } else if (records[i].result == TEST_RESULT_SKIPPED) {
+            skipped++;
+        } else {
+            failed++;
+        }
+    }
+
+    if (json) {
+        fprintf(file, "{\n  \"seed\": \"");
+        SDLTest_WriteEscaped(file, runSeed, SDL_TRUE);
+        fprintf(file, "\",\n  \"total\": %d,\n  \"passed\": %d,\n  \"failed\": %d,\n  \"skipped\": %d,\n  \"time\": %.3f,\n  \"tests\": [",
+                numRecords, passed, failed, skipped, runtime);
+        for (i = 0; i < numRecords; i++) {
+            const SDLTest_TestRecord *record = &records[i];
+            fprintf(file, "%s\n    { \"suite\": \"", (i > 0) ? "," : "");
+            SDLTest_WriteEscaped(file, record->testSuite->name ? record->testSuite->name : SDLTEST_INVALID_NAME_FORMAT, SDL_TRUE);
+            fprintf(file, "\", \"name\": \"");
+            SDLTest_WriteEscaped(file, record->testCase->name ? record->testCase->name : SDLTEST_INVALID_NAME_FORMAT, SDL_TRUE);
+            fprintf(file, "\", \"result\": \"%s\", \"passed\": %d, \"failed\": %d, \"skipped\": %d, \"time\": %.3f }",
+                    SDLTest_ResultName(record->result), record->passed, record->failed, record->skipped, record->runtime);
+        }
+        fprintf(file, "\n  ]\n}\n");
+    } else {
+        fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        fprintf(file, "<testsuites tests=\"%d\" failures=\"%d\" skipped=\"%d\" time=\"%.3f\">\n",
+                numRecords, failed, skipped, runtime);
+
+        /* Records of a suite are next to each other */
+        for (i = 0; i < numRecords; i = j) {
+            const SDLTest_TestSuiteReference *testSuite = records[i].testSuite;
+            int suiteFailed = 0, suiteSkipped = 0;
+            double suiteRuntime = 0.0;
+
+            for (j = i; j < numRecords && records[j].testSuite == testSuite; j++) {
+                if (records[j].result == TEST_RESULT_SKIPPED) {
+                    suiteSkipped++;
+                } else if (records[j].result != TEST_RESULT_PASSED) {
+                    suiteFailed++;
+                }
+                suiteRuntime += records[j].runtime;
+            }
+
+            fprintf(file, "  <testsuite name=\"");
+            SDLTest_WriteEscaped(file, testSuite->name ? testSuite->name : SDLTEST_INVALID_NAME_FORMAT, SDL_FALSE);
+            fprintf(file, "\" tests=\"%d\" failures=\"%d\" skipped=\"%d\" time=\"%.3f\">\n",
+                    j - i, suiteFailed, suiteSkipped, suiteRuntime);
+            fprintf(file, "    <properties><property name=\"seed\" value=\"");
+            SDLTest_WriteEscaped(file, runSeed, SDL_FALSE);
+            fprintf(file, "\"/></properties>\n");
+
+            for (; i < j; i++) {
+                const SDLTest_TestRecord *record = &records[i];
+                fprintf(file, "    <testcase classname=\"");
+                SDLTest_WriteEscaped(file, testSuite->name ? testSuite->name : SDLTEST_INVALID_NAME_FORMAT, SDL_FALSE);
+                fprintf(file, "\" name=\"");
+                SDLTest_WriteEscaped(file, record->testCase->name ? record->testCase->name : SDLTEST_INVALID_NAME_FORMAT, SDL_FALSE);
+                fprintf(file, "\" time=\"%.3f\"", record->runtime);
+                if (record->result == TEST_RESULT_PASSED) {
+                    fprintf(file, "/>\n");
+                } else if (record->result == TEST_RESULT_SKIPPED) {
+                    fprintf(file, "><skipped/></testcase>\n");
+                } else {
+                    fprintf(file, "><failure message=\"%s\"/></testcase>\n", SDLTest_ResultName(record->result));
+                }
+            }
+            fprintf(file, "  </testsuite>\n");
+        }
+        fprintf(file, "</testsuites>\n");
+    }
+
+    if (fclose(file) != 0) {
+        SDLTest_LogError("Failed to write report file '%s'", filename);
+    } else {
+        SDLTest_Log("Wrote test report to '%s'", filename);
+    }
+}
+
+/* Logs the summary and final result of a suite */
+static void
+SDLTest_LogSuiteResult(const char *suiteName, Uint32 passed, Uint32 failed, Uint32 skipped)
+{
+    const Uint32 countSum = passed + failed + skipped;
+
+    if (failed == 0)
+    {
+        SDLTest_Log(SDLTEST_LOG_SUMMARY_FORMAT, "Suite", countSum, passed, failed, skipped);
+        SDLTest_Log(SDLTEST_FINAL_RESULT_FORMAT, "Suite", suiteName, "Passed");
+    }
+    else
+    {
+        SDLTest_LogError(SDLTEST_LOG_SUMMARY_FORMAT, "Suite", countSum, passed, failed, skipped);
+        SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT, "Suite", suiteName, "Failed");
+    }
+}
+
 /**
 * \brief Execute a test suite using the given run seed and execution key.
 *
@@ -373,26 +1110,27 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     int failedNumberOfTests = 0;
     int suiteCounter;
     int testCounter;
-    int iterationCounter;
+    int recordCounter;
+    int numRecords = 0;
+    int selectedCounter = 0;
     SDLTest_TestSuiteReference *testSuite;
     const SDLTest_TestCaseReference *testCase;
+    SDLTest_TestRecord *record;
     const char *runSeed = NULL;
     char *currentSuiteName;
     char *currentTestName;
-    Uint64 execKey;
     float runStartSeconds;
     float suiteStartSeconds;
-    float testStartSeconds;
     float runEndSeconds;
     float suiteEndSeconds;
-    float testEndSeconds;
     float runtime;
+    double wallStartSeconds;
+    double wallRuntime;
     int suiteFilter = 0;
     char *suiteFilterName = NULL;
     int testFilter = 0;
     char *testFilterName = NULL;
-	SDL_bool forceTestRun = SDL_FALSE;
-    int testResult = 0;
+    SDL_bool useWorkers = SDL_FALSE;
     int runResult = 0;
     Uint32 totalTestFailedCount = 0;
     Uint32 totalTestPassedCount = 0;
@@ -401,7 +1139,7 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     Uint32 testPassedCount = 0;
     Uint32 testSkippedCount = 0;
     Uint32 countSum = 0;
-    const SDLTest_TestCaseReference **failedTests;
+    SDLTest_TestRecord *records;
 
     /* Sanitize test iterations */
     if (testIterations < 1) {
@@ -427,6 +1165,7 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
 
     /* Take time - run start */
     runStartSeconds = GetClock();
+    wallStartSeconds = GetWallClock();
 
     /* Log run with fuzzer parameters */
     SDLTest_Log("::::: Test Run /w seed '%s' started\n", runSeed);
@@ -444,11 +1183,11 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
 		}
 	}
 
-	/* Pre-allocate an array for tracking failed tests (potentially all test cases) */
-	failedTests = (const SDLTest_TestCaseReference **)SDL_malloc(totalNumberOfTests * sizeof(SDLTest_TestCaseReference *));
-	if (failedTests == NULL) {	
-	   SDLTest_LogError("Unable to allocate cache for failed tests");
-           SDL_Error(SDL_ENOMEM);	   
+	/* Pre-allocate an array for tracking the selected tests (potentially all test cases) */
+	records = (SDLTest_TestRecord *)SDL_calloc(SDL_max(totalNumberOfTests, 1), sizeof(SDLTest_TestRecord));
+	if (records == NULL) {
+	   SDLTest_LogError("Unable to allocate cache for test results");
+           SDL_Error(SDL_ENOMEM);
            return -1;
 	}
 
@@ -488,12 +1227,57 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
         if (suiteFilter == 0 && testFilter == 0) {
             SDLTest_LogError("Filter '%s' did not match any test suite/case.", filter);
             SDLTest_Log("Exit code: 2");
-            SDL_free((void *) failedTests);
+            SDL_free(records);
             return 2;
         }
     }
 
+    /* Select the tests that pass the filter and belong to our shard */
+    suiteCounter = 0;
+    while (testSuites[suiteCounter]) {
+        testSuite = testSuites[suiteCounter];
+        suiteCounter++;
+        if (suiteFilter == 1 && suiteFilterName != NULL && testSuite->name != NULL &&
+            SDL_strcmp(suiteFilterName, testSuite->name) != 0) {
+            continue;
+        }
+
+        testCounter = 0;
+        while (testSuite->testCases[testCounter])
+        {
+            testCase = testSuite->testCases[testCounter];
+            testCounter++;
+            if (testFilter == 1 && testFilterName != NULL && testCase->name != NULL &&
+                SDL_strcmp(testFilterName, testCase->name) != 0) {
+                continue;
+            }
+            if ((selectedCounter++ % SDLTest_ShardCount) != SDLTest_ShardIndex) {
+                continue;
+            }
+
+            record = &records[numRecords++];
+            record->testSuite = testSuite;
+            record->testCase = testCase;
+            record->suiteNumber = suiteCounter;
+            record->testNumber = testCounter;
+            record->forceTestRun = (testFilter == 1 && !testCase->enabled) ? SDL_TRUE : SDL_FALSE;
+            record->result = -1;
+        }
+    }
+
+    if (SDLTest_ShardCount > 1) {
+        SDLTest_Log("Sharding: running %d of %d test cases as shard %d/%d",
+            numRecords, selectedCounter, SDLTest_ShardIndex, SDLTest_ShardCount);
+    }
+
+#if SDLTEST_HAVE_WORKERS
+    if (SDLTest_NumWorkers > 1 && numRecords > 0) {
+        useWorkers = SDLTest_RunTestsInWorkers(records, numRecords, runSeed, userExecKey, testIterations);
+    }
+#endif
+
     /* Loop over all suites */
+    recordCounter = 0;
     suiteCounter = 0;
     while(testSuites[suiteCounter]) {
         testSuite = testSuites[suiteCounter];
@@ -504,9 +1288,11 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
         if (suiteFilter == 1 && suiteFilterName != NULL && testSuite->name != NULL &&
             SDL_strcmp(suiteFilterName, testSuite->name) != 0) {
                 /* Skip suite */
-                SDLTest_Log("===== Test Suite %i: '%s' skipped\n",
-                    suiteCounter,
-                    currentSuiteName);
+                if (!useWorkers) {
+                    SDLTest_Log("===== Test Suite %i: '%s' skipped\n",
+                        suiteCounter,
+                        currentSuiteName);
+                }
         } else {
 
             /* Reset per-suite counters */
@@ -518,9 +1304,11 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
             suiteStartSeconds = GetClock();
 
             /* Log suite started */
-            SDLTest_Log("===== Test Suite %i: '%s' started\n",
-                suiteCounter,
-                currentSuiteName);
+            if (!useWorkers) {
+                SDLTest_Log("===== Test Suite %i: '%s' started\n",
+                    suiteCounter,
+                    currentSuiteName);
+            }
 
             /* Loop over all test cases */
             testCounter = 0;
@@ -530,117 +1318,46 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
                 currentTestName = (testCase->name ? testCase->name : SDLTEST_INVALID_NAME_FORMAT);
                 testCounter++;
 
-                /* Filter tests if flag set and we have a name */
-                if (testFilter == 1 && testFilterName != NULL && testCase->name != NULL &&
-                    SDL_strcmp(testFilterName, testCase->name) != 0) {
-                        /* Skip test */
-                        SDLTest_Log("===== Test Case %i.%i: '%s' skipped\n",
-                            suiteCounter,
-                            testCounter,
-                            currentTestName);
-                } else {
-                    /* Override 'disabled' flag if we specified a test filter (i.e. force run for debugging) */
-                    if (testFilter == 1 && !testCase->enabled) {
-                        SDLTest_Log("Force run of disabled test since test filter was set");
-						forceTestRun = SDL_TRUE;
-                    }
+                if (recordCounter < numRecords &&
+                    records[recordCounter].suiteNumber == suiteCounter &&
+                    records[recordCounter].testNumber == testCounter) {
+                    record = &records[recordCounter++];
 
-                    /* Take time - test start */
-                    testStartSeconds = GetClock();
+                    /* Workers have already run it */
+                    if (!useWorkers) {
+                        SDLTest_RunTestIterations(record, runSeed, userExecKey, testIterations);
+                    }
 
-                    /* Log test started */
-                    SDLTest_Log("----- Test Case %i.%i: '%s' started",
+                    testPassedCount += record->passed;
+                    testFailedCount += record->failed;
+                    testSkippedCount += record->skipped;
+                } else if (!useWorkers) {
+                    /* Skip test, it was filtered out or belongs to another shard */
+                    SDLTest_Log("===== Test Case %i.%i: '%s' skipped\n",
                         suiteCounter,
                         testCounter,
                         currentTestName);
-                    if (testCase->description != NULL && testCase->description[0] != '\0') {
-                        SDLTest_Log("Test Description: '%s'",
-                            (testCase->description) ? testCase->description : SDLTEST_INVALID_NAME_FORMAT);
-                    }
-
-                    /* Loop over all iterations */
-                    iterationCounter = 0;
-                    while(iterationCounter < testIterations)
-                    {
-                        iterationCounter++;
-
-                        if (userExecKey != 0) {
-                            execKey = userExecKey;
-                        } else {
-                            execKey = SDLTest_GenerateExecKey(runSeed, testSuite->name, testCase->name, iterationCounter);
-                        }
-
-                        SDLTest_Log("Test Iteration %i: execKey %" SDL_PRIu64, iterationCounter, execKey);
-						testResult = SDLTest_RunTest(testSuite, testCase, execKey, forceTestRun);
-
-                        if (testResult == TEST_RESULT_PASSED) {
-                            testPassedCount++;
-                            totalTestPassedCount++;
-                        } else if (testResult == TEST_RESULT_SKIPPED) {
-                            testSkippedCount++;
-                            totalTestSkippedCount++;
-                        } else {
-                            testFailedCount++;
-                            totalTestFailedCount++;
-                        }
-                    }
-
-                    /* Take time - test end */
-                    testEndSeconds = GetClock();
-                    runtime = testEndSeconds - testStartSeconds;
-                    if (runtime < 0.0f) runtime = 0.0f;
-
-                    if (testIterations > 1) {
-                        /* Log test runtime */
-                        SDLTest_Log("Runtime of %i iterations: %.1f sec", testIterations, runtime);
-                        SDLTest_Log("Average Test runtime: %.5f sec", runtime / (float)testIterations);
-                    } else {
-                        /* Log test runtime */
-                        SDLTest_Log("Total Test runtime: %.1f sec", runtime);
-                    }
-
-                    /* Log final test result */
-                    switch (testResult) {
-                    case TEST_RESULT_PASSED:
-                        SDLTest_Log(SDLTEST_FINAL_RESULT_FORMAT, "Test", currentTestName, "Passed");
-                        break;
-                    case TEST_RESULT_FAILED:
-                        SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT, "Test", currentTestName, "Failed");
-                        break;
-                    case TEST_RESULT_NO_ASSERT:
-                        SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT,"Test", currentTestName, "No Asserts");
-                        break;
-                    }
-
-                    /* Collect failed test case references for repro-step display */
-                    if (testResult == TEST_RESULT_FAILED) {
-                        failedTests[failedNumberOfTests] = testCase;
-                        failedNumberOfTests++;
-                    }
                 }
             }
 
+            totalTestPassedCount += testPassedCount;
+            totalTestFailedCount += testFailedCount;
+            totalTestSkippedCount += testSkippedCount;
+
             /* Take time - suite end */
             suiteEndSeconds = GetClock();
             runtime = suiteEndSeconds - suiteStartSeconds;
             if (runtime < 0.0f) runtime = 0.0f;
 
             /* Log suite runtime */
-            SDLTest_Log("Total Suite runtime: %.1f sec", runtime);
-
-            /* Log summary and final Suite result */
-            countSum = testPassedCount + testFailedCount + testSkippedCount;
-            if (testFailedCount == 0)
-            {
-                SDLTest_Log(SDLTEST_LOG_SUMMARY_FORMAT, "Suite", countSum, testPassedCount, testFailedCount, testSkippedCount);
-                SDLTest_Log(SDLTEST_FINAL_RESULT_FORMAT, "Suite", currentSuiteName, "Passed");
-            }
-            else
-            {
-                SDLTest_LogError(SDLTEST_LOG_SUMMARY_FORMAT, "Suite", countSum, testPassedCount, testFailedCount, testSkippedCount);
-                SDLTest_LogError(SDLTEST_FINAL_RESULT_FORMAT, "Suite", currentSuiteName, "Failed");
+            if (useWorkers) {
+                SDLTest_Log("===== Test Suite %i: '%s'", suiteCounter, currentSuiteName);
+            } else {
+                SDLTest_Log("Total Suite runtime: %.1f sec", runtime);
             }
 
+            /* Log summary and final Suite result */
+            SDLTest_LogSuiteResult(currentSuiteName, testPassedCount, testFailedCount, testSkippedCount);
         }
     }
 
@@ -648,9 +1365,10 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     runEndSeconds = GetClock();
     runtime = runEndSeconds - runStartSeconds;
     if (runtime < 0.0f) runtime = 0.0f;
+    wallRuntime = GetWallClock() - wallStartSeconds;
 
-    /* Log total runtime */
-    SDLTest_Log("Total Run runtime: %.1f sec", runtime);
+    /* Log total runtime; the workers' CPU time doesn't show up in ours */
+    SDLTest_Log("Total Run runtime: %.1f sec", useWorkers ? (float) wallRuntime : runtime);
 
     /* Log summary and final run result */
     countSum = totalTestPassedCount + totalTestFailedCount + totalTestSkippedCount;
@@ -668,13 +1386,20 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     }
 
     /* Print repro steps for failed tests */
-    if (failedNumberOfTests > 0) {
-        SDLTest_Log("Harness input to repro failures:");
-        for (testCounter = 0; testCounter < failedNumberOfTests; testCounter++) {
-          SDLTest_Log(" --seed %s --filter %s", runSeed, failedTests[testCounter]->name);
+    for (recordCounter = 0; recordCounter < numRecords; recordCounter++) {
+        if (records[recordCounter].result == TEST_RESULT_FAILED) {
+            if (failedNumberOfTests == 0) {
+                SDLTest_Log("Harness input to repro failures:");
+            }
+            SDLTest_Log(" --seed %s --filter %s", runSeed, records[recordCounter].testCase->name);
+            failedNumberOfTests++;
         }
     }
-    SDL_free((void *) failedTests);
+
+    if (SDLTest_ReportFile != NULL) {
+        SDLTest_WriteReport(SDLTest_ReportFile, runSeed, records, numRecords, wallRuntime);
+    }
+    SDL_free(records);
 
     SDLTest_Log("Exit code: %d", runResult);
     return runResult;
@@ -0,0 +1,149 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+
+ Used by test suites to fingerprint surfaces and buffers.
+ The algorithm is XXH64, see https://github.com/Cyan4973/xxHash
+
+*/
+
+#include "SDL_config.h"
+
+#include "SDL_test.h"
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+#define ROTATE_LEFT64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+/* Little endian loads; compilers turn these into single loads where they can */
+static SDL_INLINE Uint32 SDLTest_Read32(const Uint8 *p)
+{
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+static SDL_INLINE Uint64 SDLTest_Read64(const Uint8 *p)
+{
+    return (Uint64)SDLTest_Read32(p) | ((Uint64)SDLTest_Read32(p + 4) << 32);
+}
+
+static SDL_INLINE Uint64 SDLTest_HashRound(Uint64 acc, Uint64 input)
+{
+    acc += input * PRIME64_2;
+    acc = ROTATE_LEFT64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static SDL_INLINE Uint64 SDLTest_HashMerge(Uint64 acc, Uint64 value)
+{
+    acc ^= SDLTest_HashRound(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+Uint64 SDLTest_FastHash(const void *data, size_t len, Uint64 seed)
+{
+    const Uint8 *p = (const Uint8 *)data;
+    const Uint8 *end = p + len;
+    Uint64 h;
+
+    if (len >= 32) {
+        /* Four independent lanes over 32 byte stripes */
+        const Uint8 *limit = end - 32;
+        Uint64 v1 = seed + PRIME64_1 + PRIME64_2;
+        Uint64 v2 = seed + PRIME64_2;
+        Uint64 v3 = seed;
+        Uint64 v4 = seed - PRIME64_1;
+
+        do {
+            v1 = SDLTest_HashRound(v1, SDLTest_Read64(p));
+            v2 = SDLTest_HashRound(v2, SDLTest_Read64(p + 8));
+            v3 = SDLTest_HashRound(v3, SDLTest_Read64(p + 16));
+            v4 = SDLTest_HashRound(v4, SDLTest_Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = ROTATE_LEFT64(v1, 1) + ROTATE_LEFT64(v2, 7) + ROTATE_LEFT64(v3, 12) + ROTATE_LEFT64(v4, 18);
+        h = SDLTest_HashMerge(h, v1);
+        h = SDLTest_HashMerge(h, v2);
+        h = SDLTest_HashMerge(h, v3);
+        h = SDLTest_HashMerge(h, v4);
+    } else {
+        h = seed + PRIME64_5;
+    }
+
+    h += (Uint64)len;
+
+    while (p + 8 <= end) {
+        h ^= SDLTest_HashRound(0, SDLTest_Read64(p));
+        h = ROTATE_LEFT64(h, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= (Uint64)SDLTest_Read32(p) * PRIME64_1;
+        h = ROTATE_LEFT64(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * PRIME64_5;
+        h = ROTATE_LEFT64(h, 11) * PRIME64_1;
+        p++;
+    }
+
+    /* Final mix so every input bit affects every output bit */
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+Uint64 SDLTest_HashSurface(SDL_Surface *surface)
+{
+    Uint32 header[3];
+    Uint64 h;
+    size_t rowLen;
+    int y;
+
+    if (surface == NULL) {
+        return 0;
+    }
+
+    header[0] = SDL_SwapLE32((Uint32)surface->w);
+    header[1] = SDL_SwapLE32((Uint32)surface->h);
+    header[2] = SDL_SwapLE32(surface->format->format);
+    h = SDLTest_FastHash(header, sizeof(header), 0);
+
+    SDL_LockSurface(surface);
+    rowLen = (size_t)surface->w * surface->format->BytesPerPixel;
+    for (y = 0; y < surface->h; y++) {
+        h = SDLTest_FastHash((const Uint8 *)surface->pixels + y * surface->pitch, rowLen, h);
+    }
+    SDL_UnlockSurface(surface);
+
+    return h;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
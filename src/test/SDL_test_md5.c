@@ -55,7 +55,8 @@
 
 #include "SDL_test.h"
 
-/* Forward declaration of static helper function */
+/* Forward declaration of static helper functions */
+static void SDLTest_Md5Decode(MD5UINT4 * in, const unsigned char *block);
 static void SDLTest_Md5Transform(MD5UINT4 * buf, const MD5UINT4 * in);
 
 static unsigned char MD5PADDING[64] = {
@@ -69,9 +70,9 @@ static unsigned char MD5PADDING[64] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-/* F, G, H and I are basic MD5 functions */
-#define F(x, y, z) (((x) & (y)) | ((~x) & (z)))
-#define G(x, y, z) (((x) & (z)) | ((y) & (~z)))
+/* F, G, H and I are basic MD5 functions; F and G are rewritten to need one operation less */
+#define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
 #define H(x, y, z) ((x) ^ (y) ^ (z))
 #define I(x, y, z) ((y) ^ ((x) | (~z)))
 
@@ -133,7 +134,7 @@ void SDLTest_Md5Update(SDLTest_Md5Context * mdContext, unsigned char *inBuf,
 {
   MD5UINT4  in[16];
   int       mdi;
-  unsigned int i, ii;
+  unsigned int fill;
 
   if (mdContext == NULL) return;
   if (inBuf == NULL || inLen < 1) return;
@@ -151,24 +152,37 @@ void SDLTest_Md5Update(SDLTest_Md5Context * mdContext, unsigned char *inBuf,
   mdContext->i[0] += ((MD5UINT4) inLen << 3);
   mdContext->i[1] += ((MD5UINT4) inLen >> 29);
 
-  while (inLen--) {
-    /*
-     * add new character to buffer, increment mdi
-     */
-    mdContext->in[mdi++] = *inBuf++;
-
-    /*
-     * transform if necessary
-     */
-    if (mdi == 0x40) {
-      for (i = 0, ii = 0; i < 16; i++, ii += 4)
-    in[i] = (((MD5UINT4) mdContext->in[ii + 3]) << 24) |
-      (((MD5UINT4) mdContext->in[ii + 2]) << 16) |
-      (((MD5UINT4) mdContext->in[ii + 1]) << 8) |
-      ((MD5UINT4) mdContext->in[ii]);
-      SDLTest_Md5Transform(mdContext->buf, in);
-      mdi = 0;
+  /*
+   * complete a partially filled buffer first
+   */
+  if (mdi > 0) {
+    fill = 0x40 - mdi;
+    if (inLen < fill) {
+      SDL_memcpy(&mdContext->in[mdi], inBuf, inLen);
+      return;
     }
+    SDL_memcpy(&mdContext->in[mdi], inBuf, fill);
+    SDLTest_Md5Decode(in, mdContext->in);
+    SDLTest_Md5Transform(mdContext->buf, in);
+    inBuf += fill;
+    inLen -= fill;
+  }
+
+  /*
+   * transform whole blocks straight from the input
+   */
+  while (inLen >= 0x40) {
+    SDLTest_Md5Decode(in, inBuf);
+    SDLTest_Md5Transform(mdContext->buf, in);
+    inBuf += 0x40;
+    inLen -= 0x40;
+  }
+
+  /*
+   * keep the rest for the next update
+   */
+  if (inLen > 0) {
+    SDL_memcpy(mdContext->in, inBuf, inLen);
   }
 }
 
@@ -227,6 +241,18 @@ void SDLTest_Md5Final(SDLTest_Md5Context * mdContext)
   }
 }
 
+/* Reads a 64 byte block as little endian words.
+ */
+static void SDLTest_Md5Decode(MD5UINT4 * in, const unsigned char *block)
+{
+  int i;
+
+  for (i = 0; i < 16; i++, block += 4) {
+    in[i] = ((MD5UINT4) block[0]) | (((MD5UINT4) block[1]) << 8) |
+      (((MD5UINT4) block[2]) << 16) | (((MD5UINT4) block[3]) << 24);
+  }
+}
+
 /* Basic MD5 step. Transforms buf based on in.
  */
 static void SDLTest_Md5Transform(MD5UINT4 * buf, const MD5UINT4 * in)
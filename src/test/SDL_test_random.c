@@ -26,6 +26,10 @@
  Used by the fuzzer component.
  Original source code contributed by A. Schiffler for GSOC project.
 
+ Buffers are filled by interleaved xoshiro128** generators instead, see
+ http://prng.di.unimi.it/
+
+
 */
 
 #include "SDL_config.h"
@@ -93,4 +97,53 @@ unsigned int SDLTest_Random(SDLTest_RandomContext * rndContext)
   return (rndContext->x);
 }
 
+/* Number of interleaved generators used by SDLTest_RandomFill() */
+#define SDLTEST_RANDOM_LANES 8
+
+#define ROTATE_LEFT32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* Fills buffers; the lanes are independent so the loops vectorize */
+
+void SDLTest_RandomFill(SDLTest_RandomContext * rndContext, void *buffer, size_t size)
+{
+  Uint32 s0[SDLTEST_RANDOM_LANES], s1[SDLTEST_RANDOM_LANES];
+  Uint32 s2[SDLTEST_RANDOM_LANES], s3[SDLTEST_RANDOM_LANES];
+  Uint32 block[SDLTEST_RANDOM_LANES];
+  Uint8 *dst = (Uint8 *)buffer;
+  int i;
+
+  if (rndContext==NULL || buffer==NULL || size==0) return;
+
+  /* Seed from the context, so the fill is reproducible and moves it on */
+  for (i = 0; i < SDLTEST_RANDOM_LANES; i++) {
+    s0[i] = SDLTest_Random(rndContext);
+    s1[i] = SDLTest_Random(rndContext);
+    s2[i] = SDLTest_Random(rndContext);
+    s3[i] = SDLTest_Random(rndContext);
+    if ((s0[i] | s1[i] | s2[i] | s3[i]) == 0) {
+      s0[i] = i + 1;
+    }
+  }
+
+  while (size > 0) {
+    size_t len = SDL_min(size, sizeof(block));
+
+    for (i = 0; i < SDLTEST_RANDOM_LANES; i++) {
+      Uint32 result = ROTATE_LEFT32(s1[i] * 5, 7) * 9;
+      Uint32 t = s1[i] << 9;
+
+      s2[i] ^= s0[i];
+      s3[i] ^= s1[i];
+      s1[i] ^= s2[i];
+      s0[i] ^= s3[i];
+      s2[i] ^= t;
+      s3[i] = ROTATE_LEFT32(s3[i], 11);
+      block[i] = SDL_SwapLE32(result);
+    }
+    SDL_memcpy(dst, block, len);
+    dst += len;
+    size -= len;
+  }
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
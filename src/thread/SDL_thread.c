@@ -30,6 +30,27 @@
 #include "../SDL_error_c.h"
 
 
+#ifdef SDL_THREAD_LOCAL
+/* Each thread's storage, no function call or lookup needed */
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_data;
+
+static SDL_TLSData *
+SDL_GetTLSData(void)
+{
+    return SDL_tls_data;
+}
+
+static int
+SDL_SetTLSData(SDL_TLSData *data)
+{
+    SDL_tls_data = data;
+    return 0;
+}
+#else
+#define SDL_GetTLSData  SDL_SYS_GetTLSData
+#define SDL_SetTLSData  SDL_SYS_SetTLSData
+#endif
+
 SDL_TLSID
 SDL_TLSCreate()
 {
@@ -42,7 +63,7 @@ SDL_TLSGet(SDL_TLSID id)
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || id == 0 || id > storage->limit) {
         return NULL;
     }
@@ -58,7 +79,7 @@ SDL_TLSSet(SDL_TLSID id, const void *value, void (SDLCALL *destructor)(void *))
         return SDL_InvalidParamError("id");
     }
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || (id > storage->limit)) {
         unsigned int i, oldlimit, newlimit;
 
@@ -73,7 +94,7 @@ SDL_TLSSet(SDL_TLSID id, const void *value, void (SDLCALL *destructor)(void *))
             storage->array[i].data = NULL;
             storage->array[i].destructor = NULL;
         }
-        if (SDL_SYS_SetTLSData(storage) != 0) {
+        if (SDL_SetTLSData(storage) != 0) {
             return -1;
         }
     }
@@ -88,7 +109,7 @@ SDL_TLSCleanup()
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (storage) {
         unsigned int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -96,7 +117,7 @@ SDL_TLSCleanup()
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
-        SDL_SYS_SetTLSData(NULL);
+        SDL_SetTLSData(NULL);
         SDL_free(storage);
     }
 }
@@ -105,95 +126,104 @@ SDL_TLSCleanup()
 /* This is a generic implementation of thread-local storage which doesn't
    require additional OS support.
 
-   It is not especially efficient and doesn't clean up thread-local storage
-   as threads exit.  If there is a real OS that doesn't support thread-local
-   storage this implementation should be improved to be production quality.
+   Threads are hashed by ID into a fixed table of buckets. Entries are only
+   ever added to the front of a bucket and are never freed, just released
+   for reuse when their thread clears its storage, so lookups can walk a
+   bucket without taking a lock. A thread only ever looks for, and changes,
+   its own entry.
+
+   It doesn't clean up thread-local storage as threads exit. If there is a
+   real OS that doesn't support thread-local storage this implementation
+   should be improved to be production quality.
 */
 
+#define SDL_GENERIC_TLS_BUCKET_BITS 6
+
 typedef struct SDL_TLSEntry {
+    volatile SDL_bool used;
     SDL_threadID thread;
     SDL_TLSData *storage;
     struct SDL_TLSEntry *next;
 } SDL_TLSEntry;
 
-static SDL_mutex *SDL_generic_TLS_mutex;
-static SDL_TLSEntry *SDL_generic_TLS;
+static SDL_SpinLock SDL_generic_TLS_lock;
+static SDL_TLSEntry *SDL_generic_TLS[1 << SDL_GENERIC_TLS_BUCKET_BITS];
 
+static SDL_TLSEntry **
+SDL_Generic_TLSBucket(SDL_threadID thread)
+{
+    /* Thread IDs are often aligned pointers, so hash all of the bits */
+    const Uint32 hash = ((Uint32) (((Uint64) thread) ^ (((Uint64) thread) >> 32))) * 0x9E3779B1u;
+    return &SDL_generic_TLS[hash >> (32 - SDL_GENERIC_TLS_BUCKET_BITS)];
+}
 
-SDL_TLSData *
-SDL_Generic_GetTLSData(void)
+static SDL_TLSEntry *
+SDL_Generic_FindTLSEntry(SDL_threadID thread)
 {
-    SDL_threadID thread = SDL_ThreadID();
     SDL_TLSEntry *entry;
-    SDL_TLSData *storage = NULL;
 
-#if !SDL_THREADS_DISABLED
-    if (!SDL_generic_TLS_mutex) {
-        static SDL_SpinLock tls_lock;
-        SDL_AtomicLock(&tls_lock);
-        if (!SDL_generic_TLS_mutex) {
-            SDL_mutex *mutex = SDL_CreateMutex();
-            SDL_MemoryBarrierRelease();
-            SDL_generic_TLS_mutex = mutex;
-            if (!SDL_generic_TLS_mutex) {
-                SDL_AtomicUnlock(&tls_lock);
-                return NULL;
+    entry = (SDL_TLSEntry *) SDL_AtomicGetPtr((void **) SDL_Generic_TLSBucket(thread));
+    for (; entry; entry = entry->next) {
+        if (entry->used) {
+            SDL_MemoryBarrierAcquire();
+            if (entry->thread == thread) {
+                return entry;
             }
         }
-        SDL_AtomicUnlock(&tls_lock);
     }
-#endif /* SDL_THREADS_DISABLED */
+    return NULL;
+}
 
-    SDL_MemoryBarrierAcquire();
-    SDL_LockMutex(SDL_generic_TLS_mutex);
-    for (entry = SDL_generic_TLS; entry; entry = entry->next) {
-        if (entry->thread == thread) {
-            storage = entry->storage;
-            break;
-        }
-    }
-#if !SDL_THREADS_DISABLED
-    SDL_UnlockMutex(SDL_generic_TLS_mutex);
-#endif
+SDL_TLSData *
+SDL_Generic_GetTLSData(void)
+{
+    SDL_TLSEntry *entry = SDL_Generic_FindTLSEntry(SDL_ThreadID());
 
-    return storage;
+    return entry ? entry->storage : NULL;
 }
 
 int
 SDL_Generic_SetTLSData(SDL_TLSData *storage)
 {
     SDL_threadID thread = SDL_ThreadID();
-    SDL_TLSEntry *prev, *entry;
-
-    /* SDL_Generic_GetTLSData() is always called first, so we can assume SDL_generic_TLS_mutex */
-    SDL_LockMutex(SDL_generic_TLS_mutex);
-    prev = NULL;
-    for (entry = SDL_generic_TLS; entry; entry = entry->next) {
-        if (entry->thread == thread) {
-            if (storage) {
-                entry->storage = storage;
-            } else {
-                if (prev) {
-                    prev->next = entry->next;
-                } else {
-                    SDL_generic_TLS = entry->next;
-                }
-                SDL_free(entry);
-            }
+    SDL_TLSEntry **bucket;
+    SDL_TLSEntry *entry;
+
+    entry = SDL_Generic_FindTLSEntry(thread);
+    if (entry) {
+        entry->storage = storage;
+        if (!storage) {
+            entry->used = SDL_FALSE;
+        }
+        return 0;
+    }
+    if (!storage) {
+        return 0;
+    }
+
+    bucket = SDL_Generic_TLSBucket(thread);
+    SDL_AtomicLock(&SDL_generic_TLS_lock);
+    for (entry = *bucket; entry; entry = entry->next) {
+        if (!entry->used) {
             break;
         }
-        prev = entry;
     }
-    if (!entry) {
+    if (entry) {
+        entry->thread = thread;
+        entry->storage = storage;
+        SDL_MemoryBarrierRelease();
+        entry->used = SDL_TRUE;
+    } else {
         entry = (SDL_TLSEntry *)SDL_malloc(sizeof(*entry));
         if (entry) {
+            entry->used = SDL_TRUE;
             entry->thread = thread;
             entry->storage = storage;
-            entry->next = SDL_generic_TLS;
-            SDL_generic_TLS = entry;
+            entry->next = *bucket;
+            SDL_AtomicSetPtr((void **) bucket, entry);
         }
     }
-    SDL_UnlockMutex(SDL_generic_TLS_mutex);
+    SDL_AtomicUnlock(&SDL_generic_TLS_lock);
 
     if (!entry) {
         return SDL_OutOfMemory();
@@ -78,13 +78,26 @@ typedef struct {
 /* This is how many TLS entries we allocate at once */
 #define TLS_ALLOC_CHUNKSIZE 4
 
-/* Get cross-platform, slow, thread local storage for this thread.
+/* Thread local variables managed by the compiler, used in place of the
+   SDL_SYS_*TLSData() functions where the toolchain and runtime are known
+   to support them, including in shared libraries loaded at runtime.
+   Other compilers and platforms can define SDL_THREAD_LOCAL themselves.
+ */
+#ifndef SDL_THREAD_LOCAL
+#if !SDL_THREADS_DISABLED && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__DragonFly__)) && \
+    !defined(__ANDROID__)
+#define SDL_THREAD_LOCAL __thread
+#endif
+#endif
+
+/* Get cross-platform thread local storage for this thread.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
  */
 extern SDL_TLSData *SDL_Generic_GetTLSData(void);
 
-/* Set cross-platform, slow, thread local storage for this thread.
+/* Set cross-platform thread local storage for this thread.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
  */
@@ -96,6 +96,11 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* the source palette colors info.table was built from, so palette
+       changes only remap the entries that actually changed */
+    SDL_Color *table_colors;
+    int table_ncolors;
 } SDL_BlitMap;
 
 /* Functions found in SDL_blit.c */
@@ -24,6 +24,7 @@
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 /* Functions to perform alpha blended blitting */
 
@@ -1331,12 +1332,50 @@ BlitNtoNPixelAlpha(SDL_BlitInfo * info)
 }
 
 
+/* The per-pixel alpha blits between 32-bit formats are the ones that have
+   a SIMD version on most platforms */
+static SDL_SIMDVariant SDL_BlendVariant = SDL_SIMD_UNRESOLVED;
+
+void
+SDL_ChooseBlendKernels(void)
+{
+    SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+
+#if SDL_ARM_SIMD_BLITTERS
+    if (SDL_HasARMSIMD()) {
+        variant = SDL_SIMD_ARMSIMD;
+    }
+#endif
+#if SDL_ARM_NEON_BLITTERS
+    if (SDL_HasNEON()) {
+        variant = SDL_SIMD_NEON;
+    }
+#endif
+#ifdef __MMX__
+    if (SDL_HasMMX()) {
+        variant = SDL_SIMD_MMX;
+    }
+#endif
+#ifdef __3dNOW__
+    if (SDL_Has3DNow()) {
+        variant = SDL_SIMD_3DNOW;
+    }
+#endif
+
+    SDL_BlendVariant = variant;
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_BLEND, variant);
+}
+
 SDL_BlitFunc
 SDL_CalculateBlitA(SDL_Surface * surface)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
 
+    if (SDL_BlendVariant == SDL_SIMD_UNRESOLVED) {
+        SDL_ChooseBlendKernels();
+    }
+
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case SDL_COPY_BLEND:
         /* Per-pixel alpha blits */
@@ -1357,11 +1396,11 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     || (sf->Bmask == 0xff && df->Bmask == 0x1f)))
                 {
 #if SDL_ARM_NEON_BLITTERS
-                    if (SDL_HasNEON())
+                    if (SDL_BlendVariant == SDL_SIMD_NEON)
                         return BlitARGBto565PixelAlphaARMNEON;
 #endif
 #if SDL_ARM_SIMD_BLITTERS
-                    if (SDL_HasARMSIMD())
+                    if (SDL_BlendVariant == SDL_SIMD_ARMSIMD)
                         return BlitARGBto565PixelAlphaARMSIMD;
 #endif
                 }
@@ -1387,22 +1426,22 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     && sf->Bshift % 8 == 0
                     && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
 #ifdef __3dNOW__
-                    if (SDL_Has3DNow())
+                    if (SDL_BlendVariant == SDL_SIMD_3DNOW)
                         return BlitRGBtoRGBPixelAlphaMMX3DNOW;
 #endif
 #ifdef __MMX__
-                    if (SDL_HasMMX())
+                    if (SDL_BlendVariant == SDL_SIMD_MMX)
                         return BlitRGBtoRGBPixelAlphaMMX;
 #endif
                 }
 #endif /* __MMX__ || __3dNOW__ */
                 if (sf->Amask == 0xff000000) {
 #if SDL_ARM_NEON_BLITTERS
-                    if (SDL_HasNEON())
+                    if (SDL_BlendVariant == SDL_SIMD_NEON)
                         return BlitRGBtoRGBPixelAlphaARMNEON;
 #endif
 #if SDL_ARM_SIMD_BLITTERS
-                    if (SDL_HasARMSIMD())
+                    if (SDL_BlendVariant == SDL_SIMD_ARMSIMD)
                         return BlitRGBtoRGBPixelAlphaARMSIMD;
 #endif
                     return BlitRGBtoRGBPixelAlpha;
@@ -1491,6 +1530,16 @@ SDL_CalculateBlitA(SDL_Surface * surface)
     return NULL;
 }
 
+#else
+
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+void
+SDL_ChooseBlendKernels(void)
+{
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_BLEND, SDL_SIMD_SCALAR);
+}
+
 #endif /* SDL_HAVE_BLIT_A */
 
 /* vi: set ts=4 sw=4 expandtab: */
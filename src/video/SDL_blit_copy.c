@@ -23,6 +23,7 @@
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_blit_copy.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 
 #ifdef __SSE__
@@ -52,6 +53,53 @@ SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
 }
 #endif /* __SSE__ */
 
+#if HAVE_AVX_KERNELS
+/* This assumes 32-byte aligned src and dst */
+SDL_TARGETING("avx") static void
+SDL_memcpyAVX(Uint8 * dst, const Uint8 * src, int len)
+{
+    int i;
+
+    __m256i values[2];
+    for (i = len / 64; i--;) {
+        _mm_prefetch((const char *) src, _MM_HINT_NTA);
+        values[0] = _mm256_load_si256((const __m256i *) (src + 0));
+        values[1] = _mm256_load_si256((const __m256i *) (src + 32));
+        _mm256_stream_si256((__m256i *) (dst + 0), values[0]);
+        _mm256_stream_si256((__m256i *) (dst + 32), values[1]);
+        src += 64;
+        dst += 64;
+    }
+
+    if (len & 63)
+        SDL_memcpy(dst, src, len & 63);
+}
+#endif /* HAVE_AVX_KERNELS */
+
+#if HAVE_AVX512F_KERNELS
+/* This assumes 64-byte aligned src and dst */
+SDL_TARGETING("avx512f") static void
+SDL_memcpyAVX512F(Uint8 * dst, const Uint8 * src, int len)
+{
+    int i;
+
+    __m512i values[2];
+    for (i = len / 128; i--;) {
+        _mm_prefetch((const char *) src, _MM_HINT_NTA);
+        _mm_prefetch((const char *) src + 64, _MM_HINT_NTA);
+        values[0] = _mm512_load_si512((const void *) (src + 0));
+        values[1] = _mm512_load_si512((const void *) (src + 64));
+        _mm512_stream_si512((__m512i *) (dst + 0), values[0]);
+        _mm512_stream_si512((__m512i *) (dst + 64), values[1]);
+        src += 128;
+        dst += 128;
+    }
+
+    if (len & 127)
+        SDL_memcpy(dst, src, len & 127);
+}
+#endif /* HAVE_AVX512F_KERNELS */
+
 #ifdef __MMX__
 #ifdef _MSC_VER
 #pragma warning(disable:4799)
@@ -87,10 +135,52 @@ SDL_memcpyMMX(Uint8 * dst, const Uint8 * src, int len)
 }
 #endif /* __MMX__ */
 
+/* The widest copy is used when the rows are aligned for it, narrower ones
+   otherwise, so remember everything that's usable. */
+static SDL_bool SDL_CopyKernelsChosen = SDL_FALSE;
+static SDL_bool SDL_CopyAVX512F = SDL_FALSE;
+static SDL_bool SDL_CopyAVX = SDL_FALSE;
+static SDL_bool SDL_CopySSE = SDL_FALSE;
+static SDL_bool SDL_CopyMMX = SDL_FALSE;
+
+void
+SDL_ChooseCopyKernels(void)
+{
+    SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+
+#ifdef __MMX__
+    SDL_CopyMMX = SDL_HasMMX();
+    if (SDL_CopyMMX) {
+        variant = SDL_SIMD_MMX;
+    }
+#endif
+#ifdef __SSE__
+    SDL_CopySSE = SDL_HasSSE();
+    if (SDL_CopySSE) {
+        variant = SDL_SIMD_SSE;
+    }
+#endif
+#if HAVE_AVX_KERNELS
+    SDL_CopyAVX = SDL_HasAVX();
+    if (SDL_CopyAVX) {
+        variant = SDL_SIMD_AVX;
+    }
+#endif
+#if HAVE_AVX512F_KERNELS
+    SDL_CopyAVX512F = SDL_HasAVX512F();
+    if (SDL_CopyAVX512F) {
+        variant = SDL_SIMD_AVX512F;
+    }
+#endif
+
+    SDL_CopyKernelsChosen = SDL_TRUE;
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_COPY, variant);
+}
+
 void
 SDL_BlitCopy(SDL_BlitInfo * info)
 {
-    SDL_bool overlap;
+    SDL_bool overlap, stream;
     Uint8 *src, *dst;
     int w, h;
     int srcskip, dstskip;
@@ -127,8 +217,44 @@ SDL_BlitCopy(SDL_BlitInfo * info)
         return;
     }
 
+    /* The SIMD copies below are for copies too large to stay in the cache.
+       memcpy() is as fast for the rest and leaves the result cached. */
+    stream = ((size_t) w * h >= SDL_GetCPUStreamingThreshold());
+
+    if (stream && !SDL_CopyKernelsChosen) {
+        SDL_ChooseCopyKernels();
+    }
+
+#if HAVE_AVX512F_KERNELS
+    if (stream && SDL_CopyAVX512F &&
+        !((uintptr_t) src & 63) && !(srcskip & 63) &&
+        !((uintptr_t) dst & 63) && !(dstskip & 63)) {
+        while (h--) {
+            SDL_memcpyAVX512F(dst, src, w);
+            src += srcskip;
+            dst += dstskip;
+        }
+        _mm_sfence();
+        return;
+    }
+#endif
+
+#if HAVE_AVX_KERNELS
+    if (stream && SDL_CopyAVX &&
+        !((uintptr_t) src & 31) && !(srcskip & 31) &&
+        !((uintptr_t) dst & 31) && !(dstskip & 31)) {
+        while (h--) {
+            SDL_memcpyAVX(dst, src, w);
+            src += srcskip;
+            dst += dstskip;
+        }
+        _mm_sfence();
+        return;
+    }
+#endif
+
 #ifdef __SSE__
-    if (SDL_HasSSE() &&
+    if (stream && SDL_CopySSE &&
         !((uintptr_t) src & 15) && !(srcskip & 15) &&
         !((uintptr_t) dst & 15) && !(dstskip & 15)) {
         while (h--) {
@@ -141,7 +267,7 @@ SDL_BlitCopy(SDL_BlitInfo * info)
 #endif
 
 #ifdef __MMX__
-    if (SDL_HasMMX() && !(srcskip & 7) && !(dstskip & 7)) {
+    if (stream && SDL_CopyMMX && !(srcskip & 7) && !(dstskip & 7)) {
         while (h--) {
             SDL_memcpyMMX(dst, src, w);
             src += srcskip;
@@ -23,6 +23,7 @@
 #include "SDL_video.h"
 #include "SDL_blit.h"
 #include "SDL_cpuinfo.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 
 #ifdef __SSE__
@@ -46,13 +47,25 @@
     c128 = *(__m128 *)cccc;
 #endif
 
+/* Fills too large to stay in the cache bypass it, smaller ones are left in
+   the cache for whatever reads them next */
 #define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    if (stream) { \
+        for (i = n / 64; i--;) { \
+            _mm_stream_ps((float *)(p+0), c128); \
+            _mm_stream_ps((float *)(p+16), c128); \
+            _mm_stream_ps((float *)(p+32), c128); \
+            _mm_stream_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
+    } else { \
+        for (i = n / 64; i--;) { \
+            _mm_store_ps((float *)(p+0), c128); \
+            _mm_store_ps((float *)(p+16), c128); \
+            _mm_store_ps((float *)(p+32), c128); \
+            _mm_store_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
     }
 
 #define SSE_END
@@ -63,6 +76,7 @@ SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
+    const SDL_bool stream = ((size_t) w * h * bpp >= SDL_GetCPUStreamingThreshold()); \
  \
     SSE_BEGIN; \
  \
@@ -100,6 +114,7 @@ static void
 SDL_FillRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int i, n;
+    const SDL_bool stream = ((size_t) w * h >= SDL_GetCPUStreamingThreshold());
 
     SSE_BEGIN;
     while (h--) {
@@ -131,6 +146,75 @@ DEFINE_SSE_FILLRECT(4, Uint32)
 /* *INDENT-ON* */
 #endif /* __SSE__ */
 
+/* The AVX and AVX-512 fills are the SSE fill with wider registers, built
+   for the larger instruction sets even when the compiler doesn't target
+   them by default. The color is already replicated to 32 bits. */
+/* *INDENT-OFF* */
+#define DEFINE_WIDE_FILLRECT(bpp, type, isa, target, vec, width, set1, store, nt_store) \
+SDL_TARGETING(target) static void \
+SDL_FillRect##bpp##isa(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
+{ \
+    const vec c = set1((int) color); \
+    const SDL_bool stream = ((size_t) w * h * bpp >= SDL_GetCPUStreamingThreshold()); \
+    int i, n; \
+ \
+    while (h--) { \
+        Uint8 *p = pixels; \
+        n = w * bpp; \
+ \
+        if (n >= 4 * width) { \
+            int adjust = (int) (width - ((uintptr_t)p & (width - 1))); \
+            if (adjust < width) { \
+                n -= adjust; \
+                adjust /= bpp; \
+                while (adjust--) { \
+                    *((type *)p) = (type)color; \
+                    p += bpp; \
+                } \
+            } \
+            if (stream) { \
+                for (i = n / (4 * width); i--;) { \
+                    nt_store((vec *)(p + 0 * width), c); \
+                    nt_store((vec *)(p + 1 * width), c); \
+                    nt_store((vec *)(p + 2 * width), c); \
+                    nt_store((vec *)(p + 3 * width), c); \
+                    p += 4 * width; \
+                } \
+            } else { \
+                for (i = n / (4 * width); i--;) { \
+                    store((vec *)(p + 0 * width), c); \
+                    store((vec *)(p + 1 * width), c); \
+                    store((vec *)(p + 2 * width), c); \
+                    store((vec *)(p + 3 * width), c); \
+                    p += 4 * width; \
+                } \
+            } \
+            n &= (4 * width - 1); \
+        } \
+        n /= bpp; \
+        while (n--) { \
+            *((type *)p) = (type)color; \
+            p += bpp; \
+        } \
+        pixels += pitch; \
+    } \
+    if (stream) { \
+        _mm_sfence(); \
+    } \
+}
+
+#if HAVE_AVX_KERNELS
+DEFINE_WIDE_FILLRECT(1, Uint8, AVX, "avx", __m256i, 32, _mm256_set1_epi32, _mm256_store_si256, _mm256_stream_si256)
+DEFINE_WIDE_FILLRECT(2, Uint16, AVX, "avx", __m256i, 32, _mm256_set1_epi32, _mm256_store_si256, _mm256_stream_si256)
+DEFINE_WIDE_FILLRECT(4, Uint32, AVX, "avx", __m256i, 32, _mm256_set1_epi32, _mm256_store_si256, _mm256_stream_si256)
+#endif
+#if HAVE_AVX512F_KERNELS
+DEFINE_WIDE_FILLRECT(1, Uint8, AVX512F, "avx512f", __m512i, 64, _mm512_set1_epi32, _mm512_store_si512, _mm512_stream_si512)
+DEFINE_WIDE_FILLRECT(2, Uint16, AVX512F, "avx512f", __m512i, 64, _mm512_set1_epi32, _mm512_store_si512, _mm512_stream_si512)
+DEFINE_WIDE_FILLRECT(4, Uint32, AVX512F, "avx512f", __m512i, 64, _mm512_set1_epi32, _mm512_store_si512, _mm512_stream_si512)
+#endif
+/* *INDENT-ON* */
+
 static void
 SDL_FillRect1(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
 {
@@ -295,6 +379,68 @@ static void fill_32_simd(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
 }
 #endif
 
+typedef void (*SDL_FillFunc)(Uint8 * pixels, int pitch, Uint32 color, int w, int h);
+
+/* Indexed by bytes per pixel */
+static SDL_FillFunc SDL_FillFuncs[5];
+
+void
+SDL_ChooseFillKernels(void)
+{
+    SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+
+    SDL_FillFuncs[1] = SDL_FillRect1;
+    SDL_FillFuncs[2] = SDL_FillRect2;
+    SDL_FillFuncs[3] = SDL_FillRect3;  /* 24-bit RGB is a slow path, at least for now. */
+    SDL_FillFuncs[4] = SDL_FillRect4;
+
+#if HAVE_AVX512F_KERNELS
+    if (SDL_HasAVX512F()) {
+        SDL_FillFuncs[1] = SDL_FillRect1AVX512F;
+        SDL_FillFuncs[2] = SDL_FillRect2AVX512F;
+        SDL_FillFuncs[4] = SDL_FillRect4AVX512F;
+        variant = SDL_SIMD_AVX512F;
+    } else
+#endif
+#if HAVE_AVX_KERNELS
+    if (SDL_HasAVX()) {
+        SDL_FillFuncs[1] = SDL_FillRect1AVX;
+        SDL_FillFuncs[2] = SDL_FillRect2AVX;
+        SDL_FillFuncs[4] = SDL_FillRect4AVX;
+        variant = SDL_SIMD_AVX;
+    } else
+#endif
+#ifdef __SSE__
+    if (SDL_HasSSE()) {
+        SDL_FillFuncs[1] = SDL_FillRect1SSE;
+        SDL_FillFuncs[2] = SDL_FillRect2SSE;
+        SDL_FillFuncs[4] = SDL_FillRect4SSE;
+        variant = SDL_SIMD_SSE;
+    } else
+#endif
+#if SDL_ARM_NEON_BLITTERS
+    if (SDL_HasNEON()) {
+        SDL_FillFuncs[1] = fill_8_neon;
+        SDL_FillFuncs[2] = fill_16_neon;
+        SDL_FillFuncs[4] = fill_32_neon;
+        variant = SDL_SIMD_NEON;
+    } else
+#endif
+#if SDL_ARM_SIMD_BLITTERS
+    if (SDL_HasARMSIMD()) {
+        SDL_FillFuncs[1] = fill_8_simd;
+        SDL_FillFuncs[2] = fill_16_simd;
+        SDL_FillFuncs[4] = fill_32_simd;
+        variant = SDL_SIMD_ARMSIMD;
+    } else
+#endif
+    {
+        /* The plain C fills are already set up */
+    }
+
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_FILL, variant);
+}
+
 int
 SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
               Uint32 color)
@@ -302,7 +448,7 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
     SDL_Rect clipped;
     Uint8 *pixels;
     const SDL_Rect* rect;
-    void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    SDL_FillFunc fill_function;
     int i;
 
     if (!dst) {
@@ -323,89 +469,25 @@ SDL_FillRects(SDL_Surface * dst, const SDL_Rect * rects, int count,
         return SDL_SetError("SDL_FillRects() passed NULL rects");
     }
 
-#if SDL_ARM_NEON_BLITTERS
-    if (SDL_HasNEON() && dst->format->BytesPerPixel != 3 && fill_function == NULL) {
-        switch (dst->format->BytesPerPixel) {
-        case 1:
-            fill_function = fill_8_neon;
-            break;
-        case 2:
-            fill_function = fill_16_neon;
-            break;
-        case 4:
-            fill_function = fill_32_neon;
-            break;
-        }
-    }
-#endif
-#if SDL_ARM_SIMD_BLITTERS
-    if (SDL_HasARMSIMD() && dst->format->BytesPerPixel != 3 && fill_function == NULL) {
-        switch (dst->format->BytesPerPixel) {
-        case 1:
-            fill_function = fill_8_simd;
-            break;
-        case 2:
-            fill_function = fill_16_simd;
-            break;
-        case 4:
-            fill_function = fill_32_simd;
-            break;
-        }
+    if (!SDL_FillFuncs[1]) {
+        SDL_ChooseFillKernels();
     }
-#endif
-
-    if (fill_function == NULL) {
-        switch (dst->format->BytesPerPixel) {
-        case 1:
-            {
-                color |= (color << 8);
-                color |= (color << 16);
-#ifdef __SSE__
-                if (SDL_HasSSE()) {
-                    fill_function = SDL_FillRect1SSE;
-                    break;
-                }
-#endif
-                fill_function = SDL_FillRect1;
-                break;
-            }
-
-        case 2:
-            {
-                color |= (color << 16);
-#ifdef __SSE__
-                if (SDL_HasSSE()) {
-                    fill_function = SDL_FillRect2SSE;
-                    break;
-                }
-#endif
-                fill_function = SDL_FillRect2;
-                break;
-            }
-
-        case 3:
-            /* 24-bit RGB is a slow path, at least for now. */
-            {
-                fill_function = SDL_FillRect3;
-                break;
-            }
-
-        case 4:
-            {
-#ifdef __SSE__
-                if (SDL_HasSSE()) {
-                    fill_function = SDL_FillRect4SSE;
-                    break;
-                }
-#endif
-                fill_function = SDL_FillRect4;
-                break;
-            }
 
-        default:
-            return SDL_SetError("Unsupported pixel format");
-        }
+    switch (dst->format->BytesPerPixel) {
+    case 1:
+        color |= (color << 8);
+        color |= (color << 16);
+        break;
+    case 2:
+        color |= (color << 16);
+        break;
+    case 3:
+    case 4:
+        break;
+    default:
+        return SDL_SetError("Unsupported pixel format");
     }
+    fill_function = SDL_FillFuncs[dst->format->BytesPerPixel];
 
     for (i = 0; i < count; ++i) {
         rect = &rects[i];
@@ -22,6 +22,7 @@
 
 /* General (mostly internal) pixel/color manipulation routines for SDL */
 
+#include "SDL_assert.h"
 #include "SDL_endian.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
@@ -496,47 +497,96 @@ SDL_MasksToPixelFormatEnum(int bpp, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask,
     return SDL_PIXELFORMAT_UNKNOWN;
 }
 
-static SDL_PixelFormat *formats;
+/* Every non-indexed format is shared by everyone who asks for it, so they are
+   all set up at once, the first time any of them is needed, and live for the
+   rest of the process. After that, looking one up takes no lock: the format
+   type, order and layout bits index a table of slots, and the slot's format
+   is compared against the request, since those bits alone aren't unique for
+   arbitrary values. */
+static const Uint32 cached_formats[] = {
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_RGB444,
+    SDL_PIXELFORMAT_BGR444,
+    SDL_PIXELFORMAT_RGB555,
+    SDL_PIXELFORMAT_BGR555,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_RGBA4444,
+    SDL_PIXELFORMAT_ABGR4444,
+    SDL_PIXELFORMAT_BGRA4444,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGBA5551,
+    SDL_PIXELFORMAT_ABGR1555,
+    SDL_PIXELFORMAT_BGRA5551,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_BGR565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_RGB888,
+    SDL_PIXELFORMAT_RGBX8888,
+    SDL_PIXELFORMAT_BGR888,
+    SDL_PIXELFORMAT_BGRX8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_ARGB2101010
+};
+
+#define FORMAT_SLOT_INDEX(X) (((X) >> 16) & 0xFFF)
+
+static SDL_PixelFormat formats[SDL_arraysize(cached_formats)];
+static Uint8 format_slots[0x1000];  /* index into formats, plus one */
+static SDL_atomic_t formats_ready;
 static SDL_SpinLock formats_lock = 0;
 
+static SDL_PixelFormat *
+GetCachedFormat(Uint32 pixel_format)
+{
+    int slot;
+
+    if (!SDL_AtomicGet(&formats_ready)) {
+        SDL_AtomicLock(&formats_lock);
+        if (!SDL_AtomicGet(&formats_ready)) {
+            int i;
+            for (i = 0; i < SDL_arraysize(cached_formats); ++i) {
+                SDL_InitFormat(&formats[i], cached_formats[i]);
+                SDL_assert(format_slots[FORMAT_SLOT_INDEX(cached_formats[i])] == 0);
+                format_slots[FORMAT_SLOT_INDEX(cached_formats[i])] = (Uint8)(i + 1);
+            }
+            SDL_AtomicSet(&formats_ready, 1);
+        }
+        SDL_AtomicUnlock(&formats_lock);
+    }
+
+    slot = format_slots[FORMAT_SLOT_INDEX(pixel_format)];
+    if (slot && formats[slot - 1].format == pixel_format) {
+        return &formats[slot - 1];
+    }
+    return NULL;
+}
+
 SDL_PixelFormat *
 SDL_AllocFormat(Uint32 pixel_format)
 {
     SDL_PixelFormat *format;
 
-    SDL_AtomicLock(&formats_lock);
-
-    /* Look it up in our list of previously allocated formats */
-    for (format = formats; format; format = format->next) {
-        if (pixel_format == format->format) {
-            ++format->refcount;
-            SDL_AtomicUnlock(&formats_lock);
-            return format;
-        }
+    format = GetCachedFormat(pixel_format);
+    if (format) {
+        return format;
     }
 
     /* Allocate an empty pixel format structure, and initialize it */
     format = SDL_malloc(sizeof(*format));
     if (format == NULL) {
-        SDL_AtomicUnlock(&formats_lock);
         SDL_OutOfMemory();
         return NULL;
     }
     if (SDL_InitFormat(format, pixel_format) < 0) {
-        SDL_AtomicUnlock(&formats_lock);
         SDL_free(format);
         SDL_InvalidParamError("format");
         return NULL;
     }
 
-    if (!SDL_ISPIXELFORMAT_INDEXED(pixel_format)) {
-        /* Cache the RGB formats */
-        format->next = formats;
-        formats = format;
-    }
-
-    SDL_AtomicUnlock(&formats_lock);
-
     return format;
 }
 
@@ -608,34 +658,20 @@ SDL_InitFormat(SDL_PixelFormat * format, Uint32 pixel_format)
 void
 SDL_FreeFormat(SDL_PixelFormat *format)
 {
-    SDL_PixelFormat *prev;
-
     if (!format) {
         SDL_InvalidParamError("format");
         return;
     }
 
-    SDL_AtomicLock(&formats_lock);
-
-    if (--format->refcount > 0) {
-        SDL_AtomicUnlock(&formats_lock);
+    /* The shared formats are never freed */
+    if (format >= formats && format < formats + SDL_arraysize(formats)) {
         return;
     }
 
-    /* Remove this format from our list */
-    if (format == formats) {
-        formats = format->next;
-    } else if (formats) {
-        for (prev = formats; prev->next; prev = prev->next) {
-            if (prev->next == format) {
-                prev->next = format->next;
-                break;
-            }
-        }
+    if (--format->refcount > 0) {
+        return;
     }
 
-    SDL_AtomicUnlock(&formats_lock);
-
     if (format->palette) {
         SDL_FreePalette(format->palette);
     }
@@ -912,6 +948,18 @@ Map1to1(SDL_Palette * src, SDL_Palette * dst, int *identical)
     return (map);
 }
 
+/* Map one palette color to a BitField pixel */
+static SDL_INLINE void
+Map1toNColor(const SDL_Color * color, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
+             SDL_PixelFormat * dst, Uint8 * pixel)
+{
+    Uint8 R = (Uint8) ((color->r * Rmod) / 255);
+    Uint8 G = (Uint8) ((color->g * Gmod) / 255);
+    Uint8 B = (Uint8) ((color->b * Bmod) / 255);
+    Uint8 A = (Uint8) ((color->a * Amod) / 255);
+    ASSEMBLE_RGBA(pixel, dst->BytesPerPixel, dst, R, G, B, A);
+}
+
 /* Map from Palette to BitField */
 static Uint8 *
 Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
@@ -931,15 +979,49 @@ Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
 
     /* We memory copy to the pixel map so the endianness is preserved */
     for (i = 0; i < pal->ncolors; ++i) {
-        Uint8 R = (Uint8) ((pal->colors[i].r * Rmod) / 255);
-        Uint8 G = (Uint8) ((pal->colors[i].g * Gmod) / 255);
-        Uint8 B = (Uint8) ((pal->colors[i].b * Bmod) / 255);
-        Uint8 A = (Uint8) ((pal->colors[i].a * Amod) / 255);
-        ASSEMBLE_RGBA(&map[i * bpp], dst->BytesPerPixel, dst, R, G, B, A);
+        Map1toNColor(&pal->colors[i], Rmod, Gmod, Bmod, Amod, dst, &map[i * bpp]);
     }
     return (map);
 }
 
+/* Remember the source palette a map table was built from */
+static void
+CacheMapColors(SDL_BlitMap * map, const SDL_Palette * pal)
+{
+    /* Without the copy every palette change rebuilds the whole table */
+    map->table_colors = (SDL_Color *) SDL_malloc(pal->ncolors * sizeof(SDL_Color));
+    if (map->table_colors) {
+        SDL_memcpy(map->table_colors, pal->colors, pal->ncolors * sizeof(SDL_Color));
+        map->table_ncolors = pal->ncolors;
+    }
+}
+
+/* Remap only the source palette colors that changed since the table was built */
+static void
+UpdateMapColors(SDL_BlitMap * map, SDL_PixelFormat * src, SDL_PixelFormat * dst)
+{
+    const SDL_Color *colors = src->palette->colors;
+    SDL_Color *cached = map->table_colors;
+    Uint8 *table = map->info.table;
+    const int bpp = ((dst->BytesPerPixel == 3) ? 4 : dst->BytesPerPixel);
+    int i;
+
+    for (i = 0; i < map->table_ncolors; ++i) {
+        if (colors[i].r == cached[i].r && colors[i].g == cached[i].g &&
+            colors[i].b == cached[i].b && colors[i].a == cached[i].a) {
+            continue;
+        }
+        cached[i] = colors[i];
+        if (SDL_ISPIXELFORMAT_INDEXED(dst->format)) {
+            table[i] = SDL_FindColor(dst->palette, colors[i].r, colors[i].g,
+                                     colors[i].b, colors[i].a);
+        } else {
+            Map1toNColor(&colors[i], map->info.r, map->info.g, map->info.b,
+                         map->info.a, dst, &table[i * bpp]);
+        }
+    }
+}
+
 /* Map from BitField to Dithered-Palette to Palette */
 static Uint8 *
 MapNto1(SDL_PixelFormat * src, SDL_PixelFormat * dst, int *identical)
@@ -992,6 +1074,9 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst_palette_version = 0;
     SDL_free(map->info.table);
     map->info.table = NULL;
+    SDL_free(map->table_colors);
+    map->table_colors = NULL;
+    map->table_ncolors = 0;
 }
 
 int
@@ -1001,8 +1086,23 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     SDL_PixelFormat *dstfmt;
     SDL_BlitMap *map;
 
-    /* Clear out any previous mapping */
     map = src->map;
+    srcfmt = src->format;
+    dstfmt = dst->format;
+
+    /* If only the source palette changed, the blitter stays the same and
+       just the table entries for the changed colors need remapping. This
+       keeps palette cycling cheap. */
+    if (map->dst == dst && map->table_colors &&
+        srcfmt->palette && srcfmt->palette->ncolors == map->table_ncolors &&
+        (!dstfmt->palette || map->dst_palette_version == dstfmt->palette->version) &&
+        !(src->flags & SDL_RLEACCEL)) {
+        UpdateMapColors(map, srcfmt, dstfmt);
+        map->src_palette_version = srcfmt->palette->version;
+        return 0;
+    }
+
+    /* Clear out any previous mapping */
 #if SDL_HAVE_RLE
     if ((src->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
         SDL_UnRLESurface(src, 1);
@@ -1012,8 +1112,6 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
 
     /* Figure out what kind of mapping we're doing */
     map->identity = 0;
-    srcfmt = src->format;
-    dstfmt = dst->format;
     if (SDL_ISPIXELFORMAT_INDEXED(srcfmt->format)) {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* Palette --> Palette */
@@ -1023,6 +1121,7 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
                 if (map->info.table == NULL) {
                     return (-1);
                 }
+                CacheMapColors(map, srcfmt->palette);
             }
             if (srcfmt->BitsPerPixel != dstfmt->BitsPerPixel)
                 map->identity = 0;
@@ -1034,6 +1133,7 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
             if (map->info.table == NULL) {
                 return (-1);
             }
+            CacheMapColors(map, srcfmt->palette);
         }
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
@@ -37,6 +37,12 @@ extern void SDL_InvalidateMap(SDL_BlitMap * map);
 extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
+/* Surface functions */
+/* Frees the pooled surface pixels, e.g. when memory runs low */
+extern void SDL_TrimSurfacePool(void);
+/* Frees the pooled surface pixels and stops watching surface hints */
+extern void SDL_ClearSurfacePool(void);
+
 /* Miscellaneous functions */
 extern void SDL_DitherColors(SDL_Color * colors, int bpp);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
@@ -23,6 +23,40 @@
 #include "SDL_rect.h"
 #include "SDL_rect_c.h"
 #include "SDL_assert.h"
+#include "SDL_cpuinfo.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
+
+/* The vectorized paths load SDL_Rect and pairs of SDL_Point as four ints */
+SDL_COMPILE_TIME_ASSERT(rect_layout, sizeof (SDL_Rect) == 4 * sizeof (int));
+SDL_COMPILE_TIME_ASSERT(point_layout, sizeof (SDL_Point) == 2 * sizeof (int));
+
+#if HAVE_SSE2_INTRINSICS
+/* SSE2 lacks signed 32-bit min/max, those came with SSE4.1 */
+static SDL_INLINE __m128i
+SSE2_Select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static SDL_INLINE __m128i
+SSE2_Min32(__m128i a, __m128i b)
+{
+    return SSE2_Select(_mm_cmpgt_epi32(a, b), b, a);
+}
+
+static SDL_INLINE __m128i
+SSE2_Max32(__m128i a, __m128i b)
+{
+    return SSE2_Select(_mm_cmpgt_epi32(a, b), a, b);
+}
+#endif
 
 SDL_bool
 SDL_HasIntersection(const SDL_Rect * A, const SDL_Rect * B)
@@ -188,15 +222,118 @@ SDL_UnionRect(const SDL_Rect * A, const SDL_Rect * B, SDL_Rect * result)
     result->h = Amax - Amin;
 }
 
+#if HAVE_SSE2_INTRINSICS
+static void
+EnclosePoints_SSE2(const SDL_Point * points, int count, const SDL_Rect * clip,
+                   int *minx, int *miny, int *maxx, int *maxy, SDL_bool *added)
+{
+    __m128i vmin = _mm_set1_epi32(SDL_MAX_SINT32);
+    __m128i vmax = _mm_set1_epi32(SDL_MIN_SINT32);
+    __m128i any = _mm_setzero_si128();
+    int i;
+
+    /* Two points per iteration, lanes are x0, y0, x1, y1 */
+    if (clip) {
+        const __m128i cmin = _mm_set_epi32(clip->y, clip->x, clip->y, clip->x);
+        const __m128i cmax = _mm_set_epi32(clip->y + clip->h - 1, clip->x + clip->w - 1,
+                                           clip->y + clip->h - 1, clip->x + clip->w - 1);
+        for (i = 0; i + 1 < count; i += 2) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) &points[i]);
+            __m128i inside = _mm_or_si128(_mm_cmpgt_epi32(cmin, v), _mm_cmpgt_epi32(v, cmax));
+            /* A point is inside if neither its x nor its y is outside */
+            inside = _mm_or_si128(inside, _mm_shuffle_epi32(inside, _MM_SHUFFLE(2, 3, 0, 1)));
+            inside = _mm_xor_si128(inside, _mm_set1_epi32(-1));
+            vmin = SSE2_Min32(vmin, SSE2_Select(inside, v, _mm_set1_epi32(SDL_MAX_SINT32)));
+            vmax = SSE2_Max32(vmax, SSE2_Select(inside, v, _mm_set1_epi32(SDL_MIN_SINT32)));
+            any = _mm_or_si128(any, inside);
+        }
+    } else {
+        for (i = 0; i + 1 < count; i += 2) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) &points[i]);
+            vmin = SSE2_Min32(vmin, v);
+            vmax = SSE2_Max32(vmax, v);
+        }
+        any = _mm_set1_epi32(-1);
+    }
+
+    if (i == 0 || !_mm_movemask_epi8(any)) {
+        return;  /* nothing was added, the caller handles the rest */
+    }
+
+    vmin = SSE2_Min32(vmin, _mm_srli_si128(vmin, 8));
+    vmax = SSE2_Max32(vmax, _mm_srli_si128(vmax, 8));
+    *minx = _mm_cvtsi128_si32(vmin);
+    *miny = _mm_cvtsi128_si32(_mm_srli_si128(vmin, 4));
+    *maxx = _mm_cvtsi128_si32(vmax);
+    *maxy = _mm_cvtsi128_si32(_mm_srli_si128(vmax, 4));
+    *added = SDL_TRUE;
+}
+#endif
+
+#if HAVE_NEON_INTRINSICS
+static void
+EnclosePoints_NEON(const SDL_Point * points, int count, const SDL_Rect * clip,
+                   int *minx, int *miny, int *maxx, int *maxy, SDL_bool *added)
+{
+    int32x4_t vmin = vdupq_n_s32(SDL_MAX_SINT32);
+    int32x4_t vmax = vdupq_n_s32(SDL_MIN_SINT32);
+    uint32x4_t any = vdupq_n_u32(0);
+    int32x2_t fmin, fmax;
+    int i;
+
+    /* Two points per iteration, lanes are x0, y0, x1, y1 */
+    if (clip) {
+        const int32_t lo[4] = { clip->x, clip->y, clip->x, clip->y };
+        const int32_t hi[4] = { clip->x + clip->w - 1, clip->y + clip->h - 1,
+                                clip->x + clip->w - 1, clip->y + clip->h - 1 };
+        const int32x4_t cmin = vld1q_s32(lo);
+        const int32x4_t cmax = vld1q_s32(hi);
+        for (i = 0; i + 1 < count; i += 2) {
+            const int32x4_t v = vld1q_s32((const int32_t *) &points[i]);
+            uint32x4_t inside = vandq_u32(vcgeq_s32(v, cmin), vcleq_s32(v, cmax));
+            /* A point is inside if both its x and its y are inside */
+            inside = vandq_u32(inside, vrev64q_u32(inside));
+            vmin = vminq_s32(vmin, vbslq_s32(inside, v, vdupq_n_s32(SDL_MAX_SINT32)));
+            vmax = vmaxq_s32(vmax, vbslq_s32(inside, v, vdupq_n_s32(SDL_MIN_SINT32)));
+            any = vorrq_u32(any, inside);
+        }
+    } else {
+        for (i = 0; i + 1 < count; i += 2) {
+            const int32x4_t v = vld1q_s32((const int32_t *) &points[i]);
+            vmin = vminq_s32(vmin, v);
+            vmax = vmaxq_s32(vmax, v);
+        }
+        any = vdupq_n_u32(~0u);
+    }
+
+    if (i == 0 || !(vgetq_lane_u32(any, 0) | vgetq_lane_u32(any, 2))) {
+        return;  /* nothing was added, the caller handles the rest */
+    }
+
+    fmin = vmin_s32(vget_low_s32(vmin), vget_high_s32(vmin));
+    fmax = vmax_s32(vget_low_s32(vmax), vget_high_s32(vmax));
+    *minx = vget_lane_s32(fmin, 0);
+    *miny = vget_lane_s32(fmin, 1);
+    *maxx = vget_lane_s32(fmax, 0);
+    *maxy = vget_lane_s32(fmax, 1);
+    *added = SDL_TRUE;
+}
+#endif
+
 SDL_bool
 SDL_EnclosePoints(const SDL_Point * points, int count, const SDL_Rect * clip,
                   SDL_Rect * result)
 {
+    SDL_bool added = SDL_FALSE;
+    int clip_minx = 0;
+    int clip_miny = 0;
+    int clip_maxx = 0;
+    int clip_maxy = 0;
     int minx = 0;
     int miny = 0;
     int maxx = 0;
     int maxy = 0;
-    int x, y, i;
+    int x, y, i = 0;
 
     if (!points) {
         SDL_InvalidParamError("points");
@@ -209,78 +346,70 @@ SDL_EnclosePoints(const SDL_Point * points, int count, const SDL_Rect * clip,
     }
 
     if (clip) {
-        SDL_bool added = SDL_FALSE;
-        const int clip_minx = clip->x;
-        const int clip_miny = clip->y;
-        const int clip_maxx = clip->x+clip->w-1;
-        const int clip_maxy = clip->y+clip->h-1;
-
         /* Special case for empty rectangle */
         if (SDL_RectEmpty(clip)) {
             return SDL_FALSE;
         }
 
-        for (i = 0; i < count; ++i) {
-            x = points[i].x;
-            y = points[i].y;
+        clip_minx = clip->x;
+        clip_miny = clip->y;
+        clip_maxx = clip->x+clip->w-1;
+        clip_maxy = clip->y+clip->h-1;
+    }
 
-            if (x < clip_minx || x > clip_maxx ||
-                y < clip_miny || y > clip_maxy) {
-                continue;
-            }
-            if (!added) {
-                /* Special case: if no result was requested, we are done */
-                if (result == NULL) {
-                    return SDL_TRUE;
-                }
-
-                /* First point added */
-                minx = maxx = x;
-                miny = maxy = y;
-                added = SDL_TRUE;
-                continue;
-            }
-            if (x < minx) {
-                minx = x;
-            } else if (x > maxx) {
-                maxx = x;
-            }
-            if (y < miny) {
-                miny = y;
-            } else if (y > maxy) {
-                maxy = y;
-            }
-        }
-        if (!added) {
-            return SDL_FALSE;
+    /* Enclose pairs of points in vector registers, the odd one out (if any)
+       is handled below. Without a result we stop at the first point found. */
+    if (result && count >= 2) {
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            EnclosePoints_SSE2(points, count, clip, &minx, &miny, &maxx, &maxy, &added);
+            i = count & ~1;
         }
-    } else {
-        /* Special case: if no result was requested, we are done */
-        if (result == NULL) {
-            return SDL_TRUE;
+#endif
+#if HAVE_NEON_INTRINSICS
+        if (i == 0 && SDL_HasNEON()) {
+            EnclosePoints_NEON(points, count, clip, &minx, &miny, &maxx, &maxy, &added);
+            i = count & ~1;
         }
+#endif
+    }
 
-        /* No clipping, always add the first point */
-        minx = maxx = points[0].x;
-        miny = maxy = points[0].y;
-
-        for (i = 1; i < count; ++i) {
-            x = points[i].x;
-            y = points[i].y;
+    for (; i < count; ++i) {
+        x = points[i].x;
+        y = points[i].y;
 
-            if (x < minx) {
-                minx = x;
-            } else if (x > maxx) {
-                maxx = x;
-            }
-            if (y < miny) {
-                miny = y;
-            } else if (y > maxy) {
-                maxy = y;
+        if (clip && (x < clip_minx || x > clip_maxx ||
+                     y < clip_miny || y > clip_maxy)) {
+            continue;
+        }
+        if (!added) {
+            /* Special case: if no result was requested, we are done */
+            if (result == NULL) {
+                return SDL_TRUE;
             }
+
+            /* First point added */
+            minx = maxx = x;
+            miny = maxy = y;
+            added = SDL_TRUE;
+            continue;
+        }
+        if (x < minx) {
+            minx = x;
+        } else if (x > maxx) {
+            maxx = x;
+        }
+        if (y < miny) {
+            miny = y;
+        } else if (y > maxy) {
+            maxy = y;
         }
     }
 
+    if (!added) {
+        return SDL_FALSE;
+    }
+
     if (result) {
         result->x = minx;
         result->y = miny;
@@ -465,6 +594,232 @@ SDL_IntersectRectAndLine(const SDL_Rect * rect, int *X1, int *Y1, int *X2,
     return SDL_TRUE;
 }
 
+int
+SDL_IntersectRects(const SDL_Rect * clip, const SDL_Rect * rects, int count,
+                   SDL_Rect * result)
+{
+    int i = 0;
+    int n = 0;
+
+    if (!clip) {
+        return SDL_InvalidParamError("clip");
+    }
+
+    if (!rects) {
+        return SDL_InvalidParamError("rects");
+    }
+
+    if (!result) {
+        return SDL_InvalidParamError("result");
+    }
+
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    /* Special case for empty clip rect */
+    if (SDL_RectEmpty(clip)) {
+        return 0;
+    }
+
+    /* The vector paths store every intersection and only advance the output
+       for non-empty ones, result[n] never overtakes rects[i]. */
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128i cmin = _mm_loadu_si128((const __m128i *) clip);
+        const __m128i cmax = _mm_add_epi32(cmin, _mm_srli_si128(cmin, 8));
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i < count; ++i) {
+            const __m128i r = _mm_loadu_si128((const __m128i *) &rects[i]);
+            const __m128i lo = SSE2_Max32(r, cmin);
+            const __m128i hi = SSE2_Min32(_mm_add_epi32(r, _mm_srli_si128(r, 8)), cmax);
+            const __m128i size = _mm_sub_epi32(hi, lo);
+            _mm_storeu_si128((__m128i *) &result[n], _mm_unpacklo_epi64(lo, size));
+            n += ((_mm_movemask_epi8(_mm_cmpgt_epi32(size, zero)) & 0xFF) == 0xFF);
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (i == 0 && SDL_HasNEON()) {
+        const int32x2_t cmin = vld1_s32((const int32_t *) clip);
+        const int32x2_t cmax = vadd_s32(cmin, vld1_s32((const int32_t *) clip + 2));
+        const int32x2_t zero = vdup_n_s32(0);
+
+        for (; i < count; ++i) {
+            const int32x4_t r = vld1q_s32((const int32_t *) &rects[i]);
+            const int32x2_t lo = vmax_s32(vget_low_s32(r), cmin);
+            const int32x2_t hi = vmin_s32(vadd_s32(vget_low_s32(r), vget_high_s32(r)), cmax);
+            const int32x2_t size = vsub_s32(hi, lo);
+            const uint32x2_t nonempty = vcgt_s32(size, zero);
+            vst1q_s32((int32_t *) &result[n], vcombine_s32(lo, size));
+            n += (vget_lane_u32(nonempty, 0) & vget_lane_u32(nonempty, 1)) & 1;
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        SDL_Rect clipped;
+        if (SDL_IntersectRect(&rects[i], clip, &clipped)) {
+            result[n++] = clipped;
+        }
+    }
+    return n;
+}
+
+static SDL_INLINE int
+ClipLine(const SDL_Rect * rect, const SDL_Point * line, SDL_Point * result)
+{
+    int x1 = line[0].x;
+    int y1 = line[0].y;
+    int x2 = line[1].x;
+    int y2 = line[1].y;
+
+    if (!SDL_IntersectRectAndLine(rect, &x1, &y1, &x2, &y2)) {
+        return 0;
+    }
+    result[0].x = x1;
+    result[0].y = y1;
+    result[1].x = x2;
+    result[1].y = y2;
+    return 1;
+}
+
+int
+SDL_IntersectRectAndLines(const SDL_Rect * rect, const SDL_Point * points,
+                          int count, SDL_Point * result)
+{
+    int rectx1, recty1, rectx2, recty2;
+    int i = 0;
+    int n = 0;
+
+    if (!rect) {
+        return SDL_InvalidParamError("rect");
+    }
+
+    if (!points) {
+        return SDL_InvalidParamError("points");
+    }
+
+    if (!result) {
+        return SDL_InvalidParamError("result");
+    }
+
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    /* Special case for empty rect */
+    if (SDL_RectEmpty(rect)) {
+        return 0;
+    }
+
+    rectx1 = rect->x;
+    recty1 = rect->y;
+    rectx2 = rect->x + rect->w - 1;
+    recty2 = rect->y + rect->h - 1;
+
+    /* Most lines are either entirely inside the rect or entirely to one side
+       of it, sort those out with one vector compare per segment and only run
+       Cohen-Sutherland on the ones crossing an edge. The masks have one bit
+       per lane: x1, y1, x2, y2. */
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128i lo = _mm_set_epi32(recty1, rectx1, recty1, rectx1);
+        const __m128i hi = _mm_set_epi32(recty2, rectx2, recty2, rectx2);
+
+        for (; i < count; ++i) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) &points[i * 2]);
+            const int below = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(lo, v)));
+            const int above = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, hi)));
+            if (!(below | above)) {
+                _mm_storeu_si128((__m128i *) &result[n * 2], v);
+                ++n;
+            } else if ((below & 0x5) != 0x5 && (below & 0xA) != 0xA &&
+                       (above & 0x5) != 0x5 && (above & 0xA) != 0xA) {
+                n += ClipLine(rect, &points[i * 2], &result[n * 2]);
+            }
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (i == 0 && SDL_HasNEON()) {
+        const int32_t lanes_lo[4] = { rectx1, recty1, rectx1, recty1 };
+        const int32_t lanes_hi[4] = { rectx2, recty2, rectx2, recty2 };
+        const uint32_t lanes_bit[4] = { 0x1, 0x2, 0x4, 0x8 };
+        const int32x4_t lo = vld1q_s32(lanes_lo);
+        const int32x4_t hi = vld1q_s32(lanes_hi);
+        const uint32x4_t bit = vld1q_u32(lanes_bit);
+
+        for (; i < count; ++i) {
+            const int32x4_t v = vld1q_s32((const int32_t *) &points[i * 2]);
+            const uint32x4_t b = vandq_u32(vcltq_s32(v, lo), bit);
+            const uint32x4_t a = vandq_u32(vcgtq_s32(v, hi), bit);
+            const uint32x2_t b2 = vorr_u32(vget_low_u32(b), vget_high_u32(b));
+            const uint32x2_t a2 = vorr_u32(vget_low_u32(a), vget_high_u32(a));
+            const int below = (int) (vget_lane_u32(b2, 0) | vget_lane_u32(b2, 1));
+            const int above = (int) (vget_lane_u32(a2, 0) | vget_lane_u32(a2, 1));
+            if (!(below | above)) {
+                vst1q_s32((int32_t *) &result[n * 2], v);
+                ++n;
+            } else if ((below & 0x5) != 0x5 && (below & 0xA) != 0xA &&
+                       (above & 0x5) != 0x5 && (above & 0xA) != 0xA) {
+                n += ClipLine(rect, &points[i * 2], &result[n * 2]);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        n += ClipLine(rect, &points[i * 2], &result[n * 2]);
+    }
+    return n;
+}
+
+static void
+ScaleIntsToFloats(const int *src, int count, float scale_x, float scale_y, float *dst)
+{
+    int i = 0;
+
+    /* count is even, the values alternate between x and y */
+#if HAVE_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128 scale = _mm_set_ps(scale_y, scale_x, scale_y, scale_x);
+        for (; i + 4 <= count; i += 4) {
+            const __m128i v = _mm_loadu_si128((const __m128i *) &src[i]);
+            _mm_storeu_ps(&dst[i], _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        }
+    }
+#endif
+#if HAVE_NEON_INTRINSICS
+    if (i == 0 && SDL_HasNEON()) {
+        const float lanes[4] = { scale_x, scale_y, scale_x, scale_y };
+        const float32x4_t scale = vld1q_f32(lanes);
+        for (; i + 4 <= count; i += 4) {
+            const int32x4_t v = vld1q_s32((const int32_t *) &src[i]);
+            vst1q_f32(&dst[i], vmulq_f32(vcvtq_f32_s32(v), scale));
+        }
+    }
+#endif
+
+    for (; i < count; i += 2) {
+        dst[i] = src[i] * scale_x;
+        dst[i + 1] = src[i + 1] * scale_y;
+    }
+}
+
+void
+SDL_ScaleRectsToFRects(const SDL_Rect * rects, int count, float scale_x, float scale_y, SDL_FRect * result)
+{
+    ScaleIntsToFloats(&rects->x, count * 4, scale_x, scale_y, &result->x);
+}
+
+void
+SDL_ScalePointsToFPoints(const SDL_Point * points, int count, float scale_x, float scale_y, SDL_FPoint * result)
+{
+    ScaleIntsToFloats(&points->x, count * 2, scale_x, scale_y, &result->x);
+}
+
 SDL_bool
 SDL_GetSpanEnclosingRect(int width, int height,
                          int numrects, const SDL_Rect * rects, SDL_Rect *span)
@@ -25,6 +25,8 @@
 #include "../SDL_internal.h"
 
 extern SDL_bool SDL_GetSpanEnclosingRect(int width, int height, int numrects, const SDL_Rect * rects, SDL_Rect *span);
+extern void SDL_ScaleRectsToFRects(const SDL_Rect * rects, int count, float scale_x, float scale_y, SDL_FRect * result);
+extern void SDL_ScalePointsToFPoints(const SDL_Point * points, int count, float scale_x, float scale_y, SDL_FPoint * result);
 
 #endif /* SDL_rect_c_h_ */
 
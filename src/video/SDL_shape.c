@@ -28,6 +28,15 @@
 #include "SDL_surface.h"
 #include "SDL_shape.h"
 #include "SDL_shape_internals.h"
+#include "SDL_cpuinfo.h"
+
+#ifdef __SSE2__
+#define HAVE_SSE2_INTRINSICS 1
+#endif
+
+#ifdef __ARM_NEON
+#define HAVE_NEON_INTRINSICS 1
+#endif
 
 SDL_Window*
 SDL_CreateShapedWindow(const char *title,unsigned int x,unsigned int y,unsigned int w,unsigned int h,Uint32 flags)
@@ -46,6 +55,8 @@ SDL_CreateShapedWindow(const char *title,unsigned int x,unsigned int y,unsigned
             result->shaper->mode.mode = ShapeModeDefault;
             result->shaper->mode.parameters.binarizationCutoff = 1;
             result->shaper->hasshape = SDL_FALSE;
+            result->shaper->mask = NULL;
+            result->shaper->mask_w = result->shaper->mask_h = 0;
             return result;
         }
         else {
@@ -66,166 +77,431 @@ SDL_IsShapedWindow(const SDL_Window *window)
         return (SDL_bool)(window->shaper != NULL);
 }
 
-/* REQUIRES that bitmap point to a w-by-h bitmap with ppb pixels-per-byte. */
-void
-SDL_CalculateShapeBitmap(SDL_WindowShapeMode mode,SDL_Surface *shape,Uint8* bitmap,Uint8 ppb)
+/* The shape of a window is kept as a packed mask, one bit per pixel with the
+   leftmost pixel in the least significant bit, which is also the layout of an
+   X11 bitmap. Thresholding is done a row at a time; the 32-bit formats that
+   shaped windows almost always use get a vectorized path. */
+
+typedef enum
 {
-    int x = 0;
-    int y = 0;
-    Uint8 r = 0,g = 0,b = 0,alpha = 0;
-    Uint8* pixel = NULL;
-    Uint32 pixel_value = 0,mask_value = 0;
-    int bytes_per_scanline = (shape->w + (ppb - 1)) / ppb;
-    Uint8 *bitmap_scanline;
+    SHAPE_THRESHOLD_GENERIC,
+    SHAPE_THRESHOLD_ALPHA32,
+    SHAPE_THRESHOLD_KEY32
+} SDL_ShapeThresholdKind;
+
+typedef struct
+{
+    SDL_ShapeThresholdKind kind;
+    SDL_WindowShapeMode mode;
+    const SDL_PixelFormat *format;
+    Uint8 cutoff;
+    SDL_bool reverse;
+    Uint32 keymask;
+    Uint32 key;
+} SDL_ShapeThreshold;
+
+static void
+SetupShapeThreshold(SDL_ShapeThreshold *t, const SDL_WindowShapeMode *mode, const SDL_PixelFormat *fmt)
+{
+    t->kind = SHAPE_THRESHOLD_GENERIC;
+    t->mode = *mode;
+    t->format = fmt;
+    t->cutoff = 1;
+    t->reverse = SDL_FALSE;
+    t->keymask = 0;
+    t->key = 0;
+
+    if (fmt->BytesPerPixel != 4) {
+        return;
+    }
+    switch (mode->mode) {
+    case ShapeModeBinarizeAlpha:
+        t->cutoff = mode->parameters.binarizationCutoff;
+        /* fallthrough */
+    case ShapeModeDefault:
+        if (fmt->Amask && fmt->Aloss == 0) {
+            t->kind = SHAPE_THRESHOLD_ALPHA32;
+        }
+        break;
+    case ShapeModeReverseBinarizeAlpha:
+        t->cutoff = mode->parameters.binarizationCutoff;
+        t->reverse = SDL_TRUE;
+        if (fmt->Amask && fmt->Aloss == 0) {
+            t->kind = SHAPE_THRESHOLD_ALPHA32;
+        }
+        break;
+    case ShapeModeColorKey:
+        if (fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0) {
+            const SDL_Color key = mode->parameters.colorKey;
+            t->kind = SHAPE_THRESHOLD_KEY32;
+            t->keymask = fmt->Rmask | fmt->Gmask | fmt->Bmask;
+            t->key = ((Uint32)key.r << fmt->Rshift) |
+                     ((Uint32)key.g << fmt->Gshift) |
+                     ((Uint32)key.b << fmt->Bshift);
+        }
+        break;
+    }
+}
+
+static SDL_bool
+IsPixelOpaque(const SDL_ShapeThreshold *t, const Uint8 *pixel)
+{
+    const SDL_PixelFormat *fmt = t->format;
+    Uint32 pixel_value = 0;
+    Uint8 r, g, b, a;
     SDL_Color key;
-    if(SDL_MUSTLOCK(shape))
-        SDL_LockSurface(shape);
-    for(y = 0;y<shape->h;y++) {
-        bitmap_scanline = bitmap + y * bytes_per_scanline;
-        for(x=0;x<shape->w;x++) {
-            alpha = 0;
-            pixel_value = 0;
-            pixel = (Uint8 *)(shape->pixels) + (y*shape->pitch) + (x*shape->format->BytesPerPixel);
-            switch(shape->format->BytesPerPixel) {
-                case(1):
-                    pixel_value = *pixel;
-                    break;
-                case(2):
-                    pixel_value = *(Uint16*)pixel;
-                    break;
-                case(3):
-                    pixel_value = *(Uint32*)pixel & (~shape->format->Amask);
-                    break;
-                case(4):
-                    pixel_value = *(Uint32*)pixel;
-                    break;
+
+    switch (fmt->BytesPerPixel) {
+    case 1:
+        pixel_value = *pixel;
+        break;
+    case 2:
+        pixel_value = *(const Uint16 *)pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        pixel_value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+#else
+        pixel_value = (pixel[0] << 16) | (pixel[1] << 8) | pixel[2];
+#endif
+        break;
+    case 4:
+        pixel_value = *(const Uint32 *)pixel;
+        break;
+    }
+    SDL_GetRGBA(pixel_value, fmt, &r, &g, &b, &a);
+    switch (t->mode.mode) {
+    case ShapeModeDefault:
+        return (a >= 1) ? SDL_TRUE : SDL_FALSE;
+    case ShapeModeBinarizeAlpha:
+        return (a >= t->mode.parameters.binarizationCutoff) ? SDL_TRUE : SDL_FALSE;
+    case ShapeModeReverseBinarizeAlpha:
+        return (a <= t->mode.parameters.binarizationCutoff) ? SDL_TRUE : SDL_FALSE;
+    case ShapeModeColorKey:
+        key = t->mode.parameters.colorKey;
+        return (key.r != r || key.g != g || key.b != b) ? SDL_TRUE : SDL_FALSE;
+    }
+    return SDL_FALSE;
+}
+
+#if HAVE_NEON_INTRINSICS
+static SDL_INLINE Uint8
+NEON_MoveMask8(uint8x8_t m)
+{
+    static const Uint8 weights[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x8_t bits = vand_u8(m, vld1_u8(weights));
+    bits = vpadd_u8(bits, bits);
+    bits = vpadd_u8(bits, bits);
+    bits = vpadd_u8(bits, bits);
+    return vget_lane_u8(bits, 0);
+}
+#endif
+
+/* Threshold w pixels starting at src into (w + 7) / 8 bytes of packed mask,
+   leaving the unused high bits of the last byte clear. */
+static void
+ThresholdShapeRow(const SDL_ShapeThreshold *t, const Uint8 *src, int w, Uint8 *dst)
+{
+    int x = 0;
+    Uint8 bits = 0;
+
+    if (t->kind == SHAPE_THRESHOLD_ALPHA32) {
+        const Uint32 *pixels = (const Uint32 *)src;
+        const int shift = t->format->Ashift;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            const __m128i count = _mm_cvtsi32_si128(shift);
+            const __m128i lowbyte = _mm_set1_epi32(0xFF);
+            const __m128i cutoff = _mm_set1_epi8((char)t->cutoff);
+            for (; x + 16 <= w; x += 16) {
+                const __m128i a0 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)&pixels[x + 0]), count), lowbyte);
+                const __m128i a1 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)&pixels[x + 4]), count), lowbyte);
+                const __m128i a2 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)&pixels[x + 8]), count), lowbyte);
+                const __m128i a3 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)&pixels[x + 12]), count), lowbyte);
+                const __m128i a = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+                /* SSE2 only compares signed bytes, so test a >= cutoff as max(a, cutoff) == a */
+                const __m128i opaque = t->reverse ? _mm_cmpeq_epi8(_mm_min_epu8(a, cutoff), a)
+                                                  : _mm_cmpeq_epi8(_mm_max_epu8(a, cutoff), a);
+                const int mask = _mm_movemask_epi8(opaque);
+                dst[0] = (Uint8)mask;
+                dst[1] = (Uint8)(mask >> 8);
+                dst += 2;
             }
-            SDL_GetRGBA(pixel_value,shape->format,&r,&g,&b,&alpha);
-            switch(mode.mode) {
-                case(ShapeModeDefault):
-                    mask_value = (alpha >= 1 ? 1 : 0);
-                    break;
-                case(ShapeModeBinarizeAlpha):
-                    mask_value = (alpha >= mode.parameters.binarizationCutoff ? 1 : 0);
-                    break;
-                case(ShapeModeReverseBinarizeAlpha):
-                    mask_value = (alpha <= mode.parameters.binarizationCutoff ? 1 : 0);
-                    break;
-                case(ShapeModeColorKey):
-                    key = mode.parameters.colorKey;
-                    mask_value = ((key.r != r || key.g != g || key.b != b) ? 1 : 0);
-                    break;
+        }
+#elif HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            const int32x4_t count = vdupq_n_s32(-shift);
+            const uint8x8_t cutoff = vdup_n_u8(t->cutoff);
+            for (; x + 8 <= w; x += 8) {
+                const uint32x4_t a0 = vshlq_u32(vld1q_u32(&pixels[x + 0]), count);
+                const uint32x4_t a1 = vshlq_u32(vld1q_u32(&pixels[x + 4]), count);
+                /* The narrowing moves drop everything above the alpha byte */
+                const uint8x8_t a = vmovn_u16(vcombine_u16(vmovn_u32(a0), vmovn_u32(a1)));
+                *dst++ = NEON_MoveMask8(t->reverse ? vcle_u8(a, cutoff) : vcge_u8(a, cutoff));
+            }
+        }
+#endif
+        for (; x < w; ++x) {
+            const Uint8 a = (Uint8)(pixels[x] >> shift);
+            if (t->reverse ? (a <= t->cutoff) : (a >= t->cutoff)) {
+                bits |= 1 << (x & 7);
             }
-            bitmap_scanline[x / ppb] |= mask_value << (x % ppb);
+            if ((x & 7) == 7) {
+                *dst++ = bits;
+                bits = 0;
+            }
+        }
+    } else if (t->kind == SHAPE_THRESHOLD_KEY32) {
+        const Uint32 *pixels = (const Uint32 *)src;
+#if HAVE_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            const __m128i keymask = _mm_set1_epi32((int)t->keymask);
+            const __m128i key = _mm_set1_epi32((int)t->key);
+            for (; x + 16 <= w; x += 16) {
+                const __m128i k0 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)&pixels[x + 0]), keymask), key);
+                const __m128i k1 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)&pixels[x + 4]), keymask), key);
+                const __m128i k2 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)&pixels[x + 8]), keymask), key);
+                const __m128i k3 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i *)&pixels[x + 12]), keymask), key);
+                /* Narrow the lane masks to bytes so a single movemask covers 16 pixels */
+                const __m128i keyed = _mm_packs_epi16(_mm_packs_epi32(k0, k1), _mm_packs_epi32(k2, k3));
+                const int mask = ~_mm_movemask_epi8(keyed);
+                dst[0] = (Uint8)mask;
+                dst[1] = (Uint8)(mask >> 8);
+                dst += 2;
+            }
+        }
+#elif HAVE_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            const uint32x4_t keymask = vdupq_n_u32(t->keymask);
+            const uint32x4_t key = vdupq_n_u32(t->key);
+            for (; x + 8 <= w; x += 8) {
+                const uint32x4_t k0 = vceqq_u32(vandq_u32(vld1q_u32(&pixels[x + 0]), keymask), key);
+                const uint32x4_t k1 = vceqq_u32(vandq_u32(vld1q_u32(&pixels[x + 4]), keymask), key);
+                const uint8x8_t keyed = vmovn_u16(vcombine_u16(vmovn_u32(k0), vmovn_u32(k1)));
+                *dst++ = NEON_MoveMask8(vmvn_u8(keyed));
+            }
+        }
+#endif
+        for (; x < w; ++x) {
+            if ((pixels[x] & t->keymask) != t->key) {
+                bits |= 1 << (x & 7);
+            }
+            if ((x & 7) == 7) {
+                *dst++ = bits;
+                bits = 0;
+            }
+        }
+    } else {
+        const int bpp = t->format->BytesPerPixel;
+        for (; x < w; ++x) {
+            if (IsPixelOpaque(t, src + x * bpp)) {
+                bits |= 1 << (x & 7);
+            }
+            if ((x & 7) == 7) {
+                *dst++ = bits;
+                bits = 0;
+            }
+        }
+    }
+
+    if (x & 7) {
+        *dst = bits;
+    }
+}
+
+/* Store w bits from the start of src at bit offset x of dst.
+   Returns SDL_TRUE if any of the destination bits changed. */
+static SDL_bool
+SpliceShapeBits(Uint8 *dst, int x, const Uint8 *src, int w)
+{
+    const int shift = x & 7;
+    Uint8 changed = 0;
+    int i;
+
+    dst += x >> 3;
+    for (i = 0; i < w; i += 8) {
+        const int n = SDL_min(w - i, 8);
+        const Uint16 keep = (Uint16)(((1 << n) - 1) << shift);
+        const Uint16 bits = (Uint16)((src[i >> 3] << shift) & keep);
+        Uint8 old = dst[0];
+        dst[0] = (Uint8)((old & ~keep) | bits);
+        changed |= old ^ dst[0];
+        if (keep >> 8) {
+            old = dst[1];
+            dst[1] = (Uint8)((old & ~(keep >> 8)) | (bits >> 8));
+            changed |= old ^ dst[1];
+        }
+        ++dst;
+    }
+    return changed ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Re-threshold the part of shape inside rect (or all of it, if rect is NULL)
+   into the mask on the shaper, which must already match the shape's size. */
+static int
+UpdateShapeMask(SDL_WindowShaper *shaper, SDL_Surface *shape, const SDL_Rect *rect, SDL_bool *changed)
+{
+    SDL_ShapeThreshold threshold;
+    SDL_Rect area;
+    Uint8 *row;
+    int pitch, y;
+
+    *changed = SDL_FALSE;
+
+    area.x = 0;
+    area.y = 0;
+    area.w = shape->w;
+    area.h = shape->h;
+    if (rect && !SDL_IntersectRect(rect, &area, &area)) {
+        return 0;
+    }
+    if (area.w <= 0 || area.h <= 0) {
+        return 0;
+    }
+
+    row = SDL_stack_alloc(Uint8, (area.w + 7) / 8);
+    if (row == NULL) {
+        return SDL_OutOfMemory();
+    }
+
+    SetupShapeThreshold(&threshold, &shaper->mode, shape->format);
+    pitch = (shape->w + 7) / 8;
+    if (SDL_MUSTLOCK(shape))
+        SDL_LockSurface(shape);
+    for (y = area.y; y < area.y + area.h; y++) {
+        const Uint8 *src = (const Uint8 *)shape->pixels + y * shape->pitch + area.x * shape->format->BytesPerPixel;
+        ThresholdShapeRow(&threshold, src, area.w, row);
+        if (SpliceShapeBits(shaper->mask + y * pitch, area.x, row, area.w)) {
+            *changed = SDL_TRUE;
         }
     }
-    if(SDL_MUSTLOCK(shape))
+    if (SDL_MUSTLOCK(shape))
         SDL_UnlockSurface(shape);
+
+    SDL_stack_free(row);
+    return 0;
+}
+
+/* REQUIRES that bitmap point to a w-by-h bitmap with ppb pixels-per-byte. */
+void
+SDL_CalculateShapeBitmap(SDL_WindowShaper *shaper,Uint8* bitmap,Uint8 ppb)
+{
+    const int pitch = (shaper->mask_w + 7) / 8;
+    const int bytes_per_scanline = (shaper->mask_w + (ppb - 1)) / ppb;
+    int x, y, i;
+
+    SDL_assert(shaper->mask != NULL);
+
+    if (ppb == 8) {
+        /* The mask is already a bitmap in this layout */
+        SDL_memcpy(bitmap, shaper->mask, pitch * shaper->mask_h);
+        return;
+    }
+
+    for (y = 0; y < shaper->mask_h; y++) {
+        const Uint8 *mask_scanline = shaper->mask + y * pitch;
+        Uint8 *bitmap_scanline = bitmap + y * bytes_per_scanline;
+        for (x = 0; x < shaper->mask_w; x += ppb) {
+            Uint8 value = 0;
+            for (i = 0; i < ppb && x + i < shaper->mask_w; i++) {
+                value |= ((mask_scanline[(x + i) >> 3] >> ((x + i) & 7)) & 1) << i;
+            }
+            bitmap_scanline[x / ppb] = value;
+        }
+    }
+}
+
+/* Check that w bits of a mask row starting at bit x all equal the low bit of fill. */
+static SDL_bool
+IsShapeSpanUniform(const Uint8 *row, int x, int w, Uint8 fill)
+{
+    row += x >> 3;
+    x &= 7;
+    if (x) {
+        const int n = SDL_min(w, 8 - x);
+        const Uint8 keep = (Uint8)(((1 << n) - 1) << x);
+        if ((*row ^ fill) & keep) {
+            return SDL_FALSE;
+        }
+        row++;
+        w -= n;
+    }
+    for (; w >= 8; w -= 8) {
+        if (*row++ != fill) {
+            return SDL_FALSE;
+        }
+    }
+    if (w > 0 && ((*row ^ fill) & ((1 << w) - 1))) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
 }
 
 static SDL_ShapeTree*
-RecursivelyCalculateShapeTree(SDL_WindowShapeMode mode,SDL_Surface* mask,SDL_Rect dimensions) {
-    int x = 0,y = 0;
-    Uint8* pixel = NULL;
-    Uint32 pixel_value = 0;
-    Uint8 r = 0,g = 0,b = 0,a = 0;
-    SDL_bool pixel_opaque = SDL_FALSE;
-    int last_opaque = -1;
-    SDL_Color key;
+RecursivelyCalculateShapeTree(const Uint8 *mask,int pitch,SDL_Rect dimensions) {
+    int y = 0;
+    Uint8 fill = 0;
     SDL_ShapeTree* result = (SDL_ShapeTree*)SDL_malloc(sizeof(SDL_ShapeTree));
     SDL_Rect next = {0,0,0,0};
 
+    if (dimensions.w <= 0 || dimensions.h <= 0) {
+        result->kind = TransparentShape;
+        result->data.shape = dimensions;
+        return result;
+    }
+
+    /* Walk the quadrant a row span at a time against the value of its first pixel */
+    fill = (mask[dimensions.y * pitch + (dimensions.x >> 3)] >> (dimensions.x & 7)) & 1 ? 0xFF : 0x00;
     for(y=dimensions.y;y<dimensions.y + dimensions.h;y++) {
-        for(x=dimensions.x;x<dimensions.x + dimensions.w;x++) {
-            pixel_value = 0;
-            pixel = (Uint8 *)(mask->pixels) + (y*mask->pitch) + (x*mask->format->BytesPerPixel);
-            switch(mask->format->BytesPerPixel) {
-                case(1):
-                    pixel_value = *pixel;
-                    break;
-                case(2):
-                    pixel_value = *(Uint16*)pixel;
-                    break;
-                case(3):
-                    pixel_value = *(Uint32*)pixel & (~mask->format->Amask);
-                    break;
-                case(4):
-                    pixel_value = *(Uint32*)pixel;
-                    break;
-            }
-            SDL_GetRGBA(pixel_value,mask->format,&r,&g,&b,&a);
-            switch(mode.mode) {
-                case(ShapeModeDefault):
-                    pixel_opaque = (a >= 1 ? SDL_TRUE : SDL_FALSE);
-                    break;
-                case(ShapeModeBinarizeAlpha):
-                    pixel_opaque = (a >= mode.parameters.binarizationCutoff ? SDL_TRUE : SDL_FALSE);
-                    break;
-                case(ShapeModeReverseBinarizeAlpha):
-                    pixel_opaque = (a <= mode.parameters.binarizationCutoff ? SDL_TRUE : SDL_FALSE);
-                    break;
-                case(ShapeModeColorKey):
-                    key = mode.parameters.colorKey;
-                    pixel_opaque = ((key.r != r || key.g != g || key.b != b) ? SDL_TRUE : SDL_FALSE);
-                    break;
-            }
-            if(last_opaque == -1)
-                last_opaque = pixel_opaque;
-            if(last_opaque != pixel_opaque) {
-                const int halfwidth = dimensions.w / 2;
-                const int halfheight = dimensions.h / 2;
-
-                result->kind = QuadShape;
-
-                next.x = dimensions.x;
-                next.y = dimensions.y;
-                next.w = halfwidth;
-                next.h = halfheight;
-                result->data.children.upleft = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mode,mask,next);
-
-                next.x = dimensions.x + halfwidth;
-                next.w = dimensions.w - halfwidth;
-                result->data.children.upright = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mode,mask,next);
-
-                next.x = dimensions.x;
-                next.w = halfwidth;
-                next.y = dimensions.y + halfheight;
-                next.h = dimensions.h - halfheight;
-                result->data.children.downleft = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mode,mask,next);
-
-                next.x = dimensions.x + halfwidth;
-                next.w = dimensions.w - halfwidth;
-                result->data.children.downright = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mode,mask,next);
-
-                return result;
-            }
+        if (!IsShapeSpanUniform(mask + y * pitch, dimensions.x, dimensions.w, fill)) {
+            const int halfwidth = dimensions.w / 2;
+            const int halfheight = dimensions.h / 2;
+
+            result->kind = QuadShape;
+
+            next.x = dimensions.x;
+            next.y = dimensions.y;
+            next.w = halfwidth;
+            next.h = halfheight;
+            result->data.children.upleft = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mask,pitch,next);
+
+            next.x = dimensions.x + halfwidth;
+            next.w = dimensions.w - halfwidth;
+            result->data.children.upright = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mask,pitch,next);
+
+            next.x = dimensions.x;
+            next.w = halfwidth;
+            next.y = dimensions.y + halfheight;
+            next.h = dimensions.h - halfheight;
+            result->data.children.downleft = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mask,pitch,next);
+
+            next.x = dimensions.x + halfwidth;
+            next.w = dimensions.w - halfwidth;
+            result->data.children.downright = (struct SDL_ShapeTree *)RecursivelyCalculateShapeTree(mask,pitch,next);
+
+            return result;
         }
     }
 
-
     /* If we never recursed, all the pixels in this quadrant have the same "value". */
-    result->kind = (last_opaque == SDL_TRUE ? OpaqueShape : TransparentShape);
+    result->kind = (fill ? OpaqueShape : TransparentShape);
     result->data.shape = dimensions;
     return result;
 }
 
 SDL_ShapeTree*
-SDL_CalculateShapeTree(SDL_WindowShapeMode mode,SDL_Surface* shape)
+SDL_CalculateShapeTree(SDL_WindowShaper *shaper)
 {
     SDL_Rect dimensions;
-    SDL_ShapeTree* result = NULL;
+
+    SDL_assert(shaper->mask != NULL);
 
     dimensions.x = 0;
     dimensions.y = 0;
-    dimensions.w = shape->w;
-    dimensions.h = shape->h;
+    dimensions.w = shaper->mask_w;
+    dimensions.h = shaper->mask_h;
 
-    if(SDL_MUSTLOCK(shape))
-        SDL_LockSurface(shape);
-    result = RecursivelyCalculateShapeTree(mode,shape,dimensions);
-    if(SDL_MUSTLOCK(shape))
-        SDL_UnlockSurface(shape);
-    return result;
+    return RecursivelyCalculateShapeTree(shaper->mask,(shaper->mask_w + 7) / 8,dimensions);
 }
 
 void
@@ -255,6 +531,55 @@ SDL_FreeShapeTree(SDL_ShapeTree** shape_tree)
     *shape_tree = NULL;
 }
 
+/* Hands the updated mask to the driver. The mask is built in a copy, and
+   only replaces the cached one once the driver has accepted it, so the cache
+   always describes what the window was last given. */
+static int
+ApplyWindowShape(SDL_WindowShaper *shaper, SDL_Surface *shape, const SDL_Rect *rect, SDL_bool force)
+{
+    Uint8 *previous = shaper->mask;
+    const int previous_w = shaper->mask_w;
+    const int previous_h = shaper->mask_h;
+    const size_t size = (size_t)((shape->w + 7) / 8) * shape->h;
+    SDL_bool changed;
+    int result;
+
+    shaper->mask = (Uint8 *)SDL_malloc(size);
+    if (shaper->mask == NULL) {
+        shaper->mask = previous;
+        return SDL_OutOfMemory();
+    }
+    if (previous != NULL && previous_w == shape->w && previous_h == shape->h) {
+        SDL_memcpy(shaper->mask, previous, size);
+    } else {
+        /* Keep the padding bits at the end of each row clear */
+        SDL_memset(shaper->mask, 0, size);
+        rect = NULL;
+        force = SDL_TRUE;
+    }
+    shaper->mask_w = shape->w;
+    shaper->mask_h = shape->h;
+
+    result = UpdateShapeMask(shaper, shape, rect, &changed);
+    if (result == 0) {
+        if (!changed && !force) {
+            /* The pixels changed but the shape they describe did not. */
+            result = 1;
+        } else {
+            result = SDL_GetVideoDevice()->shape_driver.SetWindowShape(shaper, shape, &shaper->mode);
+        }
+    }
+    if (result != 0) {
+        SDL_free(shaper->mask);
+        shaper->mask = previous;
+        shaper->mask_w = previous_w;
+        shaper->mask_h = previous_h;
+        return (result > 0) ? 0 : result;
+    }
+    SDL_free(previous);
+    return 0;
+}
+
 int
 SDL_SetWindowShape(SDL_Window *window,SDL_Surface *shape,SDL_WindowShapeMode *shape_mode)
 {
@@ -268,7 +593,7 @@ SDL_SetWindowShape(SDL_Window *window,SDL_Surface *shape,SDL_WindowShapeMode *sh
 
     if(shape_mode != NULL)
         window->shaper->mode = *shape_mode;
-    result = SDL_GetVideoDevice()->shape_driver.SetWindowShape(window->shaper,shape,shape_mode);
+    result = ApplyWindowShape(window->shaper,shape,NULL,SDL_TRUE);
     window->shaper->hasshape = SDL_TRUE;
     if(window->shaper->userx != 0 && window->shaper->usery != 0) {
         SDL_SetWindowPosition(window,window->shaper->userx,window->shaper->usery);
@@ -278,6 +603,24 @@ SDL_SetWindowShape(SDL_Window *window,SDL_Surface *shape,SDL_WindowShapeMode *sh
     return result;
 }
 
+int
+SDL_UpdateWindowShapeRect(SDL_Window *window,SDL_Surface *shape,const SDL_Rect *rect)
+{
+    SDL_WindowShaper *shaper;
+    if(window == NULL || !SDL_IsShapedWindow(window))
+        /* The window given was not a shapeable window. */
+        return SDL_NONSHAPEABLE_WINDOW;
+    if(shape == NULL)
+        /* Invalid shape argument. */
+        return SDL_INVALID_SHAPE_ARGUMENT;
+
+    shaper = window->shaper;
+    if(!shaper->hasshape || shaper->mask == NULL || shaper->mask_w != shape->w || shaper->mask_h != shape->h)
+        return SDL_SetWindowShape(window,shape,NULL);
+
+    return ApplyWindowShape(shaper,shape,rect,SDL_FALSE);
+}
+
 static SDL_bool
 SDL_WindowHasAShape(SDL_Window *window)
 {
@@ -26,6 +26,7 @@
 #include "SDL_rect.h"
 #include "SDL_shape.h"
 #include "SDL_surface.h"
+#include "SDL_sysvideo.h"
 
 #include "begin_code.h"
 /* Set up for C function definitions, even when using C++ */
@@ -53,8 +54,10 @@ typedef struct {
 
 typedef void(*SDL_TraversalFunction)(SDL_ShapeTree*,void*);
 
-extern void SDL_CalculateShapeBitmap(SDL_WindowShapeMode mode,SDL_Surface *shape,Uint8* bitmap,Uint8 ppb);
-extern SDL_ShapeTree* SDL_CalculateShapeTree(SDL_WindowShapeMode mode,SDL_Surface* shape);
+/* These convert the mask that SDL_SetWindowShape() caches on the shaper, so
+   they are only valid from within the driver's SetWindowShape hook. */
+extern void SDL_CalculateShapeBitmap(SDL_WindowShaper *shaper,Uint8* bitmap,Uint8 ppb);
+extern SDL_ShapeTree* SDL_CalculateShapeTree(SDL_WindowShaper *shaper);
 extern void SDL_TraverseShapeTree(SDL_ShapeTree *tree,SDL_TraversalFunction function,void* closure);
 extern void SDL_FreeShapeTree(SDL_ShapeTree** shape_tree);
 
@@ -20,18 +20,180 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
+#include "SDL_timer.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "../SDL_hints_c.h"
 
 
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
     sizeof(int) == sizeof(Sint32) && sizeof(size_t) >= sizeof(Sint32));
 
+/* The pixels of freed surfaces are kept for a while, so code that creates
+   and frees same-sized temporary surfaces every frame, like texture uploads
+   through SDL_ConvertSurface(), doesn't go back to the allocator each time. */
+#define SURFACE_POOL_SLOTS      8
+#define SURFACE_POOL_MAX_BYTES  (32 * 1024 * 1024)
+/* Pixels not reused within this many milliseconds are given back */
+#define SURFACE_POOL_MAX_AGE    2000
+
+typedef struct
+{
+    Uint32 format;
+    int w, h, pitch;
+    Uint32 pooled_at;
+    void *pixels;
+} SDL_PooledPixels;
+
+static SDL_PooledPixels surface_pool[SURFACE_POOL_SLOTS];
+static size_t surface_pool_bytes = 0;
+static int surface_pool_next = 0;
+static SDL_SpinLock surface_pool_lock = 0;
+
+/* SDL_HINT_SURFACE_SIMD_PITCH is watched once a surface is created, so the
+   hint list isn't searched for every pitch calculation */
+#define SURFACE_HINT_UNWATCHED  0
+#define SURFACE_HINT_WATCHING   1   /* the callback is being added */
+#define SURFACE_HINT_WATCHED    2
+static SDL_atomic_t surface_simd_pitch_watched;
+static SDL_bool surface_simd_pitch = SDL_FALSE;
+
+static void SDLCALL
+SDL_SurfaceSIMDPitchChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    surface_simd_pitch = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
+/* Takes the pixels that sat unused for too long out of the pool, to be
+   freed once the lock is released. Called with surface_pool_lock held. */
+static int
+TakeExpiredPixels(Uint32 now, void *expired[SURFACE_POOL_SLOTS])
+{
+    int count = 0;
+    int i;
+
+    for (i = 0; i < SURFACE_POOL_SLOTS; ++i) {
+        SDL_PooledPixels *entry = &surface_pool[i];
+        if (entry->pixels && SDL_TICKS_PASSED(now, entry->pooled_at + SURFACE_POOL_MAX_AGE)) {
+            expired[count++] = entry->pixels;
+            surface_pool_bytes -= (size_t)entry->h * entry->pitch;
+            entry->pixels = NULL;
+        }
+    }
+    return count;
+}
+
+static void *
+TakePooledPixels(Uint32 format, int w, int h, int pitch)
+{
+    const Uint32 now = SDL_GetTicks();
+    void *expired[SURFACE_POOL_SLOTS];
+    void *pixels = NULL;
+    int count;
+    int i;
+
+    SDL_AtomicLock(&surface_pool_lock);
+    count = TakeExpiredPixels(now, expired);
+    for (i = 0; i < SURFACE_POOL_SLOTS; ++i) {
+        SDL_PooledPixels *entry = &surface_pool[i];
+        if (entry->pixels && entry->format == format &&
+            entry->w == w && entry->h == h && entry->pitch == pitch) {
+            pixels = entry->pixels;
+            entry->pixels = NULL;
+            surface_pool_bytes -= (size_t)h * pitch;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&surface_pool_lock);
+
+    while (count--) {
+        SDL_SIMDFree(expired[count]);
+    }
+    return pixels;
+}
+
+/* Returns SDL_TRUE if the pool took ownership of the surface pixels */
+static SDL_bool
+PoolPixels(SDL_Surface *surface)
+{
+    const size_t size = (size_t)surface->h * surface->pitch;
+    void *expired[SURFACE_POOL_SLOTS];
+    void *evicted = NULL;
+    SDL_PooledPixels *entry;
+    SDL_bool pooled = SDL_FALSE;
+    Uint32 now;
+    int count;
+
+    if (!surface->pixels || !surface->format || size == 0 || size > SURFACE_POOL_MAX_BYTES / 2) {
+        return SDL_FALSE;
+    }
+
+    now = SDL_GetTicks();
+    SDL_AtomicLock(&surface_pool_lock);
+    count = TakeExpiredPixels(now, expired);
+    /* Replace slots round-robin, which gives up the oldest buffer first */
+    entry = &surface_pool[surface_pool_next];
+    surface_pool_next = (surface_pool_next + 1) % SURFACE_POOL_SLOTS;
+    if (entry->pixels) {
+        evicted = entry->pixels;
+        surface_pool_bytes -= (size_t)entry->h * entry->pitch;
+        entry->pixels = NULL;
+    }
+    if (surface_pool_bytes + size <= SURFACE_POOL_MAX_BYTES) {
+        entry->format = surface->format->format;
+        entry->w = surface->w;
+        entry->h = surface->h;
+        entry->pitch = surface->pitch;
+        entry->pooled_at = now;
+        entry->pixels = surface->pixels;
+        surface_pool_bytes += size;
+        pooled = SDL_TRUE;
+    }
+    SDL_AtomicUnlock(&surface_pool_lock);
+
+    while (count--) {
+        SDL_SIMDFree(expired[count]);
+    }
+    SDL_SIMDFree(evicted);
+    return pooled;
+}
+
+void
+SDL_TrimSurfacePool(void)
+{
+    void *pixels[SURFACE_POOL_SLOTS];
+    int i;
+
+    SDL_AtomicLock(&surface_pool_lock);
+    for (i = 0; i < SURFACE_POOL_SLOTS; ++i) {
+        pixels[i] = surface_pool[i].pixels;
+        surface_pool[i].pixels = NULL;
+    }
+    surface_pool_bytes = 0;
+    SDL_AtomicUnlock(&surface_pool_lock);
+
+    for (i = 0; i < SURFACE_POOL_SLOTS; ++i) {
+        SDL_SIMDFree(pixels[i]);
+    }
+}
+
+void
+SDL_ClearSurfacePool(void)
+{
+    SDL_TrimSurfacePool();
+
+    if (SDL_AtomicCAS(&surface_simd_pitch_watched, SURFACE_HINT_WATCHED, SURFACE_HINT_UNWATCHED)) {
+        SDL_DelHintCallback(SDL_HINT_SURFACE_SIMD_PITCH, SDL_SurfaceSIMDPitchChanged, NULL);
+        surface_simd_pitch = SDL_FALSE;
+    }
+}
+
 /* Public routines */
 
 /*
@@ -40,6 +202,7 @@ SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
 static int
 SDL_CalculatePitch(Uint32 format, int width)
 {
+    SDL_bool simd_pitch;
     int pitch;
 
     if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_BITSPERPIXEL(format) >= 8) {
@@ -47,23 +210,35 @@ SDL_CalculatePitch(Uint32 format, int width)
     } else {
         pitch = ((width * SDL_BITSPERPIXEL(format)) + 7) / 8;
     }
-    pitch = (pitch + 3) & ~3;   /* 4-byte aligning for speed */
+    if (SDL_AtomicGet(&surface_simd_pitch_watched) == SURFACE_HINT_WATCHED) {
+        simd_pitch = surface_simd_pitch;
+    } else {
+        /* Only one thread adds the callback, the others read the hint */
+        if (SDL_AtomicCAS(&surface_simd_pitch_watched, SURFACE_HINT_UNWATCHED, SURFACE_HINT_WATCHING)) {
+            SDL_AddHintCallback(SDL_HINT_SURFACE_SIMD_PITCH, SDL_SurfaceSIMDPitchChanged, NULL);
+            SDL_AtomicCAS(&surface_simd_pitch_watched, SURFACE_HINT_WATCHING, SURFACE_HINT_WATCHED);
+        }
+        simd_pitch = SDL_GetHintBoolean(SDL_HINT_SURFACE_SIMD_PITCH, SDL_FALSE);
+    }
+    if (simd_pitch) {
+        /* Every row starts on a SIMD boundary, since the pixels do */
+        const int align = (int) SDL_SIMDGetAlignment();
+        pitch = (pitch + (align - 1)) & ~(align - 1);
+    } else {
+        pitch = (pitch + 3) & ~3;   /* 4-byte aligning for speed */
+    }
     return pitch;
 }
 
 /*
  * Create an empty RGB surface of the appropriate depth using the given
- * enum SDL_PIXELFORMAT_* format
+ * enum SDL_PIXELFORMAT_* format. The pixels are only zeroed if clear is set.
  */
-SDL_Surface *
-SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
-                               Uint32 format)
+static SDL_Surface *
+SDL_CreateSurfaceInternal(int width, int height, Uint32 format, SDL_bool clear)
 {
     SDL_Surface *surface;
 
-    /* The flags are no longer used, make the compiler happy */
-    (void)flags;
-
     /* Allocate the surface */
     surface = (SDL_Surface *) SDL_calloc(1, sizeof(*surface));
     if (surface == NULL) {
@@ -112,15 +287,20 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
             return NULL;
         }
 
-        surface->pixels = SDL_SIMDAlloc((size_t)size);
+        surface->pixels = TakePooledPixels(format, surface->w, surface->h, surface->pitch);
+        if (!surface->pixels) {
+            surface->pixels = SDL_SIMDAlloc((size_t)size);
+        }
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
             return NULL;
         }
         surface->flags |= SDL_SIMD_ALIGNED;
-        /* This is important for bitmaps */
-        SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
+        if (clear) {
+            /* This is important for bitmaps */
+            SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
+        }
     }
 
     /* Allocate an empty mapping */
@@ -140,6 +320,20 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
     return surface;
 }
 
+/*
+ * Create an empty RGB surface of the appropriate depth using the given
+ * enum SDL_PIXELFORMAT_* format
+ */
+SDL_Surface *
+SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
+                               Uint32 format)
+{
+    /* The flags are no longer used, make the compiler happy */
+    (void)flags;
+
+    return SDL_CreateSurfaceInternal(width, height, format, SDL_TRUE);
+}
+
 /*
  * Create an empty RGB surface of the appropriate depth
  */
@@ -958,6 +1152,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
                    Uint32 flags)
 {
     SDL_Surface *convert;
+    Uint32 pixel_format;
     Uint32 copy_flags;
     SDL_Color copy_color;
     SDL_Rect bounds;
@@ -990,10 +1185,16 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     }
 
     /* Create a new surface with the desired format */
-    convert = SDL_CreateRGBSurface(flags, surface->w, surface->h,
-                                   format->BitsPerPixel, format->Rmask,
-                                   format->Gmask, format->Bmask,
-                                   format->Amask);
+    pixel_format = SDL_MasksToPixelFormatEnum(format->BitsPerPixel, format->Rmask,
+                                              format->Gmask, format->Bmask,
+                                              format->Amask);
+    if (pixel_format == SDL_PIXELFORMAT_UNKNOWN) {
+        SDL_SetError("Unknown pixel format");
+        return NULL;
+    }
+    /* The blit below writes every pixel, unless they're packed into bytes */
+    convert = SDL_CreateSurfaceInternal(surface->w, surface->h, pixel_format,
+                                        SDL_BITSPERPIXEL(pixel_format) < 8);
     if (convert == NULL) {
         return (NULL);
     }
@@ -1285,20 +1486,22 @@ SDL_FreeSurface(SDL_Surface * surface)
         SDL_UnRLESurface(surface, 0);
     }
 #endif
-    if (surface->format) {
-        SDL_SetSurfacePalette(surface, NULL);
-        SDL_FreeFormat(surface->format);
-        surface->format = NULL;
-    }
     if (surface->flags & SDL_PREALLOC) {
         /* Don't free */
     } else if (surface->flags & SDL_SIMD_ALIGNED) {
-        /* Free aligned */
-        SDL_SIMDFree(surface->pixels);
+        /* Free aligned, or keep for reuse */
+        if (!PoolPixels(surface)) {
+            SDL_SIMDFree(surface->pixels);
+        }
     } else {
         /* Normal */
         SDL_free(surface->pixels);
     }
+    if (surface->format) {
+        SDL_SetSurfacePalette(surface, NULL);
+        SDL_FreeFormat(surface->format);
+        surface->format = NULL;
+    }
     if (surface->map) {
         SDL_FreeBlitMap(surface->map);
     }
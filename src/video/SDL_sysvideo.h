@@ -52,6 +52,10 @@ struct SDL_WindowShaper
     /* Has this window been assigned a shape? */
     SDL_bool hasshape;
 
+    /* The current shape, one bit per pixel, least significant bit leftmost. */
+    Uint8 *mask;
+    int mask_w, mask_h;
+
     void *driverdata;
 };
 
@@ -30,6 +30,7 @@
 #include "SDL_rect_c.h"
 #include "../events/SDL_events_c.h"
 #include "../timer/SDL_timer_c.h"
+#include "../SDL_initprofile_c.h"
 
 #include "SDL_syswm.h"
 
@@ -466,6 +467,7 @@ SDL_VideoInit(const char *driver_name)
     SDL_VideoDevice *video;
     int index;
     int i;
+    int step, status;
 
     /* Check to make sure we don't overwrite '_this' */
     if (_this != NULL) {
@@ -485,6 +487,7 @@ SDL_VideoInit(const char *driver_name)
     }
 
     /* Select the proper video driver */
+    step = SDL_BeginInitStep(SDL_INIT_VIDEO, "video/bootstrap");
     index = 0;
     video = NULL;
     if (driver_name == NULL) {
@@ -509,6 +512,7 @@ SDL_VideoInit(const char *driver_name)
             }
         }
     }
+    SDL_EndInitStep(step);
     if (video == NULL) {
         if (driver_name) {
             return SDL_SetError("%s not available", driver_name);
@@ -529,7 +533,10 @@ SDL_VideoInit(const char *driver_name)
     _this->current_glctx_tls = SDL_TLSCreate();
 
     /* Initialize the video subsystem */
-    if (_this->VideoInit(_this) < 0) {
+    step = SDL_BeginInitStep(SDL_INIT_VIDEO, "video/%s", _this->name);
+    status = _this->VideoInit(_this);
+    SDL_EndInitStep(step);
+    if (status < 0) {
         SDL_VideoQuit();
         return -1;
     }
@@ -2763,6 +2770,10 @@ SDL_DestroyWindow(SDL_Window * window)
     if (_this->DestroyWindowFramebuffer) {
         _this->DestroyWindowFramebuffer(_this, window);
     }
+    if (window->shaper) {
+        SDL_free(window->shaper->mask);
+        window->shaper->mask = NULL;
+    }
     if (_this->DestroyWindow) {
         _this->DestroyWindow(_this, window);
     }
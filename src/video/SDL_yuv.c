@@ -25,6 +25,8 @@
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
 
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
 #include "yuv2rgb/yuv_rgb.h"
 
 #define SDL_YUV_SD_THRESHOLD    576
@@ -56,8 +58,36 @@ SDL_YUV_CONVERSION_MODE SDL_GetYUVConversionModeForResolution(int width, int hei
     return mode;
 }
 
+static SDL_SIMDVariant SDL_YUVVariant = SDL_SIMD_UNRESOLVED;
+
+void
+SDL_ChooseYUVKernels(void)
+{
+    SDL_SIMDVariant variant = SDL_SIMD_SCALAR;
+
+#if SDL_HAVE_YUV && defined(__SSE2__)
+    if (SDL_HasSSE2()) {
+        variant = SDL_SIMD_SSE2;
+    }
+#endif
+
+    SDL_YUVVariant = variant;
+    SDL_SetSIMDKernelVariant(SDL_SIMD_KERNEL_YUV, variant);
+}
+
 #if SDL_HAVE_YUV
 
+#ifdef __SSE2__
+static SDL_bool
+SDL_YUVUseSSE2(void)
+{
+    if (SDL_YUVVariant == SDL_SIMD_UNRESOLVED) {
+        SDL_ChooseYUVKernels();
+    }
+    return (SDL_YUVVariant == SDL_SIMD_SSE2);
+}
+#endif
+
 static int GetYUVConversionType(int width, int height, YCbCrType *yuv_type)
 {
     switch (SDL_GetYUVConversionModeForResolution(width, height)) {
@@ -189,7 +219,7 @@ static SDL_bool yuv_rgb_sse(
     YCbCrType yuv_type)
 {
 #ifdef __SSE2__
-    if (!SDL_HasSSE2()) {
+    if (!SDL_YUVUseSSE2()) {
         return SDL_FALSE;
     }
 
@@ -964,7 +994,7 @@ SDL_ConvertPixels_PackUVPlanes_to_NV(int width, int height, const void *src, int
     Uint8 *dstUV;
     Uint8 *tmp = NULL;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     /* Skip the Y plane */
@@ -1038,7 +1068,7 @@ SDL_ConvertPixels_SplitNV_to_UVPlanes(int width, int height, const void *src, in
     Uint8 *dst1, *dst2;
     Uint8 *tmp = NULL;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     /* Skip the Y plane */
@@ -1116,7 +1146,7 @@ SDL_ConvertPixels_SwapNV(int width, int height, const void *src, int src_pitch,
     const Uint16 *srcUV;
     Uint16 *dstUV;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     /* Skip the Y plane */
@@ -1252,7 +1282,7 @@ SDL_ConvertPixels_YUY2_to_UYVY(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
@@ -1294,7 +1324,7 @@ SDL_ConvertPixels_YUY2_to_YVYU(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
@@ -1336,7 +1366,7 @@ SDL_ConvertPixels_UYVY_to_YUY2(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
@@ -1378,7 +1408,7 @@ SDL_ConvertPixels_UYVY_to_YVYU(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
@@ -1420,7 +1450,7 @@ SDL_ConvertPixels_YVYU_to_YUY2(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
@@ -1462,7 +1492,7 @@ SDL_ConvertPixels_YVYU_to_UYVY(int width, int height, const void *src, int src_p
     const Uint8 *srcYUV = (const Uint8 *)src;
     Uint8 *dstYUV = (Uint8 *)dst;
 #ifdef __SSE2__
-    const SDL_bool use_SSE2 = SDL_HasSSE2();
+    const SDL_bool use_SSE2 = SDL_YUVUseSSE2();
 #endif
 
     y = height;
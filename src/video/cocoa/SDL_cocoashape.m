@@ -89,7 +89,7 @@ Cocoa_SetWindowShape(SDL_WindowShaper *shaper, SDL_Surface *shape, SDL_WindowSha
 
     [[NSColor clearColor] set];
     NSRectFill([[windata->nswindow contentView] frame]);
-    data->shape = SDL_CalculateShapeTree(*shape_mode,shape);
+    data->shape = SDL_CalculateShapeTree(shaper);
 
     closure.view = [windata->nswindow contentView];
     closure.path = [NSBezierPath bezierPath];
@@ -77,7 +77,7 @@ Win32_SetWindowShape(SDL_WindowShaper *shaper,SDL_Surface *shape,SDL_WindowShape
     data = (SDL_ShapeData*)shaper->driverdata;
     if(data->mask_tree != NULL)
         SDL_FreeShapeTree(&data->mask_tree);
-    data->mask_tree = SDL_CalculateShapeTree(*shape_mode,shape);
+    data->mask_tree = SDL_CalculateShapeTree(shaper);
 
     SDL_TraverseShapeTree(data->mask_tree,&CombineRectRegions,&mask_region);
     SDL_assert(mask_region != NULL);
@@ -98,7 +98,7 @@ X11_SetWindowShape(SDL_WindowShaper *shaper,SDL_Surface *shape,SDL_WindowShapeMo
     data = shaper->driverdata;
 
     /* Assume that shaper->alphacutoff already has a value, because SDL_SetWindowShape() should have given it one. */
-    SDL_CalculateShapeBitmap(shaper->mode,shape,data->bitmap,8);
+    SDL_CalculateShapeBitmap(shaper,data->bitmap,8);
 
     windowdata = (SDL_WindowData*)(shaper->window->driverdata);
     shapemask = X11_XCreateBitmapFromData(windowdata->videodata->display,windowdata->xwindow,data->bitmap,shaper->window->w,shaper->window->h);
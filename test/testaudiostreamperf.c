@@ -0,0 +1,107 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how fast audio moves through an SDL_AudioStream at typical
+   device buffer sizes. With matching formats the stream is nothing but its
+   data queue, so that row is a direct measurement of queue/dequeue cost. */
+
+#include "SDL.h"
+
+#define TOTAL_BYTES (64 * 1024 * 1024)
+
+static double
+RunStream(SDL_AudioStream *stream, Uint8 *inbuf, Uint8 *outbuf, int packetlen, int backlog)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    int put = 0;
+    int i;
+
+    /* Keep a few packets queued so reads and writes wrap around the buffer */
+    for (i = 0; i < backlog; i++) {
+        SDL_AudioStreamPut(stream, inbuf, packetlen);
+    }
+
+    while (put < TOTAL_BYTES) {
+        SDL_AudioStreamPut(stream, inbuf, packetlen);
+        put += packetlen;
+        while (SDL_AudioStreamAvailable(stream) >= packetlen * backlog) {
+            SDL_AudioStreamGet(stream, outbuf, packetlen);
+        }
+    }
+
+    SDL_AudioStreamClear(stream);
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static void
+Benchmark(const char *name, SDL_AudioFormat src_format, int src_rate, SDL_AudioFormat dst_format, int dst_rate)
+{
+    static const int packetlens[] = { 256, 1024, 4096, 16384 };
+    const int maxlen = packetlens[SDL_arraysize(packetlens) - 1];
+    Uint8 *inbuf = (Uint8 *) SDL_calloc(1, maxlen);
+    Uint8 *outbuf = (Uint8 *) SDL_malloc(maxlen * 4);
+    int i;
+
+    if (!inbuf || !outbuf) {
+        SDL_Log("Out of memory!\n");
+        SDL_free(inbuf);
+        SDL_free(outbuf);
+        return;
+    }
+
+    for (i = 0; i < SDL_arraysize(packetlens); i++) {
+        SDL_AudioStream *stream = SDL_NewAudioStream(src_format, 2, src_rate, dst_format, 2, dst_rate);
+        double best = 0.0;
+        int run;
+
+        if (!stream) {
+            SDL_Log("Couldn't create audio stream: %s\n", SDL_GetError());
+            break;
+        }
+
+        /* Take the best of a few runs, single runs are noisy */
+        for (run = 0; run < 3; run++) {
+            const double elapsed = RunStream(stream, inbuf, outbuf, packetlens[i], 4);
+            if (run == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        SDL_Log("%-24s %6d byte packets: %8.1f MB/s\n", name, packetlens[i],
+                (TOTAL_BYTES / (1024.0 * 1024.0)) / best);
+        SDL_FreeAudioStream(stream);
+    }
+
+    SDL_free(inbuf);
+    SDL_free(outbuf);
+}
+
+int
+main(int argc, char **argv)
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(0) == -1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    Benchmark("queue only", AUDIO_S16SYS, 48000, AUDIO_S16SYS, 48000);
+    Benchmark("s16 -> f32", AUDIO_S16SYS, 48000, AUDIO_F32SYS, 48000);
+    Benchmark("f32 44100 -> 48000", AUDIO_F32SYS, 44100, AUDIO_F32SYS, 48000);
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
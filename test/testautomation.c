@@ -29,11 +29,33 @@ quit(int rc)
     exit(rc);
 }
 
+/* Sets up SDL for the tests, in this process or in each worker process */
+static int
+InitState(void *arg)
+{
+    int i;
+
+    /* Initialize common state */
+    if (!SDLTest_CommonInit(state)) {
+        return -1;
+    }
+
+    /* Create the windows, initialize the renderers */
+    for (i = 0; i < state->num_windows; ++i) {
+        SDL_Renderer *renderer = state->renderers[i];
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        SDL_RenderClear(renderer);
+    }
+    return 0;
+}
+
 int
 main(int argc, char *argv[])
 {
     int result;
     int testIterations = 1;
+    int workers = 1;
+    int shardIndex, shardCount;
     Uint64 userExecKey = 0;
     char *userRunSeed = NULL;
     char *filter = NULL;
@@ -78,9 +100,27 @@ main(int argc, char *argv[])
                     consumed = 2;
                 }
             }
+            else if (SDL_strcasecmp(argv[i], "--workers") == 0) {
+                if (argv[i + 1]) {
+                    workers = SDL_atoi(argv[i + 1]);
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--shard") == 0) {
+                if (argv[i + 1] && SDL_sscanf(argv[i + 1], "%d/%d", &shardIndex, &shardCount) == 2 &&
+                    SDLTest_SetTestShard(shardIndex, shardCount) == 0) {
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--report") == 0) {
+                if (argv[i + 1]) {
+                    SDLTest_SetTestReport(argv[i + 1]);
+                    consumed = 2;
+                }
+            }
         }
         if (consumed < 0) {
-            static const char *options[] = { "[--iterations #]", "[--execKey #]", "[--seed string]", "[--filter suite_name|test_name]", NULL };
+            static const char *options[] = { "[--iterations #]", "[--execKey #]", "[--seed string]", "[--filter suite_name|test_name]", "[--workers #]", "[--shard index/count]", "[--report file.xml|file.json]", NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             quit(1);
         }
@@ -88,16 +128,11 @@ main(int argc, char *argv[])
         i += consumed;
     }
 
-    /* Initialize common state */
-    if (!SDLTest_CommonInit(state)) {
-        quit(2);
-    }
-
-    /* Create the windows, initialize the renderers */
-    for (i = 0; i < state->num_windows; ++i) {
-        SDL_Renderer *renderer = state->renderers[i];
-        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-        SDL_RenderClear(renderer);
+    /* Worker processes set up SDL for themselves, otherwise the tests run here */
+    if (workers <= 1 || SDLTest_SetTestWorkers(workers, InitState, NULL) < 0) {
+        if (InitState(NULL) < 0) {
+            quit(2);
+        }
     }
 
     /* Call Harness */
@@ -115,6 +150,7 @@ main(int argc, char *argv[])
     /* Clean up */
     SDL_free(userRunSeed);
     SDL_free(filter);
+    SDLTest_SetTestReport(NULL);
 
     /* Shutdown everything */
     quit(result);
@@ -967,6 +967,177 @@ int audio_openCloseAudioDeviceConnected()
    return TEST_COMPLETED;
 }
 
+/**
+ * \brief Checks that converting on several threads gives the same output as converting on one.
+ *
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_convertAudioParallel()
+{
+  static const struct {
+      SDL_AudioFormat src_format; Uint8 src_channels; int src_rate;
+      SDL_AudioFormat dst_format; Uint8 dst_channels; int dst_rate;
+  } conversions[] = {
+      { AUDIO_S16LSB, 2, 44100, AUDIO_F32SYS, 6, 48000 },
+      { AUDIO_F32MSB, 8, 96000, AUDIO_U8, 1, 22050 },
+      { AUDIO_S32SYS, 4, 48000, AUDIO_S16MSB, 2, 48000 },
+      { AUDIO_U16LSB, 1, 8000, AUDIO_S8, 1, 8000 }
+  };
+  SDL_AudioCVT serial, parallel;
+  int result;
+  int i, j;
+  int len;
+
+  for (i = 0; i < SDL_arraysize(conversions); i++) {
+    result = SDL_BuildAudioCVT(&serial, conversions[i].src_format, conversions[i].src_channels, conversions[i].src_rate,
+                               conversions[i].dst_format, conversions[i].dst_channels, conversions[i].dst_rate);
+    SDLTest_AssertPass("Call to SDL_BuildAudioCVT(0x%.4x,%i,%i,0x%.4x,%i,%i)",
+                       conversions[i].src_format, conversions[i].src_channels, conversions[i].src_rate,
+                       conversions[i].dst_format, conversions[i].dst_channels, conversions[i].dst_rate);
+    SDLTest_AssertCheck(result == 1, "Verify result value; expected: 1; got: %i", result);
+    parallel = serial;
+
+    /* Big enough to be split up, and not a round number of chunks */
+    len = (2 * 1024 * 1024) + (SDLTest_RandomIntegerInRange(0, 4096) * conversions[i].src_channels * (SDL_AUDIO_BITSIZE(conversions[i].src_format) / 8));
+    serial.len = parallel.len = len;
+    serial.buf = (Uint8 *)SDL_SIMDAlloc(len * serial.len_mult);
+    parallel.buf = (Uint8 *)SDL_SIMDAlloc(len * parallel.len_mult);
+    SDLTest_AssertCheck(serial.buf != NULL && parallel.buf != NULL, "Check data buffers to convert are not NULL");
+    if (serial.buf == NULL || parallel.buf == NULL) {
+      SDL_SIMDFree(serial.buf);
+      SDL_SIMDFree(parallel.buf);
+      return TEST_ABORTED;
+    }
+    SDLTest_RandomBuffer(serial.buf, len);
+    SDL_memcpy(parallel.buf, serial.buf, len);
+    if (SDL_AUDIO_ISFLOAT(conversions[i].src_format)) {
+      /* Random bytes make NaNs, whose payloads aren't worth comparing */
+      for (j = 0; j < len; j += 4) {
+        serial.buf[j + (SDL_AUDIO_ISBIGENDIAN(conversions[i].src_format) ? 0 : 3)] &= 0x3F;
+        parallel.buf[j + (SDL_AUDIO_ISBIGENDIAN(conversions[i].src_format) ? 0 : 3)] &= 0x3F;
+      }
+    }
+
+    SDL_SetHint(SDL_HINT_AUDIO_CONVERT_THREADS, "1");
+    result = SDL_ConvertAudio(&serial);
+    SDLTest_AssertCheck(result == 0, "Verify serial conversion; expected: 0; got: %i", result);
+
+    SDL_SetHint(SDL_HINT_AUDIO_CONVERT_THREADS, "4");
+    result = SDL_ConvertAudio(&parallel);
+    SDLTest_AssertCheck(result == 0, "Verify parallel conversion; expected: 0; got: %i", result);
+
+    SDLTest_AssertCheck(serial.len_cvt == parallel.len_cvt, "Verify converted length; expected: %i; got: %i", serial.len_cvt, parallel.len_cvt);
+    if (serial.len_cvt == parallel.len_cvt) {
+      result = SDL_memcmp(serial.buf, parallel.buf, serial.len_cvt);
+      SDLTest_AssertCheck(result == 0, "Verify parallel output matches serial output");
+    }
+
+    SDL_SIMDFree(serial.buf);
+    SDL_SIMDFree(parallel.buf);
+  }
+
+  SDL_SetHint(SDL_HINT_AUDIO_CONVERT_THREADS, NULL);
+  return TEST_COMPLETED;
+}
+
+/**
+ * \brief Render audio offline with the disk driver on a virtual clock
+ *
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceTicks
+ */
+int audio_diskVirtualClock()
+{
+  const Uint32 target = 10000;
+  const char *file = "audio_diskVirtualClock.raw";
+  char *oldfile;
+  SDL_AudioSpec desired;
+  SDL_AudioDeviceID id;
+  SDL_RWops *rw;
+  Uint32 start;
+  Uint32 ticks;
+  Sint64 size;
+  int result;
+
+  /* Write to a file no other test uses */
+  oldfile = SDL_getenv("SDL_DISKAUDIOFILE") ? SDL_strdup(SDL_getenv("SDL_DISKAUDIOFILE")) : NULL;
+  SDL_setenv("SDL_DISKAUDIOFILE", file, 1);
+
+  /* Switch the running audio subsystem over to the disk driver */
+  SDL_SetHint(SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK, "1");
+  result = SDL_AudioInit("disk");
+  SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+  if (result != 0) {
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK, NULL);
+    SDL_setenv("SDL_DISKAUDIOFILE", oldfile ? oldfile : "sdlaudio.raw", 1);
+    SDL_free(oldfile);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    _audioSetUp(NULL);
+    return TEST_ABORTED;
+  }
+
+  SDL_zero(desired);
+  desired.freq = 48000;
+  desired.format = AUDIO_S16SYS;
+  desired.channels = 2;
+  desired.samples = 1024;
+  desired.callback = _audio_testCallback;
+  _audio_testCallbackCounter = 0;
+  _audio_testCallbackLength = 0;
+
+  id = SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0);
+  SDLTest_AssertPass("Call to SDL_OpenAudioDevice()");
+  SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >1 got: %d", id);
+  if (id > 1) {
+    /* Nothing is rendered and the clock stands still while paused */
+    SDL_Delay(50);
+    ticks = SDL_GetAudioDeviceTicks(id);
+    SDLTest_AssertCheck(ticks == 0, "Validate ticks while paused; expected: 0 got: %d", ticks);
+
+    /* Ten seconds of audio should take a small fraction of that to render */
+    start = SDL_GetTicks();
+    SDL_PauseAudioDevice(id, 0);
+    do {
+      SDL_Delay(1);
+      ticks = SDL_GetAudioDeviceTicks(id);
+    } while (ticks < target && !SDL_TICKS_PASSED(SDL_GetTicks(), start + target / 2));
+    SDL_PauseAudioDevice(id, 1);
+    SDLTest_AssertCheck(ticks >= target, "Validate rendering ran faster than real time; expected: >=%d got: %d", target, ticks);
+
+    /* The clock counts exactly the frames given to the callback */
+    ticks = SDL_GetAudioDeviceTicks(id);
+    result = (int) (((Uint64) _audio_testCallbackLength / 4 * 1000) / desired.freq);
+    SDLTest_AssertCheck(ticks == (Uint32) result, "Validate ticks; expected: %d got: %d", result, ticks);
+
+    SDL_CloseAudioDevice(id);
+    SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+    /* The file holds what the callback rendered and nothing else */
+    rw = SDL_RWFromFile(file, "rb");
+    SDLTest_AssertCheck(rw != NULL, "Validate output file could be opened");
+    if (rw != NULL) {
+      size = SDL_RWsize(rw);
+      SDL_RWclose(rw);
+      SDLTest_AssertCheck(size == _audio_testCallbackLength, "Validate file size; expected: %d got: %d", _audio_testCallbackLength, (int) size);
+    }
+    result = remove(file);
+    SDLTest_AssertCheck(result == 0, "Validate removal of %s; expected: 0 got: %d", file, result);
+  }
+
+  /* Restart audio with the default driver */
+  SDL_SetHint(SDL_HINT_AUDIO_DISK_VIRTUAL_CLOCK, NULL);
+  SDL_QuitSubSystem(SDL_INIT_AUDIO);
+  _audioSetUp(NULL);
+
+  /* SDL_setenv() can't unset, the disk driver's default is the same thing */
+  SDL_setenv("SDL_DISKAUDIOFILE", oldfile ? oldfile : "sdlaudio.raw", 1);
+  SDL_free(oldfile);
+
+  ticks = SDL_GetAudioDeviceTicks(0);
+  SDLTest_AssertCheck(ticks == 0, "Validate ticks of an invalid device; expected: 0 got: %d", ticks);
+
+  return TEST_COMPLETED;
+}
 
 
 /* ================= Test Case References ================== */
@@ -1022,11 +1193,18 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_convertAudioParallel, "audio_convertAudioParallel", "Compare multithreaded audio conversion against a single thread.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_diskVirtualClock, "audio_diskVirtualClock", "Render audio faster than real time with the disk driver.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
+    &audioTest17, NULL
 };
 
 /* Audio test suite (global) */
@@ -174,6 +174,156 @@ events_addDelEventWatchWithUserdata(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Records events to a log and replays them one pump at a time
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_RECORD
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_REPLAY
+ */
+int
+events_recordAndReplay(void *arg)
+{
+   const char *filename = "events_recordAndReplay.log";
+   const SDL_Scancode scancode = (SDL_Scancode)SDLTest_RandomIntegerInRange(SDL_SCANCODE_A, SDL_SCANCODE_Z);
+   const Sint16 value = SDLTest_RandomSint16();
+   SDL_Event event;
+   SDL_Event events[8];
+   int result;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Record a key press and a controller axis, a user event that's not recorded,
+      a pump with nothing in it, and then the key release */
+   SDL_SetHint(SDL_HINT_EVENT_RECORD, filename);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_RECORD, \"%s\")", filename);
+
+   SDL_zero(event);
+   event.type = SDL_KEYDOWN;
+   event.key.state = SDL_PRESSED;
+   event.key.keysym.scancode = scancode;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_CONTROLLERAXISMOTION;
+   event.caxis.axis = SDL_CONTROLLER_AXIS_LEFTX;
+   event.caxis.value = value;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_USEREVENT;
+   SDL_PushEvent(&event);
+   SDL_PumpEvents();
+   SDL_PumpEvents();
+   SDL_zero(event);
+   event.type = SDL_KEYUP;
+   event.key.state = SDL_RELEASED;
+   event.key.keysym.scancode = scancode;
+   SDL_PushEvent(&event);
+   SDL_PumpEvents();
+
+   SDL_SetHint(SDL_HINT_EVENT_RECORD, "");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_RECORD, \"\")");
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   /* Replay it: each pump should bring back what arrived before the same pump in the recording */
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY_SPEED, "0");
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY, filename);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_REPLAY, \"%s\")", filename);
+
+   SDL_PumpEvents();
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 2, "Check events after first pump, expected: 2, got: %i", result);
+   if (result == 2) {
+      SDLTest_AssertCheck(events[0].type == SDL_KEYDOWN && events[0].key.keysym.scancode == scancode,
+                          "Check key press, expected: %i, got: %i", (int)scancode, (int)events[0].key.keysym.scancode);
+      SDLTest_AssertCheck(events[1].type == SDL_CONTROLLERAXISMOTION && events[1].caxis.value == value,
+                          "Check controller axis, expected: %i, got: %i", (int)value, (int)events[1].caxis.value);
+   }
+   SDLTest_AssertCheck(SDL_GetKeyboardState(NULL)[scancode] == 1, "Check replayed key is held down");
+
+   SDL_PumpEvents();
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check events after second pump, expected: 0, got: %i", result);
+
+   SDL_PumpEvents();
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 1 && events[0].type == SDL_KEYUP, "Check key release after third pump, expected: 1 event, got: %i", result);
+   SDLTest_AssertCheck(SDL_GetKeyboardState(NULL)[scancode] == 0, "Check replayed key is released");
+
+   /* The log is finished */
+   SDL_PumpEvents();
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check events after the end of the log, expected: 0, got: %i", result);
+
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY, "");
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY_SPEED, "");
+   remove(filename);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Records more events than fit in the log buffer and replays them all
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_RECORD
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_HINT_EVENT_REPLAY
+ */
+int
+events_recordManyEvents(void *arg)
+{
+   const char *filename = "events_recordManyEvents.log";
+   const int pumps = 8;
+   const int perPump = 250;
+   SDL_Event event;
+   SDL_Event events[64];
+   int i, j, result, count, expected, ordered;
+
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+   SDL_SetHint(SDL_HINT_EVENT_RECORD, filename);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_RECORD, \"%s\")", filename);
+   for (i = 0; i < pumps; i++) {
+      for (j = 0; j < perPump; j++) {
+         SDL_zero(event);
+         event.type = SDL_CONTROLLERAXISMOTION;
+         event.caxis.which = i;
+         event.caxis.value = (Sint16)j;
+         SDL_PushEvent(&event);
+      }
+      SDL_PumpEvents();
+      SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   }
+   SDL_SetHint(SDL_HINT_EVENT_RECORD, "");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_RECORD, \"\")");
+
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY_SPEED, "0");
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY, filename);
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_REPLAY, \"%s\")", filename);
+
+   /* Every pump brings back the events recorded before it, in order */
+   ordered = 1;
+   for (i = 0; i < pumps; i++) {
+      SDL_PumpEvents();
+      count = 0;
+      expected = 0;
+      while ((result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) > 0) {
+         for (j = 0; j < result; j++) {
+            if (events[j].caxis.which != i || events[j].caxis.value != expected) {
+               ordered = 0;
+            }
+            ++expected;
+         }
+         count += result;
+      }
+      SDLTest_AssertCheck(count == perPump, "Check events after pump %i, expected: %i, got: %i", i, perPump, count);
+   }
+   SDLTest_AssertCheck(ordered, "Check replayed events are in the recorded order");
+
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY, "");
+   SDL_SetHint(SDL_HINT_EVENT_REPLAY_SPEED, "");
+   remove(filename);
+
+   return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -187,9 +337,15 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_recordAndReplay, "events_recordAndReplay", "Records events to a log and replays them", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsTest5 =
+        { (SDLTest_TestCaseFp)events_recordManyEvents, "events_recordManyEvents", "Records more events than the log buffer holds and replays them", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, NULL
 };
 
 /* Events test suite (global) */
@@ -225,6 +225,57 @@ pixels_allocFreeFormat(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Check that SDL_AllocFormat shares non-indexed formats and not indexed ones
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_AllocFormat
+ */
+int
+pixels_allocSharedFormat(void *arg)
+{
+  int i;
+  int bpp;
+  Uint32 format;
+  Uint32 Rmask, Gmask, Bmask, Amask;
+  SDL_PixelFormat *first, *second;
+
+  for (i = 0; i < _numRGBPixelFormats; i++) {
+    format = _RGBPixelFormats[i];
+    first = SDL_AllocFormat(format);
+    second = SDL_AllocFormat(format);
+    SDLTest_AssertPass("Call to SDL_AllocFormat(%s) twice", _RGBPixelFormatsVerbose[i]);
+    SDLTest_AssertCheck(first != NULL && second != NULL, "Verify results are not NULL");
+    if (first == NULL || second == NULL) {
+      SDL_FreeFormat(first);
+      SDL_FreeFormat(second);
+      continue;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+      SDLTest_AssertCheck(first != second, "Verify indexed formats are not shared");
+    } else {
+      SDLTest_AssertCheck(first == second, "Verify non-indexed formats are shared");
+      SDL_PixelFormatEnumToMasks(format, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
+      SDLTest_AssertCheck(first->BitsPerPixel == bpp, "Verify value of result.BitsPerPixel; expected: %d, got %u", bpp, first->BitsPerPixel);
+      SDLTest_AssertCheck(first->Rmask == Rmask && first->Gmask == Gmask && first->Bmask == Bmask && first->Amask == Amask,
+        "Verify value of result.[RGBA]mask matches SDL_PixelFormatEnumToMasks()");
+    }
+
+    SDL_FreeFormat(first);
+    SDL_FreeFormat(second);
+    SDLTest_AssertPass("Call to SDL_FreeFormat() twice");
+  }
+
+  /* A shared format must survive its users freeing it */
+  first = SDL_AllocFormat(SDL_PIXELFORMAT_ARGB8888);
+  SDL_FreeFormat(first);
+  second = SDL_AllocFormat(SDL_PIXELFORMAT_ARGB8888);
+  SDLTest_AssertCheck(second != NULL && second->format == SDL_PIXELFORMAT_ARGB8888, "Verify shared format is still valid after SDL_FreeFormat()");
+  SDL_FreeFormat(second);
+
+  return TEST_COMPLETED;
+}
+
 /**
  * @brief Call to SDL_GetPixelFormatName
  *
@@ -517,9 +568,12 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_allocSharedFormat, "pixels_allocSharedFormat", "Check sharing of formats returned by SDL_AllocFormat", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, NULL
 };
 
 /* Pixels test suite (global) */
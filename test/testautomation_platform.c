@@ -523,6 +523,131 @@ int platform_testGetPowerInfo(void *arg)
    return TEST_COMPLETED;
 }
 
+/* !
+ * \brief Tests the CPU cache and topology functions
+ * \sa
+ * http://wiki.libsdl.org/SDL_GetCPUCacheSize
+ * http://wiki.libsdl.org/SDL_GetCPUPhysicalCoreCount
+ * http://wiki.libsdl.org/SDL_GetCPUThreadsPerCore
+ * http://wiki.libsdl.org/SDL_GetCPUEfficiencyCoreCount
+ */
+int platform_testCPUTopology(void *arg)
+{
+   int cpus, cores, threads, efficiency;
+   int level;
+
+   for (level = 1; level <= 3; level++) {
+     const int size = SDL_GetCPUCacheSize(level);
+     SDLTest_AssertPass("Call to SDL_GetCPUCacheSize(%d)", level);
+     SDLTest_AssertCheck(size >= 0, "Validate L%d cache size; expected: >= 0, got: %d", level, size);
+   }
+   SDLTest_AssertCheck(SDL_GetCPUCacheSize(0) == 0, "Validate SDL_GetCPUCacheSize(0) == 0");
+   SDLTest_AssertCheck(SDL_GetCPUCacheSize(4) == 0, "Validate SDL_GetCPUCacheSize(4) == 0");
+
+   cpus = SDL_GetCPUCount();
+   cores = SDL_GetCPUPhysicalCoreCount();
+   SDLTest_AssertPass("Call to SDL_GetCPUPhysicalCoreCount()");
+   SDLTest_AssertCheck(cores > 0 && cores <= cpus,
+             "Validate physical core count; expected: 1..%d, got: %d", cpus, cores);
+
+   threads = SDL_GetCPUThreadsPerCore();
+   SDLTest_AssertPass("Call to SDL_GetCPUThreadsPerCore()");
+   SDLTest_AssertCheck(threads > 0 && threads <= cpus,
+             "Validate threads per core; expected: 1..%d, got: %d", cpus, threads);
+
+   efficiency = SDL_GetCPUEfficiencyCoreCount();
+   SDLTest_AssertPass("Call to SDL_GetCPUEfficiencyCoreCount()");
+   SDLTest_AssertCheck(efficiency >= 0 && efficiency < cores,
+             "Validate efficiency core count; expected: 0..%d, got: %d", cores - 1, efficiency);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_GetSIMDKernelVariant and SDL_HINT_CPU_FEATURE_MASK
+ */
+int platform_testSIMDKernels(void *arg)
+{
+   static const char *kernels[] = { "fill", "copy", "blend", "convert", "resample", "mix", "yuv" };
+   char *oldHint = NULL;
+   const char *variant;
+   int i;
+
+   if (SDL_GetHint(SDL_HINT_CPU_FEATURE_MASK)) {
+     oldHint = SDL_strdup(SDL_GetHint(SDL_HINT_CPU_FEATURE_MASK));
+   }
+
+   for (i = 0; i < SDL_arraysize(kernels); i++) {
+     variant = SDL_GetSIMDKernelVariant(kernels[i]);
+     SDLTest_AssertPass("Call to SDL_GetSIMDKernelVariant(\"%s\")", kernels[i]);
+     SDLTest_AssertCheck(variant != NULL && *variant, "Validate variant is set, got: %s", variant ? variant : "(null)");
+   }
+
+   SDL_ClearError();
+   variant = SDL_GetSIMDKernelVariant("bogus");
+   SDLTest_AssertCheck(variant == NULL, "Validate unknown kernel returns NULL");
+   SDLTest_AssertCheck(*SDL_GetError() != '\0', "Validate an error was set");
+
+   SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, "-all");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, \"-all\")");
+   SDLTest_AssertCheck(!SDL_HasMMX() && !SDL_HasSSE() && !SDL_HasSSE2() && !SDL_HasAVX() &&
+                       !SDL_HasAVX512F() && !SDL_HasNEON() && !SDL_HasAltiVec(),
+                       "Validate all SIMD features are hidden");
+   for (i = 0; i < SDL_arraysize(kernels); i++) {
+     variant = SDL_GetSIMDKernelVariant(kernels[i]);
+     SDLTest_AssertCheck(variant != NULL && SDL_strcmp(variant, "scalar") == 0,
+                         "Validate %s variant; expected: scalar, got: %s", kernels[i], variant ? variant : "(null)");
+   }
+
+   SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, "-all,+sse,+sse2,+neon");
+   variant = SDL_GetSIMDKernelVariant("mix");
+   SDLTest_AssertCheck(variant != NULL && (SDL_strcmp(variant, "scalar") == 0 ||
+                       (SDL_HasSSE2() && SDL_strcmp(variant, "sse2") == 0)),
+                       "Validate mix variant follows the mask, got: %s", variant ? variant : "(null)");
+   variant = SDL_GetSIMDKernelVariant("fill");
+   SDLTest_AssertCheck(variant != NULL && SDL_strcmp(variant, "avx") != 0 && SDL_strcmp(variant, "avx512f") != 0,
+                       "Validate fill doesn't use hidden features, got: %s", variant ? variant : "(null)");
+
+   SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, oldHint);
+   SDL_free(oldHint);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_GetInitTimings
+ *
+ * @sa
+ * http://wiki.libsdl.org/SDL_GetInitTimings
+ */
+int platform_testGetInitTimings(void *arg)
+{
+   SDL_InitTiming timings[64];
+   int count, filled, i;
+
+   count = SDL_GetInitTimings(NULL, 0);
+   SDLTest_AssertPass("Call to SDL_GetInitTimings(NULL, 0)");
+   SDLTest_AssertCheck(count > 0, "Validate count; expected: >0, got: %d", count);
+
+   filled = SDL_GetInitTimings(timings, SDL_arraysize(timings));
+   SDLTest_AssertPass("Call to SDL_GetInitTimings(timings, %d)", (int) SDL_arraysize(timings));
+   SDLTest_AssertCheck(filled == count, "Validate count; expected: %d, got: %d", count, filled);
+   if (filled > SDL_arraysize(timings)) {
+     filled = SDL_arraysize(timings);
+   }
+
+   for (i = 0; i < filled; i++) {
+     SDLTest_AssertCheck(timings[i].name != NULL && *timings[i].name, "Validate step %d has a name", i);
+     SDLTest_AssertCheck(timings[i].subsystem != 0, "Validate step %d (%s) has a subsystem", i, timings[i].name);
+   }
+   SDLTest_AssertCheck(filled > 0 && timings[0].start == 0, "Validate first step starts at 0");
+
+   filled = SDL_GetInitTimings(timings, 1);
+   SDLTest_AssertCheck(filled == count, "Validate a short array still returns the full count; expected: %d, got: %d", count, filled);
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Platform test cases */
@@ -559,6 +684,15 @@ static const SDLTest_TestCaseReference platformTest10 =
 static const SDLTest_TestCaseReference platformTest11 =
         { (SDLTest_TestCaseFp)platform_testGetPowerInfo, "platform_testGetPowerInfo", "Tests SDL_GetPowerInfo function", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference platformTest12 =
+        { (SDLTest_TestCaseFp)platform_testCPUTopology, "platform_testCPUTopology", "Tests CPU cache and core topology functions", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference platformTest13 =
+        { (SDLTest_TestCaseFp)platform_testSIMDKernels, "platform_testSIMDKernels", "Tests SIMD kernel selection and SDL_HINT_CPU_FEATURE_MASK", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference platformTest14 =
+        { (SDLTest_TestCaseFp)platform_testGetInitTimings, "platform_testGetInitTimings", "Tests SDL_GetInitTimings", TEST_ENABLED };
+
 /* Sequence of Platform test cases */
 static const SDLTest_TestCaseReference *platformTests[] =  {
     &platformTest1,
@@ -572,6 +706,9 @@ static const SDLTest_TestCaseReference *platformTests[] =  {
     &platformTest9,
     &platformTest10,
     &platformTest11,
+    &platformTest12,
+    &platformTest13,
+    &platformTest14,
     NULL
 };
 
@@ -1574,6 +1574,124 @@ int rect_testRectEqualsParam(void *arg)
     return TEST_COMPLETED;
 }
 
+/* !
+ * \brief Tests SDL_IntersectRects() against SDL_IntersectRect()
+ */
+int rect_testIntersectRects(void *arg)
+{
+    SDL_Rect clip;
+    SDL_Rect rects[67];
+    SDL_Rect result[67];
+    SDL_Rect expected;
+    const int count = SDL_arraysize(rects);
+    int i, n, found;
+
+    clip.x = SDLTest_RandomIntegerInRange(-256, 256);
+    clip.y = SDLTest_RandomIntegerInRange(-256, 256);
+    clip.w = SDLTest_RandomIntegerInRange(1, 512);
+    clip.h = SDLTest_RandomIntegerInRange(1, 512);
+    for (i = 0; i < count; ++i) {
+        rects[i].x = SDLTest_RandomIntegerInRange(-1024, 1024);
+        rects[i].y = SDLTest_RandomIntegerInRange(-1024, 1024);
+        rects[i].w = SDLTest_RandomIntegerInRange(-2, 1024);
+        rects[i].h = SDLTest_RandomIntegerInRange(-2, 1024);
+    }
+
+    n = SDL_IntersectRects(&clip, rects, count, result);
+    SDLTest_AssertPass("Call to SDL_IntersectRects()");
+    found = 0;
+    for (i = 0; i < count; ++i) {
+        if (SDL_IntersectRect(&rects[i], &clip, &expected)) {
+            if (found < n && !SDL_RectEquals(&result[found], &expected)) {
+                break;
+            }
+            ++found;
+        }
+    }
+    SDLTest_AssertCheck(n == found, "Check number of intersections, expected: %d, got: %d", found, n);
+    SDLTest_AssertCheck(i == count, "Check that intersections match SDL_IntersectRect(), first mismatch at: %d", i);
+
+    /* In place */
+    n = SDL_IntersectRects(&clip, rects, count, rects);
+    SDLTest_AssertCheck(n == found, "Check number of in place intersections, expected: %d, got: %d", found, n);
+    SDLTest_AssertCheck(SDL_memcmp(rects, result, n * sizeof (SDL_Rect)) == 0, "Check that in place intersections match");
+
+    /* Empty clip rect */
+    clip.w = 0;
+    n = SDL_IntersectRects(&clip, result, count, result);
+    SDLTest_AssertCheck(n == 0, "Check that an empty clip rect culls everything, got: %d", n);
+
+    /* Invalid parameters */
+    n = SDL_IntersectRects(NULL, rects, count, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 1st parameter is NULL");
+    n = SDL_IntersectRects(&clip, NULL, count, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 2nd parameter is NULL");
+    n = SDL_IntersectRects(&clip, rects, -1, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when count is negative");
+    n = SDL_IntersectRects(&clip, rects, count, NULL);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 4th parameter is NULL");
+
+    return TEST_COMPLETED;
+}
+
+/* !
+ * \brief Tests SDL_IntersectRectAndLines() against SDL_IntersectRectAndLine()
+ */
+int rect_testIntersectRectAndLines(void *arg)
+{
+    SDL_Rect rect;
+    SDL_Point points[2 * 67];
+    SDL_Point result[2 * 67];
+    const int count = SDL_arraysize(points) / 2;
+    int x1, y1, x2, y2;
+    int i, n, found;
+
+    rect.x = SDLTest_RandomIntegerInRange(-64, 64);
+    rect.y = SDLTest_RandomIntegerInRange(-64, 64);
+    rect.w = SDLTest_RandomIntegerInRange(1, 128);
+    rect.h = SDLTest_RandomIntegerInRange(1, 128);
+    for (i = 0; i < 2 * count; ++i) {
+        points[i].x = SDLTest_RandomIntegerInRange(-256, 256);
+        points[i].y = SDLTest_RandomIntegerInRange(-256, 256);
+    }
+
+    n = SDL_IntersectRectAndLines(&rect, points, count, result);
+    SDLTest_AssertPass("Call to SDL_IntersectRectAndLines()");
+    found = 0;
+    for (i = 0; i < count; ++i) {
+        x1 = points[i * 2].x;
+        y1 = points[i * 2].y;
+        x2 = points[i * 2 + 1].x;
+        y2 = points[i * 2 + 1].y;
+        if (SDL_IntersectRectAndLine(&rect, &x1, &y1, &x2, &y2)) {
+            if (found < n && (result[found * 2].x != x1 || result[found * 2].y != y1 ||
+                              result[found * 2 + 1].x != x2 || result[found * 2 + 1].y != y2)) {
+                break;
+            }
+            ++found;
+        }
+    }
+    SDLTest_AssertCheck(n == found, "Check number of clipped lines, expected: %d, got: %d", found, n);
+    SDLTest_AssertCheck(i == count, "Check that clipped lines match SDL_IntersectRectAndLine(), first mismatch at: %d", i);
+
+    /* In place */
+    n = SDL_IntersectRectAndLines(&rect, points, count, points);
+    SDLTest_AssertCheck(n == found, "Check number of lines clipped in place, expected: %d, got: %d", found, n);
+    SDLTest_AssertCheck(SDL_memcmp(points, result, n * 2 * sizeof (SDL_Point)) == 0, "Check that lines clipped in place match");
+
+    /* Invalid parameters */
+    n = SDL_IntersectRectAndLines(NULL, points, count, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 1st parameter is NULL");
+    n = SDL_IntersectRectAndLines(&rect, NULL, count, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 2nd parameter is NULL");
+    n = SDL_IntersectRectAndLines(&rect, points, -1, result);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when count is negative");
+    n = SDL_IntersectRectAndLines(&rect, points, count, NULL);
+    SDLTest_AssertCheck(n == -1, "Check that function returns -1 when 4th parameter is NULL");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Rect test cases */
@@ -1673,6 +1791,13 @@ static const SDLTest_TestCaseReference rectTest28 =
 static const SDLTest_TestCaseReference rectTest29 =
         { (SDLTest_TestCaseFp)rect_testRectEqualsParam, "rect_testRectEqualsParam", "Negative tests against SDL_RectEquals with invalid parameters", TEST_ENABLED };
 
+/* SDL_IntersectRects, SDL_IntersectRectAndLines */
+static const SDLTest_TestCaseReference rectTest30 =
+        { (SDLTest_TestCaseFp)rect_testIntersectRects, "rect_testIntersectRects", "Tests SDL_IntersectRects against SDL_IntersectRect", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rectTest31 =
+        { (SDLTest_TestCaseFp)rect_testIntersectRectAndLines, "rect_testIntersectRectAndLines", "Tests SDL_IntersectRectAndLines against SDL_IntersectRectAndLine", TEST_ENABLED };
+
 
 /* !
  * \brief Sequence of Rect test cases; functions that handle simple rectangles including overlaps and merges.
@@ -1683,7 +1808,7 @@ static const SDLTest_TestCaseReference rectTest29 =
 static const SDLTest_TestCaseReference *rectTests[] =  {
     &rectTest1, &rectTest2, &rectTest3, &rectTest4, &rectTest5, &rectTest6, &rectTest7, &rectTest8, &rectTest9, &rectTest10, &rectTest11, &rectTest12, &rectTest13, &rectTest14,
     &rectTest15, &rectTest16, &rectTest17, &rectTest18, &rectTest19, &rectTest20, &rectTest21, &rectTest22, &rectTest23, &rectTest24, &rectTest25, &rectTest26, &rectTest27,
-    &rectTest28, &rectTest29, NULL
+    &rectTest28, &rectTest29, &rectTest30, &rectTest31, NULL
 };
 
 
@@ -420,6 +420,459 @@ render_testBlit(void *arg)
 }
 
 
+/**
+ * @brief Tests textured and solid geometry rendering.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderGeometry
+ */
+int
+render_testGeometry(void *arg)
+{
+   int ret;
+   SDL_Texture *tface;
+   SDL_Surface *referenceSurface = NULL;
+   SDL_Vertex verts[4];
+   const int indices[6] = { 0, 1, 2, 2, 1, 3 };
+   Uint32 tformat;
+   int taccess, tw, th;
+   int i, j, ni, nj;
+   int checkFailCount1;
+   Uint32 *pixels;
+   SDL_Rect rect;
+
+   /* Clear surface. */
+   _clearScreen();
+
+   /* Create face surface. */
+   tface = _loadTestFace();
+   SDLTest_AssertCheck(tface != NULL,  "Verify _loadTestFace() result");
+   if (tface == NULL) {
+       return TEST_ABORTED;
+   }
+
+   /* Bad parameters are rejected. */
+   SDL_zero(verts);
+   ret = SDL_RenderGeometry(renderer, NULL, verts, 2, NULL, 0);
+   SDLTest_AssertCheck(ret == -1, "Verify result from SDL_RenderGeometry with 2 vertices, expected -1, got %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, verts, 4, indices, 5);
+   SDLTest_AssertCheck(ret == -1, "Verify result from SDL_RenderGeometry with 5 indices, expected -1, got %i", ret);
+
+   /* Probe for support, this draws nothing since the triangle is degenerate. */
+   ret = SDL_RenderGeometry(renderer, NULL, verts, 3, NULL, 0);
+   if (ret != 0) {
+       SDLTest_Log("SDL_RenderGeometry not supported by this renderer: %s", SDL_GetError());
+       SDL_DestroyTexture(tface);
+       return TEST_SKIPPED;
+   }
+
+   /* Constant values. */
+   ret = SDL_QueryTexture(tface, &tformat, &taccess, &tw, &th);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_QueryTexture, expected 0, got %i", ret);
+   ni     = TESTRENDER_SCREEN_W - tw;
+   nj     = TESTRENDER_SCREEN_H - th;
+
+   for (i = 0; i < 4; i++) {
+      verts[i].color.r = verts[i].color.g = verts[i].color.b = verts[i].color.a = 255;
+      verts[i].tex_coord.x = (float) (i & 1);
+      verts[i].tex_coord.y = (float) (i >> 1);
+   }
+
+   /* Loop blit, every textured quad must match SDL_RenderCopy() exactly. */
+   checkFailCount1 = 0;
+   for (j=0; j <= nj; j+=4) {
+      for (i=0; i <= ni; i+=4) {
+         verts[0].position.x = verts[2].position.x = (float) i;
+         verts[1].position.x = verts[3].position.x = (float) (i + tw);
+         verts[0].position.y = verts[1].position.y = (float) j;
+         verts[2].position.y = verts[3].position.y = (float) (j + th);
+         ret = SDL_RenderGeometry(renderer, tface, verts, 4, indices, 6);
+         if (ret != 0) checkFailCount1++;
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_RenderGeometry, expected: 0, got: %i", checkFailCount1);
+
+   /* Make current */
+   SDL_RenderPresent(renderer);
+
+   /* See if it's the same */
+   referenceSurface = SDLTest_ImageBlit();
+   _compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE );
+   SDL_FreeSurface(referenceSurface);
+   referenceSurface = NULL;
+   SDL_DestroyTexture( tface );
+
+   /* A blended full screen quad must not overlap itself along the shared edge. */
+   _clearScreen();
+   for (i = 0; i < 4; i++) {
+      verts[i].position.x = (float) ((i & 1) * TESTRENDER_SCREEN_W);
+      verts[i].position.y = (float) ((i >> 1) * TESTRENDER_SCREEN_H);
+      verts[i].color.r = 255;
+      verts[i].color.g = 0;
+      verts[i].color.b = 0;
+      verts[i].color.a = 128;
+   }
+   ret = SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawBlendMode, expected: 0, got: %i", ret);
+   ret = SDL_RenderGeometry(renderer, NULL, verts, 4, indices, 6);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderGeometry, expected: 0, got: %i", ret);
+   SDL_RenderPresent(renderer);
+
+   pixels = (Uint32 *)SDL_malloc(4*TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H);
+   SDLTest_AssertCheck(pixels != NULL, "Validate allocated temp pixel buffer");
+   if (pixels == NULL) return TEST_ABORTED;
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = TESTRENDER_SCREEN_W;
+   rect.h = TESTRENDER_SCREEN_H;
+   ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, pixels, TESTRENDER_SCREEN_W*4);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   checkFailCount1 = 0;
+   for (i = 0; i < TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H; i++) {
+      if (pixels[i] != pixels[0]) checkFailCount1++;
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate uniform color of blended quad, expected: 0 mismatches, got: %i", checkFailCount1);
+   SDL_free(pixels);
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Replay callback that counts commands. Helper for render_testCaptureReplay.
+ */
+static void SDLCALL
+_countReplayedCommand(void *userdata, const SDL_RenderReplayTiming *timing)
+{
+   int *commands = (int *)userdata;
+   if (timing->name != NULL) {
+      (*commands)++;
+   }
+}
+
+/**
+ * @brief Captures a frame, replays it and checks that the result is identical.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderStartCapture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderReplayCapture
+ */
+int
+render_testCaptureReplay(void *arg)
+{
+   const char *file = "render_capture.dat";
+   const int indices[3] = { 0, 1, 2 };
+   SDL_Texture *tface;
+   SDL_Texture *target = NULL;
+   SDL_Vertex verts[3];
+   SDL_Rect rect;
+   SDL_Point points[3];
+   Uint32 *pattern;
+   Uint32 *expected;
+   Uint32 *actual;
+   int ret, i, tw, th, commands, mismatches;
+
+   tface = _loadTestFace();
+   SDLTest_AssertCheck(tface != NULL, "Verify _loadTestFace() result");
+   if (tface == NULL) {
+      return TEST_ABORTED;
+   }
+   SDL_QueryTexture(tface, NULL, NULL, &tw, &th);
+
+   expected = (Uint32 *)SDL_malloc(4*TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H);
+   actual = (Uint32 *)SDL_malloc(4*TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H);
+   pattern = (Uint32 *)SDL_malloc(4*tw*th);
+   SDLTest_AssertCheck(expected != NULL && actual != NULL && pattern != NULL, "Validate allocated temp pixel buffers");
+   if (expected == NULL || actual == NULL || pattern == NULL) {
+      SDL_free(expected);
+      SDL_free(actual);
+      SDL_free(pattern);
+      SDL_DestroyTexture(tface);
+      return TEST_ABORTED;
+   }
+
+   _clearScreen();
+
+   ret = SDL_RenderStartCapture(renderer, file, 1);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderStartCapture, expected: 0, got: %i", ret);
+   ret = SDL_RenderStartCapture(renderer, file, 1);
+   SDLTest_AssertCheck(ret == -1, "Validate that a second capture is rejected, expected: -1, got: %i", ret);
+
+   /* Solid primitives */
+   SDL_SetRenderDrawColor(renderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(renderer);
+   rect.x = 5; rect.y = 5; rect.w = 30; rect.h = 20;
+   SDL_SetRenderDrawColor(renderer, 200, 10, 10, 128);
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_SetRenderDrawColor(renderer, 10, 200, 10, SDL_ALPHA_OPAQUE);
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+   points[0].x = 0; points[0].y = 59;
+   points[1].x = 40; points[1].y = 30;
+   points[2].x = 79; points[2].y = 59;
+   SDL_RenderDrawLines(renderer, points, 3);
+   SDL_RenderDrawPoints(renderer, points, 3);
+
+   /* Textures, including one that changes after it was used */
+   SDL_SetTextureColorMod(tface, 255, 128, 64);
+   SDL_RenderCopy(renderer, tface, NULL, NULL);
+   for (i = 0; i < tw*th; i++) {
+      pattern[i] = (i & 4) ? 0xFF00FFFF : 0x80FF0000;
+   }
+   SDL_UpdateTexture(tface, NULL, pattern, tw*4);
+   SDL_SetTextureColorMod(tface, 255, 255, 255);
+   rect.x = 40; rect.y = 20; rect.w = tw / 2; rect.h = th / 2;
+   SDL_RenderCopyEx(renderer, tface, NULL, &rect, 30.0, NULL, SDL_FLIP_HORIZONTAL);
+
+   for (i = 0; i < 3; i++) {
+      verts[i].color.r = 255;
+      verts[i].color.g = (Uint8)(i * 100);
+      verts[i].color.b = 255;
+      verts[i].color.a = 255;
+      verts[i].tex_coord.x = (float)(i & 1);
+      verts[i].tex_coord.y = (float)(i >> 1);
+   }
+   verts[0].position.x = 10.0f; verts[0].position.y = 30.0f;
+   verts[1].position.x = 50.0f; verts[1].position.y = 35.0f;
+   verts[2].position.x = 20.0f; verts[2].position.y = 58.0f;
+   SDL_RenderGeometry(renderer, tface, verts, 3, indices, 3);
+
+   /* Render target contents are replayed too */
+   if (SDL_RenderTargetSupported(renderer)) {
+      target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 16, 16);
+      SDLTest_AssertCheck(target != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (target != NULL) {
+         SDL_SetRenderTarget(renderer, target);
+         SDL_SetRenderDrawColor(renderer, 255, 255, 0, SDL_ALPHA_OPAQUE);
+         SDL_RenderClear(renderer);
+         SDL_SetRenderTarget(renderer, NULL);
+         rect.x = 60; rect.y = 2; rect.w = 16; rect.h = 16;
+         SDL_RenderCopy(renderer, target, NULL, &rect);
+      }
+   }
+
+   rect.x = 0; rect.y = 0; rect.w = TESTRENDER_SCREEN_W; rect.h = TESTRENDER_SCREEN_H;
+   ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, expected, TESTRENDER_SCREEN_W*4);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+   /* The capture stops by itself after one frame */
+   SDL_RenderPresent(renderer);
+   ret = SDL_RenderStopCapture(renderer);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_RenderStopCapture after the last frame, expected: -1, got: %i", ret);
+
+   _clearScreen();
+   commands = 0;
+   ret = SDL_RenderReplayCapture(renderer, file, _countReplayedCommand, &commands);
+   SDLTest_AssertCheck(ret == 1, "Validate result from SDL_RenderReplayCapture, expected: 1, got: %i", ret);
+   SDLTest_AssertCheck(commands > 10, "Validate number of replayed commands, expected: >10, got: %i", commands);
+
+   ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, actual, TESTRENDER_SCREEN_W*4);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   mismatches = 0;
+   for (i = 0; i < TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H; i++) {
+      if (actual[i] != expected[i]) mismatches++;
+   }
+   SDLTest_AssertCheck(mismatches == 0, "Validate replayed frame, expected: 0 mismatches, got: %i", mismatches);
+
+   ret = SDL_RenderReplayCapture(renderer, "render_capture_missing.dat", NULL, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate replay of a missing file, expected: -1, got: %i", ret);
+
+   remove(file);
+   if (target != NULL) {
+      SDL_DestroyTexture(target);
+   }
+   SDL_DestroyTexture(tface);
+   SDL_free(pattern);
+   SDL_free(actual);
+   SDL_free(expected);
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Tests rotated and flipped copies against the exact texel mapping.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+render_testCopyEx(void *arg)
+{
+   const int tw = 6, th = 4;
+   const Uint32 background = 0xFF204060;
+   const int angles[4] = { 0, 90, 180, 270 };
+   const int cosines[4] = { 1, 0, -1, 0 };
+   const int sines[4] = { 0, 1, 0, -1 };
+   SDL_Texture *texture;
+   Uint32 pattern[6 * 4];
+   Uint32 *pixels;
+   SDL_Rect rect, dst;
+   SDL_Point center;
+   int ret, x, y, a, flip, mode, centered, failures, mismatches;
+
+   /* Unique colors, and texels that are either transparent or opaque */
+   for (y = 0; y < th; y++) {
+      for (x = 0; x < tw; x++) {
+         const Uint32 alpha = ((x + y) % 3 == 0) ? 0x00 : 0xFF;
+         pattern[y*tw + x] = (alpha << 24) | ((Uint32)(x*40 + 10) << 16) | ((Uint32)(y*60 + 10) << 8) | (Uint32)(x + y*tw);
+      }
+   }
+   texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, tw, th);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture == NULL) {
+      return TEST_ABORTED;
+   }
+   ret = SDL_UpdateTexture(texture, NULL, pattern, tw*4);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+
+   pixels = (Uint32 *)SDL_malloc(4*TESTRENDER_SCREEN_W*TESTRENDER_SCREEN_H);
+   SDLTest_AssertCheck(pixels != NULL, "Validate allocated temp pixel buffer");
+   if (pixels == NULL) {
+      SDL_DestroyTexture(texture);
+      return TEST_ABORTED;
+   }
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = TESTRENDER_SCREEN_W;
+   rect.h = TESTRENDER_SCREEN_H;
+   dst.x = 30;
+   dst.y = 20;
+   dst.w = tw;
+   dst.h = th;
+
+   failures = 0;
+   for (mode = 0; mode < 2; mode++) {
+      ret = SDL_SetTextureBlendMode(texture, mode ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetTextureBlendMode, expected: 0, got: %i", ret);
+      for (a = 0; a < 4; a++) {
+         for (flip = 0; flip < 4; flip++) {
+            for (centered = 0; centered < 2; centered++) {
+               /* Integer centers keep every destination pixel center on a texel center */
+               center.x = centered ? tw / 2 : 1;
+               center.y = centered ? th / 2 : 1;
+
+               SDL_SetRenderDrawColor(renderer, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE);
+               SDL_RenderClear(renderer);
+               ret = SDL_RenderCopyEx(renderer, texture, NULL, &dst, angles[a], &center, (SDL_RendererFlip)flip);
+               SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+               ret = SDL_RenderReadPixels(renderer, &rect, RENDER_COMPARE_FORMAT, pixels, TESTRENDER_SCREEN_W*4);
+               SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+
+               /* Map every pixel center back into the texture by rotating it the other way */
+               mismatches = 0;
+               for (y = 0; y < TESTRENDER_SCREEN_H; y++) {
+                  for (x = 0; x < TESTRENDER_SCREEN_W; x++) {
+                     const double dx = x + 0.5 - (dst.x + center.x);
+                     const double dy = y + 0.5 - (dst.y + center.y);
+                     const double u = center.x + dx*cosines[a] + dy*sines[a];
+                     const double v = center.y - dx*sines[a] + dy*cosines[a];
+                     Uint32 expected = background;
+                     if (u >= 0.0 && u < tw && v >= 0.0 && v < th) {
+                        int tx = (int)u;
+                        int ty = (int)v;
+                        if (flip & SDL_FLIP_HORIZONTAL) tx = tw - 1 - tx;
+                        if (flip & SDL_FLIP_VERTICAL) ty = th - 1 - ty;
+                        if (!mode || (pattern[ty*tw + tx] >> 24) != 0) {
+                           expected = pattern[ty*tw + tx];
+                        }
+                     }
+                     if ((pixels[y*TESTRENDER_SCREEN_W + x] & 0x00FFFFFF) != (expected & 0x00FFFFFF)) {
+                        mismatches++;
+                     }
+                  }
+               }
+               if (mismatches != 0) {
+                  SDLTest_LogError("RenderCopyEx with blend mode %i, angle %i, flip %i, center %i,%i: %i mismatched pixels",
+                                   mode, angles[a], flip, center.x, center.y, mismatches);
+                  failures++;
+               }
+            }
+         }
+      }
+   }
+   SDLTest_AssertCheck(failures == 0, "Validate rotated and flipped copies, expected: 0 failures, got: %i", failures);
+
+   SDL_free(pixels);
+   SDL_DestroyTexture(texture);
+
+   return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Tests renderer IDs and the text drawing cache that relies on them.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRendererID
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRendererFromID
+ */
+int
+render_testRendererID(void *arg)
+{
+   SDL_Surface *surface;
+   SDL_Renderer *other;
+   SDL_Renderer *renderers[10];
+   Uint32 id, otherID;
+   int i, ret;
+
+   id = SDL_GetRendererID(renderer);
+   SDLTest_AssertCheck(id != 0, "Validate SDL_GetRendererID, expected: non-zero, got: %u", (unsigned int)id);
+   SDLTest_AssertCheck(SDL_GetRendererFromID(id) == renderer, "Validate SDL_GetRendererFromID with a live renderer");
+   SDLTest_AssertCheck(SDL_GetRendererFromID(0) == NULL, "Validate SDL_GetRendererFromID(0), expected: NULL");
+
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+
+   /* More renderers than the text drawing cache holds, each one destroyed
+      after drawing, so addresses are likely reused by the next one */
+   for (i = 0; i < 20; i++) {
+      other = SDL_CreateSoftwareRenderer(surface);
+      SDLTest_AssertCheck(other != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+      if (other == NULL) {
+         break;
+      }
+      otherID = SDL_GetRendererID(other);
+      SDLTest_AssertCheck(otherID != 0 && otherID != id, "Validate a new renderer has a new ID, got: %u", (unsigned int)otherID);
+
+      ret = SDLTest_DrawString(other, 0, 0, "ID");
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_DrawString, expected: 0, got: %i", ret);
+      ret = SDLTest_DrawString(renderer, 0, 0, "ID");
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_DrawString, expected: 0, got: %i", ret);
+
+      SDL_DestroyRenderer(other);
+      SDLTest_AssertCheck(SDL_GetRendererFromID(otherID) == NULL, "Validate SDL_GetRendererFromID after SDL_DestroyRenderer, expected: NULL");
+   }
+
+   /* Text drawn on more renderers that still exist than the cache holds */
+   for (i = 0; i < SDL_arraysize(renderers); i++) {
+      renderers[i] = SDL_CreateSoftwareRenderer(surface);
+      if (renderers[i]) {
+         ret = SDLTest_DrawString(renderers[i], 0, 0, "ID");
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_DrawString, expected: 0, got: %i", ret);
+      }
+   }
+   for (i = 0; i < SDL_arraysize(renderers); i++) {
+      if (renderers[i]) {
+         SDL_DestroyRenderer(renderers[i]);
+      }
+   }
+
+   /* Only the atlas of the renderer still alive gets destroyed */
+   SDLTest_CleanupTextDrawing();
+   SDLTest_AssertPass("Call to SDLTest_CleanupTextDrawing()");
+   ret = SDLTest_DrawString(renderer, 0, 0, "ID");
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_DrawString after cleanup, expected: 0, got: %i", ret);
+
+   SDL_FreeSurface(surface);
+
+   return TEST_COMPLETED;
+}
+
+
 /**
  * @brief Blits doing color tests.
  *
@@ -1085,9 +1538,21 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testGeometry, "render_testGeometry", "Tests rendering geometry", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testCaptureReplay, "render_testCaptureReplay", "Tests capturing and replaying render commands", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testCopyEx, "render_testCopyEx", "Tests rotated and flipped copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest11 =
+        { (SDLTest_TestCaseFp)render_testRendererID, "render_testRendererID", "Tests renderer IDs and cached font textures", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, &renderTest11, NULL
 };
 
 /* Render test suite (global) */
@@ -1254,6 +1254,370 @@ sdltest_randomAsciiStringOfSize(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Calls to SDLTest_CompareSurfaces and SDLTest_CompareSurfacesWithDiff
+ */
+int
+sdltest_compareSurfaces(void *arg)
+{
+  const int w = 37, h = 5;
+  const int errorX[3] = { 3, 20, 36 };
+  const int errorY[3] = { 1, 2, 4 };
+  SDL_Surface *surface;
+  SDL_Surface *reference;
+  SDL_Surface *converted;
+  SDL_Surface *diff;
+  Uint32 *pixels;
+  int result;
+  SDL_bool saveImages;
+  int i;
+
+  surface = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  reference = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  SDLTest_AssertCheck(surface != NULL && reference != NULL, "Validate that surfaces were created");
+  if (surface == NULL || reference == NULL) {
+    SDL_FreeSurface(surface);
+    SDL_FreeSurface(reference);
+    return TEST_ABORTED;
+  }
+
+  /* Channels stay below 0xF0 so the errors added below can't overflow */
+  pixels = (Uint32 *)reference->pixels;
+  for (i = 0; i < w * h; i++) {
+    pixels[i] = SDLTest_RandomUint32() & 0xEFEFEFEF;
+  }
+  SDL_memcpy(surface->pixels, reference->pixels, reference->pitch * h);
+
+  /* Several comparisons below fail on purpose; don't leave their images behind */
+  saveImages = SDLTest_SetCompareSurfacesSaveImages(SDL_FALSE);
+
+  result = SDLTest_CompareSurfaces(surface, reference, 0);
+  SDLTest_AssertCheck(result == 0, "Validate result for identical surfaces, expected: 0, got: %i", result);
+
+  /* Alpha is not compared */
+  pixels = (Uint32 *)surface->pixels;
+  for (i = 0; i < w * h; i++) {
+    pixels[i] ^= 0xFF000000;
+  }
+  result = SDLTest_CompareSurfaces(surface, reference, 0);
+  SDLTest_AssertCheck(result == 0, "Validate result for surfaces differing in alpha, expected: 0, got: %i", result);
+
+  /* Three pixels with a squared RGB-difference of 100 */
+  for (i = 0; i < 3; i++) {
+    pixels[errorY[i] * w + errorX[i]] += 0x000A0000;
+  }
+  result = SDLTest_CompareSurfaces(surface, reference, 100);
+  SDLTest_AssertCheck(result == 0, "Validate result with allowable error 100, expected: 0, got: %i", result);
+  result = SDLTest_CompareSurfaces(surface, reference, 99);
+  SDLTest_AssertCheck(result == 3, "Validate result with allowable error 99, expected: 3, got: %i", result);
+
+  /* Same comparison against a reference in another format */
+  converted = SDL_ConvertSurfaceFormat(reference, SDL_PIXELFORMAT_ABGR8888, 0);
+  SDLTest_AssertCheck(converted != NULL, "Validate that reference was converted to ABGR8888");
+  if (converted != NULL) {
+    result = SDLTest_CompareSurfaces(surface, converted, 100);
+    SDLTest_AssertCheck(result == 0, "Validate result against ABGR8888 with allowable error 100, expected: 0, got: %i", result);
+    result = SDLTest_CompareSurfaces(surface, converted, 99);
+    SDLTest_AssertCheck(result == 3, "Validate result against ABGR8888 with allowable error 99, expected: 3, got: %i", result);
+    SDL_FreeSurface(converted);
+  }
+
+  /* Difference image */
+  diff = (SDL_Surface *)&diff;
+  result = SDLTest_CompareSurfacesWithDiff(surface, reference, 100, &diff);
+  SDLTest_AssertCheck(result == 0 && diff == NULL, "Validate that no difference image is created without errors, got: %i, %p", result, (void *)diff);
+  result = SDLTest_CompareSurfacesWithDiff(surface, reference, 99, &diff);
+  SDLTest_AssertCheck(result == 3 && diff != NULL, "Validate that a difference image is created with errors, got: %i, %p", result, (void *)diff);
+  if (diff != NULL) {
+    pixels = (Uint32 *)diff->pixels;
+    for (i = 0; i < 3; i++) {
+      SDLTest_AssertCheck(pixels[errorY[i] * (diff->pitch / 4) + errorX[i]] == 0xFFFF0000, "Validate that pixel %i,%i is marked", errorX[i], errorY[i]);
+    }
+    SDLTest_AssertCheck(pixels[0] != 0xFFFF0000, "Validate that pixel 0,0 is not marked");
+    SDL_FreeSurface(diff);
+  }
+
+  result = SDLTest_CompareSurfaces(NULL, reference, 0);
+  SDLTest_AssertCheck(result == -1, "Validate result for NULL surface, expected: -1, got: %i", result);
+
+  SDLTest_SetCompareSurfacesSaveImages(saveImages);
+
+  SDL_FreeSurface(surface);
+  SDL_FreeSurface(reference);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Calls to SDLTest_Crc32Calc and the SDLTest_Md5 functions
+ */
+int
+sdltest_crc32AndMd5(void *arg)
+{
+  const char *message = "The quick brown fox jumps over the lazy dog";
+  const char *expectedMd5 = "9e107d9d372bb6826bd81d3542a419d6";
+  const int lengths[] = { 0, 1, 7, 8, 15, 63, 64, 65, 200, 1023 };
+  SDLTest_Crc32Context crcContext;
+  SDLTest_Md5Context md5Context;
+  CrcUint32 crc, crcBytewise;
+  Uint8 buffer[1024 + 3];
+  char md5[33];
+  int result;
+  int i, j;
+
+  result = SDLTest_Crc32Init(&crcContext);
+  SDLTest_AssertCheck(result == 0, "Validate result from SDLTest_Crc32Init, expected: 0, got: %i", result);
+
+  result = SDLTest_Crc32Calc(&crcContext, (CrcUint8 *)"123456789", 9, &crc);
+  SDLTest_AssertCheck(result == 0 && crc == 0xCBF43926, "Validate CRC32 of check string, expected: 0xcbf43926, got: 0x%08x", crc);
+
+  /* Whole buffers take the fast paths, single bytes the table; both must agree */
+  for (i = 0; i < (int) sizeof(buffer); i++) {
+    buffer[i] = SDLTest_RandomUint8();
+  }
+  for (i = 0; i < (int) SDL_arraysize(lengths); i++) {
+    const int offset = i % 4;
+    SDLTest_Crc32Calc(&crcContext, buffer + offset, lengths[i], &crc);
+    SDLTest_Crc32CalcStart(&crcContext, &crcBytewise);
+    for (j = 0; j < lengths[i]; j++) {
+      SDLTest_Crc32CalcBuffer(&crcContext, buffer + offset + j, 1, &crcBytewise);
+    }
+    SDLTest_Crc32CalcEnd(&crcContext, &crcBytewise);
+    SDLTest_AssertCheck(crc == crcBytewise, "Validate CRC32 of %i bytes, expected: 0x%08x, got: 0x%08x", lengths[i], crcBytewise, crc);
+  }
+  SDLTest_Crc32Done(&crcContext);
+
+  /* Update in pieces that straddle the 64 byte blocks */
+  SDLTest_Md5Init(&md5Context);
+  for (i = 0; i < 3; i++) {
+    SDLTest_Md5Update(&md5Context, (unsigned char *)message, (unsigned int) SDL_strlen(message));
+  }
+  SDLTest_Md5Final(&md5Context);
+  SDL_memcpy(buffer, md5Context.digest, sizeof(md5Context.digest));
+  SDLTest_Md5Init(&md5Context);
+  for (i = 0; i < 3 * (int) SDL_strlen(message); i++) {
+    SDLTest_Md5Update(&md5Context, (unsigned char *)&message[i % SDL_strlen(message)], 1);
+  }
+  SDLTest_Md5Final(&md5Context);
+  SDLTest_AssertCheck(SDL_memcmp(buffer, md5Context.digest, sizeof(md5Context.digest)) == 0, "Validate that MD5 doesn't depend on how the input is split");
+
+  SDLTest_Md5Init(&md5Context);
+  SDLTest_Md5Update(&md5Context, (unsigned char *)message, (unsigned int) SDL_strlen(message));
+  SDLTest_Md5Final(&md5Context);
+  for (i = 0; i < 16; i++) {
+    SDL_snprintf(&md5[i * 2], 3, "%02x", md5Context.digest[i]);
+  }
+  /* MD5UINT4 is unsigned long; only 32-bit longs give the standard digest */
+  if (sizeof(MD5UINT4) == 4) {
+    SDLTest_AssertCheck(SDL_strcmp(md5, expectedMd5) == 0, "Validate MD5, expected: %s, got: %s", expectedMd5, md5);
+  } else {
+    SDLTest_Log("MD5 of check string: %s (standard digest is only expected with a 32-bit MD5UINT4)", md5);
+  }
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Calls to SDLTest_FastHash and SDLTest_HashSurface
+ */
+int
+sdltest_fastHash(void *arg)
+{
+  const char *message = "Nobody inspects the spammish repetition";
+  SDL_Surface *surface;
+  SDL_Surface *padded;
+  Uint64 hash, hash2;
+  int y;
+
+  hash = SDLTest_FastHash("", 0, 0);
+  SDLTest_AssertCheck(hash == 0xEF46DB3751D8E999ULL, "Validate hash of empty input, expected: 0xef46db3751d8e999, got: 0x%08x%08x", (Uint32)(hash >> 32), (Uint32)hash);
+  hash = SDLTest_FastHash(message, SDL_strlen(message), 0);
+  SDLTest_AssertCheck(hash == 0xFBCEA83C8A378BF1ULL, "Validate hash of message, expected: 0xfbcea83c8a378bf1, got: 0x%08x%08x", (Uint32)(hash >> 32), (Uint32)hash);
+  hash2 = SDLTest_FastHash(message, SDL_strlen(message), 1);
+  SDLTest_AssertCheck(hash != hash2, "Validate that the seed changes the hash");
+
+  /* Same pixels in surfaces with different pitch */
+  surface = SDLTest_ImageBlit();
+  SDLTest_AssertCheck(surface != NULL, "Validate that SDLTest_ImageBlit() returned a surface");
+  if (surface == NULL) {
+    return TEST_ABORTED;
+  }
+  padded = SDL_CreateRGBSurfaceWithFormat(0, surface->w + 3, surface->h, surface->format->BitsPerPixel, surface->format->format);
+  SDLTest_AssertCheck(padded != NULL, "Validate that padded surface was created");
+  if (padded != NULL) {
+    padded->w = surface->w;
+    for (y = 0; y < surface->h; y++) {
+      SDL_memcpy((Uint8 *)padded->pixels + y * padded->pitch, (Uint8 *)surface->pixels + y * surface->pitch, surface->w * surface->format->BytesPerPixel);
+    }
+    hash = SDLTest_HashSurface(surface);
+    hash2 = SDLTest_HashSurface(padded);
+    SDLTest_AssertCheck(hash == hash2, "Validate that the hash doesn't depend on the pitch");
+
+    ((Uint8 *)padded->pixels)[padded->pitch * 3 + 5] ^= 1;
+    hash2 = SDLTest_HashSurface(padded);
+    SDLTest_AssertCheck(hash != hash2, "Validate that changing a pixel changes the hash");
+    padded->w = surface->w + 3;
+    SDL_FreeSurface(padded);
+  }
+  SDL_FreeSurface(surface);
+
+  hash = SDLTest_HashSurface(NULL);
+  SDLTest_AssertCheck(hash == 0, "Validate hash of NULL surface, expected: 0, got: 0x%08x%08x", (Uint32)(hash >> 32), (Uint32)hash);
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * @brief Calls to SDLTest_DrawString and SDLTest_DrawScaledString
+ */
+int
+sdltest_drawString(void *arg)
+{
+  const char *text = "SDL_test 0123456789";
+  const int textWidth = (int) SDL_strlen(text) * FONT_CHARACTER_SIZE;
+  SDL_Surface *surface;
+  SDL_Surface *scaledSurface;
+  SDL_Renderer *renderer;
+  SDL_Renderer *scaledRenderer;
+  Uint32 pixel, scaledPixel;
+  int mismatches = 0;
+  int lit = 0;
+  int result;
+  int x, y;
+
+  surface = SDL_CreateRGBSurfaceWithFormat(0, textWidth, FONT_CHARACTER_SIZE, 32, SDL_PIXELFORMAT_ARGB8888);
+  scaledSurface = SDL_CreateRGBSurfaceWithFormat(0, textWidth * 2, FONT_CHARACTER_SIZE * 2, 32, SDL_PIXELFORMAT_ARGB8888);
+  renderer = surface ? SDL_CreateSoftwareRenderer(surface) : NULL;
+  SDLTest_AssertCheck(renderer != NULL && scaledSurface != NULL, "Validate that software renderer was created");
+  if (renderer == NULL || scaledSurface == NULL) {
+    SDL_FreeSurface(surface);
+    SDL_FreeSurface(scaledSurface);
+    return TEST_ABORTED;
+  }
+
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+  SDL_RenderClear(renderer);
+  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+  result = SDLTest_DrawString(renderer, 0, 0, text);
+  SDLTest_AssertCheck(result == 0, "Validate result from SDLTest_DrawString, expected: 0, got: %i", result);
+  SDL_RenderPresent(renderer);
+
+  /* The atlas belongs to the renderer */
+  SDLTest_CleanupTextDrawing();
+  SDL_DestroyRenderer(renderer);
+
+  scaledRenderer = SDL_CreateSoftwareRenderer(scaledSurface);
+  SDLTest_AssertCheck(scaledRenderer != NULL, "Validate that software renderer was created");
+  if (scaledRenderer != NULL) {
+    SDL_SetRenderDrawColor(scaledRenderer, 0, 0, 0, 255);
+    SDL_RenderClear(scaledRenderer);
+    SDL_SetRenderDrawColor(scaledRenderer, 255, 255, 255, 255);
+    result = SDLTest_DrawScaledString(scaledRenderer, 0, 0, text, 2.0f);
+    SDLTest_AssertCheck(result == 0, "Validate result from SDLTest_DrawScaledString, expected: 0, got: %i", result);
+    SDL_RenderPresent(scaledRenderer);
+
+    /* Each pixel becomes a 2x2 block */
+    for (y = 0; y < scaledSurface->h; y++) {
+      for (x = 0; x < scaledSurface->w; x++) {
+        pixel = ((Uint32 *)((Uint8 *)surface->pixels + (y / 2) * surface->pitch))[x / 2];
+        scaledPixel = ((Uint32 *)((Uint8 *)scaledSurface->pixels + y * scaledSurface->pitch))[x];
+        if (pixel != scaledPixel) {
+          mismatches++;
+        }
+        if (scaledPixel == 0xFFFFFFFF) {
+          lit++;
+        }
+      }
+    }
+    SDLTest_AssertCheck(lit > 0, "Validate that text was drawn, got %i lit pixels", lit);
+    SDLTest_AssertCheck(mismatches == 0, "Validate that scaled text matches unscaled text, got %i mismatches", mismatches);
+
+    result = SDLTest_DrawScaledString(scaledRenderer, 0, 0, text, 0.0f);
+    SDLTest_AssertCheck(result == -1, "Validate result from SDLTest_DrawScaledString with zero scale, expected: -1, got: %i", result);
+
+    SDLTest_CleanupTextDrawing();
+    SDL_DestroyRenderer(scaledRenderer);
+  }
+
+  SDL_FreeSurface(surface);
+  SDL_FreeSurface(scaledSurface);
+
+  return TEST_COMPLETED;
+}
+
+
+/**
+ * @brief Calls to SDLTest_RandomFill() and SDLTest_RandomBuffer()
+ */
+int
+sdltest_randomFill(void *arg)
+{
+  /* Sequences from SDLTest_RandomInit(0x12345678, 0x9abcdef0) */
+  static const Uint32 expectedValues[] = { 0x4E053420, 0x902AE1CE, 0xE4623ADF, 0x156C262F };
+  static const Uint8 expectedBytes[] = { 0xA8, 0x9E, 0xD8, 0xC4, 0xC1, 0x03, 0xE6, 0x99, 0xFD, 0x21, 0x54, 0x49 };
+  static const size_t sizes[] = { 1, 3, 31, 32, 33, 1000, 4096 + 7 };
+  SDLTest_RandomContext context1, context2;
+  Uint8 buffer1[4096 + 7], buffer2[4096 + 7];
+  Uint32 value;
+  int seen[256];
+  int fuzzerCount1, fuzzerCount2;
+  int missing;
+  int i;
+
+  /* The per value generator is unchanged, so exec keys stay reproducible */
+  SDLTest_RandomInit(&context1, 0x12345678, 0x9abcdef0);
+  for (i = 0; i < (int) SDL_arraysize(expectedValues); i++) {
+    value = SDLTest_Random(&context1);
+    SDLTest_AssertCheck(value == expectedValues[i], "Validate SDLTest_Random value %i, expected: 0x%08x, got: 0x%08x", i, expectedValues[i], value);
+  }
+
+  SDLTest_RandomInit(&context1, 0x12345678, 0x9abcdef0);
+  SDLTest_RandomFill(&context1, buffer1, sizeof(expectedBytes));
+  SDLTest_AssertPass("Call to SDLTest_RandomFill()");
+  SDLTest_AssertCheck(SDL_memcmp(buffer1, expectedBytes, sizeof(expectedBytes)) == 0, "Validate filled bytes match the expected sequence");
+
+  /* Same state gives the same bytes, and shorter fills are prefixes of longer ones */
+  SDLTest_RandomInit(&context2, 0x12345678, 0x9abcdef0);
+  SDLTest_RandomFill(&context2, buffer2, sizeof(buffer2));
+  for (i = 0; i < (int) SDL_arraysize(sizes); i++) {
+    SDL_memset(buffer1, 0, sizeof(buffer1));
+    SDLTest_RandomInit(&context1, 0x12345678, 0x9abcdef0);
+    SDLTest_RandomFill(&context1, buffer1, sizes[i]);
+    SDLTest_AssertCheck(SDL_memcmp(buffer1, buffer2, sizes[i]) == 0, "Validate fill of %i bytes matches", (int) sizes[i]);
+    SDLTest_AssertCheck(sizes[i] == sizeof(buffer1) || buffer1[sizes[i]] == 0, "Validate fill of %i bytes stops at the end of the buffer", (int) sizes[i]);
+  }
+
+  /* The context is advanced, so consecutive fills differ */
+  SDLTest_RandomFill(&context1, buffer1, sizeof(buffer1));
+  SDLTest_AssertCheck(SDL_memcmp(buffer1, buffer2, sizeof(buffer1)) != 0, "Validate consecutive fills differ");
+
+  SDL_zero(seen);
+  for (i = 0; i < (int) sizeof(buffer2); i++) {
+    seen[buffer2[i]]++;
+  }
+  missing = 0;
+  for (i = 0; i < (int) SDL_arraysize(seen); i++) {
+    if (seen[i] == 0) {
+      missing++;
+    }
+  }
+  SDLTest_AssertCheck(missing == 0, "Validate all byte values occur, %i missing", missing);
+
+  /* Degenerate calls leave the buffer alone */
+  SDLTest_RandomFill(NULL, buffer1, sizeof(buffer1));
+  SDLTest_RandomFill(&context1, NULL, sizeof(buffer1));
+  SDLTest_RandomFill(&context1, buffer1, 0);
+  SDLTest_AssertPass("Call to SDLTest_RandomFill() with invalid parameters");
+
+  fuzzerCount1 = SDLTest_GetFuzzerInvocationCount();
+  SDLTest_RandomBuffer(buffer1, sizeof(buffer1));
+  SDLTest_AssertPass("Call to SDLTest_RandomBuffer()");
+  fuzzerCount2 = SDLTest_GetFuzzerInvocationCount();
+  SDLTest_AssertCheck(fuzzerCount2 == fuzzerCount1 + 1, "Verify fuzzer invocation count, expected: %d, got: %d", fuzzerCount1 + 1, fuzzerCount2);
+
+  return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -1303,11 +1667,27 @@ static const SDLTest_TestCaseReference sdltestTest14 =
 static const SDLTest_TestCaseReference sdltestTest15 =
         { (SDLTest_TestCaseFp)sdltest_generateRunSeed, "sdltest_generateRunSeed", "Checks internal harness function SDLTest_GenerateRunSeed", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference sdltestTest16 =
+        { (SDLTest_TestCaseFp)sdltest_compareSurfaces, "sdltest_compareSurfaces", "Calls to surface comparison with and without difference image", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference sdltestTest17 =
+        { (SDLTest_TestCaseFp)sdltest_crc32AndMd5, "sdltest_crc32AndMd5", "Calls to CRC32 and MD5 checksums", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference sdltestTest18 =
+        { (SDLTest_TestCaseFp)sdltest_fastHash, "sdltest_fastHash", "Calls to fast hashing of buffers and surfaces", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference sdltestTest19 =
+        { (SDLTest_TestCaseFp)sdltest_drawString, "sdltest_drawString", "Calls to text drawing with and without scaling", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference sdltestTest20 =
+        { (SDLTest_TestCaseFp)sdltest_randomFill, "sdltest_randomFill", "Calls to bulk random buffer generators", TEST_ENABLED };
+
 /* Sequence of SDL_test test cases */
 static const SDLTest_TestCaseReference *sdltestTests[] =  {
     &sdltestTest1, &sdltestTest2, &sdltestTest3, &sdltestTest4, &sdltestTest5, &sdltestTest6,
     &sdltestTest7, &sdltestTest8, &sdltestTest9, &sdltestTest10, &sdltestTest11, &sdltestTest12,
-    &sdltestTest13, &sdltestTest14, &sdltestTest15, NULL
+    &sdltestTest13, &sdltestTest14, &sdltestTest15, &sdltestTest16,
+    &sdltestTest17, &sdltestTest18, &sdltestTest19, &sdltestTest20, NULL
 };
 
 /* SDL_test test suite (global) */
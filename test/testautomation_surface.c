@@ -589,6 +589,168 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/* Check that every pixel of dst matches the palette color of its source index */
+static int
+_checkPaletteBlit(SDL_Surface *src, SDL_Surface *dst, int dstx)
+{
+   int x, y;
+   int mismatches = 0;
+
+   for (y = 0; y < src->h; y++) {
+      for (x = 0; x < src->w; x++) {
+         const Uint8 index = ((Uint8 *)src->pixels)[y * src->pitch + x];
+         const SDL_Color *color = &src->format->palette->colors[index];
+         const Uint8 *pixel = (Uint8 *)dst->pixels + y * dst->pitch + (x + dstx) * dst->format->BytesPerPixel;
+         Uint32 value;
+
+         switch (dst->format->BytesPerPixel) {
+         case 1: value = *pixel; break;
+         case 2: value = *(Uint16 *)pixel; break;
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+         case 3: value = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16); break;
+#else
+         case 3: value = (pixel[0] << 16) | (pixel[1] << 8) | pixel[2]; break;
+#endif
+         default: value = *(Uint32 *)pixel; break;
+         }
+         if (value != SDL_MapRGB(dst->format, color->r, color->g, color->b)) {
+            mismatches++;
+         }
+      }
+   }
+   return mismatches;
+}
+
+/**
+ * @brief Tests that palette changes on the source surface show up in later blits.
+ */
+int
+surface_testBlitPaletteChange(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 };
+   SDL_Surface *src;
+   SDL_Color colors[256];
+   SDL_Rect dstrect;
+   int i, f, ret;
+
+   src = SDL_CreateRGBSurfaceWithFormat(0, 13, 3, 8, SDL_PIXELFORMAT_INDEX8);
+   SDLTest_AssertCheck(src != NULL, "Verify 8-bit source surface is not NULL");
+   if (src == NULL) {
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 256; i++) {
+      colors[i].r = (Uint8) i;
+      colors[i].g = (Uint8) (255 - i);
+      colors[i].b = (Uint8) (i * 7);
+      colors[i].a = 255;
+   }
+   SDL_SetPaletteColors(src->format->palette, colors, 0, 256);
+   for (i = 0; i < src->h * src->pitch; i++) {
+      ((Uint8 *)src->pixels)[i] = (Uint8) (i * 5);
+   }
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+      SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, 16, 3, 32, formats[f]);
+      SDLTest_AssertCheck(dst != NULL, "Verify %s destination surface is not NULL", SDL_GetPixelFormatName(formats[f]));
+      if (dst == NULL) {
+         continue;
+      }
+      if (dst->format->palette) {
+         /* Same colors in a different order, so the blit has to remap */
+         for (i = 0; i < 256; i++) {
+            SDL_SetPaletteColors(dst->format->palette, &colors[255 - i], i, 1);
+         }
+      }
+
+      /* Odd offset and width to exercise unaligned and leftover pixels */
+      dstrect.x = 1;
+      dstrect.y = 0;
+      ret = SDL_BlitSurface(src, NULL, dst, &dstrect);
+      SDLTest_AssertCheck(ret == 0, "Verify result from blit, expected: 0, got: %i", ret);
+      ret = _checkPaletteBlit(src, dst, 1);
+      SDLTest_AssertCheck(ret == 0, "Verify %s pixels, expected: 0 mismatches, got: %i", SDL_GetPixelFormatName(formats[f]), ret);
+
+      /* Cycle part of the palette and blit again */
+      for (i = 10; i < 20; i++) {
+         SDL_Color color = colors[(i + 100) & 255];
+         SDL_SetPaletteColors(src->format->palette, &color, i, 1);
+      }
+      ret = SDL_BlitSurface(src, NULL, dst, &dstrect);
+      SDLTest_AssertCheck(ret == 0, "Verify result from blit after palette change, expected: 0, got: %i", ret);
+      ret = _checkPaletteBlit(src, dst, 1);
+      SDLTest_AssertCheck(ret == 0, "Verify %s pixels after palette change, expected: 0 mismatches, got: %i", SDL_GetPixelFormatName(formats[f]), ret);
+
+      SDL_SetPaletteColors(src->format->palette, colors, 0, 256);
+      SDL_FreeSurface(dst);
+   }
+
+   /* A 16-bit destination whose pitch isn't a multiple of 4 alternates row alignment */
+   {
+      Uint16 pixels[3 * 17];
+      SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormatFrom(pixels, 16, 3, 16, 17 * sizeof(Uint16), SDL_PIXELFORMAT_RGB565);
+      SDLTest_AssertCheck(dst != NULL, "Verify destination surface with odd pitch is not NULL");
+      if (dst != NULL) {
+         for (dstrect.x = 0; dstrect.x < 2; dstrect.x++) {
+            SDL_memset(pixels, 0, sizeof(pixels));
+            ret = SDL_BlitSurface(src, NULL, dst, &dstrect);
+            SDLTest_AssertCheck(ret == 0, "Verify result from blit to odd pitch, expected: 0, got: %i", ret);
+            ret = _checkPaletteBlit(src, dst, dstrect.x);
+            SDLTest_AssertCheck(ret == 0, "Verify pixels with odd pitch at x=%i, expected: 0 mismatches, got: %i", dstrect.x, ret);
+         }
+         SDL_FreeSurface(dst);
+      }
+   }
+
+   SDL_FreeSurface(src);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that recycled surface memory comes back cleared and that SDL_HINT_SURFACE_SIMD_PITCH aligns rows.
+ */
+int
+surface_testRecycledPixels(void *arg)
+{
+   const int align = (int) SDL_SIMDGetAlignment();
+   SDL_Surface *surface;
+   int i, dirty;
+
+   /* Dirty a surface, free it, and ask for another one just like it */
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 33, 17, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   SDL_memset(surface->pixels, 0xAA, surface->h * surface->pitch);
+   SDL_FreeSurface(surface);
+
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 33, 17, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(surface != NULL, "Verify second surface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   dirty = 0;
+   for (i = 0; i < surface->h * surface->pitch; i++) {
+      dirty += (((Uint8 *)surface->pixels)[i] != 0);
+   }
+   SDLTest_AssertCheck(dirty == 0, "Verify new surface is cleared, expected: 0 dirty bytes, got: %i", dirty);
+   SDL_FreeSurface(surface);
+
+   SDL_SetHint(SDL_HINT_SURFACE_SIMD_PITCH, "1");
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 33, 17, 24, SDL_PIXELFORMAT_RGB24);
+   SDL_SetHint(SDL_HINT_SURFACE_SIMD_PITCH, NULL);
+   SDLTest_AssertCheck(surface != NULL, "Verify SIMD pitch surface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   SDLTest_AssertCheck((surface->pitch % align) == 0, "Verify pitch is a multiple of %i, got: %i", align, surface->pitch);
+   SDLTest_AssertCheck((((size_t) surface->pixels) % align) == 0, "Verify pixels are aligned to %i bytes", align);
+   SDL_FreeSurface(surface);
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -631,11 +793,17 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitPaletteChange, "surface_testBlitPaletteChange", "Tests blitting from an 8-bit surface whose palette changes.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testRecycledPixels, "surface_testRecycledPixels", "Tests reuse of freed surface memory and SIMD aligned pitches.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, NULL
 };
 
 /* Surface test suite (global) */
@@ -1720,6 +1720,105 @@ video_getSetWindowData(void *arg)
   return returnValue;
 }
 
+/**
+ * @brief Tests full and incremental window shape updates
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_SetWindowShape
+ */
+int
+video_updateWindowShapeRect(void *arg)
+{
+  const char* title = "video_updateWindowShapeRect Test Window";
+  SDL_Window* window;
+  SDL_Surface* shape;
+  SDL_WindowShapeMode mode;
+  SDL_Rect rect;
+  int result;
+  int y;
+
+  shape = SDL_CreateRGBSurfaceWithFormat(0, 64, 48, 32, SDL_PIXELFORMAT_ARGB8888);
+  SDLTest_AssertCheck(shape != NULL, "Validate that shape surface is not NULL");
+  if (shape == NULL) return TEST_ABORTED;
+  SDL_FillRect(shape, NULL, 0x00000000);
+
+  /* Plain windows can't be shaped */
+  window = _createVideoSuiteTestWindow(title);
+  if (window != NULL) {
+    result = SDL_SetWindowShape(window, shape, NULL);
+    SDLTest_AssertPass("Call to SDL_SetWindowShape(plainWindow,...)");
+    SDLTest_AssertCheck(result == SDL_NONSHAPEABLE_WINDOW, "Verify result, expected: %d, got: %d", SDL_NONSHAPEABLE_WINDOW, result);
+    result = SDL_UpdateWindowShapeRect(window, shape, NULL);
+    SDLTest_AssertPass("Call to SDL_UpdateWindowShapeRect(plainWindow,...)");
+    SDLTest_AssertCheck(result == SDL_NONSHAPEABLE_WINDOW, "Verify result, expected: %d, got: %d", SDL_NONSHAPEABLE_WINDOW, result);
+    _destroyVideoSuiteTestWindow(window);
+  }
+  result = SDL_UpdateWindowShapeRect(NULL, shape, NULL);
+  SDLTest_AssertPass("Call to SDL_UpdateWindowShapeRect(NULL,...)");
+  SDLTest_AssertCheck(result == SDL_NONSHAPEABLE_WINDOW, "Verify result, expected: %d, got: %d", SDL_NONSHAPEABLE_WINDOW, result);
+
+  window = SDL_CreateShapedWindow(title, 0, 0, shape->w, shape->h, 0);
+  SDLTest_AssertPass("Call to SDL_CreateShapedWindow()");
+  if (window == NULL) {
+    SDLTest_Log("Shaped windows are not supported by the %s video driver", SDL_GetCurrentVideoDriver());
+    SDL_FreeSurface(shape);
+    return TEST_SKIPPED;
+  }
+
+  result = SDL_UpdateWindowShapeRect(window, NULL, NULL);
+  SDLTest_AssertPass("Call to SDL_UpdateWindowShapeRect(...,NULL,...)");
+  SDLTest_AssertCheck(result == SDL_INVALID_SHAPE_ARGUMENT, "Verify result, expected: %d, got: %d", SDL_INVALID_SHAPE_ARGUMENT, result);
+
+  /* Without a shape, the first update sets the whole thing */
+  result = SDL_GetShapedWindowMode(window, NULL);
+  SDLTest_AssertCheck(result == SDL_WINDOW_LACKS_SHAPE, "Verify window lacks a shape, expected: %d, got: %d", SDL_WINDOW_LACKS_SHAPE, result);
+  rect.x = 8;
+  rect.y = 8;
+  rect.w = 32;
+  rect.h = 16;
+  SDL_FillRect(shape, &rect, 0xFFFFFFFF);
+  result = SDL_UpdateWindowShapeRect(window, shape, &rect);
+  SDLTest_AssertPass("Call to SDL_UpdateWindowShapeRect() without a shape");
+  SDLTest_AssertCheck(result == 0, "Verify result, expected: 0, got: %d", result);
+  result = SDL_GetShapedWindowMode(window, &mode);
+  SDLTest_AssertCheck(result == 0, "Verify window has a shape, expected: 0, got: %d", result);
+  SDLTest_AssertCheck(mode.mode == ShapeModeDefault, "Verify shape mode, expected: %d, got: %d", ShapeModeDefault, mode.mode);
+
+  /* Grow the opaque area, with rectangles that do and don't change the shape */
+  for (y = 0; y < shape->h; y += 8) {
+    rect.x = y;
+    rect.y = y;
+    rect.w = 8;
+    rect.h = 8;
+    SDL_FillRect(shape, &rect, 0xFFFFFFFF);
+    result = SDL_UpdateWindowShapeRect(window, shape, &rect);
+    SDLTest_AssertCheck(result == 0, "Verify update of %d,%d %dx%d, expected: 0, got: %d", rect.x, rect.y, rect.w, rect.h, result);
+    result = SDL_UpdateWindowShapeRect(window, shape, &rect);
+    SDLTest_AssertCheck(result == 0, "Verify unchanged update of %d,%d %dx%d, expected: 0, got: %d", rect.x, rect.y, rect.w, rect.h, result);
+  }
+
+  /* Rectangles are clipped to the shape */
+  rect.x = shape->w - 4;
+  rect.y = -4;
+  rect.w = 16;
+  rect.h = 16;
+  result = SDL_UpdateWindowShapeRect(window, shape, &rect);
+  SDLTest_AssertCheck(result == 0, "Verify update of partially outside rectangle, expected: 0, got: %d", result);
+  rect.x = shape->w;
+  rect.y = 0;
+  result = SDL_UpdateWindowShapeRect(window, shape, &rect);
+  SDLTest_AssertCheck(result == 0, "Verify update of rectangle outside the shape, expected: 0, got: %d", result);
+
+  /* The whole surface is checked when no rectangle is given */
+  SDL_FillRect(shape, NULL, 0xFFFFFFFF);
+  result = SDL_UpdateWindowShapeRect(window, shape, NULL);
+  SDLTest_AssertCheck(result == 0, "Verify update of the whole shape, expected: 0, got: %d", result);
+
+  SDL_DestroyWindow(window);
+  SDL_FreeSurface(shape);
+
+  return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -1793,13 +1892,16 @@ static const SDLTest_TestCaseReference videoTest22 =
 static const SDLTest_TestCaseReference videoTest23 =
         { (SDLTest_TestCaseFp)video_getSetWindowData, "video_getSetWindowData",  "Checks SDL_SetWindowData and SDL_GetWindowData positive and negative cases", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference videoTest24 =
+        { (SDLTest_TestCaseFp)video_updateWindowShapeRect, "video_updateWindowShapeRect",  "Checks SDL_SetWindowShape and SDL_UpdateWindowShapeRect full and incremental updates", TEST_ENABLED };
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] =  {
     &videoTest1, &videoTest2, &videoTest3, &videoTest4, &videoTest5, &videoTest6,
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
     &videoTest18, &videoTest19, &videoTest20, &videoTest21, &videoTest22,
-    &videoTest23, NULL
+    &videoTest23, &videoTest24, NULL
 };
 
 /* Video test suite (global) */
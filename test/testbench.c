@@ -0,0 +1,289 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Microbenchmarks for a few hot paths: surface fills and blits, audio
+   conversion, the event queue and YUV conversion. Save a run with --save
+   and compare a later one against it with --baseline; the program exits
+   with 1 if anything got slower than the threshold allows. */
+
+#include "SDL.h"
+#include "SDL_test.h"
+
+#define WIDTH   640
+#define HEIGHT  480
+
+typedef struct
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+} SurfacePair;
+
+typedef struct
+{
+    SDL_AudioCVT cvt;
+    Uint8 *input;
+} AudioState;
+
+typedef struct
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    int src_pitch;
+    int dst_pitch;
+    void *src;
+    void *dst;
+} PixelsState;
+
+static void
+FillSurface(SDL_Surface *surface)
+{
+    Uint8 *pixels = (Uint8 *) surface->pixels;
+    int i;
+
+    /* A pattern with varying alpha, so blending can't take shortcuts */
+    for (i = 0; i < surface->pitch * surface->h; i++) {
+        pixels[i] = (Uint8) (i * 31 + (i >> 8));
+    }
+}
+
+static void
+BenchmarkFillRect(void *arg, int iterations)
+{
+    SDL_Surface *surface = (SDL_Surface *) arg;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        SDL_FillRect(surface, NULL, (Uint32) i);
+    }
+}
+
+static void
+BenchmarkBlit(void *arg, int iterations)
+{
+    SurfacePair *pair = (SurfacePair *) arg;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        SDL_BlitSurface(pair->src, NULL, pair->dst, NULL);
+    }
+}
+
+static void
+BenchmarkConvertAudio(void *arg, int iterations)
+{
+    AudioState *state = (AudioState *) arg;
+    int i;
+
+    /* Conversion happens in place, so start from the original input each time */
+    for (i = 0; i < iterations; i++) {
+        SDL_memcpy(state->cvt.buf, state->input, state->cvt.len);
+        SDL_ConvertAudio(&state->cvt);
+    }
+}
+
+static void
+BenchmarkEvents(void *arg, int iterations)
+{
+    SDL_Event event;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        SDL_zero(event);
+        event.type = SDL_USEREVENT;
+        event.user.code = i;
+        SDL_PushEvent(&event);
+        SDL_PollEvent(&event);
+    }
+}
+
+static void
+BenchmarkConvertPixels(void *arg, int iterations)
+{
+    PixelsState *state = (PixelsState *) arg;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        SDL_ConvertPixels(WIDTH, HEIGHT, state->src_format, state->src, state->src_pitch,
+                          state->dst_format, state->dst, state->dst_pitch);
+    }
+}
+
+static void
+RunSurfaceBenchmarks(SDLTest_BenchmarkContext *context)
+{
+    SDL_Surface *argb = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *argb2 = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *rgb565 = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 16, SDL_PIXELFORMAT_RGB565);
+    SurfacePair pair;
+
+    if (!argb || !argb2 || !rgb565) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+    } else {
+        FillSurface(argb);
+        FillSurface(rgb565);
+
+        SDLTest_RunBenchmark(context, "SDL_FillRect ARGB8888", BenchmarkFillRect, argb2);
+
+        pair.src = argb;
+        pair.dst = argb2;
+        SDL_SetSurfaceBlendMode(argb, SDL_BLENDMODE_NONE);
+        SDLTest_RunBenchmark(context, "SDL_BlitSurface copy ARGB8888", BenchmarkBlit, &pair);
+
+        SDL_SetSurfaceBlendMode(argb, SDL_BLENDMODE_BLEND);
+        SDLTest_RunBenchmark(context, "SDL_BlitSurface blend ARGB8888", BenchmarkBlit, &pair);
+
+        pair.src = rgb565;
+        SDLTest_RunBenchmark(context, "SDL_BlitSurface RGB565 to ARGB8888", BenchmarkBlit, &pair);
+    }
+
+    SDL_FreeSurface(rgb565);
+    SDL_FreeSurface(argb2);
+    SDL_FreeSurface(argb);
+}
+
+static void
+RunAudioBenchmarks(SDLTest_BenchmarkContext *context)
+{
+    const int frames = 4096;
+    AudioState state;
+    Sint16 *samples;
+    int i;
+
+    SDL_zero(state);
+    if (SDL_BuildAudioCVT(&state.cvt, AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't build audio converter: %s\n", SDL_GetError());
+        return;
+    }
+
+    state.cvt.len = frames * 2 * sizeof (Sint16);
+    state.cvt.buf = (Uint8 *) SDL_malloc(state.cvt.len * state.cvt.len_mult);
+    state.input = (Uint8 *) SDL_malloc(state.cvt.len);
+    if (state.cvt.buf && state.input) {
+        samples = (Sint16 *) state.input;
+        for (i = 0; i < frames * 2; i++) {
+            samples[i] = (Sint16) (SDL_sin(i * 0.01) * 30000.0);
+        }
+        SDLTest_RunBenchmark(context, "SDL_ConvertAudio S16 44100 to F32 48000", BenchmarkConvertAudio, &state);
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+    }
+
+    SDL_free(state.input);
+    SDL_free(state.cvt.buf);
+}
+
+static void
+RunPixelsBenchmarks(SDLTest_BenchmarkContext *context)
+{
+    const int yuv_size = WIDTH * HEIGHT + 2 * ((WIDTH + 1) / 2) * ((HEIGHT + 1) / 2);
+    Uint8 *yuv = (Uint8 *) SDL_malloc(yuv_size);
+    Uint8 *rgb = (Uint8 *) SDL_malloc(WIDTH * HEIGHT * 4);
+    PixelsState state;
+    int i;
+
+    if (yuv && rgb) {
+        for (i = 0; i < yuv_size; i++) {
+            yuv[i] = (Uint8) (i * 7);
+        }
+        for (i = 0; i < WIDTH * HEIGHT * 4; i++) {
+            rgb[i] = (Uint8) (i * 13);
+        }
+
+        state.src_format = SDL_PIXELFORMAT_IYUV;
+        state.src = yuv;
+        state.src_pitch = WIDTH;
+        state.dst_format = SDL_PIXELFORMAT_ARGB8888;
+        state.dst = rgb;
+        state.dst_pitch = WIDTH * 4;
+        SDLTest_RunBenchmark(context, "SDL_ConvertPixels IYUV to ARGB8888", BenchmarkConvertPixels, &state);
+
+        state.src_format = SDL_PIXELFORMAT_ARGB8888;
+        state.src = rgb;
+        state.src_pitch = WIDTH * 4;
+        state.dst_format = SDL_PIXELFORMAT_NV12;
+        state.dst = yuv;
+        state.dst_pitch = WIDTH;
+        SDLTest_RunBenchmark(context, "SDL_ConvertPixels ARGB8888 to NV12", BenchmarkConvertPixels, &state);
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+    }
+
+    SDL_free(rgb);
+    SDL_free(yuv);
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDLTest_BenchmarkContext context;
+    const char *baseline = NULL;
+    const char *save = NULL;
+    int regressions = 0;
+    int cpu = -1;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    SDLTest_BenchmarkInit(&context);
+
+    for (i = 1; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--baseline") == 0 && argv[i + 1]) {
+            baseline = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--save") == 0 && argv[i + 1]) {
+            save = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--cpu") == 0 && argv[i + 1]) {
+            cpu = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--filter") == 0 && argv[i + 1]) {
+            context.filter = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--samples") == 0 && argv[i + 1]) {
+            context.samples = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--threshold") == 0 && argv[i + 1]) {
+            context.threshold = SDL_atof(argv[++i]) / 100.0;
+        } else {
+            SDL_Log("Usage: %s [--baseline file] [--save file] [--cpu #] [--filter name] [--samples #] [--threshold percent]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) == -1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    if (cpu >= 0) {
+        SDLTest_BenchmarkPinThread(cpu);
+    }
+    if (baseline && SDLTest_BenchmarkLoadBaseline(&context, baseline) < 0) {
+        SDL_Quit();
+        return 1;
+    }
+
+    RunSurfaceBenchmarks(&context);
+    RunAudioBenchmarks(&context);
+    SDLTest_RunBenchmark(&context, "SDL_PushEvent and SDL_PollEvent", BenchmarkEvents, NULL);
+    RunPixelsBenchmarks(&context);
+
+    if (save) {
+        SDLTest_BenchmarkSave(&context, save);
+    }
+    if (baseline) {
+        regressions = SDLTest_BenchmarkRegressions(&context);
+        SDL_Log("%d regression%s\n", regressions, (regressions == 1) ? "" : "s");
+    }
+
+    SDLTest_BenchmarkQuit(&context);
+    SDL_Quit();
+    return (regressions > 0) ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
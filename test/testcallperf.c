@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures what it costs to call into SDL for a few small, hot functions.
+   Compare a regular build against one configured with DYNAPI_DIRECT to see
+   how much the dynamic API jump table adds to each call. */
+
+#include "SDL.h"
+
+#define CALLS 10000000
+
+static int SDLCALL
+LocalCall(SDL_atomic_t *a)
+{
+    return a->value;
+}
+
+/* Called through a volatile pointer so the compiler can't inline it */
+static int (SDLCALL *volatile local_call)(SDL_atomic_t *a) = LocalCall;
+
+static double
+NanosecondsPerCall(Uint64 start, int calls)
+{
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return ((double) elapsed * 1000000000.0) / ((double) SDL_GetPerformanceFrequency() * calls);
+}
+
+static void
+BenchmarkAtomics(void)
+{
+    SDL_atomic_t a;
+    Uint64 start;
+    int sum = 0;
+    int i;
+
+    SDL_AtomicSet(&a, 1);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < CALLS; i++) {
+        sum += local_call(&a);
+    }
+    SDL_Log("%-24s %6.2f ns/call\n", "local function", NanosecondsPerCall(start, CALLS));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < CALLS; i++) {
+        sum += SDL_AtomicGet(&a);
+    }
+    SDL_Log("%-24s %6.2f ns/call\n", "SDL_AtomicGet", NanosecondsPerCall(start, CALLS));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < CALLS; i++) {
+        sum += SDL_AtomicAdd(&a, 1);
+    }
+    SDL_Log("%-24s %6.2f ns/call\n", "SDL_AtomicAdd", NanosecondsPerCall(start, CALLS));
+
+    if (sum == 0) {
+        SDL_Log("Unexpected sum\n");
+    }
+}
+
+static void
+BenchmarkEvents(void)
+{
+    const int calls = CALLS / 10;
+    SDL_Event event;
+    Uint64 start;
+    int i;
+
+    /* An empty queue, so this is mostly the cost of getting there */
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < calls; i++) {
+        SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+    }
+    SDL_Log("%-24s %6.2f ns/call\n", "SDL_PeepEvents", NanosecondsPerCall(start, calls));
+}
+
+static void
+BenchmarkRenderCopy(void)
+{
+    const int calls = CALLS / 10;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *renderer = surface ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    SDL_Texture *texture = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1) : NULL;
+    const SDL_Rect dst = { 0, 0, 1, 1 };
+    Uint64 start;
+    int i;
+
+    if (!texture) {
+        SDL_Log("Couldn't create a software renderer: %s\n", SDL_GetError());
+    } else {
+        /* Commands are batched, flush now and then so the queue stays small */
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i < calls; i++) {
+            SDL_RenderCopy(renderer, texture, NULL, &dst);
+            if ((i & 1023) == 1023) {
+                SDL_RenderFlush(renderer);
+            }
+        }
+        SDL_Log("%-24s %6.2f ns/call\n", "SDL_RenderCopy (1x1)", NanosecondsPerCall(start, calls));
+    }
+
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    SDL_FreeSurface(surface);
+}
+
+int
+main(int argc, char **argv)
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_EVENTS) == -1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    BenchmarkAtomics();
+    BenchmarkEvents();
+    BenchmarkRenderCopy();
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -25,6 +25,122 @@ widelen(char *data)
     return len;
 }
 
+#define BENCHMARK_BYTES (16 * 1024 * 1024)
+
+/* Converts all of inbuf in one call and returns the number of bytes written */
+static size_t
+convert(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft,
+        char *outbuf, size_t outbytesleft)
+{
+    SDL_iconv_t cd = SDL_iconv_open(tocode, fromcode);
+    const size_t outlen = outbytesleft;
+
+    if (cd == (SDL_iconv_t) -1) {
+        return 0;
+    }
+    SDL_iconv(cd, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+    SDL_iconv_close(cd);
+    return outlen - outbytesleft;
+}
+
+static double
+seconds_since(Uint64 start)
+{
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static int
+benchmark(const char *name, const char *text, size_t len, const char *encoding)
+{
+    const double megabytes = len / (1024.0 * 1024.0);
+    char *wide = (char *) SDL_malloc(len * 4);
+    char *utf8 = (char *) SDL_malloc(len);
+    size_t widelen, utf8len;
+    double to, from;
+    Uint64 start;
+
+    if (!wide || !utf8) {
+        SDL_free(wide);
+        SDL_free(utf8);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        return 1;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    widelen = convert(encoding, "UTF-8", text, len, wide, len * 4);
+    to = seconds_since(start);
+
+    start = SDL_GetPerformanceCounter();
+    utf8len = convert("UTF-8", encoding, wide, widelen, utf8, len);
+    from = seconds_since(start);
+
+    SDL_Log("%-6s UTF-8 -> %-8s %8.1f MB/s, back %8.1f MB/s\n",
+            name, encoding, megabytes / to, megabytes / from);
+
+    if (utf8len != len || SDL_memcmp(utf8, text, len) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FAIL: %s round trip through %s\n", name, encoding);
+        SDL_free(wide);
+        SDL_free(utf8);
+        return 1;
+    }
+    SDL_free(wide);
+    SDL_free(utf8);
+    return 0;
+}
+
+/* Measures conversion throughput for ASCII and for mixed-script text */
+static int
+run_benchmarks(void)
+{
+    static const char *mixed[] = {
+        "The quick brown fox jumps over the lazy dog. ",
+        "\xce\x93\xce\xb1\xce\xb6\xce\xad\xce\xb5\xcf\x82 ",   /* Greek */
+        "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e ",                 /* Japanese */
+        "\xf0\x9f\x98\x80 "                                      /* Emoji */
+    };
+    static const char *encodings[] = { "UTF-16LE", "UTF-32LE", "UCS-4" };
+    char *ascii = (char *) SDL_malloc(BENCHMARK_BYTES);
+    char *text = (char *) SDL_malloc(BENCHMARK_BYTES);
+    size_t asciilen = 0, textlen = 0;
+    int i, errors = 0;
+
+    if (!ascii || !text) {
+        SDL_free(ascii);
+        SDL_free(text);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        return 1;
+    }
+
+    for (i = 0; ; i = (i + 1) % SDL_arraysize(mixed)) {
+        const size_t len = SDL_strlen(mixed[i]);
+        if (textlen + len > BENCHMARK_BYTES) {
+            break;
+        }
+        SDL_memcpy(text + textlen, mixed[i], len);
+        textlen += len;
+    }
+    for (;;) {
+        const size_t len = SDL_strlen(mixed[0]);
+        if (asciilen + len > BENCHMARK_BYTES) {
+            break;
+        }
+        SDL_memcpy(ascii + asciilen, mixed[0], len);
+        asciilen += len;
+    }
+
+    errors += benchmark("ASCII", ascii, asciilen, "ASCII");
+    for (i = 0; i < SDL_arraysize(encodings); ++i) {
+        errors += benchmark("ASCII", ascii, asciilen, encodings[i]);
+    }
+    for (i = 0; i < SDL_arraysize(encodings); ++i) {
+        errors += benchmark("mixed", text, textlen, encodings[i]);
+    }
+
+    SDL_free(ascii);
+    SDL_free(text);
+    return errors;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -52,6 +168,11 @@ main(int argc, char *argv[])
     /* Enable standard application logging */
     SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
 
+    if (argv[1] && SDL_strcmp(argv[1], "--benchmark") == 0) {
+        errors = run_benchmarks();
+        return (errors ? errors + 1 : 0);
+    }
+
     if (!argv[1]) {
         argv[1] = "utf8.txt";
     }
@@ -369,6 +369,9 @@ TestCPUInfo(SDL_bool verbose)
     if (verbose) {
         SDL_Log("CPU count: %d\n", SDL_GetCPUCount());
         SDL_Log("CPU cache line size: %d\n", SDL_GetCPUCacheLineSize());
+        SDL_Log("CPU cache sizes: L1 %d, L2 %d, L3 %d\n", SDL_GetCPUCacheSize(1), SDL_GetCPUCacheSize(2), SDL_GetCPUCacheSize(3));
+        SDL_Log("CPU physical cores: %d (%d threads per core, %d efficiency cores)\n",
+                SDL_GetCPUPhysicalCoreCount(), SDL_GetCPUThreadsPerCore(), SDL_GetCPUEfficiencyCoreCount());
         SDL_Log("RDTSC %s\n", SDL_HasRDTSC()? "detected" : "not detected");
         SDL_Log("AltiVec %s\n", SDL_HasAltiVec()? "detected" : "not detected");
         SDL_Log("MMX %s\n", SDL_HasMMX()? "detected" : "not detected");
@@ -383,6 +386,11 @@ TestCPUInfo(SDL_bool verbose)
         SDL_Log("AVX-512F %s\n", SDL_HasAVX512F()? "detected" : "not detected");
         SDL_Log("NEON %s\n", SDL_HasNEON()? "detected" : "not detected");
         SDL_Log("System RAM %d MB\n", SDL_GetSystemRAM());
+        SDL_Log("SIMD kernels: fill %s, copy %s, blend %s, convert %s, resample %s, mix %s, yuv %s\n",
+                SDL_GetSIMDKernelVariant("fill"), SDL_GetSIMDKernelVariant("copy"),
+                SDL_GetSIMDKernelVariant("blend"), SDL_GetSIMDKernelVariant("convert"),
+                SDL_GetSIMDKernelVariant("resample"), SDL_GetSIMDKernelVariant("mix"),
+                SDL_GetSIMDKernelVariant("yuv"));
     }
     return (0);
 }
@@ -0,0 +1,412 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Fixed workload benchmarks for the render API: each scene draws the same
+   frames on every run, and the time per frame is reported with its spread.
+   It runs on every render driver that works with the current video driver,
+   or the one given with --renderer. Renderers draw nothing while their
+   window is hidden, so for a headless run use SDL_VIDEODRIVER=dummy for the
+   software renderer, or SDL_VIDEODRIVER=offscreen for GL and GLES2 as well.
+
+   Save a run with --save and compare a later one against it with
+   --baseline. --compare checks a saved run against the baseline without
+   rendering anything. The program exits with 1 if anything got slower than
+   the threshold allows. */
+
+#include "SDL.h"
+#include "SDL_test.h"
+
+#define WIDTH           640
+#define HEIGHT          480
+#define SPRITE_SIZE     32
+#define NUM_SPRITES     1000
+#define STREAM_SIZE     256
+#define TARGET_SIZE     256
+
+typedef struct
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    SDL_Texture *streaming;
+    SDL_Texture *target;
+    SDL_FRect positions[NUM_SPRITES];
+    Uint32 frame;
+} Scene;
+
+static SDL_Texture *
+CreateSprite(SDL_Renderer *renderer)
+{
+    Uint32 pixels[SPRITE_SIZE * SPRITE_SIZE];
+    SDL_Texture *texture;
+    int x, y;
+
+    /* A disc with a soft edge, so blending has partial alpha to work with */
+    for (y = 0; y < SPRITE_SIZE; y++) {
+        for (x = 0; x < SPRITE_SIZE; x++) {
+            const int dx = 2 * x - SPRITE_SIZE + 1;
+            const int dy = 2 * y - SPRITE_SIZE + 1;
+            const int distance = dx * dx + dy * dy;
+            const int radius = SPRITE_SIZE * SPRITE_SIZE;
+            const Uint32 alpha = (distance >= radius) ? 0 : 255 - (255 * distance) / radius;
+            pixels[y * SPRITE_SIZE + x] = (alpha << 24) | ((Uint32) (x * 8) << 16) | ((Uint32) (y * 8) << 8) | 0x80;
+        }
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, SPRITE_SIZE, SPRITE_SIZE);
+    if (texture) {
+        SDL_UpdateTexture(texture, NULL, pixels, SPRITE_SIZE * 4);
+    }
+    return texture;
+}
+
+static void
+BeginFrame(Scene *scene)
+{
+    SDL_SetRenderDrawColor(scene->renderer, 0x20, 0x20, 0x40, 0xFF);
+    SDL_RenderClear(scene->renderer);
+}
+
+/* Presents the frame and waits for the renderer to finish it, so the time
+   of GPU renderers isn't hidden by commands that are still in flight */
+static void
+EndFrame(Scene *scene)
+{
+    Uint32 pixel;
+    SDL_Rect rect;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = 1;
+    rect.h = 1;
+    SDL_RenderReadPixels(scene->renderer, &rect, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof (pixel));
+    SDL_RenderPresent(scene->renderer);
+    ++scene->frame;
+}
+
+/* The sprites move by a fixed amount every frame, wrapping at the edges */
+static void
+GetSpriteRect(Scene *scene, int i, SDL_FRect *rect)
+{
+    const float step = (float) (scene->frame % 64);
+
+    *rect = scene->positions[i];
+    rect->x += step * ((i & 1) ? 1.0f : -1.0f);
+    rect->y += step * ((i & 2) ? 1.0f : -1.0f);
+    if (rect->x < 0.0f) {
+        rect->x += WIDTH - SPRITE_SIZE;
+    } else if (rect->x > WIDTH - SPRITE_SIZE) {
+        rect->x -= WIDTH - SPRITE_SIZE;
+    }
+    if (rect->y < 0.0f) {
+        rect->y += HEIGHT - SPRITE_SIZE;
+    } else if (rect->y > HEIGHT - SPRITE_SIZE) {
+        rect->y -= HEIGHT - SPRITE_SIZE;
+    }
+}
+
+static void
+DrawSprites(Scene *scene)
+{
+    SDL_FRect rect;
+    int i;
+
+    for (i = 0; i < NUM_SPRITES; i++) {
+        GetSpriteRect(scene, i, &rect);
+        SDL_RenderCopyF(scene->renderer, scene->sprite, NULL, &rect);
+    }
+}
+
+static void
+BenchmarkSprites(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    int i;
+
+    SDL_SetTextureBlendMode(scene->sprite, SDL_BLENDMODE_NONE);
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        DrawSprites(scene);
+        EndFrame(scene);
+    }
+}
+
+static void
+BenchmarkSpritesBlend(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    int i;
+
+    SDL_SetTextureBlendMode(scene->sprite, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        DrawSprites(scene);
+        EndFrame(scene);
+    }
+}
+
+static void
+BenchmarkSpritesRotated(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    SDL_FRect rect;
+    int i, j;
+
+    SDL_SetTextureBlendMode(scene->sprite, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        for (j = 0; j < NUM_SPRITES; j++) {
+            const double angle = (double) ((scene->frame + j * 7) % 360);
+            GetSpriteRect(scene, j, &rect);
+            SDL_RenderCopyExF(scene->renderer, scene->sprite, NULL, &rect, angle, NULL, SDL_FLIP_NONE);
+        }
+        EndFrame(scene);
+    }
+}
+
+static void
+BenchmarkFillRects(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    SDL_FRect rects[NUM_SPRITES];
+    int i, j;
+
+    SDL_SetRenderDrawBlendMode(scene->renderer, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        for (j = 0; j < NUM_SPRITES; j++) {
+            GetSpriteRect(scene, j, &rects[j]);
+        }
+        SDL_SetRenderDrawColor(scene->renderer, 0xFF, 0x80, 0x00, 0x80);
+        SDL_RenderFillRectsF(scene->renderer, rects, NUM_SPRITES);
+        EndFrame(scene);
+    }
+    SDL_SetRenderDrawBlendMode(scene->renderer, SDL_BLENDMODE_NONE);
+}
+
+static void
+BenchmarkLines(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    SDL_FRect from, to;
+    int i, j;
+
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        SDL_SetRenderDrawColor(scene->renderer, 0x00, 0xFF, 0x80, 0xFF);
+        for (j = 0; j < NUM_SPRITES; j++) {
+            GetSpriteRect(scene, j, &from);
+            GetSpriteRect(scene, (j + 1) % NUM_SPRITES, &to);
+            SDL_RenderDrawLineF(scene->renderer, from.x, from.y, to.x, to.y);
+        }
+        EndFrame(scene);
+    }
+}
+
+static void
+BenchmarkStreaming(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    void *pixels;
+    int pitch;
+    int i, y;
+
+    for (i = 0; i < iterations; i++) {
+        BeginFrame(scene);
+        if (SDL_LockTexture(scene->streaming, NULL, &pixels, &pitch) == 0) {
+            for (y = 0; y < STREAM_SIZE; y++) {
+                SDL_memset4((Uint8 *) pixels + y * pitch, 0xFF000000 | (scene->frame * 0x010101) | y, STREAM_SIZE);
+            }
+            SDL_UnlockTexture(scene->streaming);
+        }
+        SDL_RenderCopy(scene->renderer, scene->streaming, NULL, NULL);
+        EndFrame(scene);
+    }
+}
+
+static void
+BenchmarkRenderTarget(void *arg, int iterations)
+{
+    Scene *scene = (Scene *) arg;
+    SDL_FRect rect;
+    int i, j;
+
+    SDL_SetTextureBlendMode(scene->sprite, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < iterations; i++) {
+        SDL_SetRenderTarget(scene->renderer, scene->target);
+        SDL_SetRenderDrawColor(scene->renderer, 0x00, 0x00, 0x00, 0x00);
+        SDL_RenderClear(scene->renderer);
+        for (j = 0; j < NUM_SPRITES / 10; j++) {
+            GetSpriteRect(scene, j, &rect);
+            rect.x *= (float) (TARGET_SIZE - SPRITE_SIZE) / (WIDTH - SPRITE_SIZE);
+            rect.y *= (float) (TARGET_SIZE - SPRITE_SIZE) / (HEIGHT - SPRITE_SIZE);
+            SDL_RenderCopyF(scene->renderer, scene->sprite, NULL, &rect);
+        }
+        SDL_SetRenderTarget(scene->renderer, NULL);
+
+        BeginFrame(scene);
+        SDL_RenderCopy(scene->renderer, scene->target, NULL, NULL);
+        EndFrame(scene);
+    }
+}
+
+static void
+RunRendererBenchmarks(SDLTest_BenchmarkContext *context, int index, const char *name)
+{
+    static const struct {
+        const char *name;
+        SDLTest_BenchmarkFp benchmark;
+    } benchmarks[] = {
+        { "sprites", BenchmarkSprites },
+        { "sprites blend", BenchmarkSpritesBlend },
+        { "sprites rotated", BenchmarkSpritesRotated },
+        { "fill rects", BenchmarkFillRects },
+        { "lines", BenchmarkLines },
+        { "streaming texture", BenchmarkStreaming },
+        { "render target", BenchmarkRenderTarget }
+    };
+    SDL_Window *window;
+    Scene scene;
+    char title[64];
+    Uint32 seed = 1;
+    int i;
+
+    window = SDL_CreateWindow(name, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WIDTH, HEIGHT, 0);
+    if (!window) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window: %s\n", SDL_GetError());
+        return;
+    }
+
+    SDL_zero(scene);
+    scene.renderer = SDL_CreateRenderer(window, index, 0);
+    if (!scene.renderer) {
+        SDL_Log("Skipping %s renderer: %s\n", name, SDL_GetError());
+        SDL_DestroyWindow(window);
+        return;
+    }
+
+    scene.sprite = CreateSprite(scene.renderer);
+    scene.streaming = SDL_CreateTexture(scene.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, STREAM_SIZE, STREAM_SIZE);
+    if (SDL_RenderTargetSupported(scene.renderer)) {
+        scene.target = SDL_CreateTexture(scene.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, TARGET_SIZE, TARGET_SIZE);
+    }
+
+    /* The same sprite layout on every run */
+    for (i = 0; i < NUM_SPRITES; i++) {
+        seed = seed * 1103515245 + 12345;
+        scene.positions[i].x = (float) ((seed >> 8) % (WIDTH - SPRITE_SIZE));
+        seed = seed * 1103515245 + 12345;
+        scene.positions[i].y = (float) ((seed >> 8) % (HEIGHT - SPRITE_SIZE));
+        scene.positions[i].w = SPRITE_SIZE;
+        scene.positions[i].h = SPRITE_SIZE;
+    }
+
+    for (i = 0; i < (int) SDL_arraysize(benchmarks); i++) {
+        if ((!scene.sprite || !scene.streaming) ||
+            (benchmarks[i].benchmark == BenchmarkRenderTarget && !scene.target)) {
+            SDL_Log("Skipping %s %s: not supported\n", name, benchmarks[i].name);
+            continue;
+        }
+        SDL_snprintf(title, sizeof (title), "%s: %s", name, benchmarks[i].name);
+        scene.frame = 0;
+        SDLTest_RunBenchmark(context, title, benchmarks[i].benchmark, &scene);
+    }
+
+    SDL_DestroyRenderer(scene.renderer);
+    SDL_DestroyWindow(window);
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDLTest_BenchmarkContext context;
+    const char *baseline = NULL;
+    const char *compare = NULL;
+    const char *renderer = NULL;
+    const char *save = NULL;
+    int regressions = 0;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    SDLTest_BenchmarkInit(&context);
+
+    for (i = 1; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--baseline") == 0 && argv[i + 1]) {
+            baseline = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--compare") == 0 && argv[i + 1]) {
+            compare = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--save") == 0 && argv[i + 1]) {
+            save = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--renderer") == 0 && argv[i + 1]) {
+            renderer = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--filter") == 0 && argv[i + 1]) {
+            context.filter = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--samples") == 0 && argv[i + 1]) {
+            context.samples = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--threshold") == 0 && argv[i + 1]) {
+            context.threshold = SDL_atof(argv[++i]) / 100.0;
+        } else {
+            SDL_Log("Usage: %s [--baseline file] [--compare file] [--save file] [--renderer name] [--filter name] [--samples #] [--threshold percent]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (compare && !baseline) {
+        SDL_Log("--compare needs a --baseline to compare against\n");
+        return 1;
+    }
+
+    if (baseline && SDLTest_BenchmarkLoadBaseline(&context, baseline) < 0) {
+        SDLTest_BenchmarkQuit(&context);
+        return 1;
+    }
+
+    if (compare) {
+        if (SDLTest_BenchmarkLoadResults(&context, compare) < 0) {
+            SDLTest_BenchmarkQuit(&context);
+            return 1;
+        }
+    } else {
+        if (SDL_Init(SDL_INIT_VIDEO) == -1) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+            SDLTest_BenchmarkQuit(&context);
+            return 1;
+        }
+        SDL_Log("Video driver: %s\n", SDL_GetCurrentVideoDriver());
+
+        for (i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+            SDL_RendererInfo info;
+
+            if (SDL_GetRenderDriverInfo(i, &info) < 0) {
+                continue;
+            }
+            if (renderer && SDL_strcasecmp(renderer, info.name) != 0) {
+                continue;
+            }
+            RunRendererBenchmarks(&context, i, info.name);
+        }
+        SDL_Quit();
+    }
+
+    if (save) {
+        SDLTest_BenchmarkSave(&context, save);
+    }
+    if (baseline) {
+        regressions = SDLTest_BenchmarkRegressions(&context);
+        SDL_Log("%d regression%s\n", regressions, (regressions == 1) ? "" : "s");
+    }
+
+    SDLTest_BenchmarkQuit(&context);
+    return (regressions > 0) ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,137 @@
+/*
+  Copyright (C) 1997-2020 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Replays a file written by SDL_RenderStartCapture() on the renderer picked
+   with the usual test options, and prints how long each kind of command
+   took. Use --geometry to match the output size of the captured renderer. */
+
+#include <stdlib.h>
+
+#include "SDL_test_common.h"
+
+#define NUM_COMMAND_NAMES   16
+
+typedef struct
+{
+    const char *name;
+    Uint64 calls;
+    Uint64 items;
+    Uint64 ticks;
+} CommandStats;
+
+static SDLTest_CommonState *state;
+static CommandStats stats[NUM_COMMAND_NAMES];
+
+/* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
+static void
+quit(int rc)
+{
+    SDLTest_CommonQuit(state);
+    exit(rc);
+}
+
+static void SDLCALL
+CountCommand(void *userdata, const SDL_RenderReplayTiming *timing)
+{
+    int i;
+
+    for (i = 0; i < NUM_COMMAND_NAMES; ++i) {
+        if (!stats[i].name) {
+            stats[i].name = timing->name;
+        }
+        if (SDL_strcmp(stats[i].name, timing->name) == 0) {
+            ++stats[i].calls;
+            stats[i].items += timing->count;
+            stats[i].ticks += timing->ticks;
+            break;
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *file = NULL;
+    SDL_bool timing = SDL_FALSE;
+    int loops = 1;
+    int frames = 0;
+    Uint64 start, elapsed;
+    double frequency;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (consumed == 0) {
+            consumed = -1;
+            if (SDL_strcasecmp(argv[i], "--loops") == 0 && argv[i + 1]) {
+                loops = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcasecmp(argv[i], "--timing") == 0) {
+                timing = SDL_TRUE;
+                consumed = 1;
+            } else if (!file && argv[i][0] != '-') {
+                file = argv[i];
+                consumed = 1;
+            }
+        }
+        if (consumed < 0) {
+            static const char *options[] = { "[--loops N]", "[--timing]", "capture", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            quit(1);
+        }
+        i += consumed;
+    }
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No capture file given\n");
+        quit(1);
+    }
+    if (!SDLTest_CommonInit(state)) {
+        quit(2);
+    }
+
+    frequency = (double) SDL_GetPerformanceFrequency();
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < loops; ++i) {
+        int replayed = SDL_RenderReplayCapture(state->renderers[0], file, timing ? CountCommand : NULL, NULL);
+        if (replayed < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't replay %s: %s\n", file, SDL_GetError());
+            quit(2);
+        }
+        frames += replayed;
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (elapsed > 0) {
+        SDL_Log("%d frames in %.2f ms, %.2f frames per second\n", frames,
+                (elapsed * 1000.0) / frequency, (frames * frequency) / elapsed);
+    }
+    for (i = 0; i < NUM_COMMAND_NAMES && stats[i].name; ++i) {
+        SDL_Log("%-12s %8" SDL_PRIu64 " calls %10" SDL_PRIu64 " items %10.3f ms\n",
+                stats[i].name, stats[i].calls, stats[i].items,
+                (stats[i].ticks * 1000.0) / frequency);
+    }
+
+    quit(0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */